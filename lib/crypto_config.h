@@ -39,8 +39,11 @@
 
 //Multiple precision integer support
 #define MPI_SUPPORT ENABLED
-//Assembly optimizations for time-critical routines
-#define MPI_ASM_SUPPORT DISABLED // DISABLED for Linux/GCC to get rid of undefined reference error in CMake
+//Assembly optimizations for time-critical routines (enabled by CMake when
+//an assembly implementation is available for the target architecture)
+#ifndef MPI_ASM_SUPPORT
+   #define MPI_ASM_SUPPORT DISABLED
+#endif
 
 //Base64 encoding support
 #define BASE64_SUPPORT ENABLED
@@ -0,0 +1,266 @@
+/**
+ * @file crypto_cache.c
+ * @brief Shared cache of immutable precomputed objects
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * Entries are built the first time a given key is requested, while holding
+ * the mutex, so that concurrent requests for the same key do not duplicate
+ * the work. Once inserted, an entry is never modified nor released until
+ * the cache itself is released
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "core/crypto_cache.h"
+#include "debug.h"
+
+
+/**
+ * @brief Cache initialization
+ * @param[in] size Maximum number of cache entries
+ * @return Handle referencing the fully initialized cache
+ **/
+
+CryptoCache *cryptoInitCache(uint_t size)
+{
+   size_t n;
+   CryptoCache *cache;
+
+   //Make sure the parameter is acceptable
+   if(size < 1)
+      return NULL;
+
+   //Size of the memory required
+   n = sizeof(CryptoCache) + size * sizeof(void *);
+
+   //Allocate a memory buffer to hold the cache
+   cache = cryptoAllocMem(n);
+   //Failed to allocate memory?
+   if(cache == NULL)
+      return NULL;
+
+   //Clear the cache
+   osMemset(cache, 0, n);
+
+   //Create a mutex to prevent simultaneous access to the cache
+   if(!osCreateMutex(&cache->mutex))
+   {
+      //Clean up side effects
+      cryptoFreeMem(cache);
+      //Report an error
+      return NULL;
+   }
+
+   //Save the maximum number of cache entries
+   cache->size = size;
+
+   //Return a pointer to the newly created cache
+   return cache;
+}
+
+
+/**
+ * @brief Release cache
+ * @param[in] cache Pointer to the cache
+ * @param[in] algo Type of the cache entries
+ **/
+
+void cryptoFreeCache(CryptoCache *cache, const CryptoCacheAlgo *algo)
+{
+   uint_t i;
+
+   //Valid cache?
+   if(cache != NULL)
+   {
+      //Loop through the cache entries
+      for(i = 0; i < cache->size; i++)
+      {
+         //Valid entry?
+         if(cache->entries[i] != NULL)
+         {
+            //Release the entry
+            algo->release(cache->entries[i]);
+            cryptoFreeMem(cache->entries[i]);
+         }
+      }
+
+      //Release previously allocated resources
+      osDeleteMutex(&cache->mutex);
+      cryptoFreeMem(cache);
+   }
+}
+
+
+/**
+ * @brief Insert an entry that has been built by the caller
+ * @param[in] cache Pointer to the cache
+ * @param[in] entry Entry allocated with cryptoAllocMem
+ * @return Error code
+ **/
+
+error_t cryptoCacheAdd(CryptoCache *cache, void *entry)
+{
+   error_t error;
+   uint_t i;
+
+   //Check parameters
+   if(cache == NULL || entry == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Acquire exclusive access to the cache
+   osAcquireMutex(&cache->mutex);
+
+   //Look for a free entry
+   for(i = 0; i < cache->size; i++)
+   {
+      //Free entry?
+      if(cache->entries[i] == NULL)
+         break;
+   }
+
+   //Any free entry?
+   if(i < cache->size)
+   {
+      //Save the entry
+      cache->entries[i] = entry;
+      error = NO_ERROR;
+   }
+   else
+   {
+      //The cache is full
+      error = ERROR_OUT_OF_RESOURCES;
+   }
+
+   //Release exclusive access to the cache
+   osReleaseMutex(&cache->mutex);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Retrieve the entry matching a key, building it if necessary
+ * @param[in] cache Pointer to the cache
+ * @param[in] algo Type of the cache entries
+ * @param[in] key Key identifying the entry
+ * @param[out] entry Pointer to the matching entry
+ * @return Error code
+ **/
+
+error_t cryptoCacheGet(CryptoCache *cache, const CryptoCacheAlgo *algo,
+   const void *key, void **entry)
+{
+   error_t error;
+   uint_t i;
+   void *p;
+
+   //Check parameters
+   if(cache == NULL || algo == NULL || key == NULL || entry == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Initialize status code
+   error = NO_ERROR;
+   //Initialize pointer
+   p = NULL;
+
+   //Acquire exclusive access to the cache
+   osAcquireMutex(&cache->mutex);
+
+   //Loop through the cache entries
+   for(i = 0; i < cache->size && p == NULL; i++)
+   {
+      //Matching entry?
+      if(cache->entries[i] != NULL && algo->match(cache->entries[i], key))
+      {
+         p = cache->entries[i];
+      }
+   }
+
+   //No matching entry?
+   if(p == NULL)
+   {
+      //Look for a free entry
+      for(i = 0; i < cache->size; i++)
+      {
+         //Free entry?
+         if(cache->entries[i] == NULL)
+            break;
+      }
+
+      //The cache is full?
+      if(i >= cache->size)
+      {
+         error = ERROR_OUT_OF_RESOURCES;
+      }
+
+      //Check status code
+      if(!error)
+      {
+         //Allocate a memory buffer to hold the new entry
+         p = cryptoAllocMem(algo->entrySize);
+         //Failed to allocate memory?
+         if(p == NULL)
+            error = ERROR_OUT_OF_MEMORY;
+      }
+
+      //Check status code
+      if(!error)
+      {
+         //Build the new entry
+         error = algo->build(p, key);
+
+         //Check status code
+         if(!error)
+         {
+            //Save the new entry
+            cache->entries[i] = p;
+         }
+         else
+         {
+            //Clean up side effects
+            algo->release(p);
+            cryptoFreeMem(p);
+            p = NULL;
+         }
+      }
+   }
+
+   //Release exclusive access to the cache
+   osReleaseMutex(&cache->mutex);
+
+   //Return a pointer to the matching entry
+   *entry = p;
+
+   //Return status code
+   return error;
+}
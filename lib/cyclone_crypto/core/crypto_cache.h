@@ -0,0 +1,88 @@
+/**
+ * @file crypto_cache.h
+ * @brief Shared cache of immutable precomputed objects
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _CRYPTO_CACHE_H
+#define _CRYPTO_CACHE_H
+
+//Dependencies
+#include "core/crypto.h"
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+//Cache entry related functions
+typedef bool_t (*CryptoCacheMatch)(const void *entry, const void *key);
+typedef error_t (*CryptoCacheBuild)(void *entry, const void *key);
+typedef void (*CryptoCacheRelease)(void *entry);
+
+
+/**
+ * @brief Type of the objects held by a cache
+ **/
+
+typedef struct
+{
+   size_t entrySize;           ///<Size of an entry, in bytes
+   CryptoCacheMatch match;     ///<Check whether an entry matches a key
+   CryptoCacheBuild build;     ///<Build a new entry for a key
+   CryptoCacheRelease release; ///<Release the resources held by an entry
+} CryptoCacheAlgo;
+
+
+/**
+ * @brief Cache of immutable precomputed objects
+ **/
+
+typedef struct
+{
+   OsMutex mutex;   ///<Mutex preventing simultaneous access to the cache
+   uint_t size;     ///<Max number of entries
+   void *entries[]; ///<Cache entries
+} CryptoCache;
+
+
+//Cache related functions
+CryptoCache *cryptoInitCache(uint_t size);
+void cryptoFreeCache(CryptoCache *cache, const CryptoCacheAlgo *algo);
+
+error_t cryptoCacheAdd(CryptoCache *cache, void *entry);
+
+error_t cryptoCacheGet(CryptoCache *cache, const CryptoCacheAlgo *algo,
+   const void *key, void **entry);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
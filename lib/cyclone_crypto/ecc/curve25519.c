@@ -40,13 +40,94 @@
 //Check crypto library configuration
 #if (X25519_SUPPORT == ENABLED || ED25519_SUPPORT == ENABLED)
 
+#if (CURVE25519_64BIT_SUPPORT == ENABLED)
+
+//Mask of a 51-bit limb
+#define CURVE25519_MASK 0x0007FFFFFFFFFFFF
+//Limbs of 2p
+#define CURVE25519_2P0 0x000FFFFFFFFFFFDA
+#define CURVE25519_2P1 0x000FFFFFFFFFFFFE
+
+//Square root of -1 modulo p (constant)
+static const Curve25519Limb CURVE25519_SQRT_MINUS_1[5] =
+{
+   0x00061B274A0EA0B0, 0x0000D5A5FC8F189D, 0x0007EF5E9CBD0C60,
+   0x00078595A6804C9E, 0x0002B8324804FC1D
+};
+
+#else
+
 //Square root of -1 modulo p (constant)
-static const uint32_t CURVE25519_SQRT_MINUS_1[8] =
+static const Curve25519Limb CURVE25519_SQRT_MINUS_1[8] =
 {
    0x4A0EA0B0, 0xC4EE1B27, 0xAD2FE478, 0x2F431806,
    0x3DFBD7A7, 0x2B4D0099, 0x4FC1DF0B, 0x2B832480
 };
 
+#endif
+
+
+#if (CURVE25519_64BIT_SUPPORT == ENABLED)
+
+/**
+ * @brief Propagate the carries of an integer
+ *
+ * The limbs of the result do not exceed 2^51 + 2^10. The result is reduced
+ * modulo p, but is not necessarily the canonical representative
+ *
+ * @param[in,out] r Integer whose limbs are less than 2^63
+ **/
+
+static void curve25519Carry(Curve25519Limb *r)
+{
+   //Reduce each limb to 51 bits
+   r[1] += r[0] >> 51;
+   r[0] &= CURVE25519_MASK;
+   r[2] += r[1] >> 51;
+   r[1] &= CURVE25519_MASK;
+   r[3] += r[2] >> 51;
+   r[2] &= CURVE25519_MASK;
+   r[4] += r[3] >> 51;
+   r[3] &= CURVE25519_MASK;
+
+   //Reduce the bits above 2^255 (2^255 = 19 mod p)
+   r[0] += (r[4] >> 51) * 19;
+   r[4] &= CURVE25519_MASK;
+}
+
+
+/**
+ * @brief Propagate the carries of a product
+ * @param[out] r Resulting integer R = T mod p
+ * @param[in] t0 Limb 0 of the double-width integer T
+ * @param[in] t1 Limb 1 of the double-width integer T
+ * @param[in] t2 Limb 2 of the double-width integer T
+ * @param[in] t3 Limb 3 of the double-width integer T
+ * @param[in] t4 Limb 4 of the double-width integer T
+ **/
+
+static void curve25519CarryWide(Curve25519Limb *r, Curve25519Dlimb t0,
+   Curve25519Dlimb t1, Curve25519Dlimb t2, Curve25519Dlimb t3,
+   Curve25519Dlimb t4)
+{
+   //Reduce each limb to 51 bits
+   t1 += (uint64_t) (t0 >> 51);
+   t2 += (uint64_t) (t1 >> 51);
+   t3 += (uint64_t) (t2 >> 51);
+   t4 += (uint64_t) (t3 >> 51);
+
+   r[0] = (uint64_t) t0 & CURVE25519_MASK;
+   r[1] = (uint64_t) t1 & CURVE25519_MASK;
+   r[2] = (uint64_t) t2 & CURVE25519_MASK;
+   r[3] = (uint64_t) t3 & CURVE25519_MASK;
+   r[4] = (uint64_t) t4 & CURVE25519_MASK;
+
+   //Reduce the bits above 2^255 (2^255 = 19 mod p)
+   r[0] += (uint64_t) (t4 >> 51) * 19;
+   r[1] += r[0] >> 51;
+   r[0] &= CURVE25519_MASK;
+}
+
 
 /**
  * @brief Set integer value
@@ -54,7 +135,228 @@ static const uint32_t CURVE25519_SQRT_MINUS_1[8] =
  * @param[in] b Initial value
  **/
 
-void curve25519SetInt(uint32_t *a, uint32_t b)
+void curve25519SetInt(Curve25519Limb *a, uint32_t b)
+{
+   //Set the value of the least significant limb
+   a[0] = b;
+
+   //Initialize the rest of the integer
+   a[1] = 0;
+   a[2] = 0;
+   a[3] = 0;
+   a[4] = 0;
+}
+
+
+/**
+ * @brief Modular addition
+ * @param[out] r Resulting integer R = (A + B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < p
+ **/
+
+void curve25519Add(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b)
+{
+   uint_t i;
+
+   //Compute R = A + B (limbs are not allowed to overflow)
+   for(i = 0; i < 5; i++)
+   {
+      r[i] = a[i] + b[i];
+   }
+
+   //Perform modular reduction
+   curve25519Carry(r);
+}
+
+
+/**
+ * @brief Modular addition
+ * @param[out] r Resulting integer R = (A + B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < (2^32 - 1)
+ **/
+
+void curve25519AddInt(Curve25519Limb *r, const Curve25519Limb *a, uint32_t b)
+{
+   //Compute R = A + B
+   r[0] = a[0] + b;
+   r[1] = a[1];
+   r[2] = a[2];
+   r[3] = a[3];
+   r[4] = a[4];
+
+   //Perform modular reduction
+   curve25519Carry(r);
+}
+
+
+/**
+ * @brief Modular subtraction
+ * @param[out] r Resulting integer R = (A - B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < p
+ **/
+
+void curve25519Sub(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b)
+{
+   //Compute R = A + 2p - B, so that no limb can underflow
+   r[0] = a[0] + CURVE25519_2P0 - b[0];
+   r[1] = a[1] + CURVE25519_2P1 - b[1];
+   r[2] = a[2] + CURVE25519_2P1 - b[2];
+   r[3] = a[3] + CURVE25519_2P1 - b[3];
+   r[4] = a[4] + CURVE25519_2P1 - b[4];
+
+   //Perform modular reduction
+   curve25519Carry(r);
+}
+
+
+/**
+ * @brief Modular subtraction
+ * @param[out] r Resulting integer R = (A - B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < (2^32 - 1)
+ **/
+
+void curve25519SubInt(Curve25519Limb *r, const Curve25519Limb *a, uint32_t b)
+{
+   //Compute R = A + 2p - B
+   r[0] = a[0] + CURVE25519_2P0 - b;
+   r[1] = a[1] + CURVE25519_2P1;
+   r[2] = a[2] + CURVE25519_2P1;
+   r[3] = a[3] + CURVE25519_2P1;
+   r[4] = a[4] + CURVE25519_2P1;
+
+   //Perform modular reduction
+   curve25519Carry(r);
+}
+
+
+/**
+ * @brief Modular multiplication
+ * @param[out] r Resulting integer R = (A * B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < p
+ **/
+
+__weak_func void curve25519Mul(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b)
+{
+   Curve25519Dlimb t0;
+   Curve25519Dlimb t1;
+   Curve25519Dlimb t2;
+   Curve25519Dlimb t3;
+   Curve25519Dlimb t4;
+   uint64_t b1;
+   uint64_t b2;
+   uint64_t b3;
+   uint64_t b4;
+
+   //The partial products that exceed 2^255 are folded back into the lower
+   //limbs using 2^255 = 19 mod p
+   b1 = b[1] * 19;
+   b2 = b[2] * 19;
+   b3 = b[3] * 19;
+   b4 = b[4] * 19;
+
+   //Schoolbook multiplication
+   t0 = (Curve25519Dlimb) a[0] * b[0] + (Curve25519Dlimb) a[1] * b4 +
+      (Curve25519Dlimb) a[2] * b3 + (Curve25519Dlimb) a[3] * b2 +
+      (Curve25519Dlimb) a[4] * b1;
+
+   t1 = (Curve25519Dlimb) a[0] * b[1] + (Curve25519Dlimb) a[1] * b[0] +
+      (Curve25519Dlimb) a[2] * b4 + (Curve25519Dlimb) a[3] * b3 +
+      (Curve25519Dlimb) a[4] * b2;
+
+   t2 = (Curve25519Dlimb) a[0] * b[2] + (Curve25519Dlimb) a[1] * b[1] +
+      (Curve25519Dlimb) a[2] * b[0] + (Curve25519Dlimb) a[3] * b4 +
+      (Curve25519Dlimb) a[4] * b3;
+
+   t3 = (Curve25519Dlimb) a[0] * b[3] + (Curve25519Dlimb) a[1] * b[2] +
+      (Curve25519Dlimb) a[2] * b[1] + (Curve25519Dlimb) a[3] * b[0] +
+      (Curve25519Dlimb) a[4] * b4;
+
+   t4 = (Curve25519Dlimb) a[0] * b[4] + (Curve25519Dlimb) a[1] * b[3] +
+      (Curve25519Dlimb) a[2] * b[2] + (Curve25519Dlimb) a[3] * b[1] +
+      (Curve25519Dlimb) a[4] * b[0];
+
+   //Propagate the carries
+   curve25519CarryWide(r, t0, t1, t2, t3, t4);
+}
+
+
+/**
+ * @brief Modular multiplication
+ * @param[out] r Resulting integer R = (A * B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < (2^32 - 1)
+ **/
+
+void curve25519MulInt(Curve25519Limb *r, const Curve25519Limb *a, uint32_t b)
+{
+   //Compute R = A * B
+   curve25519CarryWide(r, (Curve25519Dlimb) a[0] * b, (Curve25519Dlimb) a[1] * b,
+      (Curve25519Dlimb) a[2] * b, (Curve25519Dlimb) a[3] * b,
+      (Curve25519Dlimb) a[4] * b);
+}
+
+
+/**
+ * @brief Modular squaring
+ * @param[out] r Resulting integer R = (A ^ 2) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ **/
+
+__weak_func void curve25519Sqr(Curve25519Limb *r, const Curve25519Limb *a)
+{
+   Curve25519Dlimb t0;
+   Curve25519Dlimb t1;
+   Curve25519Dlimb t2;
+   Curve25519Dlimb t3;
+   Curve25519Dlimb t4;
+   uint64_t a0;
+   uint64_t a1;
+   uint64_t a3;
+   uint64_t a4;
+
+   //Each cross product appears twice in the square
+   a0 = a[0] * 2;
+   a1 = a[1] * 2;
+   a3 = a[3] * 19;
+   a4 = a[4] * 19;
+
+   //Only 15 partial products are required
+   t0 = (Curve25519Dlimb) a[0] * a[0] + (Curve25519Dlimb) a1 * a4 +
+      (Curve25519Dlimb) (a[2] * 2) * a3;
+
+   t1 = (Curve25519Dlimb) a0 * a[1] + (Curve25519Dlimb) (a[2] * 2) * a4 +
+      (Curve25519Dlimb) a[3] * a3;
+
+   t2 = (Curve25519Dlimb) a0 * a[2] + (Curve25519Dlimb) a[1] * a[1] +
+      (Curve25519Dlimb) (a[3] * 2) * a4;
+
+   t3 = (Curve25519Dlimb) a0 * a[3] + (Curve25519Dlimb) a1 * a[2] +
+      (Curve25519Dlimb) a[4] * a4;
+
+   t4 = (Curve25519Dlimb) a0 * a[4] + (Curve25519Dlimb) a1 * a[3] +
+      (Curve25519Dlimb) a[2] * a[2];
+
+   //Propagate the carries
+   curve25519CarryWide(r, t0, t1, t2, t3, t4);
+}
+
+#else
+
+/**
+ * @brief Set integer value
+ * @param[out] a Pointer to the integer to be initialized
+ * @param[in] b Initial value
+ **/
+
+void curve25519SetInt(Curve25519Limb *a, uint32_t b)
 {
    uint_t i;
 
@@ -76,7 +378,8 @@ void curve25519SetInt(uint32_t *a, uint32_t b)
  * @param[in] b An integer such as 0 <= B < p
  **/
 
-void curve25519Add(uint32_t *r, const uint32_t *a, const uint32_t *b)
+void curve25519Add(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b)
 {
    uint_t i;
    uint64_t temp;
@@ -102,7 +405,7 @@ void curve25519Add(uint32_t *r, const uint32_t *a, const uint32_t *b)
  * @param[in] b An integer such as 0 <= B < (2^32 - 1)
  **/
 
-void curve25519AddInt(uint32_t *r, const uint32_t *a, uint32_t b)
+void curve25519AddInt(Curve25519Limb *r, const Curve25519Limb *a, uint32_t b)
 {
    uint_t i;
    uint64_t temp;
@@ -127,7 +430,8 @@ void curve25519AddInt(uint32_t *r, const uint32_t *a, uint32_t b)
  * @param[in] b An integer such as 0 <= B < p
  **/
 
-void curve25519Sub(uint32_t *r, const uint32_t *a, const uint32_t *b)
+void curve25519Sub(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b)
 {
    uint_t i;
    int64_t temp;
@@ -156,7 +460,7 @@ void curve25519Sub(uint32_t *r, const uint32_t *a, const uint32_t *b)
  * @param[in] b An integer such as 0 <= B < (2^32 - 1)
  **/
 
-void curve25519SubInt(uint32_t *r, const uint32_t *a, uint32_t b)
+void curve25519SubInt(Curve25519Limb *r, const Curve25519Limb *a, uint32_t b)
 {
    uint_t i;
    int64_t temp;
@@ -188,7 +492,8 @@ void curve25519SubInt(uint32_t *r, const uint32_t *a, uint32_t b)
  * @param[in] b An integer such as 0 <= B < p
  **/
 
-__weak_func void curve25519Mul(uint32_t *r, const uint32_t *a, const uint32_t *b)
+__weak_func void curve25519Mul(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b)
 {
    uint_t i;
    uint_t j;
@@ -274,7 +579,7 @@ __weak_func void curve25519Mul(uint32_t *r, const uint32_t *a, const uint32_t *b
  * @param[in] b An integer such as 0 <= B < (2^32 - 1)
  **/
 
-void curve25519MulInt(uint32_t *r, const uint32_t *a, uint32_t b)
+void curve25519MulInt(Curve25519Limb *r, const Curve25519Limb *a, uint32_t b)
 {
    int_t i;
    uint64_t temp;
@@ -314,13 +619,15 @@ void curve25519MulInt(uint32_t *r, const uint32_t *a, uint32_t b)
  * @param[in] a An integer such as 0 <= A < p
  **/
 
-__weak_func void curve25519Sqr(uint32_t *r, const uint32_t *a)
+__weak_func void curve25519Sqr(Curve25519Limb *r, const Curve25519Limb *a)
 {
    //Compute R = (A ^ 2) mod p
    curve25519Mul(r, a, a);
 }
 
 
+#endif
+
 /**
  * @brief Raise an integer to power 2^n
  * @param[out] r Resulting integer R = (A ^ (2^n)) mod p
@@ -328,7 +635,7 @@ __weak_func void curve25519Sqr(uint32_t *r, const uint32_t *a)
  * @param[in] n An integer such as n >= 1
  **/
 
-void curve25519Pwr2(uint32_t *r, const uint32_t *a, uint_t n)
+void curve25519Pwr2(Curve25519Limb *r, const Curve25519Limb *a, uint_t n)
 {
    uint_t i;
 
@@ -343,13 +650,79 @@ void curve25519Pwr2(uint32_t *r, const uint32_t *a, uint_t n)
 }
 
 
+#if (CURVE25519_64BIT_SUPPORT == ENABLED)
+
+/**
+ * @brief Modular reduction
+ * @param[out] r Resulting integer R = A mod p
+ * @param[in] a An integer whose limbs are less than 2^63
+ **/
+
+void curve25519Red(Curve25519Limb *r, const Curve25519Limb *a)
+{
+   uint_t i;
+   uint_t j;
+   uint64_t u[5];
+
+   //Copy the limbs of A
+   for(i = 0; i < 5; i++)
+   {
+      u[i] = a[i];
+   }
+
+   //Two carry passes leave an integer U such as 0 <= U < 2^255 + 19
+   for(j = 0; j < 2; j++)
+   {
+      for(i = 0; i < 4; i++)
+      {
+         u[i + 1] += u[i] >> 51;
+         u[i] &= CURVE25519_MASK;
+      }
+
+      //Reduce bit 255 (2^255 = 19 mod p)
+      u[0] += (u[4] >> 51) * 19;
+      u[4] &= CURVE25519_MASK;
+   }
+
+   //Compute U + 19. Bit 255 is set if and only if U >= p, in which case
+   //it is folded back so that the result is U - p + 19
+   u[0] += 19;
+
+   for(i = 0; i < 4; i++)
+   {
+      u[i + 1] += u[i] >> 51;
+      u[i] &= CURVE25519_MASK;
+   }
+
+   u[0] += (u[4] >> 51) * 19;
+   u[4] &= CURVE25519_MASK;
+
+   //Add 2^255 - 19 and discard bit 255 to cancel the previous offset
+   u[0] += CURVE25519_MASK - 18;
+
+   for(i = 1; i < 5; i++)
+   {
+      u[i] += CURVE25519_MASK;
+   }
+
+   for(i = 0; i < 4; i++)
+   {
+      u[i + 1] += u[i] >> 51;
+      r[i] = u[i] & CURVE25519_MASK;
+   }
+
+   r[4] = u[4] & CURVE25519_MASK;
+}
+
+#else
+
 /**
  * @brief Modular reduction
  * @param[out] r Resulting integer R = A mod p
  * @param[in] a An integer such as 0 <= A < (2 * p)
  **/
 
-void curve25519Red(uint32_t *r, const uint32_t *a)
+void curve25519Red(Curve25519Limb *r, const Curve25519Limb *a)
 {
    uint_t i;
    uint64_t temp;
@@ -371,16 +744,18 @@ void curve25519Red(uint32_t *r, const uint32_t *a)
 }
 
 
+#endif
+
 /**
  * @brief Modular multiplicative inverse
  * @param[out] r Resulting integer R = A^-1 mod p
  * @param[in] a An integer such as 0 <= A < p
  **/
 
-void curve25519Inv(uint32_t *r, const uint32_t *a)
+void curve25519Inv(Curve25519Limb *r, const Curve25519Limb *a)
 {
-   uint32_t u[8];
-   uint32_t v[8];
+   Curve25519Limb u[CURVE25519_LIMB_LEN];
+   Curve25519Limb v[CURVE25519_LIMB_LEN];
 
    //Since GF(p) is a prime field, the Fermat's little theorem can be
    //used to find the multiplicative inverse of A modulo p
@@ -427,13 +802,14 @@ void curve25519Inv(uint32_t *r, const uint32_t *a)
  * @return The function returns 0 if the square root exists, else 1
  **/
 
-uint32_t curve25519Sqrt(uint32_t *r, const uint32_t *a, const uint32_t *b)
+uint32_t curve25519Sqrt(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b)
 {
    uint32_t res1;
    uint32_t res2;
-   uint32_t c[8];
-   uint32_t u[8];
-   uint32_t v[8];
+   Curve25519Limb c[CURVE25519_LIMB_LEN];
+   Curve25519Limb u[CURVE25519_LIMB_LEN];
+   Curve25519Limb v[CURVE25519_LIMB_LEN];
 
    //Compute the candidate root (A / B)^((p + 3) / 8). This can be done
    //with the following trick, using a single modular powering for both the
@@ -512,12 +888,12 @@ uint32_t curve25519Sqrt(uint32_t *r, const uint32_t *a, const uint32_t *b)
  * @param[in] b Pointer to the source integer
  **/
 
-void curve25519Copy(uint32_t *a, const uint32_t *b)
+void curve25519Copy(Curve25519Limb *a, const Curve25519Limb *b)
 {
    uint_t i;
 
    //Copy the value of the integer
-   for(i = 0; i < 8; i++)
+   for(i = 0; i < CURVE25519_LIMB_LEN; i++)
    {
       a[i] = b[i];
    }
@@ -531,17 +907,17 @@ void curve25519Copy(uint32_t *a, const uint32_t *b)
  * @param[in] c Condition variable
  **/
 
-void curve25519Swap(uint32_t *a, uint32_t *b, uint32_t c)
+void curve25519Swap(Curve25519Limb *a, Curve25519Limb *b, uint32_t c)
 {
    uint_t i;
-   uint32_t mask;
-   uint32_t dummy;
+   Curve25519Limb mask;
+   Curve25519Limb dummy;
 
    //The mask is the all-1 or all-0 word
-   mask = ~c + 1;
+   mask = ~((Curve25519Limb) c) + 1;
 
    //Conditional swap
-   for(i = 0; i < 8; i++)
+   for(i = 0; i < CURVE25519_LIMB_LEN; i++)
    {
       //Constant time implementation
       dummy = mask & (a[i] ^ b[i]);
@@ -559,17 +935,17 @@ void curve25519Swap(uint32_t *a, uint32_t *b, uint32_t c)
  * @param[in] c Condition variable
  **/
 
-void curve25519Select(uint32_t *r, const uint32_t *a, const uint32_t *b,
-   uint32_t c)
+void curve25519Select(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b, uint32_t c)
 {
    uint_t i;
-   uint32_t mask;
+   Curve25519Limb mask;
 
    //The mask is the all-1 or all-0 word
-   mask = c - 1;
+   mask = (Curve25519Limb) c - 1;
 
    //Select between A and B
-   for(i = 0; i < 8; i++)
+   for(i = 0; i < CURVE25519_LIMB_LEN; i++)
    {
       //Constant time implementation
       r[i] = (a[i] & mask) | (b[i] & ~mask);
@@ -584,33 +960,97 @@ void curve25519Select(uint32_t *r, const uint32_t *a, const uint32_t *b,
  * @return The function returns 0 if the A = B, else 1
  **/
 
-uint32_t curve25519Comp(const uint32_t *a, const uint32_t *b)
+uint32_t curve25519Comp(const Curve25519Limb *a, const Curve25519Limb *b)
 {
    uint_t i;
-   uint32_t mask;
+   Curve25519Limb mask;
+   Curve25519Limb u[CURVE25519_LIMB_LEN];
+   Curve25519Limb v[CURVE25519_LIMB_LEN];
+
+   //Retrieve the canonical representatives of A and B
+   curve25519Red(u, a);
+   curve25519Red(v, b);
 
    //Initialize mask
    mask = 0;
 
    //Compare A and B
-   for(i = 0; i < 8; i++)
+   for(i = 0; i < CURVE25519_LIMB_LEN; i++)
    {
       //Constant time implementation
-      mask |= a[i] ^ b[i];
+      mask |= u[i] ^ v[i];
    }
 
    //Return 0 if A = B, else 1
-   return ((uint32_t) (mask | (~mask + 1))) >> 31;
+   return (uint32_t) ((mask | (~mask + 1)) >> (sizeof(Curve25519Limb) * 8 - 1));
 }
 
 
+#if (CURVE25519_64BIT_SUPPORT == ENABLED)
+
 /**
  * @brief Import an octet string
+ *
+ * Bit 255 of the octet string is ignored
+ *
  * @param[out] a Pointer to resulting integer
  * @param[in] data Octet string to be converted
  **/
 
-void curve25519Import(uint32_t *a, const uint8_t *data)
+void curve25519Import(Curve25519Limb *a, const uint8_t *data)
+{
+   uint64_t w0;
+   uint64_t w1;
+   uint64_t w2;
+   uint64_t w3;
+
+   //Read the octet string as four little-endian 64-bit words
+   w0 = LOAD64LE(data);
+   w1 = LOAD64LE(data + 8);
+   w2 = LOAD64LE(data + 16);
+   w3 = LOAD64LE(data + 24);
+
+   //Split the integer into 51-bit limbs
+   a[0] = w0 & CURVE25519_MASK;
+   a[1] = ((w0 >> 51) | (w1 << 13)) & CURVE25519_MASK;
+   a[2] = ((w1 >> 38) | (w2 << 26)) & CURVE25519_MASK;
+   a[3] = ((w2 >> 25) | (w3 << 39)) & CURVE25519_MASK;
+   a[4] = (w3 >> 12) & CURVE25519_MASK;
+}
+
+
+/**
+ * @brief Export an octet string
+ * @param[in] a Pointer to the integer to be exported
+ * @param[out] data Octet string resulting from the conversion
+ **/
+
+void curve25519Export(Curve25519Limb *a, uint8_t *data)
+{
+   uint64_t u[5];
+
+   //Retrieve the canonical representative of A
+   curve25519Red(u, a);
+
+   //Pack the 51-bit limbs into four little-endian 64-bit words
+   STORE64LE(u[0] | (u[1] << 51), data);
+   STORE64LE((u[1] >> 13) | (u[2] << 38), data + 8);
+   STORE64LE((u[2] >> 26) | (u[3] << 25), data + 16);
+   STORE64LE((u[3] >> 39) | (u[4] << 12), data + 24);
+}
+
+#else
+
+/**
+ * @brief Import an octet string
+ *
+ * Bit 255 of the octet string is ignored
+ *
+ * @param[out] a Pointer to resulting integer
+ * @param[in] data Octet string to be converted
+ **/
+
+void curve25519Import(Curve25519Limb *a, const uint8_t *data)
 {
    uint_t i;
 
@@ -622,6 +1062,9 @@ void curve25519Import(uint32_t *a, const uint8_t *data)
    {
       a[i] = letoh32(a[i]);
    }
+
+   //Clear bit 255
+   a[7] &= 0x7FFFFFFF;
 }
 
 
@@ -631,7 +1074,7 @@ void curve25519Import(uint32_t *a, const uint8_t *data)
  * @param[out] data Octet string resulting from the conversion
  **/
 
-void curve25519Export(uint32_t *a, uint8_t *data)
+void curve25519Export(Curve25519Limb *a, uint8_t *data)
 {
    uint_t i;
 
@@ -645,4 +1088,7 @@ void curve25519Export(uint32_t *a, uint8_t *data)
    osMemcpy(data, a, 32);
 }
 
+
+#endif
+
 #endif
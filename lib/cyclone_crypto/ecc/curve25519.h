@@ -34,11 +34,31 @@
 //Dependencies
 #include "core/crypto.h"
 
+//64-bit field arithmetic (radix 2^51) support
+#ifndef CURVE25519_64BIT_SUPPORT
+   #if defined(__SIZEOF_INT128__)
+      #define CURVE25519_64BIT_SUPPORT ENABLED
+   #else
+      #define CURVE25519_64BIT_SUPPORT DISABLED
+   #endif
+#elif (CURVE25519_64BIT_SUPPORT != ENABLED && CURVE25519_64BIT_SUPPORT != DISABLED)
+   #error CURVE25519_64BIT_SUPPORT parameter is not valid
+#elif (CURVE25519_64BIT_SUPPORT == ENABLED && !defined(__SIZEOF_INT128__))
+   #error CURVE25519_64BIT_SUPPORT requires 128-bit integer support
+#endif
+
 //Length of the elliptic curve
 #define CURVE25519_BIT_LEN 255
 #define CURVE25519_BYTE_LEN 32
 #define CURVE25519_WORD_LEN 8
 
+//Number of limbs in a field element
+#if (CURVE25519_64BIT_SUPPORT == ENABLED)
+   #define CURVE25519_LIMB_LEN 5
+#else
+   #define CURVE25519_LIMB_LEN 8
+#endif
+
 //A24 constant
 #define CURVE25519_A24 121666
 
@@ -47,31 +67,61 @@
 extern "C" {
 #endif
 
+
+/**
+ * @brief Limb of a field element
+ *
+ * With the 64-bit backend, a field element is made of five 51-bit limbs.
+ * The arithmetic functions only partially reduce their results, so that
+ * the limbs must be normalized with curve25519Red before being inspected
+ * directly. curve25519Comp and curve25519Export take care of that
+ *
+ **/
+
+#if (CURVE25519_64BIT_SUPPORT == ENABLED)
+   typedef uint64_t Curve25519Limb;
+   __extension__ typedef unsigned __int128 Curve25519Dlimb;
+#else
+   typedef uint32_t Curve25519Limb;
+   typedef uint64_t Curve25519Dlimb;
+#endif
+
+
 //Curve25519 related functions
-void curve25519SetInt(uint32_t *a, uint32_t b);
-void curve25519Add(uint32_t *r, const uint32_t *a, const uint32_t *b);
-void curve25519AddInt(uint32_t *r, const uint32_t *a, uint32_t b);
-void curve25519Sub(uint32_t *r, const uint32_t *a, const uint32_t *b);
-void curve25519SubInt(uint32_t *r, const uint32_t *a, uint32_t b);
-void curve25519Mul(uint32_t *r, const uint32_t *a, const uint32_t *b);
-void curve25519MulInt(uint32_t *r, const uint32_t *a, uint32_t b);
-void curve25519Red(uint32_t *r, const uint32_t *a);
-void curve25519Sqr(uint32_t *r, const uint32_t *a);
-void curve25519Pwr2(uint32_t *r, const uint32_t *a, uint_t n);
-void curve25519Inv(uint32_t *r, const uint32_t *a);
-
-uint32_t curve25519Sqrt(uint32_t *r, const uint32_t *a, const uint32_t *b);
-
-void curve25519Copy(uint32_t *a, const uint32_t *b);
-void curve25519Swap(uint32_t *a, uint32_t *b, uint32_t c);
-
-void curve25519Select(uint32_t *r, const uint32_t *a, const uint32_t *b,
-   uint32_t c);
-
-uint32_t curve25519Comp(const uint32_t *a, const uint32_t *b);
-
-void curve25519Import(uint32_t *a, const uint8_t *data);
-void curve25519Export(uint32_t *a, uint8_t *data);
+void curve25519SetInt(Curve25519Limb *a, uint32_t b);
+
+void curve25519Add(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b);
+
+void curve25519AddInt(Curve25519Limb *r, const Curve25519Limb *a, uint32_t b);
+
+void curve25519Sub(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b);
+
+void curve25519SubInt(Curve25519Limb *r, const Curve25519Limb *a, uint32_t b);
+
+void curve25519Mul(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b);
+
+void curve25519MulInt(Curve25519Limb *r, const Curve25519Limb *a, uint32_t b);
+void curve25519Red(Curve25519Limb *r, const Curve25519Limb *a);
+void curve25519Sqr(Curve25519Limb *r, const Curve25519Limb *a);
+void curve25519Pwr2(Curve25519Limb *r, const Curve25519Limb *a, uint_t n);
+void curve25519Inv(Curve25519Limb *r, const Curve25519Limb *a);
+
+uint32_t curve25519Sqrt(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b);
+
+void curve25519Copy(Curve25519Limb *a, const Curve25519Limb *b);
+void curve25519Swap(Curve25519Limb *a, Curve25519Limb *b, uint32_t c);
+
+void curve25519Select(Curve25519Limb *r, const Curve25519Limb *a,
+   const Curve25519Limb *b, uint32_t c);
+
+uint32_t curve25519Comp(const Curve25519Limb *a, const Curve25519Limb *b);
+
+void curve25519Import(Curve25519Limb *a, const uint8_t *data);
+void curve25519Export(Curve25519Limb *a, uint8_t *data);
 
 //C++ guard
 #ifdef __cplusplus
@@ -41,13 +41,378 @@
 #if (X448_SUPPORT == ENABLED || ED448_SUPPORT == ENABLED)
 
 
+#if (CURVE448_64BIT_SUPPORT == ENABLED)
+
+//Mask of a 56-bit limb
+#define CURVE448_MASK 0x00FFFFFFFFFFFFFF
+//Limbs of 2p
+#define CURVE448_2P0 0x01FFFFFFFFFFFFFE
+#define CURVE448_2P4 0x01FFFFFFFFFFFFFC
+
+
+/**
+ * @brief Propagate the carries of an integer
+ *
+ * The limbs of the result do not exceed 2^56 + 2^8. The result is reduced
+ * modulo p, but is not necessarily the canonical representative
+ *
+ * @param[in,out] r Integer whose limbs are less than 2^63
+ **/
+
+static void curve448Carry(Curve448Limb *r)
+{
+   uint_t i;
+   uint64_t c;
+
+   //Reduce each limb to 56 bits
+   for(i = 0; i < 7; i++)
+   {
+      r[i + 1] += r[i] >> 56;
+      r[i] &= CURVE448_MASK;
+   }
+
+   //Reduce the bits above 2^448 (2^448 = 2^224 + 1 mod p)
+   c = r[7] >> 56;
+   r[7] &= CURVE448_MASK;
+   r[0] += c;
+   r[4] += c;
+}
+
+
+/**
+ * @brief Propagate the carries of a product
+ * @param[out] r Resulting integer R = T mod p
+ * @param[in] t Double-width integer T (8 limbs)
+ **/
+
+static void curve448CarryWide(Curve448Limb *r, Curve448Dlimb *t)
+{
+   uint_t i;
+   uint64_t c;
+
+   //Reduce each limb to 56 bits
+   for(i = 0; i < 7; i++)
+   {
+      t[i + 1] += (uint64_t) (t[i] >> 56);
+      r[i] = (uint64_t) t[i] & CURVE448_MASK;
+   }
+
+   r[7] = (uint64_t) t[7] & CURVE448_MASK;
+
+   //Reduce the bits above 2^448 (2^448 = 2^224 + 1 mod p)
+   c = (uint64_t) (t[7] >> 56);
+   r[0] += c;
+   r[4] += c;
+
+   r[1] += r[0] >> 56;
+   r[0] &= CURVE448_MASK;
+   r[5] += r[4] >> 56;
+   r[4] &= CURVE448_MASK;
+}
+
+
+/**
+ * @brief Multiplication of two half-size integers
+ * @param[out] t Resulting integer T = A * B (7 double-width limbs)
+ * @param[in] a First operand A (4 limbs)
+ * @param[in] b Second operand B (4 limbs)
+ **/
+
+static void curve448MulHalf(Curve448Dlimb *t, const uint64_t *a,
+   const uint64_t *b)
+{
+   //Schoolbook multiplication
+   t[0] = (Curve448Dlimb) a[0] * b[0];
+
+   t[1] = (Curve448Dlimb) a[0] * b[1] + (Curve448Dlimb) a[1] * b[0];
+
+   t[2] = (Curve448Dlimb) a[0] * b[2] + (Curve448Dlimb) a[1] * b[1] +
+      (Curve448Dlimb) a[2] * b[0];
+
+   t[3] = (Curve448Dlimb) a[0] * b[3] + (Curve448Dlimb) a[1] * b[2] +
+      (Curve448Dlimb) a[2] * b[1] + (Curve448Dlimb) a[3] * b[0];
+
+   t[4] = (Curve448Dlimb) a[1] * b[3] + (Curve448Dlimb) a[2] * b[2] +
+      (Curve448Dlimb) a[3] * b[1];
+
+   t[5] = (Curve448Dlimb) a[2] * b[3] + (Curve448Dlimb) a[3] * b[2];
+
+   t[6] = (Curve448Dlimb) a[3] * b[3];
+}
+
+
+/**
+ * @brief Squaring of a half-size integer
+ * @param[out] t Resulting integer T = A^2 (7 double-width limbs)
+ * @param[in] a Operand A (4 limbs)
+ **/
+
+static void curve448SqrHalf(Curve448Dlimb *t, const uint64_t *a)
+{
+   uint64_t a0;
+   uint64_t a1;
+   uint64_t a2;
+
+   //Each cross product appears twice in the square
+   a0 = a[0] * 2;
+   a1 = a[1] * 2;
+   a2 = a[2] * 2;
+
+   //Only 10 partial products are required
+   t[0] = (Curve448Dlimb) a[0] * a[0];
+   t[1] = (Curve448Dlimb) a0 * a[1];
+   t[2] = (Curve448Dlimb) a0 * a[2] + (Curve448Dlimb) a[1] * a[1];
+   t[3] = (Curve448Dlimb) a0 * a[3] + (Curve448Dlimb) a1 * a[2];
+   t[4] = (Curve448Dlimb) a1 * a[3] + (Curve448Dlimb) a[2] * a[2];
+   t[5] = (Curve448Dlimb) a2 * a[3];
+   t[6] = (Curve448Dlimb) a[3] * a[3];
+}
+
+
+/**
+ * @brief Fold the partial products of a Karatsuba multiplication
+ *
+ * Let A = A0 + A1 * 2^224 and B = B0 + B1 * 2^224. Since 2^448 = 2^224 + 1
+ * mod p, the product is A * B = (P + Q) + (S - P) * 2^224 mod p, where
+ * P = A0 * B0, Q = A1 * B1 and S = (A0 + A1) * (B0 + B1). The limbs of weight
+ * 2^224 and above are folded once again using the same identity
+ *
+ * @param[out] r Resulting integer R = A * B mod p
+ * @param[in] p Partial product P (7 double-width limbs)
+ * @param[in] q Partial product Q (7 double-width limbs)
+ * @param[in] s Partial product S (7 double-width limbs)
+ **/
+
+static void curve448Fold(Curve448Limb *r, const Curve448Dlimb *p,
+   const Curve448Dlimb *q, const Curve448Dlimb *s)
+{
+   uint_t i;
+   Curve448Dlimb t[8];
+
+   //S - P cannot underflow, since each of its limbs is a sum of products
+   //that includes the matching limb of P
+   for(i = 0; i < 3; i++)
+   {
+      t[i] = p[i] + q[i] + s[i + 4] - p[i + 4];
+      t[i + 4] = s[i] - p[i] + q[i + 4] + s[i + 4];
+   }
+
+   t[3] = p[3] + q[3];
+   t[7] = s[3] - p[3];
+
+   //Propagate the carries
+   curve448CarryWide(r, t);
+}
+
+
 /**
  * @brief Set integer value
  * @param[out] a Pointer to the integer to be initialized
  * @param[in] b Initial value
  **/
 
-void curve448SetInt(uint32_t *a, uint32_t b)
+void curve448SetInt(Curve448Limb *a, uint32_t b)
+{
+   uint_t i;
+
+   //Set the value of the least significant limb
+   a[0] = b;
+
+   //Initialize the rest of the integer
+   for(i = 1; i < 8; i++)
+   {
+      a[i] = 0;
+   }
+}
+
+
+/**
+ * @brief Modular addition
+ * @param[out] r Resulting integer R = (A + B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < p
+ **/
+
+void curve448Add(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b)
+{
+   uint_t i;
+
+   //Compute R = A + B (limbs are not allowed to overflow)
+   for(i = 0; i < 8; i++)
+   {
+      r[i] = a[i] + b[i];
+   }
+
+   //Perform modular reduction
+   curve448Carry(r);
+}
+
+
+/**
+ * @brief Modular addition
+ * @param[out] r Resulting integer R = (A + B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < (2^32 - 1)
+ **/
+
+void curve448AddInt(Curve448Limb *r, const Curve448Limb *a, uint32_t b)
+{
+   uint_t i;
+
+   //Compute R = A + B
+   for(r[0] = a[0] + b, i = 1; i < 8; i++)
+   {
+      r[i] = a[i];
+   }
+
+   //Perform modular reduction
+   curve448Carry(r);
+}
+
+
+/**
+ * @brief Modular subtraction
+ * @param[out] r Resulting integer R = (A - B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < p
+ **/
+
+void curve448Sub(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b)
+{
+   uint_t i;
+
+   //Compute R = A + 2p - B, so that no limb can underflow
+   for(i = 0; i < 8; i++)
+   {
+      r[i] = a[i] + ((i == 4) ? CURVE448_2P4 : CURVE448_2P0) - b[i];
+   }
+
+   //Perform modular reduction
+   curve448Carry(r);
+}
+
+
+/**
+ * @brief Modular subtraction
+ * @param[out] r Resulting integer R = (A - B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < (2^32 - 1)
+ **/
+
+void curve448SubInt(Curve448Limb *r, const Curve448Limb *a, uint32_t b)
+{
+   uint_t i;
+
+   //Compute R = A + 2p - B
+   for(i = 0; i < 8; i++)
+   {
+      r[i] = a[i] + ((i == 4) ? CURVE448_2P4 : CURVE448_2P0);
+   }
+
+   r[0] -= b;
+
+   //Perform modular reduction
+   curve448Carry(r);
+}
+
+
+/**
+ * @brief Modular multiplication
+ * @param[out] r Resulting integer R = (A * B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < p
+ **/
+
+__weak_func void curve448Mul(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b)
+{
+   uint_t i;
+   uint64_t u[4];
+   uint64_t v[4];
+   Curve448Dlimb p[7];
+   Curve448Dlimb q[7];
+   Curve448Dlimb s[7];
+
+   //Compute the sums of the halves A0 + A1 and B0 + B1
+   for(i = 0; i < 4; i++)
+   {
+      u[i] = a[i] + a[i + 4];
+      v[i] = b[i] + b[i + 4];
+   }
+
+   //Karatsuba multiplication requires 3 half-size products instead of 4
+   curve448MulHalf(p, a, b);
+   curve448MulHalf(q, a + 4, b + 4);
+   curve448MulHalf(s, u, v);
+
+   //Perform fast modular reduction
+   curve448Fold(r, p, q, s);
+}
+
+
+/**
+ * @brief Modular multiplication
+ * @param[out] r Resulting integer R = (A * B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < (2^32 - 1)
+ **/
+
+void curve448MulInt(Curve448Limb *r, const Curve448Limb *a, uint32_t b)
+{
+   uint_t i;
+   Curve448Dlimb t[8];
+
+   //Compute R = A * B
+   for(i = 0; i < 8; i++)
+   {
+      t[i] = (Curve448Dlimb) a[i] * b;
+   }
+
+   //Propagate the carries
+   curve448CarryWide(r, t);
+}
+
+
+/**
+ * @brief Modular squaring
+ * @param[out] r Resulting integer R = (A ^ 2) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ **/
+
+void curve448Sqr(Curve448Limb *r, const Curve448Limb *a)
+{
+   uint_t i;
+   uint64_t u[4];
+   Curve448Dlimb p[7];
+   Curve448Dlimb q[7];
+   Curve448Dlimb s[7];
+
+   //Compute the sum of the halves A0 + A1
+   for(i = 0; i < 4; i++)
+   {
+      u[i] = a[i] + a[i + 4];
+   }
+
+   //Karatsuba squaring requires 3 half-size squares
+   curve448SqrHalf(p, a);
+   curve448SqrHalf(q, a + 4);
+   curve448SqrHalf(s, u);
+
+   //Perform fast modular reduction
+   curve448Fold(r, p, q, s);
+}
+
+#else
+
+/**
+ * @brief Set integer value
+ * @param[out] a Pointer to the integer to be initialized
+ * @param[in] b Initial value
+ **/
+
+void curve448SetInt(Curve448Limb *a, uint32_t b)
 {
    uint_t i;
 
@@ -69,7 +434,8 @@ void curve448SetInt(uint32_t *a, uint32_t b)
  * @param[in] b An integer such as 0 <= B < p
  **/
 
-void curve448Add(uint32_t *r, const uint32_t *a, const uint32_t *b)
+void curve448Add(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b)
 {
    uint_t i;
    uint64_t temp;
@@ -95,7 +461,7 @@ void curve448Add(uint32_t *r, const uint32_t *a, const uint32_t *b)
  * @param[in] b An integer such as 0 <= B < (2^32 - 1)
  **/
 
-void curve448AddInt(uint32_t *r, const uint32_t *a, uint32_t b)
+void curve448AddInt(Curve448Limb *r, const Curve448Limb *a, uint32_t b)
 {
    uint_t i;
    uint64_t temp;
@@ -120,7 +486,8 @@ void curve448AddInt(uint32_t *r, const uint32_t *a, uint32_t b)
  * @param[in] b An integer such as 0 <= B < p
  **/
 
-void curve448Sub(uint32_t *r, const uint32_t *a, const uint32_t *b)
+void curve448Sub(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b)
 {
    uint_t i;
    int64_t temp;
@@ -157,7 +524,7 @@ void curve448Sub(uint32_t *r, const uint32_t *a, const uint32_t *b)
  * @param[in] b An integer such as 0 <= B < (2^32 - 1)
  **/
 
-void curve448SubInt(uint32_t *r, const uint32_t *a, uint32_t b)
+void curve448SubInt(Curve448Limb *r, const Curve448Limb *a, uint32_t b)
 {
    uint_t i;
    int64_t temp;
@@ -196,7 +563,8 @@ void curve448SubInt(uint32_t *r, const uint32_t *a, uint32_t b)
  * @param[in] b An integer such as 0 <= B < p
  **/
 
-__weak_func void curve448Mul(uint32_t *r, const uint32_t *a, const uint32_t *b)
+__weak_func void curve448Mul(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b)
 {
    uint_t i;
    uint_t j;
@@ -288,12 +656,12 @@ __weak_func void curve448Mul(uint32_t *r, const uint32_t *a, const uint32_t *b)
  * @param[in] b An integer such as 0 <= B < (2^32 - 1)
  **/
 
-void curve448MulInt(uint32_t *r, const uint32_t *a, uint32_t b)
+void curve448MulInt(Curve448Limb *r, const Curve448Limb *a, uint32_t b)
 {
    int_t i;
    uint64_t c;
    uint64_t temp;
-   uint32_t u[14];
+   Curve448Limb u[CURVE448_LIMB_LEN];
 
    //Compute R = A * B
    for(temp = 0, i = 0; i < 14; i++)
@@ -329,12 +697,14 @@ void curve448MulInt(uint32_t *r, const uint32_t *a, uint32_t b)
  * @param[in] a An integer such as 0 <= A < p
  **/
 
-void curve448Sqr(uint32_t *r, const uint32_t *a)
+void curve448Sqr(Curve448Limb *r, const Curve448Limb *a)
 {
    //Compute R = (A ^ 2) mod p
    curve448Mul(r, a, a);
 }
 
+#endif
+
 
 /**
  * @brief Raise an integer to power 2^n
@@ -343,7 +713,7 @@ void curve448Sqr(uint32_t *r, const uint32_t *a)
  * @param[in] n An integer such as n >= 1
  **/
 
-void curve448Pwr2(uint32_t *r, const uint32_t *a, uint_t n)
+void curve448Pwr2(Curve448Limb *r, const Curve448Limb *a, uint_t n)
 {
    uint_t i;
 
@@ -358,6 +728,58 @@ void curve448Pwr2(uint32_t *r, const uint32_t *a, uint_t n)
 }
 
 
+
+#if (CURVE448_64BIT_SUPPORT == ENABLED)
+
+/**
+ * @brief Modular reduction
+ * @param[out] r Resulting integer R = A mod p
+ * @param[in] a An integer whose limbs are less than 2^63
+ * @param[in] h The highest term of A
+ **/
+
+void curve448Red(Curve448Limb *r, const Curve448Limb *a, uint32_t h)
+{
+   uint_t i;
+   uint64_t c;
+   uint64_t mask;
+   uint64_t u[8];
+
+   //Copy the limbs of A
+   for(i = 0; i < 8; i++)
+   {
+      u[i] = a[i];
+   }
+
+   //Fold the highest term (2^448 = 2^224 + 1 mod p)
+   u[0] += h;
+   u[4] += h;
+
+   //Propagate the carries, so that 0 <= U < 2p
+   curve448Carry(u);
+
+   //Compute U - p. The limbs of U do not exceed 2^56 + 2^8, hence each
+   //difference fits in 57 bits and bit 63 holds the borrow
+   for(c = 0, i = 0; i < 8; i++)
+   {
+      u[i] -= ((i == 4) ? CURVE448_MASK - 1 : CURVE448_MASK) + c;
+      c = u[i] >> 63;
+      u[i] &= CURVE448_MASK;
+   }
+
+   //If U < p, then add p back and discard bit 448
+   mask = ~c + 1;
+
+   for(c = 0, i = 0; i < 8; i++)
+   {
+      c += u[i] + (((i == 4) ? CURVE448_MASK - 1 : CURVE448_MASK) & mask);
+      r[i] = c & CURVE448_MASK;
+      c >>= 56;
+   }
+}
+
+#else
+
 /**
  * @brief Modular reduction
  * @param[out] r Resulting integer R = A mod p
@@ -365,7 +787,7 @@ void curve448Pwr2(uint32_t *r, const uint32_t *a, uint_t n)
  * @param[in] h The highest term of A
  **/
 
-void curve448Red(uint32_t *r, const uint32_t *a, uint32_t h)
+void curve448Red(Curve448Limb *r, const Curve448Limb *a, uint32_t h)
 {
    uint_t i;
    uint64_t temp;
@@ -393,6 +815,8 @@ void curve448Red(uint32_t *r, const uint32_t *a, uint32_t h)
    curve448Select(r, b, a, h & 1);
 }
 
+#endif
+
 
 /**
  * @brief Modular multiplicative inverse
@@ -400,10 +824,10 @@ void curve448Red(uint32_t *r, const uint32_t *a, uint32_t h)
  * @param[in] a An integer such as 0 <= A < p
  **/
 
-void curve448Inv(uint32_t *r, const uint32_t *a)
+void curve448Inv(Curve448Limb *r, const Curve448Limb *a)
 {
-   uint32_t u[14];
-   uint32_t v[14];
+   Curve448Limb u[CURVE448_LIMB_LEN];
+   Curve448Limb v[CURVE448_LIMB_LEN];
 
    //Since GF(p) is a prime field, the Fermat's little theorem can be
    //used to find the multiplicative inverse of A modulo p
@@ -449,12 +873,13 @@ void curve448Inv(uint32_t *r, const uint32_t *a)
  * @return The function returns 0 if the square root exists, else 1
  **/
 
-uint32_t curve448Sqrt(uint32_t *r, const uint32_t *a, const uint32_t *b)
+uint32_t curve448Sqrt(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b)
 {
    uint32_t res;
-   uint32_t c[14];
-   uint32_t u[14];
-   uint32_t v[14];
+   Curve448Limb c[CURVE448_LIMB_LEN];
+   Curve448Limb u[CURVE448_LIMB_LEN];
+   Curve448Limb v[CURVE448_LIMB_LEN];
 
    //Compute the candidate root (A / B)^((p + 1) / 4). This can be done
    //with the following trick, using a single modular powering for both the
@@ -525,12 +950,12 @@ uint32_t curve448Sqrt(uint32_t *r, const uint32_t *a, const uint32_t *b)
  * @param[in] b Pointer to the source integer
  **/
 
-void curve448Copy(uint32_t *a, const uint32_t *b)
+void curve448Copy(Curve448Limb *a, const Curve448Limb *b)
 {
    uint_t i;
 
    //Copy the value of the integer
-   for(i = 0; i < 14; i++)
+   for(i = 0; i < CURVE448_LIMB_LEN; i++)
    {
       a[i] = b[i];
    }
@@ -544,17 +969,17 @@ void curve448Copy(uint32_t *a, const uint32_t *b)
  * @param[in] c Condition variable
  **/
 
-void curve448Swap(uint32_t *a, uint32_t *b, uint32_t c)
+void curve448Swap(Curve448Limb *a, Curve448Limb *b, uint32_t c)
 {
    uint_t i;
-   uint32_t mask;
-   uint32_t dummy;
+   Curve448Limb mask;
+   Curve448Limb dummy;
 
    //The mask is the all-1 or all-0 word
-   mask = ~c + 1;
+   mask = ~((Curve448Limb) c) + 1;
 
    //Conditional swap
-   for(i = 0; i < 14; i++)
+   for(i = 0; i < CURVE448_LIMB_LEN; i++)
    {
       //Constant time implementation
       dummy = mask & (a[i] ^ b[i]);
@@ -572,17 +997,17 @@ void curve448Swap(uint32_t *a, uint32_t *b, uint32_t c)
  * @param[in] c Condition variable
  **/
 
-void curve448Select(uint32_t *r, const uint32_t *a, const uint32_t *b,
-   uint32_t c)
+void curve448Select(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b, uint32_t c)
 {
    uint_t i;
-   uint32_t mask;
+   Curve448Limb mask;
 
    //The mask is the all-1 or all-0 word
-   mask = c - 1;
+   mask = (Curve448Limb) c - 1;
 
    //Select between A and B
-   for(i = 0; i < 14; i++)
+   for(i = 0; i < CURVE448_LIMB_LEN; i++)
    {
       //Constant time implementation
       r[i] = (a[i] & mask) | (b[i] & ~mask);
@@ -597,33 +1022,89 @@ void curve448Select(uint32_t *r, const uint32_t *a, const uint32_t *b,
  * @return The function returns 0 if the A = B, else 1
  **/
 
-uint32_t curve448Comp(const uint32_t *a, const uint32_t *b)
+uint32_t curve448Comp(const Curve448Limb *a, const Curve448Limb *b)
 {
    uint_t i;
-   uint32_t mask;
+   Curve448Limb mask;
+   Curve448Limb u[CURVE448_LIMB_LEN];
+   Curve448Limb v[CURVE448_LIMB_LEN];
+
+   //Retrieve the canonical representatives of A and B
+   curve448Red(u, a, 0);
+   curve448Red(v, b, 0);
 
    //Initialize mask
    mask = 0;
 
    //Compare A and B
-   for(i = 0; i < 14; i++)
+   for(i = 0; i < CURVE448_LIMB_LEN; i++)
    {
       //Constant time implementation
-      mask |= a[i] ^ b[i];
+      mask |= u[i] ^ v[i];
    }
 
    //Return 0 if A = B, else 1
-   return ((uint32_t) (mask | (~mask + 1))) >> 31;
+   return (uint32_t) ((mask | (~mask + 1)) >> (sizeof(Curve448Limb) * 8 - 1));
+}
+
+
+
+#if (CURVE448_64BIT_SUPPORT == ENABLED)
+
+/**
+ * @brief Import an octet string
+ * @param[out] a Pointer to resulting integer
+ * @param[in] data Octet string to be converted
+ **/
+
+void curve448Import(Curve448Limb *a, const uint8_t *data)
+{
+   uint_t i;
+
+   //Split the integer into 56-bit limbs
+   for(i = 0; i < 7; i++)
+   {
+      a[i] = LOAD64LE(data + 7 * i) & CURVE448_MASK;
+   }
+
+   //The last limb is read without overrunning the octet string
+   a[7] = LOAD64LE(data + 48) >> 8;
 }
 
 
+/**
+ * @brief Export an octet string
+ * @param[in] a Pointer to the integer to be exported
+ * @param[out] data Octet string resulting from the conversion
+ **/
+
+void curve448Export(Curve448Limb *a, uint8_t *data)
+{
+   uint_t i;
+   uint64_t u[8];
+
+   //Retrieve the canonical representative of A
+   curve448Red(u, a, 0);
+
+   //Pack the 56-bit limbs. Each store overlaps the first byte of the next
+   //limb, which is then written again with the same value
+   for(i = 0; i < 7; i++)
+   {
+      STORE64LE(u[i] | (u[i + 1] << 56), data + 7 * i);
+   }
+
+   STORE64LE((u[6] >> 48) | (u[7] << 8), data + 48);
+}
+
+#else
+
 /**
  * @brief Import an octet string
  * @param[out] a Pointer to resulting integer
  * @param[in] data Octet string to be converted
  **/
 
-void curve448Import(uint32_t *a, const uint8_t *data)
+void curve448Import(Curve448Limb *a, const uint8_t *data)
 {
    uint_t i;
 
@@ -644,7 +1125,7 @@ void curve448Import(uint32_t *a, const uint8_t *data)
  * @param[out] data Octet string resulting from the conversion
  **/
 
-void curve448Export(uint32_t *a, uint8_t *data)
+void curve448Export(Curve448Limb *a, uint8_t *data)
 {
    uint_t i;
 
@@ -659,3 +1140,5 @@ void curve448Export(uint32_t *a, uint8_t *data)
 }
 
 #endif
+
+#endif
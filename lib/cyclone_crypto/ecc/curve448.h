@@ -34,11 +34,31 @@
 //Dependencies
 #include "core/crypto.h"
 
+//64-bit field arithmetic (radix 2^56) support
+#ifndef CURVE448_64BIT_SUPPORT
+   #if defined(__SIZEOF_INT128__)
+      #define CURVE448_64BIT_SUPPORT ENABLED
+   #else
+      #define CURVE448_64BIT_SUPPORT DISABLED
+   #endif
+#elif (CURVE448_64BIT_SUPPORT != ENABLED && CURVE448_64BIT_SUPPORT != DISABLED)
+   #error CURVE448_64BIT_SUPPORT parameter is not valid
+#elif (CURVE448_64BIT_SUPPORT == ENABLED && !defined(__SIZEOF_INT128__))
+   #error CURVE448_64BIT_SUPPORT requires 128-bit integer support
+#endif
+
 //Length of the elliptic curve
 #define CURVE448_BIT_LEN 448
 #define CURVE448_BYTE_LEN 56
 #define CURVE448_WORD_LEN 14
 
+//Number of limbs in a field element
+#if (CURVE448_64BIT_SUPPORT == ENABLED)
+   #define CURVE448_LIMB_LEN 8
+#else
+   #define CURVE448_LIMB_LEN 14
+#endif
+
 //A24 constant
 #define CURVE448_A24 39082
 
@@ -47,31 +67,61 @@
 extern "C" {
 #endif
 
+
+/**
+ * @brief Limb of a field element
+ *
+ * With the 64-bit backend, a field element is made of eight 56-bit limbs.
+ * The arithmetic functions only partially reduce their results, so that
+ * the limbs must be normalized with curve448Red before being inspected
+ * directly. curve448Comp and curve448Export take care of that
+ *
+ **/
+
+#if (CURVE448_64BIT_SUPPORT == ENABLED)
+   typedef uint64_t Curve448Limb;
+   __extension__ typedef unsigned __int128 Curve448Dlimb;
+#else
+   typedef uint32_t Curve448Limb;
+   typedef uint64_t Curve448Dlimb;
+#endif
+
+
 //Curve448 related functions
-void curve448SetInt(uint32_t *a, uint32_t b);
-void curve448Add(uint32_t *r, const uint32_t *a, const uint32_t *b);
-void curve448AddInt(uint32_t *r, const uint32_t *a, uint32_t b);
-void curve448Sub(uint32_t *r, const uint32_t *a, const uint32_t *b);
-void curve448SubInt(uint32_t *r, const uint32_t *a, uint32_t b);
-void curve448Mul(uint32_t *r, const uint32_t *a, const uint32_t *b);
-void curve448MulInt(uint32_t *r, const uint32_t *a, uint32_t b);
-void curve448Red(uint32_t *r, const uint32_t *a, uint32_t h);
-void curve448Sqr(uint32_t *r, const uint32_t *a);
-void curve448Pwr2(uint32_t *r, const uint32_t *a, uint_t n);
-void curve448Inv(uint32_t *r, const uint32_t *a);
-
-uint32_t curve448Sqrt(uint32_t *r, const uint32_t *a, const uint32_t *b);
-
-void curve448Copy(uint32_t *a, const uint32_t *b);
-void curve448Swap(uint32_t *a, uint32_t *b, uint32_t c);
-
-void curve448Select(uint32_t *r, const uint32_t *a, const uint32_t *b,
-   uint32_t c);
-
-uint32_t curve448Comp(const uint32_t *a, const uint32_t *b);
-
-void curve448Import(uint32_t *a, const uint8_t *data);
-void curve448Export(uint32_t *a, uint8_t *data);
+void curve448SetInt(Curve448Limb *a, uint32_t b);
+
+void curve448Add(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b);
+
+void curve448AddInt(Curve448Limb *r, const Curve448Limb *a, uint32_t b);
+
+void curve448Sub(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b);
+
+void curve448SubInt(Curve448Limb *r, const Curve448Limb *a, uint32_t b);
+
+void curve448Mul(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b);
+
+void curve448MulInt(Curve448Limb *r, const Curve448Limb *a, uint32_t b);
+void curve448Red(Curve448Limb *r, const Curve448Limb *a, uint32_t h);
+void curve448Sqr(Curve448Limb *r, const Curve448Limb *a);
+void curve448Pwr2(Curve448Limb *r, const Curve448Limb *a, uint_t n);
+void curve448Inv(Curve448Limb *r, const Curve448Limb *a);
+
+uint32_t curve448Sqrt(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b);
+
+void curve448Copy(Curve448Limb *a, const Curve448Limb *b);
+void curve448Swap(Curve448Limb *a, Curve448Limb *b, uint32_t c);
+
+void curve448Select(Curve448Limb *r, const Curve448Limb *a,
+   const Curve448Limb *b, uint32_t c);
+
+uint32_t curve448Comp(const Curve448Limb *a, const Curve448Limb *b);
+
+void curve448Import(Curve448Limb *a, const uint8_t *data);
+void curve448Export(Curve448Limb *a, uint8_t *data);
 
 //C++ guard
 #ifdef __cplusplus
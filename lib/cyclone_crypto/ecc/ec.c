@@ -34,6 +34,13 @@
 //Dependencies
 #include "core/crypto.h"
 #include "ecc/ec.h"
+#include "ecc/ec_comb.h"
+#include "ecc/ec_complete.h"
+#include "ecc/ec_fixed.h"
+#include "ecc/ec_glv.h"
+#include "ecc/ec_registry.h"
+#include "ecc/ec_tables.h"
+#include "ecc/ec_wnaf.h"
 #include "debug.h"
 
 //Check crypto library configuration
@@ -54,6 +61,7 @@ void ecInitDomainParameters(EcDomainParameters *params)
    params->name = NULL;
    params->type = EC_CURVE_TYPE_NONE;
    params->mod = NULL;
+   params->comb = NULL;
 
    //Initialize EC domain parameters
    mpiInit(&params->p);
@@ -77,6 +85,9 @@ void ecFreeDomainParameters(EcDomainParameters *params)
    mpiFree(&params->b);
    ecFree(&params->g);
    mpiFree(&params->q);
+
+   //The precomputed tables are owned by the cache
+   params->comb = NULL;
 }
 
 
@@ -125,6 +136,24 @@ error_t ecLoadDomainParameters(EcDomainParameters *params,
    //Fast modular reduction
    params->mod = curveInfo->mod;
 
+#if (EC_COMB_SUPPORT == ENABLED && EC_STATIC_TABLE_SUPPORT == ENABLED)
+   //Use the tables compiled into the library, if any
+   params->comb = ecGetStaticCombTable(curveInfo);
+#endif
+
+#if (EC_COMB_SUPPORT == ENABLED)
+   //Any registered cache?
+   if(params->comb == NULL && ecCombGetCache() != NULL)
+   {
+      //Retrieve the precomputed multiples of the base point (the generic
+      //scalar multiplication is used if they are not available)
+      if(ecCombGetTable(ecCombGetCache(), params, &params->comb))
+      {
+         params->comb = NULL;
+      }
+   }
+#endif
+
    //Debug message
    TRACE_DEBUG("  p:\r\n");
    TRACE_DEBUG_MPI("    ", &params->p);
@@ -145,6 +174,58 @@ end:
 }
 
 
+/**
+ * @brief Retrieve EC domain parameters
+ *
+ * The shared EC domain parameters held by the registered registry are used
+ * whenever possible. Otherwise, the domain parameters are loaded into the
+ * structure provided by the caller, which must be released afterwards
+ *
+ * @param[in] curveInfo Elliptic curve parameters
+ * @param[in] buffer Initialized EC domain parameters used when the shared
+ *   parameters are not available
+ * @param[out] params Pointer to the EC domain parameters to be used
+ * @return Error code
+ **/
+
+error_t ecGetDomainParameters(const EcCurveInfo *curveInfo,
+   EcDomainParameters *buffer, const EcDomainParameters **params)
+{
+   error_t error;
+
+   //Check parameters
+   if(curveInfo == NULL || buffer == NULL || params == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+#if (EC_REGISTRY_SUPPORT == ENABLED)
+   //Any registered registry?
+   if(ecGetRegistry() != NULL)
+   {
+      //Retrieve the shared EC domain parameters
+      error = ecRegistryGetDomainParameters(ecGetRegistry(), curveInfo,
+         params);
+
+      //The domain parameters are loaded locally if the registry is full
+      if(error != ERROR_OUT_OF_RESOURCES)
+         return error;
+   }
+#endif
+
+   //Load EC domain parameters
+   error = ecLoadDomainParameters(buffer, curveInfo);
+
+   //Check status code
+   if(!error)
+   {
+      //Point to the locally loaded domain parameters
+      *params = buffer;
+   }
+
+   //Return status code
+   return error;
+}
+
+
 /**
  * @brief Initialize an EC public key
  * @param[in] key Pointer to the EC public key to initialize
@@ -555,6 +636,113 @@ end:
 }
 
 
+/**
+ * @brief Recover affine representation of several points
+ *
+ * Montgomery's trick is used so that a single modular inversion is
+ * required, whatever the number of points
+ *
+ * @param[in] params EC domain parameters
+ * @param[in,out] r Array of points to be converted
+ * @param[in] n Number of points in the array
+ * @return Error code
+ **/
+
+error_t ecAffinifyBatch(const EcDomainParameters *params, EcPoint *r,
+   uint_t n)
+{
+   error_t error;
+   uint_t i;
+   Mpi a;
+   Mpi b;
+   Mpi *c;
+
+   //Nothing to do?
+   if(n == 0)
+      return NO_ERROR;
+
+   //Allocate a memory buffer to hold the partial products
+   c = cryptoAllocMem(n * sizeof(Mpi));
+   //Failed to allocate memory?
+   if(c == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Initialize multiple precision integers
+   for(i = 0; i < n; i++)
+   {
+      mpiInit(&c[i]);
+   }
+
+   mpiInit(&a);
+   mpiInit(&b);
+
+   //Compute the partial products c[i] = Z[0] * Z[1] * ... * Z[i]
+   MPI_CHECK(mpiSetValue(&a, 1));
+
+   for(i = 0; i < n; i++)
+   {
+      //Points at the infinity are left unchanged
+      if(mpiCompInt(&r[i].z, 0) != 0)
+      {
+         EC_CHECK(ecMulMod(params, &a, &a, &r[i].z));
+      }
+
+      MPI_CHECK(mpiCopy(&c[i], &a));
+   }
+
+   //Compute a = 1 / (Z[0] * Z[1] * ... * Z[n - 1]) mod p
+   MPI_CHECK(mpiInvMod(&a, &a, &params->p));
+
+   //Process the points in reverse order
+   for(i = n; i > 0; i--)
+   {
+      //Point at the infinity?
+      if(mpiCompInt(&r[i - 1].z, 0) == 0)
+         continue;
+
+      //Compute b = 1 / Z[i - 1] mod p
+      if(i > 1)
+      {
+         EC_CHECK(ecMulMod(params, &b, &a, &c[i - 2]));
+      }
+      else
+      {
+         MPI_CHECK(mpiCopy(&b, &a));
+      }
+
+      //Update a = 1 / (Z[0] * Z[1] * ... * Z[i - 2]) mod p
+      EC_CHECK(ecMulMod(params, &a, &a, &r[i - 1].z));
+
+      //Set Rx = b^2 * Rx mod p
+      EC_CHECK(ecMulMod(params, &r[i - 1].z, &b, &b));
+      EC_CHECK(ecMulMod(params, &r[i - 1].x, &r[i - 1].x, &r[i - 1].z));
+
+      //Set Ry = b^3 * Ry mod p
+      EC_CHECK(ecMulMod(params, &r[i - 1].z, &r[i - 1].z, &b));
+      EC_CHECK(ecMulMod(params, &r[i - 1].y, &r[i - 1].y, &r[i - 1].z));
+
+      //Set Rz = 1
+      MPI_CHECK(mpiSetValue(&r[i - 1].z, 1));
+   }
+
+end:
+   //Release multiple precision integers
+   for(i = 0; i < n; i++)
+   {
+      mpiFree(&c[i]);
+   }
+
+   mpiFree(&a);
+   mpiFree(&b);
+
+   //Release previously allocated memory
+   cryptoFreeMem(c);
+
+   //Return status code
+   return error;
+}
+
+
 /**
  * @brief Check whether the affine point S is on the curve
  * @param[in] params EC domain parameters
@@ -927,8 +1115,9 @@ error_t ecFullAdd(const EcDomainParameters *params, EcPoint *r,
          mpiCompInt(&r->y, 0) == 0 &&
          mpiCompInt(&r->z, 0) == 0)
       {
-         //Compute R = 2 * S
-         EC_CHECK(ecDouble(params, r, s));
+         //S and T are the same point. Since S may have been overwritten when
+         //it shares the same storage as R, compute R = 2 * T in that case
+         EC_CHECK(ecDouble(params, r, (r == s) ? t : s));
       }
    }
 
@@ -988,10 +1177,59 @@ __weak_func error_t ecMult(const EcDomainParameters *params, EcPoint *r, const M
 {
    error_t error;
    uint_t i;
-   Mpi h;
+   uint_t n;
+   int_t u;
+   int8_t *naf;
+   EcPoint q;
+   EcPoint t[1 << (EC_MULT_WINDOW_SIZE - 2)];
+
+#if (EC_COMB_SUPPORT == ENABLED)
+   //Multiplication of the base point G?
+   if(params->comb != NULL && mpiGetBitLength(d) <= params->comb->expLen &&
+      mpiCompInt(&s->z, 1) == 0 && mpiComp(&s->x, &params->g.x) == 0 &&
+      mpiComp(&s->y, &params->g.y) == 0)
+   {
+      //Use the precomputed multiples of G
+      return ecCombMult(params, params->comb, r, d);
+   }
+#endif
 
-   //Initialize multiple precision integer
-   mpiInit(&h);
+#if (EC_GLV_SUPPORT == ENABLED)
+   //Curve with an efficiently computable endomorphism?
+   if(ecGlvGetParams(params) != NULL && d->sign >= 0 &&
+      mpiComp(d, &params->q) < 0)
+   {
+      //Split the scalar into two halves of about half the size
+      return ecGlvMult(params, r, d, s);
+   }
+#endif
+
+#if (EC_COMPLETE_SUPPORT == ENABLED)
+   //Use the complete addition formulas on curves with a = -3
+   error = ecCompleteMult(params, r, d, s);
+   //Unless the operation is not supported, the result is final
+   if(error != ERROR_UNSUPPORTED_ELLIPTIC_CURVE)
+      return error;
+#endif
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+   //Use fixed-width field arithmetic whenever the curve allows it
+   error = ecFixedMult(params, r, d, s);
+   //Unless the operation is not supported, the result is final
+   if(error != ERROR_UNSUPPORTED_ELLIPTIC_CURVE)
+      return error;
+#endif
+
+   //Initialize EC points
+   ecInit(&q);
+
+   for(i = 0; i < arraysize(t); i++)
+   {
+      ecInit(&t[i]);
+   }
+
+   //Initialize pointer
+   naf = NULL;
 
    //Check whether d == 0
    if(mpiCompInt(d, 0) == 0)
@@ -1047,43 +1285,155 @@ __weak_func error_t ecMult(const EcDomainParameters *params, EcPoint *r, const M
             EC_CHECK(ecFullAdd(params, r, r, s));
          }
       }
-//Fast left-to-right binary method
+//Width-w NAF method
 #else
-      //Precompute h = 3 * d
-      MPI_CHECK(mpiAdd(&h, d, d));
-      MPI_CHECK(mpiAdd(&h, &h, d));
+      //Precompute T[0] = S
+      EC_CHECK(ecCopy(&t[0], r));
+      //Compute Q = 2.S
+      EC_CHECK(ecDouble(params, &q, r));
+
+      //Precompute the odd multiples T[i] = (2i + 1).S
+      for(i = 1; i < arraysize(t); i++)
+      {
+         EC_CHECK(ecFullAdd(params, &t[i], &q, &t[i - 1]));
+      }
+
+      //Normalize the precomputed points so that mixed additions can be used
+      EC_CHECK(ecAffinifyBatch(params, t, arraysize(t)));
+
+      //The width-w NAF of d is at most one digit longer than d
+      n = mpiGetBitLength(d) + 1;
+
+      //Allocate a memory buffer to hold the digits
+      naf = cryptoAllocMem(n);
+      //Failed to allocate memory?
+      if(naf == NULL)
+      {
+         error = ERROR_OUT_OF_MEMORY;
+         goto end;
+      }
+
+      //Compute the width-w NAF representation of d
+      n = ecComputeWnaf(naf, d, EC_MULT_WINDOW_SIZE);
+
+      //The most significant digit is always positive
+      EC_CHECK(ecCopy(r, &t[(naf[n - 1] - 1) / 2]));
 
       //Scalar multiplication
-      for(i = mpiGetBitLength(&h) - 2; i >= 1; i--)
+      for(i = n - 1; i >= 1; i--)
       {
          //Point doubling
          EC_CHECK(ecDouble(params, r, r));
 
-         //Check whether h(i) == 1 and k(i) == 0
-         if(mpiGetBitValue(&h, i) && !mpiGetBitValue(d, i))
+         //Retrieve the current digit
+         u = naf[i - 1];
+
+         //Check whether the digit is positive or negative
+         if(u > 0)
          {
-            //Compute R = R + S
-            EC_CHECK(ecFullAdd(params, r, r, s));
+            //Compute R = R + T[(u - 1) / 2]
+            EC_CHECK(ecFullAdd(params, r, r, &t[(u - 1) / 2]));
          }
-         //Check whether h(i) == 0 and k(i) == 1
-         else if(!mpiGetBitValue(&h, i) && mpiGetBitValue(d, i))
+         else if(u < 0)
          {
-            //Compute R = R - S
-            EC_CHECK(ecFullSub(params, r, r, s));
+            //Compute R = R - T[(-u - 1) / 2]
+            EC_CHECK(ecFullSub(params, r, r, &t[(-u - 1) / 2]));
          }
       }
 #endif
    }
 
 end:
-   //Release multiple precision integer
-   mpiFree(&h);
+   //Release EC points
+   ecFree(&q);
+
+   for(i = 0; i < arraysize(t); i++)
+   {
+      ecFree(&t[i]);
+   }
+
+   //Release memory buffer
+   if(naf != NULL)
+   {
+      cryptoFreeMem(naf);
+   }
 
    //Return status code
    return error;
 }
 
 
+/**
+ * @brief Width-w NAF recoding of a scalar
+ * @param[out] naf Digits of the width-w NAF, least significant first. The
+ *   buffer must be able to hold one more digit than the bit length of d
+ * @param[in] d A positive integer
+ * @param[in] w Window size (2 <= w <= 8)
+ * @return Number of digits (the most significant digit is nonzero)
+ **/
+
+uint_t ecComputeWnaf(int8_t *naf, const Mpi *d, uint_t w)
+{
+   uint_t i;
+   uint_t k;
+   uint_t n;
+   uint_t c;
+   int_t u;
+
+   //The width-w NAF of d is at most one digit longer than d
+   n = mpiGetBitLength(d) + 1;
+
+   //Compute the digits from right to left
+   for(i = 0, c = 0; i < n; )
+   {
+      //Extract the next w bits of d and add the pending carry
+      for(u = c, k = 0; k < w; k++)
+      {
+         u += mpiGetBitValue(d, i + k) << k;
+      }
+
+      //Odd window?
+      if((u & 1) != 0)
+      {
+         //Select the digit in the range -2^(w-1) < u < 2^(w-1)
+         if(u >= (1 << (w - 1)))
+         {
+            u -= 1 << w;
+            c = 1;
+         }
+         else
+         {
+            c = 0;
+         }
+
+         //Save the nonzero digit
+         naf[i++] = (int8_t) u;
+
+         //A nonzero digit is always followed by w - 1 zero digits
+         for(k = 1; k < w && i < n; k++)
+         {
+            naf[i++] = 0;
+         }
+      }
+      else
+      {
+         //Propagate the carry
+         c = (mpiGetBitValue(d, i) + c) >> 1;
+         naf[i++] = 0;
+      }
+   }
+
+   //Skip leading zero digits
+   while(n > 0 && naf[n - 1] == 0)
+   {
+      n--;
+   }
+
+   //Return the number of digits
+   return n;
+}
+
+
 /**
  * @brief An auxiliary function for the twin multiplication
  * @param[in] t An integer T such as 0 <= T <= 31
@@ -1149,6 +1499,35 @@ error_t ecTwinMult(const EcDomainParameters *params, EcPoint *r,
    EcPoint spt;
    EcPoint smt;
 
+#if (EC_COMB_SUPPORT == ENABLED)
+   //Twin multiplication involving the base point G?
+   if(params->comb != NULL && params->comb->wnaf.points != NULL &&
+      d0->sign >= 0 && d1->sign >= 0 && mpiCompInt(&s->z, 1) == 0 &&
+      mpiComp(&s->x, &params->g.x) == 0 && mpiComp(&s->y, &params->g.y) == 0)
+   {
+      //Use the precomputed odd multiples of G
+      return ecWnafTwinMult(params, r, d0, s, &params->comb->wnaf, d1, t,
+         NULL);
+   }
+#endif
+
+#if (EC_GLV_SUPPORT == ENABLED)
+   //Curve with an efficiently computable endomorphism?
+   if(ecGlvGetParams(params) != NULL && d0->sign >= 0 && d1->sign >= 0)
+   {
+      //Each scalar is split into two halves of about half the size
+      return ecWnafTwinMult(params, r, d0, s, NULL, d1, t, NULL);
+   }
+#endif
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+   //Use fixed-width field arithmetic whenever the curve allows it
+   error = ecWnafTwinMultFixed(params, r, d0, s, NULL, d1, t, NULL);
+   //Unless the operation is not supported, the result is final
+   if(error != ERROR_UNSUPPORTED_ELLIPTIC_CURVE)
+      return error;
+#endif
+
    //Initialize EC points
    ecInit(&spt);
    ecInit(&smt);
@@ -38,11 +38,22 @@
 //Error code checking
 #define EC_CHECK(f) if((error = f) != NO_ERROR) goto end
 
+//Window size for variable-base scalar multiplication
+#ifndef EC_MULT_WINDOW_SIZE
+   #define EC_MULT_WINDOW_SIZE 4
+#elif (EC_MULT_WINDOW_SIZE < 2 || EC_MULT_WINDOW_SIZE > 6)
+   #error EC_MULT_WINDOW_SIZE parameter is not valid
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+//Forward declaration of EcCombTable structure
+struct _EcCombTable;
+#define EcCombTable struct _EcCombTable
+
 
 /**
  * @brief EC point
@@ -71,6 +82,7 @@ typedef struct
    Mpi q;              ///<Order of the point G
    uint32_t h;         ///<Cofactor h
    EcFastModAlgo mod;  ///<Fast modular reduction
+   const EcCombTable *comb; ///<Precomputed multiples of the base point G
 } EcDomainParameters;
 
 
@@ -105,6 +117,9 @@ void ecFreeDomainParameters(EcDomainParameters *params);
 error_t ecLoadDomainParameters(EcDomainParameters *params,
    const EcCurveInfo *curveInfo);
 
+error_t ecGetDomainParameters(const EcCurveInfo *curveInfo,
+   EcDomainParameters *buffer, const EcDomainParameters **params);
+
 void ecInitPublicKey(EcPublicKey *key);
 void ecFreePublicKey(EcPublicKey *key);
 
@@ -138,6 +153,9 @@ error_t ecProjectify(const EcDomainParameters *params, EcPoint *r,
 error_t ecAffinify(const EcDomainParameters *params, EcPoint *r,
    const EcPoint *s);
 
+error_t ecAffinifyBatch(const EcDomainParameters *params, EcPoint *r,
+   uint_t n);
+
 bool_t ecIsPointAffine(const EcDomainParameters *params, const EcPoint *s);
 
 error_t ecDouble(const EcDomainParameters *params, EcPoint *r,
@@ -155,6 +173,8 @@ error_t ecFullSub(const EcDomainParameters *params, EcPoint *r,
 error_t ecMult(const EcDomainParameters *params, EcPoint *r, const Mpi *d,
    const EcPoint *s);
 
+uint_t ecComputeWnaf(int8_t *naf, const Mpi *d, uint_t w);
+
 error_t ecTwinMult(const EcDomainParameters *params, EcPoint *r,
    const Mpi *d0, const EcPoint *s, const Mpi *d1, const EcPoint *t);
 
@@ -0,0 +1,573 @@
+/**
+ * @file ec_comb.c
+ * @brief Fixed-base scalar multiplication (Lim-Lee comb method)
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ * @section Description
+ *
+ * ECDSA signature generation and EC key pair generation multiply the same
+ * base point G by a fresh scalar for every operation. The Lim-Lee comb
+ * method splits the scalar into h rows of a bits and each row into v blocks
+ * of b bits. The sums of the points 2^(i * a + j * b).G are precomputed in
+ * affine coordinates for every combination of rows, so that a scalar
+ * multiplication costs only b point doublings and at most v * b mixed
+ * additions
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_comb.h"
+#include "ecc/ec_fixed.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (EC_SUPPORT == ENABLED && EC_COMB_SUPPORT == ENABLED)
+
+//Cache of precomputed tables used by the scalar multiplication routines
+static EcCombCache *ecCombCache = NULL;
+
+
+/**
+ * @brief Initialize precomputed base point multiples
+ * @param[in] table Pointer to the precomputed tables
+ **/
+
+void ecCombInit(EcCombTable *table)
+{
+   //Clear the structure
+   osMemset(table, 0, sizeof(EcCombTable));
+
+   //Initialize multiple precision integer
+   mpiInit(&table->p);
+   //Initialize the odd multiples of G
+   ecWnafInit(&table->wnaf);
+}
+
+
+/**
+ * @brief Release precomputed base point multiples
+ * @param[in] table Pointer to the precomputed tables
+ **/
+
+void ecCombFree(EcCombTable *table)
+{
+   uint_t i;
+
+   //Valid tables?
+   if(table->points != NULL)
+   {
+      //Release EC points
+      for(i = 0; i < (table->v << table->h); i++)
+      {
+         ecFree(&table->points[i]);
+      }
+
+      cryptoFreeMem(table->points);
+   }
+
+   //Release the odd multiples of G
+   ecWnafFree(&table->wnaf);
+
+   //Release multiple precision integer
+   mpiFree(&table->p);
+
+   //Clear the structure
+   ecCombInit(table);
+}
+
+
+/**
+ * @brief Precompute multiples of the base point
+ * @param[in] params EC domain parameters
+ * @param[out] table Pointer to the precomputed tables
+ * @return Error code
+ **/
+
+error_t ecCombBuild(const EcDomainParameters *params, EcCombTable *table)
+{
+   error_t error;
+   uint_t i;
+   uint_t j;
+   uint_t n;
+   uint_t u;
+   EcPoint *s;
+   EcPoint x;
+
+   //Check parameters
+   if(params == NULL || table == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Only Weierstrass curves are supported
+   if(params->type != EC_CURVE_TYPE_SECP_K1 &&
+      params->type != EC_CURVE_TYPE_SECP_R1 &&
+      params->type != EC_CURVE_TYPE_BRAINPOOLP_R1)
+   {
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+   }
+
+   //Release previously allocated resources
+   ecCombFree(table);
+
+   //Number of entries in each table
+   n = 1 << EC_COMB_TEETH;
+
+   //Allocate a memory buffer to hold the precomputed points
+   table->points = cryptoAllocMem(EC_COMB_TABLES * n * sizeof(EcPoint));
+   //Failed to allocate memory?
+   if(table->points == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Initialize EC points
+   for(i = 0; i < (EC_COMB_TABLES * n); i++)
+   {
+      ecInit(&table->points[i]);
+   }
+
+   //The scalar is split into h rows of a bits, and each row is split into
+   //v blocks of b bits
+   table->name = params->name;
+   table->expLen = mpiGetBitLength(&params->q);
+   table->h = EC_COMB_TEETH;
+   table->v = EC_COMB_TABLES;
+   table->a = (table->expLen + table->h - 1) / table->h;
+   table->b = (table->a + table->v - 1) / table->v;
+
+   //Initialize EC point
+   ecInit(&x);
+
+   //Save the prime modulus
+   MPI_CHECK(mpiCopy(&table->p, &params->p));
+
+   //Let X = G
+   EC_CHECK(ecProjectify(params, &x, &params->g));
+
+   //The first table holds the sums of the points 2^(i * a).G for every
+   //subset of rows
+   for(i = 0; i < table->h; i++)
+   {
+      //Let S[0][2^i] = 2^(i * a).G
+      s = table->points + (1 << i);
+      EC_CHECK(ecCopy(s, &x));
+
+      //Compute S[0][2^i + u] = S[0][u] + S[0][2^i]
+      for(u = 1; u < (1U << i); u++)
+      {
+         EC_CHECK(ecFullAdd(params, s + u, table->points + u, &x));
+      }
+
+      //Compute X = 2^((i + 1) * a).G
+      if((i + 1) < table->h)
+      {
+         for(j = 0; j < table->a; j++)
+         {
+            EC_CHECK(ecDouble(params, &x, &x));
+         }
+      }
+   }
+
+   //Each subsequent table is obtained by multiplying the entries of the
+   //previous one by 2^b
+   for(i = n; i < (table->v * n); i++)
+   {
+      //Skip the first entry of each table
+      if((i % n) != 0)
+      {
+         EC_CHECK(ecCopy(&table->points[i], &table->points[i - n]));
+
+         for(j = 0; j < table->b; j++)
+         {
+            EC_CHECK(ecDouble(params, &table->points[i], &table->points[i]));
+         }
+      }
+   }
+
+   //Convert the precomputed points to affine representation
+   for(i = 0; i < (table->v * n); i++)
+   {
+      //The first entry of each table is the point at the infinity
+      if((i % n) == 0)
+      {
+         MPI_CHECK(mpiSetValue(&table->points[i].x, 1));
+         MPI_CHECK(mpiSetValue(&table->points[i].y, 1));
+         MPI_CHECK(mpiSetValue(&table->points[i].z, 0));
+      }
+      else
+      {
+         EC_CHECK(ecAffinify(params, &table->points[i], &table->points[i]));
+      }
+   }
+
+   //Let X = G
+   EC_CHECK(ecProjectify(params, &x, &params->g));
+
+   //Precompute the odd multiples of G used by twin multiplications
+   EC_CHECK(ecWnafBuild(params, &table->wnaf, &x, EC_COMB_WNAF_WIDTH));
+
+end:
+   //Release EC point
+   ecFree(&x);
+
+   //Any error to report?
+   if(error)
+   {
+      //Clean up side effects
+      ecCombFree(table);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Fixed-base scalar multiplication
+ * @param[in] params EC domain parameters
+ * @param[in] table Precomputed multiples of the base point G
+ * @param[out] r Resulting point R = d.G
+ * @param[in] d An integer d such as 0 <= d < 2^expLen
+ * @return Error code
+ **/
+
+error_t ecCombMult(const EcDomainParameters *params, const EcCombTable *table,
+   EcPoint *r, const Mpi *d)
+{
+   error_t error;
+   int_t t;
+   uint_t i;
+   uint_t j;
+   uint_t u;
+   uint_t pos;
+
+   //Check parameters
+   if(params == NULL || table == NULL || table->points == NULL ||
+      r == NULL || d == NULL)
+   {
+      return ERROR_INVALID_PARAMETER;
+   }
+
+   //The scalar must be a non-negative integer that fits in the tables
+   if(d->sign < 0 || mpiGetBitLength(d) > table->expLen)
+      return ERROR_INVALID_PARAMETER;
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+   //Use fixed-width field arithmetic whenever the curve allows it
+   error = ecCombMultFixed(params, table, r, d);
+   //Unless the operation is not supported, the result is final
+   if(error != ERROR_UNSUPPORTED_ELLIPTIC_CURVE)
+      return error;
+#endif
+
+   //Set R = (1, 1, 0)
+   MPI_CHECK(mpiSetValue(&r->x, 1));
+   MPI_CHECK(mpiSetValue(&r->y, 1));
+   MPI_CHECK(mpiSetValue(&r->z, 0));
+
+   //The columns of the scalar are processed in a left-to-right fashion
+   for(t = table->b - 1; t >= 0; t--)
+   {
+      //Point doubling
+      EC_CHECK(ecDouble(params, r, r));
+
+      //Loop through the tables
+      for(j = 0; j < table->v; j++)
+      {
+         //Bit position within each row
+         pos = j * table->b + t;
+
+         //Gather the bits of the current column from every row
+         for(u = 0, i = table->h; i > 0 && pos < table->a; i--)
+         {
+            u = (u << 1) | mpiGetBitValue(d, (i - 1) * table->a + pos);
+         }
+
+         //Compute R = R + S[j][u]
+         if(u != 0)
+         {
+            EC_CHECK(ecFullAdd(params, r, r,
+               &table->points[(j << table->h) + u]));
+         }
+      }
+   }
+
+end:
+   //Return status code
+   return error;
+}
+
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+
+/**
+ * @brief Fixed-base scalar multiplication (fixed-width field arithmetic)
+ * @param[in] params EC domain parameters
+ * @param[in] table Precomputed multiples of the base point G
+ * @param[out] r Resulting point R = d.G
+ * @param[in] d An integer d such as 0 <= d < 2^expLen
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+error_t ecCombMultFixed(const EcDomainParameters *params,
+   const EcCombTable *table, EcPoint *r, const Mpi *d)
+{
+   error_t error;
+   EcFixedCurve curve;
+   EcFixedPoint q;
+
+   //Load curve parameters
+   error = ecFixedInit(&curve, params);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Compute Q = d.G
+   error = ecCombMultFixedPoint(&curve, table, &q, d);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Convert the result to projective representation
+   return ecFixedExport(&curve, r, &q);
+}
+
+
+/**
+ * @brief Fixed-base scalar multiplication (fixed-width representation)
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[in] table Precomputed multiples of the base point G
+ * @param[out] r Resulting point R = d.G
+ * @param[in] d An integer d such as 0 <= d < 2^expLen
+ * @return Error code
+ **/
+
+error_t ecCombMultFixedPoint(const EcFixedCurve *curve,
+   const EcCombTable *table, EcFixedPoint *r, const Mpi *d)
+{
+   error_t error;
+   int_t t;
+   uint_t i;
+   uint_t j;
+   uint_t u;
+   uint_t pos;
+   EcFixedPoint s;
+
+   //The scalar must be a non-negative integer that fits in the tables
+   if(d->sign < 0 || mpiGetBitLength(d) > table->expLen)
+      return ERROR_INVALID_PARAMETER;
+
+   //Set R = (1, 1, 0)
+   osMemcpy(r->x, curve->one, curve->n * sizeof(MpiFixedWord));
+   osMemcpy(r->y, curve->one, curve->n * sizeof(MpiFixedWord));
+   osMemset(r->z, 0, curve->n * sizeof(MpiFixedWord));
+
+   //The columns of the scalar are processed in a left-to-right fashion
+   for(t = table->b - 1; t >= 0; t--)
+   {
+      //Point doubling
+      ecFixedDouble(curve, r, r);
+
+      //Loop through the tables
+      for(j = 0; j < table->v; j++)
+      {
+         //Bit position within each row
+         pos = j * table->b + t;
+
+         //Gather the bits of the current column from every row
+         for(u = 0, i = table->h; i > 0 && pos < table->a; i--)
+         {
+            u = (u << 1) | mpiGetBitValue(d, (i - 1) * table->a + pos);
+         }
+
+         //Compute R = R + S[j][u]
+         if(u != 0)
+         {
+            //Convert the precomputed point to fixed-width representation
+            error = ecFixedImport(curve, &s,
+               &table->points[(j << table->h) + u]);
+            //Any error to report?
+            if(error)
+               return error;
+
+            //Point addition
+            ecFixedAdd(curve, r, r, &s);
+         }
+      }
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+#endif
+
+
+/**
+ * @brief Check whether cached tables match a curve
+ * @param[in] entry Cached tables
+ * @param[in] key EC domain parameters
+ * @return TRUE if the tables match, else FALSE
+ **/
+
+static bool_t ecCombMatchEntry(const void *entry, const void *key)
+{
+   const EcCombTable *table;
+   const EcDomainParameters *params;
+
+   //Point to the tables and the domain parameters
+   table = (const EcCombTable *) entry;
+   params = (const EcDomainParameters *) key;
+
+   //Compare curve name and prime
+   return !osStrcmp(table->name, params->name) &&
+      !mpiComp(&table->p, &params->p);
+}
+
+
+/**
+ * @brief Build the tables for a curve
+ * @param[out] entry Tables to be built
+ * @param[in] key EC domain parameters
+ * @return Error code
+ **/
+
+static error_t ecCombBuildEntry(void *entry, const void *key)
+{
+   //Build the precomputed tables
+   ecCombInit(entry);
+   return ecCombBuild(key, entry);
+}
+
+
+/**
+ * @brief Release cached tables
+ * @param[in] entry Cached tables
+ **/
+
+static void ecCombReleaseEntry(void *entry)
+{
+   ecCombFree(entry);
+}
+
+
+//Type of the cache entries
+static const CryptoCacheAlgo ecCombCacheAlgo =
+{
+   sizeof(EcCombTable),
+   ecCombMatchEntry,
+   ecCombBuildEntry,
+   ecCombReleaseEntry
+};
+
+
+/**
+ * @brief Cache initialization
+ * @param[in] size Maximum number of cache entries
+ * @return Handle referencing the fully initialized cache
+ **/
+
+EcCombCache *ecCombInitCache(uint_t size)
+{
+   return cryptoInitCache(size);
+}
+
+
+/**
+ * @brief Release cache
+ * @param[in] cache Pointer to the cache
+ **/
+
+void ecCombFreeCache(EcCombCache *cache)
+{
+   cryptoFreeCache(cache, &ecCombCacheAlgo);
+}
+
+
+/**
+ * @brief Retrieve the precomputed multiples of the base point of a curve
+ * @param[in] cache Pointer to the cache
+ * @param[in] params EC domain parameters
+ * @param[out] table Precomputed multiples of the base point
+ * @return Error code
+ **/
+
+error_t ecCombGetTable(EcCombCache *cache, const EcDomainParameters *params,
+   const EcCombTable **table)
+{
+   error_t error;
+   void *entry;
+
+   //Check parameters
+   if(cache == NULL || params == NULL || params->name == NULL ||
+      table == NULL)
+   {
+      return ERROR_INVALID_PARAMETER;
+   }
+
+   //Retrieve the matching tables, building them if necessary
+   error = cryptoCacheGet(cache, &ecCombCacheAlgo, params, &entry);
+
+   //Return the precomputed tables
+   *table = entry;
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Register the cache used when loading EC domain parameters
+ * @param[in] cache Pointer to the cache (NULL to disable the cache)
+ * @return Error code
+ **/
+
+error_t ecCombRegisterCache(EcCombCache *cache)
+{
+   //Save the cache
+   ecCombCache = cache;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Get the registered cache
+ * @return Pointer to the cache (NULL if no cache has been registered)
+ **/
+
+EcCombCache *ecCombGetCache(void)
+{
+   //Return the registered cache
+   return ecCombCache;
+}
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file ec_comb.h
+ * @brief Fixed-base scalar multiplication (Lim-Lee comb method)
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+
+#ifndef _EC_COMB_H
+#define _EC_COMB_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "core/crypto_cache.h"
+#include "ecc/ec.h"
+#include "ecc/ec_fixed.h"
+#include "ecc/ec_wnaf.h"
+
+//Fixed-base scalar multiplication support
+#ifndef EC_COMB_SUPPORT
+   #define EC_COMB_SUPPORT DISABLED
+#elif (EC_COMB_SUPPORT != ENABLED && EC_COMB_SUPPORT != DISABLED)
+   #error EC_COMB_SUPPORT parameter is not valid
+#endif
+
+//Number of bits of the scalar combined into each table index
+#ifndef EC_COMB_TEETH
+   #define EC_COMB_TEETH 6
+#elif (EC_COMB_TEETH < 1 || EC_COMB_TEETH > 8)
+   #error EC_COMB_TEETH parameter is not valid
+#endif
+
+//Number of precomputed tables
+#ifndef EC_COMB_TABLES
+   #define EC_COMB_TABLES 2
+#elif (EC_COMB_TABLES < 1 || EC_COMB_TABLES > 8)
+   #error EC_COMB_TABLES parameter is not valid
+#endif
+
+//Width of the NAF window used for the base point in twin multiplications
+#ifndef EC_COMB_WNAF_WIDTH
+   #define EC_COMB_WNAF_WIDTH 7
+#elif (EC_COMB_WNAF_WIDTH < 2 || EC_COMB_WNAF_WIDTH > 8)
+   #error EC_COMB_WNAF_WIDTH parameter is not valid
+#endif
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Precomputed multiples of the base point
+ **/
+
+struct _EcCombTable
+{
+   const char_t *name; ///<Curve name
+   Mpi p;              ///<Prime
+   uint_t expLen;      ///<Maximum length of the scalar, in bits
+   uint_t h;           ///<Number of bits combined into each table index
+   uint_t v;           ///<Number of tables
+   uint_t a;           ///<Length of each row of the scalar, in bits
+   uint_t b;           ///<Length of each column block, in bits
+   EcPoint *points;    ///<Precomputed points in affine coordinates (v * 2^h entries)
+   EcWnafTable wnaf;   ///<Odd multiples of G used by twin multiplications
+};
+
+
+/**
+ * @brief Cache of precomputed base point multiples
+ **/
+
+typedef CryptoCache EcCombCache;
+
+
+//Fixed-base scalar multiplication related functions
+void ecCombInit(EcCombTable *table);
+void ecCombFree(EcCombTable *table);
+
+error_t ecCombBuild(const EcDomainParameters *params, EcCombTable *table);
+
+error_t ecCombMult(const EcDomainParameters *params, const EcCombTable *table,
+   EcPoint *r, const Mpi *d);
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+
+error_t ecCombMultFixed(const EcDomainParameters *params,
+   const EcCombTable *table, EcPoint *r, const Mpi *d);
+
+error_t ecCombMultFixedPoint(const EcFixedCurve *curve,
+   const EcCombTable *table, EcFixedPoint *r, const Mpi *d);
+
+#endif
+
+EcCombCache *ecCombInitCache(uint_t size);
+void ecCombFreeCache(EcCombCache *cache);
+
+error_t ecCombGetTable(EcCombCache *cache, const EcDomainParameters *params,
+   const EcCombTable **table);
+
+error_t ecCombRegisterCache(EcCombCache *cache);
+EcCombCache *ecCombGetCache(void);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
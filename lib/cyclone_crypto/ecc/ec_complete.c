@@ -0,0 +1,589 @@
+/**
+ * @file ec_complete.c
+ * @brief Complete addition formulas for short Weierstrass curves
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * The points are represented in homogeneous projective coordinates, so
+ * that (X : Y : Z) stands for the affine point (X / Z, Y / Z) and the point
+ * at the infinity is (0 : 1 : 0). The addition formulas are valid for any
+ * pair of input points, including doubling, opposite points and the point
+ * at the infinity, so that the scalar multiplication does not need any
+ * data-dependent branch. Only curves with a = -3 (NIST curves) are
+ * supported. Refer to "Complete addition formulas for prime order elliptic
+ * curves" (Renes, Costello and Batina, EUROCRYPT 2016), algorithms 4 and 6
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_fixed.h"
+#include "ecc/ec_complete.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (EC_SUPPORT == ENABLED && EC_COMPLETE_SUPPORT == ENABLED)
+
+
+/**
+ * @brief Point doubling (complete formula, a = -3)
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point R = 2S
+ * @param[in] s Point S
+ **/
+
+void ecCompleteDouble(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s)
+{
+   uint_t n;
+   MpiFixedWord x3[EC_FIXED_MAX_WORDS];
+   MpiFixedWord y3[EC_FIXED_MAX_WORDS];
+   MpiFixedWord z3[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t0[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t1[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t2[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t3[EC_FIXED_MAX_WORDS];
+
+   //Size of a field element
+   n = curve->n * sizeof(MpiFixedWord);
+
+   //Compute t0 = X^2, t1 = Y^2 and t2 = Z^2
+   ecFixedSqrMod(curve, t0, s->x);
+   ecFixedSqrMod(curve, t1, s->y);
+   ecFixedSqrMod(curve, t2, s->z);
+   //Compute t3 = 2 * X * Y
+   ecFixedMulMod(curve, t3, s->x, s->y);
+   ecFixedAddMod(curve, t3, t3, t3);
+   //Compute z3 = 2 * X * Z
+   ecFixedMulMod(curve, z3, s->x, s->z);
+   ecFixedAddMod(curve, z3, z3, z3);
+   //Compute y3 = b * t2 - z3
+   ecFixedMulMod(curve, y3, curve->b, t2);
+   ecFixedSubMod(curve, y3, y3, z3);
+   //Compute y3 = 3 * y3
+   ecFixedAddMod(curve, x3, y3, y3);
+   ecFixedAddMod(curve, y3, x3, y3);
+   //Compute x3 = t1 - y3 and y3 = t1 + y3
+   ecFixedSubMod(curve, x3, t1, y3);
+   ecFixedAddMod(curve, y3, t1, y3);
+   //Compute y3 = x3 * y3 and x3 = x3 * t3
+   ecFixedMulMod(curve, y3, x3, y3);
+   ecFixedMulMod(curve, x3, x3, t3);
+   //Compute t2 = 3 * t2
+   ecFixedAddMod(curve, t3, t2, t2);
+   ecFixedAddMod(curve, t2, t2, t3);
+   //Compute z3 = b * z3 - t2 - t0
+   ecFixedMulMod(curve, z3, curve->b, z3);
+   ecFixedSubMod(curve, z3, z3, t2);
+   ecFixedSubMod(curve, z3, z3, t0);
+   //Compute z3 = 3 * z3
+   ecFixedAddMod(curve, t3, z3, z3);
+   ecFixedAddMod(curve, z3, z3, t3);
+   //Compute t0 = 3 * t0 - t2
+   ecFixedAddMod(curve, t3, t0, t0);
+   ecFixedAddMod(curve, t0, t3, t0);
+   ecFixedSubMod(curve, t0, t0, t2);
+   //Compute y3 = y3 + t0 * z3
+   ecFixedMulMod(curve, t0, t0, z3);
+   ecFixedAddMod(curve, y3, y3, t0);
+   //Compute t0 = 2 * Y * Z
+   ecFixedMulMod(curve, t0, s->y, s->z);
+   ecFixedAddMod(curve, t0, t0, t0);
+   //Compute x3 = x3 - t0 * z3
+   ecFixedMulMod(curve, z3, t0, z3);
+   ecFixedSubMod(curve, x3, x3, z3);
+   //Compute z3 = 4 * t0 * t1
+   ecFixedMulMod(curve, z3, t0, t1);
+   ecFixedAddMod(curve, z3, z3, z3);
+   ecFixedAddMod(curve, z3, z3, z3);
+
+   //Set R = (x3, y3, z3)
+   osMemcpy(r->x, x3, n);
+   osMemcpy(r->y, y3, n);
+   osMemcpy(r->z, z3, n);
+}
+
+
+/**
+ * @brief Point addition (complete formula, a = -3)
+ *
+ * The formula is valid for any pair of points, including S = T, S = -T
+ * and the point at the infinity
+ *
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point R = S + T
+ * @param[in] s First operand
+ * @param[in] t Second operand
+ **/
+
+void ecCompleteAdd(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s, const EcFixedPoint *t)
+{
+   uint_t n;
+   MpiFixedWord x3[EC_FIXED_MAX_WORDS];
+   MpiFixedWord y3[EC_FIXED_MAX_WORDS];
+   MpiFixedWord z3[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t0[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t1[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t2[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t3[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t4[EC_FIXED_MAX_WORDS];
+
+   //Size of a field element
+   n = curve->n * sizeof(MpiFixedWord);
+
+   //Compute t0 = Sx * Tx, t1 = Sy * Ty and t2 = Sz * Tz
+   ecFixedMulMod(curve, t0, s->x, t->x);
+   ecFixedMulMod(curve, t1, s->y, t->y);
+   ecFixedMulMod(curve, t2, s->z, t->z);
+   //Compute t3 = (Sx + Sy) * (Tx + Ty) - t0 - t1
+   ecFixedAddMod(curve, t3, s->x, s->y);
+   ecFixedAddMod(curve, t4, t->x, t->y);
+   ecFixedMulMod(curve, t3, t3, t4);
+   ecFixedAddMod(curve, t4, t0, t1);
+   ecFixedSubMod(curve, t3, t3, t4);
+   //Compute t4 = (Sy + Sz) * (Ty + Tz) - t1 - t2
+   ecFixedAddMod(curve, t4, s->y, s->z);
+   ecFixedAddMod(curve, x3, t->y, t->z);
+   ecFixedMulMod(curve, t4, t4, x3);
+   ecFixedAddMod(curve, x3, t1, t2);
+   ecFixedSubMod(curve, t4, t4, x3);
+   //Compute y3 = (Sx + Sz) * (Tx + Tz) - t0 - t2
+   ecFixedAddMod(curve, x3, s->x, s->z);
+   ecFixedAddMod(curve, y3, t->x, t->z);
+   ecFixedMulMod(curve, x3, x3, y3);
+   ecFixedAddMod(curve, y3, t0, t2);
+   ecFixedSubMod(curve, y3, x3, y3);
+   //Compute x3 = 3 * (y3 - b * t2)
+   ecFixedMulMod(curve, z3, curve->b, t2);
+   ecFixedSubMod(curve, x3, y3, z3);
+   ecFixedAddMod(curve, z3, x3, x3);
+   ecFixedAddMod(curve, x3, x3, z3);
+   //Compute z3 = t1 - x3 and x3 = t1 + x3
+   ecFixedSubMod(curve, z3, t1, x3);
+   ecFixedAddMod(curve, x3, t1, x3);
+   //Compute t2 = 3 * t2
+   ecFixedAddMod(curve, t1, t2, t2);
+   ecFixedAddMod(curve, t2, t1, t2);
+   //Compute y3 = 3 * (b * y3 - t2 - t0)
+   ecFixedMulMod(curve, y3, curve->b, y3);
+   ecFixedSubMod(curve, y3, y3, t2);
+   ecFixedSubMod(curve, y3, y3, t0);
+   ecFixedAddMod(curve, t1, y3, y3);
+   ecFixedAddMod(curve, y3, t1, y3);
+   //Compute t0 = 3 * t0 - t2
+   ecFixedAddMod(curve, t1, t0, t0);
+   ecFixedAddMod(curve, t0, t1, t0);
+   ecFixedSubMod(curve, t0, t0, t2);
+   //Compute t1 = t4 * y3 and t2 = t0 * y3
+   ecFixedMulMod(curve, t1, t4, y3);
+   ecFixedMulMod(curve, t2, t0, y3);
+   //Compute y3 = x3 * z3 + t2
+   ecFixedMulMod(curve, y3, x3, z3);
+   ecFixedAddMod(curve, y3, y3, t2);
+   //Compute x3 = t3 * x3 - t1
+   ecFixedMulMod(curve, x3, t3, x3);
+   ecFixedSubMod(curve, x3, x3, t1);
+   //Compute z3 = t4 * z3 + t3 * t0
+   ecFixedMulMod(curve, z3, t4, z3);
+   ecFixedMulMod(curve, t1, t3, t0);
+   ecFixedAddMod(curve, z3, z3, t1);
+
+   //Set R = (x3, y3, z3)
+   osMemcpy(r->x, x3, n);
+   osMemcpy(r->y, y3, n);
+   osMemcpy(r->z, z3, n);
+}
+
+
+/**
+ * @brief Extract a digit of the regular recoding of a scalar
+ *
+ * The odd scalar k is written as the sum of the digits d[i] * 2^(i * w),
+ * where every digit is odd and |d[i]| < 2^w. The digit d[i] is given by
+ * the bits i * w to i * w + w of k, the least significant of which is
+ * forced to 1, minus 2^w (the most significant digit is never offset, so
+ * that it is always positive)
+ *
+ * @param[in] k Odd scalar
+ * @param[in] n Size of the scalar, in words
+ * @param[in] i Index of the digit
+ * @param[in] m Number of digits
+ * @return Signed digit
+ **/
+
+static int_t ecCompleteGetDigit(const MpiFixedWord *k, uint_t n, uint_t i,
+   uint_t m)
+{
+   uint_t j;
+   uint_t offset;
+   MpiFixedWord u;
+
+   //Position of the first bit
+   j = (i * EC_COMPLETE_WINDOW_SIZE) / MPI_FIXED_WORD_SIZE;
+   offset = (i * EC_COMPLETE_WINDOW_SIZE) % MPI_FIXED_WORD_SIZE;
+
+   //Extract w + 1 bits
+   u = k[j] >> offset;
+
+   //The window may straddle two words
+   if((offset + EC_COMPLETE_WINDOW_SIZE) >= MPI_FIXED_WORD_SIZE &&
+      (j + 1) < n)
+   {
+      u |= k[j + 1] << (MPI_FIXED_WORD_SIZE - offset);
+   }
+
+   //Force the least significant bit to 1
+   u = (u & ((2 << EC_COMPLETE_WINDOW_SIZE) - 1)) | 1;
+
+   //Return the signed digit
+   if(i < (m - 1))
+   {
+      return (int_t) u - (1 << EC_COMPLETE_WINDOW_SIZE);
+   }
+   else
+   {
+      return (int_t) u;
+   }
+}
+
+
+/**
+ * @brief Constant-time table lookup
+ *
+ * The whole table is scanned, so that neither the memory access pattern
+ * nor the execution time depend on the value of the digit
+ *
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point R = d.S
+ * @param[in] t Odd multiples T[i] = (2i + 1).S
+ * @param[in] d Odd signed digit
+ **/
+
+static void ecCompleteSelect(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *t, int_t d)
+{
+   uint_t i;
+   uint_t j;
+   uint_t u;
+   uint_t sign;
+   MpiFixedWord mask;
+   MpiFixedWord y[EC_FIXED_MAX_WORDS];
+
+   //Retrieve the sign and the absolute value of the digit
+   sign = (uint_t) d >> (sizeof(uint_t) * 8 - 1);
+   u = (((uint_t) d ^ (0 - sign)) + sign) >> 1;
+
+   //Clear the resulting point
+   osMemset(r, 0, sizeof(EcFixedPoint));
+
+   //Scan the table
+   for(i = 0; i < (1 << (EC_COMPLETE_WINDOW_SIZE - 1)); i++)
+   {
+      //The mask is set if and only if i = (|d| - 1) / 2
+      mask = (MpiFixedWord) (i ^ u) - 1;
+      mask = 0 - (mask >> (MPI_FIXED_WORD_SIZE - 1));
+
+      //Conditional copy
+      for(j = 0; j < curve->n; j++)
+      {
+         r->x[j] |= t[i].x[j] & mask;
+         r->y[j] |= t[i].y[j] & mask;
+         r->z[j] |= t[i].z[j] & mask;
+      }
+   }
+
+   //Compute Y = -Ry
+   osMemset(y, 0, curve->n * sizeof(MpiFixedWord));
+   ecFixedSubMod(curve, y, y, r->y);
+
+   //Negate the point if the digit is negative
+   mask = 0 - (MpiFixedWord) sign;
+
+   for(j = 0; j < curve->n; j++)
+   {
+      r->y[j] = (r->y[j] & ~mask) | (y[j] & mask);
+   }
+}
+
+
+/**
+ * @brief Convert a point from Jacobian to homogeneous projective coordinates
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Point (X : Y : Z) = (Sx * Sz : Sy : Sz^3)
+ * @param[in] s Point in Jacobian coordinates
+ **/
+
+static void ecCompleteFromJacobian(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s)
+{
+   MpiFixedWord t[EC_FIXED_MAX_WORDS];
+
+   //Compute Z = Sz^3
+   ecFixedSqrMod(curve, t, s->z);
+   ecFixedMulMod(curve, t, t, s->z);
+   //Compute X = Sx * Sz
+   ecFixedMulMod(curve, r->x, s->x, s->z);
+
+   //Set Y = Sy
+   if(r != s)
+   {
+      osMemcpy(r->y, s->y, curve->n * sizeof(MpiFixedWord));
+   }
+
+   //Set Z = Sz^3
+   osMemcpy(r->z, t, curve->n * sizeof(MpiFixedWord));
+}
+
+
+/**
+ * @brief Convert a point from homogeneous projective to Jacobian coordinates
+ *
+ * The point at the infinity (0 : Y : 0) is mapped to (1, 1, 0) without
+ * any branch
+ *
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Point (Sx * Sz, Sy * Sz^2, Sz) in Jacobian coordinates
+ * @param[in] s Point in homogeneous projective coordinates
+ **/
+
+static void ecCompleteToJacobian(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s)
+{
+   uint_t i;
+   MpiFixedWord c;
+   MpiFixedWord mask;
+   MpiFixedWord t[EC_FIXED_MAX_WORDS];
+
+   //Compute Ry = Sy * Sz^2
+   ecFixedSqrMod(curve, t, s->z);
+   ecFixedMulMod(curve, r->y, s->y, t);
+   //Compute Rx = Sx * Sz
+   ecFixedMulMod(curve, r->x, s->x, s->z);
+
+   //Set Rz = Sz
+   if(r != s)
+   {
+      osMemcpy(r->z, s->z, curve->n * sizeof(MpiFixedWord));
+   }
+
+   //The mask is set if and only if Rz = 0
+   for(c = 0, i = 0; i < curve->n; i++)
+   {
+      c |= r->z[i];
+   }
+
+   mask = ((c | (0 - c)) >> (MPI_FIXED_WORD_SIZE - 1)) - 1;
+
+   //Replace (0, 0, 0) with (1, 1, 0)
+   for(i = 0; i < curve->n; i++)
+   {
+      r->x[i] = (r->x[i] & ~mask) | (curve->one[i] & mask);
+      r->y[i] = (r->y[i] & ~mask) | (curve->one[i] & mask);
+   }
+}
+
+
+/**
+ * @brief Scalar multiplication (complete formulas)
+ * @param[in] params EC domain parameters
+ * @param[out] r Resulting point R = d.S
+ * @param[in] d An integer d such as 0 <= d < p
+ * @param[in] s EC point
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+error_t ecCompleteMult(const EcDomainParameters *params, EcPoint *r,
+   const Mpi *d, const EcPoint *s)
+{
+   error_t error;
+   EcFixedCurve curve;
+   EcFixedPoint q;
+
+   //Load curve parameters
+   error = ecFixedInit(&curve, params);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Only curves with a = -3 are supported
+   if(curve.aType != EC_FIXED_COEF_A_MINUS_3)
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //Import the point S
+   error = ecFixedImport(&curve, &q, s);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Compute Q = d.S
+   error = ecCompleteMultPoint(&curve, &q, d, &q);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Convert the result to projective representation
+   return ecFixedExport(&curve, r, &q);
+}
+
+
+/**
+ * @brief Scalar multiplication (complete formulas, fixed-width representation)
+ *
+ * The scalar is processed with a fixed window and a regular signed-digit
+ * recoding, so that the sequence of operations only depends on the size
+ * of the field. Even scalars are handled by computing (d + 1).S - S.
+ *
+ * All the additions use the complete formula. The doublings are performed
+ * in Jacobian coordinates, which is cheaper: the doubling formula has no
+ * exceptional case on curves of odd order, since the point at the infinity
+ * is mapped to itself and there is no point of order 2
+ *
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point R = d.S (Jacobian coordinates)
+ * @param[in] d An integer d such as 0 <= d < p
+ * @param[in] s EC point (Jacobian coordinates)
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+error_t ecCompleteMultPoint(const EcFixedCurve *curve, EcFixedPoint *r,
+   const Mpi *d, const EcFixedPoint *s)
+{
+   uint_t i;
+   uint_t j;
+   uint_t m;
+   uint_t n;
+   MpiFixedWord mask;
+   MpiFixedWord k[EC_FIXED_MAX_WORDS];
+   MpiFixedWord y[EC_FIXED_MAX_WORDS];
+   EcFixedPoint a;
+   EcFixedPoint q;
+   EcFixedPoint t[1 << (EC_COMPLETE_WINDOW_SIZE - 1)];
+
+   //Only curves with a = -3 are supported
+   if(curve->aType != EC_FIXED_COEF_A_MINUS_3)
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //Bit length of the modulus
+   for(m = curve->n * MPI_FIXED_WORD_SIZE; m > 0; m--)
+   {
+      if((curve->p[(m - 1) / MPI_FIXED_WORD_SIZE] >>
+         ((m - 1) % MPI_FIXED_WORD_SIZE)) & 1)
+      {
+         break;
+      }
+   }
+
+   //Scalars that do not fit in a field element are handled by the generic
+   //implementation
+   if(d->sign < 0 || mpiGetBitLength(d) > m)
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //Number of digits
+   m = (m + EC_COMPLETE_WINDOW_SIZE - 1) / EC_COMPLETE_WINDOW_SIZE;
+
+   //Import the scalar
+   if(mpiFixedImport(k, d, curve->n))
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //Size of a field element
+   n = curve->n * sizeof(MpiFixedWord);
+
+   //Check whether S is the point at the infinity
+   if(ecFixedIsZero(curve, s->z))
+   {
+      //Set R = (1, 1, 0)
+      osMemcpy(r->x, curve->one, n);
+      osMemcpy(r->y, curve->one, n);
+      osMemset(r->z, 0, n);
+      return NO_ERROR;
+   }
+
+   //Precompute the odd multiples T[i] = (2i + 1).S in homogeneous
+   //projective coordinates
+   ecCompleteFromJacobian(curve, &t[0], s);
+   ecCompleteDouble(curve, &q, &t[0]);
+
+   for(i = 1; i < arraysize(t); i++)
+   {
+      ecCompleteAdd(curve, &t[i], &t[i - 1], &q);
+   }
+
+   //Even scalars are replaced with d + 1
+   mask = (k[0] & 1) - 1;
+   k[0] |= 1;
+
+   //The most significant digit is always positive
+   ecCompleteSelect(curve, &q, t, ecCompleteGetDigit(k, curve->n, m - 1, m));
+   ecCompleteToJacobian(curve, &a, &q);
+
+   //Scalar multiplication
+   for(i = m - 1; i > 0; i--)
+   {
+      //Compute A = 2^w * A
+      for(j = 0; j < EC_COMPLETE_WINDOW_SIZE; j++)
+      {
+         ecFixedDouble(curve, &a, &a);
+      }
+
+      //Compute A = A + d[i - 1].S
+      ecCompleteSelect(curve, &q, t, ecCompleteGetDigit(k, curve->n, i - 1, m));
+      ecCompleteFromJacobian(curve, &a, &a);
+      ecCompleteAdd(curve, &a, &a, &q);
+      ecCompleteToJacobian(curve, &a, &a);
+   }
+
+   //Let Q = -S if d is even, else Q = (0 : 1 : 0)
+   osMemset(y, 0, n);
+   ecFixedSubMod(curve, y, y, t[0].y);
+
+   for(j = 0; j < curve->n; j++)
+   {
+      q.x[j] = t[0].x[j] & mask;
+      q.y[j] = (curve->one[j] & ~mask) | (y[j] & mask);
+      q.z[j] = t[0].z[j] & mask;
+   }
+
+   //Compute R = A + Q
+   ecCompleteFromJacobian(curve, &a, &a);
+   ecCompleteAdd(curve, &a, &a, &q);
+   ecCompleteToJacobian(curve, r, &a);
+
+   //Erase the scalar
+   osMemset(k, 0, sizeof(k));
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * @file ec_complete.h
+ * @brief Complete addition formulas for short Weierstrass curves
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _EC_COMPLETE_H
+#define _EC_COMPLETE_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_fixed.h"
+
+//Complete addition formulas support
+#ifndef EC_COMPLETE_SUPPORT
+   #define EC_COMPLETE_SUPPORT DISABLED
+#elif (EC_COMPLETE_SUPPORT != ENABLED && EC_COMPLETE_SUPPORT != DISABLED)
+   #error EC_COMPLETE_SUPPORT parameter is not valid
+#elif (EC_COMPLETE_SUPPORT == ENABLED && EC_FIXED_SUPPORT != ENABLED)
+   #error EC_COMPLETE_SUPPORT requires EC_FIXED_SUPPORT
+#endif
+
+//Window size for constant-time scalar multiplication
+#ifndef EC_COMPLETE_WINDOW_SIZE
+   #define EC_COMPLETE_WINDOW_SIZE 4
+#elif (EC_COMPLETE_WINDOW_SIZE < 2 || EC_COMPLETE_WINDOW_SIZE > 6)
+   #error EC_COMPLETE_WINDOW_SIZE parameter is not valid
+#endif
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Complete addition formulas related functions
+void ecCompleteDouble(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s);
+
+void ecCompleteAdd(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s, const EcFixedPoint *t);
+
+error_t ecCompleteMult(const EcDomainParameters *params, EcPoint *r,
+   const Mpi *d, const EcPoint *s);
+
+error_t ecCompleteMultPoint(const EcFixedCurve *curve, EcFixedPoint *r,
+   const Mpi *d, const EcFixedPoint *s);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1379,7 +1379,13 @@ error_t secp128r1Mod(Mpi *a, const Mpi *p)
       MPI_CHECK(mpiAdd(a, a, &t));
 
       //Check for end condition
-   } while(mpiComp(a, p) > 0);
+   } while(mpiGetBitLength(a) > mpiGetBitLength(p));
+
+   //Compute A mod p
+   while(mpiComp(a, p) >= 0)
+   {
+      MPI_CHECK(mpiSub(a, a, p));
+   }
 
 end:
    //Release multiple precision integers
@@ -1427,7 +1433,13 @@ error_t secp128r2Mod(Mpi *a, const Mpi *p)
       MPI_CHECK(mpiAdd(a, a, &t));
 
       //Check for end condition
-   } while(mpiComp(a, p) > 0);
+   } while(mpiGetBitLength(a) > mpiGetBitLength(p));
+
+   //Compute A mod p
+   while(mpiComp(a, p) >= 0)
+   {
+      MPI_CHECK(mpiSub(a, a, p));
+   }
 
 end:
    //Release multiple precision integers
@@ -1478,7 +1490,13 @@ error_t secp160k1Mod(Mpi *a, const Mpi *p)
       MPI_CHECK(mpiAdd(a, a, &t));
 
       //Check for end condition
-   } while(mpiComp(a, p) > 0);
+   } while(mpiGetBitLength(a) > mpiGetBitLength(p));
+
+   //Compute A mod p
+   while(mpiComp(a, p) >= 0)
+   {
+      MPI_CHECK(mpiSub(a, a, p));
+   }
 
 end:
    //Release multiple precision integers
@@ -1526,7 +1544,13 @@ error_t secp160r1Mod(Mpi *a, const Mpi *p)
       MPI_CHECK(mpiAdd(a, a, &t));
 
       //Check for end condition
-   } while(mpiComp(a, p) > 0);
+   } while(mpiGetBitLength(a) > mpiGetBitLength(p));
+
+   //Compute A mod p
+   while(mpiComp(a, p) >= 0)
+   {
+      MPI_CHECK(mpiSub(a, a, p));
+   }
 
 end:
    //Release multiple precision integers
@@ -1577,7 +1601,13 @@ error_t secp160r2Mod(Mpi *a, const Mpi *p)
       MPI_CHECK(mpiAdd(a, a, &t));
 
       //Check for end condition
-   } while(mpiComp(a, p) > 0);
+   } while(mpiGetBitLength(a) > mpiGetBitLength(p));
+
+   //Compute A mod p
+   while(mpiComp(a, p) >= 0)
+   {
+      MPI_CHECK(mpiSub(a, a, p));
+   }
 
 end:
    //Release multiple precision integers
@@ -1628,7 +1658,13 @@ error_t secp192k1Mod(Mpi *a, const Mpi *p)
       MPI_CHECK(mpiAdd(a, a, &t));
 
       //Check for end condition
-   } while(mpiComp(a, p) > 0);
+   } while(mpiGetBitLength(a) > mpiGetBitLength(p));
+
+   //Compute A mod p
+   while(mpiComp(a, p) >= 0)
+   {
+      MPI_CHECK(mpiSub(a, a, p));
+   }
 
 end:
    //Release multiple precision integers
@@ -1746,7 +1782,13 @@ error_t secp224k1Mod(Mpi *a, const Mpi *p)
       MPI_CHECK(mpiAdd(a, a, &t));
 
       //Check for end condition
-   } while(mpiComp(a, p) > 0);
+   } while(mpiGetBitLength(a) > mpiGetBitLength(p));
+
+   //Compute A mod p
+   while(mpiComp(a, p) >= 0)
+   {
+      MPI_CHECK(mpiSub(a, a, p));
+   }
 
 end:
    //Release multiple precision integers
@@ -1872,7 +1914,13 @@ error_t secp256k1Mod(Mpi *a, const Mpi *p)
       MPI_CHECK(mpiAdd(a, a, &t));
 
       //Check for end condition
-   } while(mpiComp(a, p) > 0);
+   } while(mpiGetBitLength(a) > mpiGetBitLength(p));
+
+   //Compute A mod p
+   while(mpiComp(a, p) >= 0)
+   {
+      MPI_CHECK(mpiSub(a, a, p));
+   }
 
 end:
    //Release multiple precision integers
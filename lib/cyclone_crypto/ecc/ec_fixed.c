@@ -0,0 +1,1171 @@
+/**
+ * @file ec_fixed.c
+ * @brief Fixed-width field arithmetic for Weierstrass curves
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * The generic point arithmetic operates on multiple precision integers, so
+ * that every field operation allocates memory and checks the length of its
+ * operands. This module keeps the coordinates in fixed-size arrays, in
+ * Montgomery representation, and uses unrolled kernels for the field sizes
+ * of the standard curves (256, 384 and 521 bits). Curves whose prime is
+ * smaller than one of these sizes use the next larger kernel
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_fixed.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (EC_SUPPORT == ENABLED && EC_FIXED_SUPPORT == ENABLED)
+
+//Multiplication: T = A * B (T is 2n words long)
+#define EC_FIXED_MUL_CORE(t, a, b, n) \
+{ \
+   uint_t i; \
+   uint_t j; \
+   MpiFixedWord c; \
+   for(i = 0; i < (n); i++) \
+   { \
+      (t)[i] = 0; \
+   } \
+   for(i = 0; i < (n); i++) \
+   { \
+      c = 0; \
+      for(j = 0; j < (n); j++) \
+      { \
+         MPI_FIXED_MUL_ACC((t)[i + j], (a)[i], (b)[j], c); \
+      } \
+      (t)[i + (n)] = c; \
+   } \
+}
+
+//Squaring: T = A^2 (T is 2n words long)
+#define EC_FIXED_SQR_CORE(t, a, n) \
+{ \
+   uint_t i; \
+   uint_t j; \
+   MpiFixedWord c; \
+   MpiFixedDword z; \
+   for(i = 0; i < 2 * (n); i++) \
+   { \
+      (t)[i] = 0; \
+   } \
+   for(i = 0; i < (n) - 1; i++) \
+   { \
+      c = 0; \
+      for(j = i + 1; j < (n); j++) \
+      { \
+         MPI_FIXED_MUL_ACC((t)[i + j], (a)[i], (a)[j], c); \
+      } \
+      (t)[i + (n)] = c; \
+   } \
+   for(c = 0, i = 0; i < 2 * (n); i++) \
+   { \
+      z = (MpiFixedDword) (t)[i] << 1 | c; \
+      (t)[i] = (MpiFixedWord) z; \
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE); \
+   } \
+   for(c = 0, i = 0; i < (n); i++) \
+   { \
+      z = (MpiFixedDword) (a)[i] * (a)[i] + (t)[2 * i] + c; \
+      (t)[2 * i] = (MpiFixedWord) z; \
+      z = (MpiFixedDword) (t)[2 * i + 1] + (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE); \
+      (t)[2 * i + 1] = (MpiFixedWord) z; \
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE); \
+   } \
+}
+
+//Montgomery reduction: R = T / 2^(n * w) mod P (T is 2n words long)
+#define EC_FIXED_RED_CORE(r, t, p, m, n) \
+{ \
+   uint_t i; \
+   uint_t j; \
+   MpiFixedWord c; \
+   MpiFixedWord u; \
+   MpiFixedWord mask; \
+   MpiFixedWord carry; \
+   MpiFixedDword z; \
+   for(carry = 0, i = 0; i < (n); i++) \
+   { \
+      u = (t)[i] * (m); \
+      c = 0; \
+      for(j = 0; j < (n); j++) \
+      { \
+         MPI_FIXED_MUL_ACC((t)[i + j], u, (p)[j], c); \
+      } \
+      z = (MpiFixedDword) (t)[i + (n)] + c + carry; \
+      (t)[i + (n)] = (MpiFixedWord) z; \
+      carry = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE); \
+   } \
+   for(c = 0, i = 0; i < (n); i++) \
+   { \
+      z = (MpiFixedDword) (t)[i + (n)] - (p)[i] - c; \
+      (r)[i] = (MpiFixedWord) z; \
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE) & 1; \
+   } \
+   mask = 0 - (c & (carry ^ 1)); \
+   for(i = 0; i < (n); i++) \
+   { \
+      (r)[i] = ((r)[i] & ~mask) | ((t)[i + (n)] & mask); \
+   } \
+}
+
+//Instantiate the Montgomery kernels for a given field size
+#define EC_FIXED_KERNEL(bits) \
+static void ecFixedMontgomeryMul##bits(MpiFixedWord *r, const MpiFixedWord *a, \
+   const MpiFixedWord *b, const MpiFixedWord *p, MpiFixedWord m) \
+{ \
+   MpiFixedWord t[2 * EC_FIXED_WORDS(bits)]; \
+   EC_FIXED_MUL_CORE(t, a, b, EC_FIXED_WORDS(bits)); \
+   EC_FIXED_RED_CORE(r, t, p, m, EC_FIXED_WORDS(bits)); \
+} \
+static void ecFixedMontgomerySqr##bits(MpiFixedWord *r, const MpiFixedWord *a, \
+   const MpiFixedWord *p, MpiFixedWord m) \
+{ \
+   MpiFixedWord t[2 * EC_FIXED_WORDS(bits)]; \
+   EC_FIXED_SQR_CORE(t, a, EC_FIXED_WORDS(bits)); \
+   EC_FIXED_RED_CORE(r, t, p, m, EC_FIXED_WORDS(bits)); \
+}
+
+//Fixed-width kernels
+EC_FIXED_KERNEL(256)
+#if (EC_FIXED_MAX_MODULUS_SIZE >= 384)
+EC_FIXED_KERNEL(384)
+#endif
+#if (EC_FIXED_MAX_MODULUS_SIZE >= 521)
+EC_FIXED_KERNEL(521)
+#endif
+
+//Supported field sizes
+static const MpiFixedKernel ecFixedKernels[] =
+{
+   {256, EC_FIXED_WORDS(256), ecFixedMontgomeryMul256, ecFixedMontgomerySqr256},
+#if (EC_FIXED_MAX_MODULUS_SIZE >= 384)
+   {384, EC_FIXED_WORDS(384), ecFixedMontgomeryMul384, ecFixedMontgomerySqr384},
+#endif
+#if (EC_FIXED_MAX_MODULUS_SIZE >= 521)
+   {521, EC_FIXED_WORDS(521), ecFixedMontgomeryMul521, ecFixedMontgomerySqr521}
+#endif
+};
+
+
+/**
+ * @brief Load a modulus in fixed-width representation
+ * @param[out] curve Curve parameters in fixed-width representation
+ * @param[in] p Odd modulus
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the modulus cannot
+ *   be handled by the fixed-width kernels)
+ **/
+
+static error_t ecFixedLoadModulus(EcFixedCurve *curve, const Mpi *p)
+{
+   error_t error;
+   uint_t i;
+   uint_t n;
+   MpiFixedWord t[EC_FIXED_MAX_WORDS];
+
+   //Montgomery arithmetic requires an odd modulus
+   if(p->sign < 0 || !mpiIsOdd(p))
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //Number of words required to hold an integer modulo p
+   n = EC_FIXED_WORDS(mpiGetBitLength(p));
+
+   //Select the smallest kernel that can hold a field element
+   for(curve->kernel = NULL, i = 0; i < arraysize(ecFixedKernels); i++)
+   {
+      if(ecFixedKernels[i].n >= n)
+      {
+         curve->kernel = &ecFixedKernels[i];
+         break;
+      }
+   }
+
+   //The field size is not supported?
+   if(curve->kernel == NULL)
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //Save the number of words
+   n = curve->kernel->n;
+   curve->n = n;
+
+   //Import the modulus
+   error = mpiFixedImport(curve->p, p, n);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Compute the Montgomery constant and R^2 mod p
+   curve->m = mpiFixedMontgomeryInit(curve->p);
+   mpiFixedMontgomerySetup(curve->kernel, curve->r2, curve->p, curve->m);
+
+   //Compute the Montgomery representation of 1
+   osMemset(t, 0, n * sizeof(MpiFixedWord));
+   t[0] = 1;
+   ecFixedMulMod(curve, curve->one, t, curve->r2);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Load curve parameters in fixed-width representation
+ * @param[out] curve Curve parameters in fixed-width representation
+ * @param[in] params EC domain parameters
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the curve cannot
+ *   be handled by the fixed-width kernels)
+ **/
+
+error_t ecFixedInit(EcFixedCurve *curve, const EcDomainParameters *params)
+{
+   error_t error;
+   uint_t i;
+   uint_t n;
+   MpiFixedWord c;
+   MpiFixedWord t[EC_FIXED_MAX_WORDS];
+   MpiFixedDword z;
+
+   //Only Weierstrass curves are supported
+   if(params->type != EC_CURVE_TYPE_SECP_K1 &&
+      params->type != EC_CURVE_TYPE_SECP_R1 &&
+      params->type != EC_CURVE_TYPE_BRAINPOOLP_R1)
+   {
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+   }
+
+   //Load the prime modulus
+   error = ecFixedLoadModulus(curve, &params->p);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Size of a field element, in words
+   n = curve->n;
+
+   //Import the curve parameter a
+   error = mpiFixedImport(curve->a, &params->a, n);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Compute T = a + 3
+   for(c = 3, i = 0; i < n; i++)
+   {
+      z = (MpiFixedDword) curve->a[i] + c;
+      t[i] = (MpiFixedWord) z;
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE);
+   }
+
+   //Check whether a = 0 or a = -3, so that faster doubling formulas can
+   //be used
+   if(ecFixedIsZero(curve, curve->a))
+   {
+      curve->aType = EC_FIXED_COEF_A_ZERO;
+   }
+   else if(!osMemcmp(t, curve->p, n * sizeof(MpiFixedWord)))
+   {
+      curve->aType = EC_FIXED_COEF_A_MINUS_3;
+   }
+   else
+   {
+      curve->aType = EC_FIXED_COEF_A_GENERIC;
+   }
+
+   //Convert the parameter a to Montgomery representation
+   ecFixedMulMod(curve, curve->a, curve->a, curve->r2);
+
+   //Import the curve parameter b
+   error = mpiFixedImport(curve->b, &params->b, n);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Convert the parameter b to Montgomery representation
+   ecFixedMulMod(curve, curve->b, curve->b, curve->r2);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Load the order of the base point in fixed-width representation
+ *
+ * The resulting structure provides arithmetic modulo q through the same
+ * routines as the field arithmetic (ecFixedMulMod, ecFixedInvMod, etc.).
+ * It must not be used for point arithmetic
+ *
+ * @param[out] order Order of the base point in fixed-width representation
+ * @param[in] params EC domain parameters
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the order cannot
+ *   be handled by the fixed-width kernels)
+ **/
+
+error_t ecFixedInitOrder(EcFixedCurve *order, const EcDomainParameters *params)
+{
+   error_t error;
+
+   //Only Weierstrass curves are supported
+   if(params->type != EC_CURVE_TYPE_SECP_K1 &&
+      params->type != EC_CURVE_TYPE_SECP_R1 &&
+      params->type != EC_CURVE_TYPE_BRAINPOOLP_R1)
+   {
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+   }
+
+   //Load the order of the base point
+   error = ecFixedLoadModulus(order, &params->q);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //The curve parameters a and b are meaningless modulo q
+   osMemset(order->a, 0, order->n * sizeof(MpiFixedWord));
+   osMemset(order->b, 0, order->n * sizeof(MpiFixedWord));
+   order->aType = EC_FIXED_COEF_A_ZERO;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Convert an EC point to fixed-width representation
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point (Montgomery representation)
+ * @param[in] s Point to be converted (projective representation)
+ * @return Error code
+ **/
+
+error_t ecFixedImport(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcPoint *s)
+{
+   error_t error;
+
+   //Point at the infinity?
+   if(mpiCompInt(&s->z, 0) == 0)
+   {
+      //Set R = (1, 1, 0)
+      osMemcpy(r->x, curve->one, curve->n * sizeof(MpiFixedWord));
+      osMemcpy(r->y, curve->one, curve->n * sizeof(MpiFixedWord));
+      osMemset(r->z, 0, curve->n * sizeof(MpiFixedWord));
+
+      //Successful processing
+      return NO_ERROR;
+   }
+
+   //Import the coordinates of the point
+   error = mpiFixedImport(r->x, &s->x, curve->n);
+
+   //Check status code
+   if(!error)
+   {
+      error = mpiFixedImport(r->y, &s->y, curve->n);
+   }
+
+   //Check status code
+   if(!error)
+   {
+      error = mpiFixedImport(r->z, &s->z, curve->n);
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //Convert the coordinates to Montgomery representation
+      ecFixedMulMod(curve, r->x, r->x, curve->r2);
+      ecFixedMulMod(curve, r->y, r->y, curve->r2);
+      ecFixedMulMod(curve, r->z, r->z, curve->r2);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Convert an EC point from fixed-width representation
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point (projective representation)
+ * @param[in] s Point to be converted (Montgomery representation)
+ * @return Error code
+ **/
+
+error_t ecFixedExport(const EcFixedCurve *curve, EcPoint *r,
+   const EcFixedPoint *s)
+{
+   error_t error;
+   MpiFixedWord t[EC_FIXED_MAX_WORDS];
+   MpiFixedWord u[EC_FIXED_MAX_WORDS];
+
+   //Point at the infinity?
+   if(ecFixedIsZero(curve, s->z))
+   {
+      //Set R = (1, 1, 0)
+      MPI_CHECK(mpiSetValue(&r->x, 1));
+      MPI_CHECK(mpiSetValue(&r->y, 1));
+      MPI_CHECK(mpiSetValue(&r->z, 0));
+   }
+   else
+   {
+      //Let U = 1
+      osMemset(u, 0, curve->n * sizeof(MpiFixedWord));
+      u[0] = 1;
+
+      //Convert the coordinates back from Montgomery representation
+      ecFixedMulMod(curve, t, s->x, u);
+      MPI_CHECK(mpiFixedExport(&r->x, t, curve->n));
+      ecFixedMulMod(curve, t, s->y, u);
+      MPI_CHECK(mpiFixedExport(&r->y, t, curve->n));
+      ecFixedMulMod(curve, t, s->z, u);
+      MPI_CHECK(mpiFixedExport(&r->z, t, curve->n));
+   }
+
+end:
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Point doubling
+ *
+ * The formulas do not branch on the value of S. The point at the infinity
+ * (Sz = 0) is mapped to itself, and the curves have no point of order 2
+ *
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point R = 2S
+ * @param[in] s Point S
+ **/
+
+void ecFixedDouble(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s)
+{
+   uint_t n;
+   MpiFixedWord t1[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t2[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t3[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t4[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t5[EC_FIXED_MAX_WORDS];
+
+   //Size of a field element
+   n = curve->n * sizeof(MpiFixedWord);
+
+   //Set t1 = Sx, t2 = Sy and t3 = Sz
+   osMemcpy(t1, s->x, n);
+   osMemcpy(t2, s->y, n);
+   osMemcpy(t3, s->z, n);
+
+   //Check the form of the parameter a
+   if(curve->aType == EC_FIXED_COEF_A_ZERO)
+   {
+      //Compute t5 = t1^2
+      ecFixedSqrMod(curve, t5, t1);
+      //Compute t4 = 3 * t5
+      ecFixedAddMod(curve, t4, t5, t5);
+      ecFixedAddMod(curve, t4, t4, t5);
+   }
+   else if(curve->aType == EC_FIXED_COEF_A_MINUS_3)
+   {
+      //Compute t4 = t3^2
+      ecFixedSqrMod(curve, t4, t3);
+      //Compute t5 = t1 - t4
+      ecFixedSubMod(curve, t5, t1, t4);
+      //Compute t4 = t1 + t4
+      ecFixedAddMod(curve, t4, t1, t4);
+      //Compute t5 = t4 * t5
+      ecFixedMulMod(curve, t5, t4, t5);
+      //Compute t4 = 3 * t5
+      ecFixedAddMod(curve, t4, t5, t5);
+      ecFixedAddMod(curve, t4, t4, t5);
+   }
+   else
+   {
+      //Compute t4 = t3^4
+      ecFixedSqrMod(curve, t4, t3);
+      ecFixedSqrMod(curve, t4, t4);
+      //Compute t4 = a * t4
+      ecFixedMulMod(curve, t4, t4, curve->a);
+      //Compute t5 = t1^2
+      ecFixedSqrMod(curve, t5, t1);
+      //Compute t4 = t4 + 3 * t5
+      ecFixedAddMod(curve, t4, t4, t5);
+      ecFixedAddMod(curve, t4, t4, t5);
+      ecFixedAddMod(curve, t4, t4, t5);
+   }
+
+   //Compute t3 = t3 * t2
+   ecFixedMulMod(curve, t3, t3, t2);
+   //Compute t3 = 2 * t3
+   ecFixedAddMod(curve, t3, t3, t3);
+   //Compute t2 = t2^2
+   ecFixedSqrMod(curve, t2, t2);
+   //Compute t5 = t1 * t2
+   ecFixedMulMod(curve, t5, t1, t2);
+   //Compute t5 = 4 * t5
+   ecFixedAddMod(curve, t5, t5, t5);
+   ecFixedAddMod(curve, t5, t5, t5);
+   //Compute t1 = t4^2
+   ecFixedSqrMod(curve, t1, t4);
+   //Compute t1 = t1 - 2 * t5
+   ecFixedSubMod(curve, t1, t1, t5);
+   ecFixedSubMod(curve, t1, t1, t5);
+   //Compute t2 = t2^2
+   ecFixedSqrMod(curve, t2, t2);
+   //Compute t2 = 8 * t2
+   ecFixedAddMod(curve, t2, t2, t2);
+   ecFixedAddMod(curve, t2, t2, t2);
+   ecFixedAddMod(curve, t2, t2, t2);
+   //Compute t5 = t5 - t1
+   ecFixedSubMod(curve, t5, t5, t1);
+   //Compute t5 = t4 * t5
+   ecFixedMulMod(curve, t5, t4, t5);
+   //Compute t2 = t5 - t2
+   ecFixedSubMod(curve, t2, t5, t2);
+
+   //Set R = (t1, t2, t3)
+   osMemcpy(r->x, t1, n);
+   osMemcpy(r->y, t2, n);
+   osMemcpy(r->z, t3, n);
+}
+
+
+/**
+ * @brief Point addition
+ *
+ * Mixed addition is used when T is in affine representation (Tz = 1)
+ *
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point R = S + T
+ * @param[in] s First operand
+ * @param[in] t Second operand
+ **/
+
+void ecFixedAdd(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s, const EcFixedPoint *t)
+{
+   uint_t i;
+   uint_t n;
+   bool_t affine;
+   MpiFixedWord c;
+   MpiFixedWord mask;
+   MpiFixedDword z;
+   MpiFixedWord t1[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t2[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t3[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t4[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t5[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t6[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t7[EC_FIXED_MAX_WORDS];
+
+   //Size of a field element
+   n = curve->n * sizeof(MpiFixedWord);
+
+   //Check whether Sz == 0
+   if(ecFixedIsZero(curve, s->z))
+   {
+      //Set R = T
+      if(r != t)
+         osMemcpy(r, t, sizeof(EcFixedPoint));
+      return;
+   }
+
+   //Check whether Tz == 0
+   if(ecFixedIsZero(curve, t->z))
+   {
+      //Set R = S
+      if(r != s)
+         osMemcpy(r, s, sizeof(EcFixedPoint));
+      return;
+   }
+
+   //Check whether Tz == 1
+   affine = !osMemcmp(t->z, curve->one, n);
+
+   //Set t1 = Sx, t2 = Sy, t3 = Sz, t4 = Tx and t5 = Ty
+   osMemcpy(t1, s->x, n);
+   osMemcpy(t2, s->y, n);
+   osMemcpy(t3, s->z, n);
+   osMemcpy(t4, t->x, n);
+   osMemcpy(t5, t->y, n);
+
+   //Check whether Tz != 1
+   if(!affine)
+   {
+      //Compute t6 = Tz
+      osMemcpy(t6, t->z, n);
+      //Compute t7 = t6^2
+      ecFixedSqrMod(curve, t7, t6);
+      //Compute t1 = t1 * t7
+      ecFixedMulMod(curve, t1, t1, t7);
+      //Compute t7 = t6 * t7
+      ecFixedMulMod(curve, t7, t6, t7);
+      //Compute t2 = t2 * t7
+      ecFixedMulMod(curve, t2, t2, t7);
+   }
+
+   //Compute t7 = t3^2
+   ecFixedSqrMod(curve, t7, t3);
+   //Compute t4 = t4 * t7
+   ecFixedMulMod(curve, t4, t4, t7);
+   //Compute t7 = t3 * t7
+   ecFixedMulMod(curve, t7, t3, t7);
+   //Compute t5 = t5 * t7
+   ecFixedMulMod(curve, t5, t5, t7);
+   //Compute t4 = t1 - t4
+   ecFixedSubMod(curve, t4, t1, t4);
+   //Compute t5 = t2 - t5
+   ecFixedSubMod(curve, t5, t2, t5);
+
+   //Check whether t4 == 0
+   if(ecFixedIsZero(curve, t4))
+   {
+      //Check whether t5 == 0
+      if(ecFixedIsZero(curve, t5))
+      {
+         //S and T are the same point, so that R = 2S
+         ecFixedDouble(curve, r, s);
+      }
+      else
+      {
+         //Set R = (1, 1, 0)
+         osMemcpy(r->x, curve->one, n);
+         osMemcpy(r->y, curve->one, n);
+         osMemset(r->z, 0, n);
+      }
+
+      return;
+   }
+
+   //Compute t1 = 2 * t1 - t4
+   ecFixedAddMod(curve, t1, t1, t1);
+   ecFixedSubMod(curve, t1, t1, t4);
+   //Compute t2 = 2 * t2 - t5
+   ecFixedAddMod(curve, t2, t2, t2);
+   ecFixedSubMod(curve, t2, t2, t5);
+
+   //Check whether Tz != 1
+   if(!affine)
+   {
+      //Compute t3 = t3 * t6
+      ecFixedMulMod(curve, t3, t3, t6);
+   }
+
+   //Compute t3 = t3 * t4
+   ecFixedMulMod(curve, t3, t3, t4);
+   //Compute t7 = t4^2
+   ecFixedSqrMod(curve, t7, t4);
+   //Compute t4 = t4 * t7
+   ecFixedMulMod(curve, t4, t4, t7);
+   //Compute t7 = t1 * t7
+   ecFixedMulMod(curve, t7, t1, t7);
+   //Compute t1 = t5^2
+   ecFixedSqrMod(curve, t1, t5);
+   //Compute t1 = t1 - t7
+   ecFixedSubMod(curve, t1, t1, t7);
+   //Compute t7 = t7 - 2 * t1
+   ecFixedAddMod(curve, t6, t1, t1);
+   ecFixedSubMod(curve, t7, t7, t6);
+   //Compute t5 = t5 * t7
+   ecFixedMulMod(curve, t5, t5, t7);
+   //Compute t4 = t2 * t4
+   ecFixedMulMod(curve, t4, t2, t4);
+   //Compute t2 = t5 - t4
+   ecFixedSubMod(curve, t2, t5, t4);
+
+   //Compute t2 = t2 / 2 (add p first if t2 is odd)
+   mask = 0 - (t2[0] & 1);
+
+   for(c = 0, i = 0; i < curve->n; i++)
+   {
+      z = (MpiFixedDword) t2[i] + (curve->p[i] & mask) + c;
+      t2[i] = (MpiFixedWord) z;
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE);
+   }
+
+   for(i = 0; i < (curve->n - 1); i++)
+   {
+      t2[i] = (t2[i] >> 1) | (t2[i + 1] << (MPI_FIXED_WORD_SIZE - 1));
+   }
+
+   t2[i] = (t2[i] >> 1) | (c << (MPI_FIXED_WORD_SIZE - 1));
+
+   //Set R = (t1, t2, t3)
+   osMemcpy(r->x, t1, n);
+   osMemcpy(r->y, t2, n);
+   osMemcpy(r->z, t3, n);
+}
+
+
+/**
+ * @brief Point subtraction
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point R = S - T
+ * @param[in] s First operand
+ * @param[in] t Second operand
+ **/
+
+void ecFixedSub(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s, const EcFixedPoint *t)
+{
+   EcFixedPoint u;
+
+   //Set Ux = Tx and Uz = Tz
+   osMemcpy(u.x, t->x, curve->n * sizeof(MpiFixedWord));
+   osMemcpy(u.z, t->z, curve->n * sizeof(MpiFixedWord));
+
+   //Set Uy = -Ty
+   osMemset(u.y, 0, curve->n * sizeof(MpiFixedWord));
+   ecFixedSubMod(curve, u.y, u.y, t->y);
+
+   //Compute R = S + U
+   ecFixedAdd(curve, r, s, &u);
+}
+
+
+/**
+ * @brief Recover affine representation of several points
+ *
+ * Montgomery's trick is used so that a single modular inversion is
+ * required for every group of 16 points
+ *
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[in,out] r Array of points to be converted
+ * @param[in] n Number of points in the array
+ **/
+
+void ecFixedAffinifyBatch(const EcFixedCurve *curve, EcFixedPoint *r,
+   uint_t n)
+{
+   uint_t i;
+   uint_t k;
+   uint_t m;
+   MpiFixedWord a[EC_FIXED_MAX_WORDS];
+   MpiFixedWord b[EC_FIXED_MAX_WORDS];
+   MpiFixedWord c[16][EC_FIXED_MAX_WORDS];
+
+   //Process the points by groups of 16
+   for(; n > 0; r += m, n -= m)
+   {
+      //Number of points in the current group
+      m = MIN(n, 16);
+
+      //Compute the partial products c[i] = Z[0] * Z[1] * ... * Z[i]
+      osMemcpy(a, curve->one, curve->n * sizeof(MpiFixedWord));
+
+      for(i = 0; i < m; i++)
+      {
+         //Points at the infinity are left unchanged
+         if(!ecFixedIsZero(curve, r[i].z))
+         {
+            ecFixedMulMod(curve, a, a, r[i].z);
+         }
+
+         osMemcpy(c[i], a, curve->n * sizeof(MpiFixedWord));
+      }
+
+      //Compute a = 1 / (Z[0] * Z[1] * ... * Z[m - 1]) mod p
+      ecFixedInvMod(curve, a, a);
+
+      //Process the points in reverse order
+      for(k = m; k > 0; k--)
+      {
+         //Index of the current point
+         i = k - 1;
+
+         //Point at the infinity?
+         if(ecFixedIsZero(curve, r[i].z))
+            continue;
+
+         //Compute b = 1 / Z[i] mod p
+         if(i > 0)
+         {
+            ecFixedMulMod(curve, b, a, c[i - 1]);
+         }
+         else
+         {
+            osMemcpy(b, a, curve->n * sizeof(MpiFixedWord));
+         }
+
+         //Update a = 1 / (Z[0] * Z[1] * ... * Z[i - 1]) mod p
+         ecFixedMulMod(curve, a, a, r[i].z);
+
+         //Set Rx = b^2 * Rx and Ry = b^3 * Ry
+         ecFixedSqrMod(curve, r[i].z, b);
+         ecFixedMulMod(curve, r[i].x, r[i].x, r[i].z);
+         ecFixedMulMod(curve, r[i].z, r[i].z, b);
+         ecFixedMulMod(curve, r[i].y, r[i].y, r[i].z);
+
+         //Set Rz = 1
+         osMemcpy(r[i].z, curve->one, curve->n * sizeof(MpiFixedWord));
+      }
+   }
+}
+
+
+/**
+ * @brief Compute the odd multiples of an EC point
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[in,out] t On entry, T[0] holds the point S. On exit, T[i] holds
+ *   (2i + 1).S in affine coordinates
+ * @param[in] n Number of points to compute
+ **/
+
+void ecFixedPrecompute(const EcFixedCurve *curve, EcFixedPoint *t, uint_t n)
+{
+   uint_t i;
+   EcFixedPoint x;
+
+   //Compute X = 2.S
+   ecFixedDouble(curve, &x, &t[0]);
+
+   //Compute T[i] = (2i + 1).S
+   for(i = 1; i < n; i++)
+   {
+      ecFixedAdd(curve, &t[i], &x, &t[i - 1]);
+   }
+
+   //Normalize the points so that mixed additions can be used
+   ecFixedAffinifyBatch(curve, t, n);
+}
+
+
+/**
+ * @brief Scalar multiplication
+ * @param[in] params EC domain parameters
+ * @param[out] r Resulting point R = d.S
+ * @param[in] d An integer d such as 0 <= d < p
+ * @param[in] s EC point
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+error_t ecFixedMult(const EcDomainParameters *params, EcPoint *r,
+   const Mpi *d, const EcPoint *s)
+{
+   error_t error;
+   EcFixedCurve curve;
+   EcFixedPoint q;
+
+   //Load curve parameters
+   error = ecFixedInit(&curve, params);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Import the point S
+   error = ecFixedImport(&curve, &q, s);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Compute Q = d.S
+   error = ecFixedMultPoint(&curve, &q, d, &q);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Convert the result to projective representation
+   return ecFixedExport(&curve, r, &q);
+}
+
+
+/**
+ * @brief Scalar multiplication (fixed-width representation)
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point R = d.S
+ * @param[in] d An integer d such as 0 <= d < p
+ * @param[in] s EC point
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the scalar does
+ *   not fit in a field element)
+ **/
+
+error_t ecFixedMultPoint(const EcFixedCurve *curve, EcFixedPoint *r,
+   const Mpi *d, const EcFixedPoint *s)
+{
+   uint_t i;
+   uint_t n;
+   int_t u;
+   EcFixedPoint t[1 << (EC_MULT_WINDOW_SIZE - 2)];
+   int8_t naf[EC_FIXED_MAX_WORDS * MPI_FIXED_WORD_SIZE + 1];
+
+   //Scalars that do not fit in a field element are handled by the generic
+   //implementation
+   if(d->sign < 0 || mpiGetBitLength(d) >= sizeof(naf))
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //Compute the width-w NAF representation of d
+   n = ecComputeWnaf(naf, d, EC_MULT_WINDOW_SIZE);
+
+   //Check whether d == 0 or S is the point at the infinity
+   if(n == 0 || ecFixedIsZero(curve, s->z))
+   {
+      //Set R = (1, 1, 0)
+      osMemcpy(r->x, curve->one, curve->n * sizeof(MpiFixedWord));
+      osMemcpy(r->y, curve->one, curve->n * sizeof(MpiFixedWord));
+      osMemset(r->z, 0, curve->n * sizeof(MpiFixedWord));
+   }
+   else
+   {
+      //Precompute the odd multiples T[i] = (2i + 1).S
+      t[0] = *s;
+      ecFixedPrecompute(curve, t, arraysize(t));
+
+      //The most significant digit is always positive
+      *r = t[(naf[n - 1] - 1) / 2];
+
+      //Scalar multiplication
+      for(i = n - 1; i >= 1; i--)
+      {
+         //Point doubling
+         ecFixedDouble(curve, r, r);
+
+         //Retrieve the current digit
+         u = naf[i - 1];
+
+         //Check whether the digit is positive or negative
+         if(u > 0)
+         {
+            //Compute R = R + T[(u - 1) / 2]
+            ecFixedAdd(curve, r, r, &t[(u - 1) / 2]);
+         }
+         else if(u < 0)
+         {
+            //Compute R = R - T[(-u - 1) / 2]
+            ecFixedSub(curve, r, r, &t[(-u - 1) / 2]);
+         }
+      }
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Modular addition
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting integer R = (A + B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < p
+ **/
+
+void ecFixedAddMod(const EcFixedCurve *curve, MpiFixedWord *r,
+   const MpiFixedWord *a, const MpiFixedWord *b)
+{
+   uint_t i;
+   MpiFixedWord c;
+   MpiFixedWord d;
+   MpiFixedWord mask;
+   MpiFixedWord t[EC_FIXED_MAX_WORDS];
+   MpiFixedDword z;
+
+   //Compute R = A + B
+   for(c = 0, i = 0; i < curve->n; i++)
+   {
+      z = (MpiFixedDword) a[i] + b[i] + c;
+      r[i] = (MpiFixedWord) z;
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE);
+   }
+
+   //Compute T = R - p
+   for(d = 0, i = 0; i < curve->n; i++)
+   {
+      z = (MpiFixedDword) r[i] - curve->p[i] - d;
+      t[i] = (MpiFixedWord) z;
+      d = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE) & 1;
+   }
+
+   //Keep R if A + B < p, else replace R with T
+   mask = 0 - (d & (c ^ 1));
+
+   for(i = 0; i < curve->n; i++)
+   {
+      r[i] = (r[i] & mask) | (t[i] & ~mask);
+   }
+}
+
+
+/**
+ * @brief Modular subtraction
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting integer R = (A - B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < p
+ **/
+
+void ecFixedSubMod(const EcFixedCurve *curve, MpiFixedWord *r,
+   const MpiFixedWord *a, const MpiFixedWord *b)
+{
+   uint_t i;
+   MpiFixedWord c;
+   MpiFixedWord d;
+   MpiFixedWord mask;
+   MpiFixedDword z;
+
+   //Compute R = A - B
+   for(d = 0, i = 0; i < curve->n; i++)
+   {
+      z = (MpiFixedDword) a[i] - b[i] - d;
+      r[i] = (MpiFixedWord) z;
+      d = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE) & 1;
+   }
+
+   //Add p if the result is negative
+   mask = 0 - d;
+
+   for(c = 0, i = 0; i < curve->n; i++)
+   {
+      z = (MpiFixedDword) r[i] + (curve->p[i] & mask) + c;
+      r[i] = (MpiFixedWord) z;
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE);
+   }
+}
+
+
+/**
+ * @brief Modular multiplication (Montgomery representation)
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting integer R = (A * B / 2^(n * w)) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < p
+ **/
+
+void ecFixedMulMod(const EcFixedCurve *curve, MpiFixedWord *r,
+   const MpiFixedWord *a, const MpiFixedWord *b)
+{
+   curve->kernel->montMul(r, a, b, curve->p, curve->m);
+}
+
+
+/**
+ * @brief Modular squaring (Montgomery representation)
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting integer R = (A ^ 2 / 2^(n * w)) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ **/
+
+void ecFixedSqrMod(const EcFixedCurve *curve, MpiFixedWord *r,
+   const MpiFixedWord *a)
+{
+   curve->kernel->montSqr(r, a, curve->p, curve->m);
+}
+
+
+/**
+ * @brief Modular inversion (Montgomery representation)
+ *
+ * The inverse is computed as A^(p - 2) mod p, using a fixed 4-bit window
+ *
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting integer R = A^-1 mod p
+ * @param[in] a An integer such as 0 < A < p
+ **/
+
+void ecFixedInvMod(const EcFixedCurve *curve, MpiFixedWord *r,
+   const MpiFixedWord *a)
+{
+   int_t i;
+   uint_t j;
+   uint_t u;
+   MpiFixedWord c;
+   MpiFixedWord e[EC_FIXED_MAX_WORDS];
+   MpiFixedWord t[16][EC_FIXED_MAX_WORDS];
+   MpiFixedDword z;
+
+   //Compute E = p - 2
+   for(c = 2, j = 0; j < curve->n; j++)
+   {
+      z = (MpiFixedDword) curve->p[j] - c;
+      e[j] = (MpiFixedWord) z;
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE) & 1;
+   }
+
+   //Precompute T[i] = A^i
+   osMemcpy(t[0], curve->one, curve->n * sizeof(MpiFixedWord));
+   osMemcpy(t[1], a, curve->n * sizeof(MpiFixedWord));
+
+   for(j = 2; j < 16; j++)
+   {
+      ecFixedMulMod(curve, t[j], t[j - 1], a);
+   }
+
+   //Let R = 1
+   osMemcpy(r, curve->one, curve->n * sizeof(MpiFixedWord));
+
+   //Process the exponent 4 bits at a time, from left to right
+   for(i = curve->n * MPI_FIXED_WORD_SIZE - 4; i >= 0; i -= 4)
+   {
+      //Compute R = R^16
+      for(j = 0; j < 4; j++)
+      {
+         ecFixedSqrMod(curve, r, r);
+      }
+
+      //Extract the current window
+      u = (e[i / MPI_FIXED_WORD_SIZE] >> (i % MPI_FIXED_WORD_SIZE)) & 0x0F;
+
+      //Compute R = R * A^u
+      if(u != 0)
+      {
+         ecFixedMulMod(curve, r, r, t[u]);
+      }
+   }
+}
+
+
+/**
+ * @brief Check whether a field element is zero
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[in] a An integer such as 0 <= A < p
+ * @return TRUE if A = 0, else FALSE
+ **/
+
+bool_t ecFixedIsZero(const EcFixedCurve *curve, const MpiFixedWord *a)
+{
+   uint_t i;
+   MpiFixedWord c;
+
+   //Check whether all the words are zero
+   for(c = 0, i = 0; i < curve->n; i++)
+   {
+      c |= a[i];
+   }
+
+   //Return TRUE if A = 0
+   return (c == 0) ? TRUE : FALSE;
+}
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file ec_fixed.h
+ * @brief Fixed-width field arithmetic for Weierstrass curves
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _EC_FIXED_H
+#define _EC_FIXED_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "mpi/mpi_fixed.h"
+
+//Fixed-width field arithmetic support
+#ifndef EC_FIXED_SUPPORT
+   #if (MPI_FIXED_SUPPORT == ENABLED)
+      #define EC_FIXED_SUPPORT ENABLED
+   #else
+      #define EC_FIXED_SUPPORT DISABLED
+   #endif
+#elif (EC_FIXED_SUPPORT != ENABLED && EC_FIXED_SUPPORT != DISABLED)
+   #error EC_FIXED_SUPPORT parameter is not valid
+#elif (EC_FIXED_SUPPORT == ENABLED && MPI_FIXED_SUPPORT != ENABLED)
+   #error EC_FIXED_SUPPORT requires MPI_FIXED_SUPPORT
+#endif
+
+//Number of words required to hold a field element of the specified size
+#define EC_FIXED_WORDS(bits) (((bits) + MPI_FIXED_WORD_SIZE - 1) / MPI_FIXED_WORD_SIZE)
+
+//Largest prime modulus supported, in bits (the coordinates of the points
+//are sized for the largest enabled curve)
+#ifndef EC_FIXED_MAX_MODULUS_SIZE
+   #if (SECP521R1_SUPPORT == ENABLED || BRAINPOOLP512R1_SUPPORT == ENABLED)
+      #define EC_FIXED_MAX_MODULUS_SIZE 521
+   #elif (SECP384R1_SUPPORT == ENABLED || BRAINPOOLP384R1_SUPPORT == ENABLED || \
+      BRAINPOOLP320R1_SUPPORT == ENABLED)
+      #define EC_FIXED_MAX_MODULUS_SIZE 384
+   #else
+      #define EC_FIXED_MAX_MODULUS_SIZE 256
+   #endif
+#elif (EC_FIXED_MAX_MODULUS_SIZE != 256 && EC_FIXED_MAX_MODULUS_SIZE != 384 && \
+   EC_FIXED_MAX_MODULUS_SIZE != 521)
+   #error EC_FIXED_MAX_MODULUS_SIZE parameter is not valid
+#endif
+
+//Maximum number of words
+#define EC_FIXED_MAX_WORDS EC_FIXED_WORDS(EC_FIXED_MAX_MODULUS_SIZE)
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Special forms of the curve parameter a
+ **/
+
+typedef enum
+{
+   EC_FIXED_COEF_A_GENERIC = 0,
+   EC_FIXED_COEF_A_ZERO    = 1,
+   EC_FIXED_COEF_A_MINUS_3 = 2
+} EcFixedCoefA;
+
+
+/**
+ * @brief Curve parameters in fixed-width representation
+ **/
+
+typedef struct
+{
+   const MpiFixedKernel *kernel;         ///<Montgomery kernels
+   uint_t n;                             ///<Size of a field element, in words
+   MpiFixedWord p[EC_FIXED_MAX_WORDS];   ///<Prime modulus p
+   MpiFixedWord m;                       ///<Montgomery constant -1/p mod 2^w
+   MpiFixedWord r2[EC_FIXED_MAX_WORDS];  ///<R^2 mod p
+   MpiFixedWord one[EC_FIXED_MAX_WORDS]; ///<Montgomery representation of 1
+   MpiFixedWord a[EC_FIXED_MAX_WORDS];   ///<Montgomery representation of a
+   MpiFixedWord b[EC_FIXED_MAX_WORDS];   ///<Montgomery representation of b
+   EcFixedCoefA aType;                   ///<Special form of the parameter a
+} EcFixedCurve;
+
+
+/**
+ * @brief EC point (Jacobian coordinates, Montgomery representation)
+ **/
+
+typedef struct
+{
+   MpiFixedWord x[EC_FIXED_MAX_WORDS]; ///<x-coordinate
+   MpiFixedWord y[EC_FIXED_MAX_WORDS]; ///<y-coordinate
+   MpiFixedWord z[EC_FIXED_MAX_WORDS]; ///<z-coordinate
+} EcFixedPoint;
+
+
+//Fixed-width field arithmetic related functions
+error_t ecFixedInit(EcFixedCurve *curve, const EcDomainParameters *params);
+error_t ecFixedInitOrder(EcFixedCurve *order, const EcDomainParameters *params);
+
+error_t ecFixedImport(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcPoint *s);
+
+error_t ecFixedExport(const EcFixedCurve *curve, EcPoint *r,
+   const EcFixedPoint *s);
+
+void ecFixedDouble(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s);
+
+void ecFixedAdd(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s, const EcFixedPoint *t);
+
+void ecFixedSub(const EcFixedCurve *curve, EcFixedPoint *r,
+   const EcFixedPoint *s, const EcFixedPoint *t);
+
+void ecFixedAffinifyBatch(const EcFixedCurve *curve, EcFixedPoint *r,
+   uint_t n);
+
+void ecFixedPrecompute(const EcFixedCurve *curve, EcFixedPoint *t, uint_t n);
+
+error_t ecFixedMult(const EcDomainParameters *params, EcPoint *r,
+   const Mpi *d, const EcPoint *s);
+
+error_t ecFixedMultPoint(const EcFixedCurve *curve, EcFixedPoint *r,
+   const Mpi *d, const EcFixedPoint *s);
+
+void ecFixedAddMod(const EcFixedCurve *curve, MpiFixedWord *r,
+   const MpiFixedWord *a, const MpiFixedWord *b);
+
+void ecFixedSubMod(const EcFixedCurve *curve, MpiFixedWord *r,
+   const MpiFixedWord *a, const MpiFixedWord *b);
+
+void ecFixedMulMod(const EcFixedCurve *curve, MpiFixedWord *r,
+   const MpiFixedWord *a, const MpiFixedWord *b);
+
+void ecFixedSqrMod(const EcFixedCurve *curve, MpiFixedWord *r,
+   const MpiFixedWord *a);
+
+void ecFixedInvMod(const EcFixedCurve *curve, MpiFixedWord *r,
+   const MpiFixedWord *a);
+
+bool_t ecFixedIsZero(const EcFixedCurve *curve, const MpiFixedWord *a);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,266 @@
+/**
+ * @file ec_glv.c
+ * @brief GLV endomorphism for Koblitz curves
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * On secp256k1, the map phi(x, y) = (beta.x, y) is an endomorphism that
+ * acts as the multiplication by a scalar lambda. A 256-bit scalar k can be
+ * rewritten as k = k1 + k2.lambda mod q, where k1 and k2 are about 128 bits
+ * long, so that k.S = k1.S + k2.phi(S) can be computed as a twin
+ * multiplication with half as many doublings. Refer to "Faster Point
+ * Multiplication on Elliptic Curves with Efficient Endomorphisms" (Gallant,
+ * Lambert and Vanstone, CRYPTO 2001)
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_glv.h"
+#include "ecc/ec_wnaf.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (EC_SUPPORT == ENABLED)
+
+
+/**
+ * @brief Curves with an efficiently computable endomorphism
+ **/
+
+static const EcGlvParams ecGlvCurves[] =
+{
+   //secp256k1 elliptic curve
+   {
+      "secp256k1",
+      //beta
+      {
+         0x7A, 0xE9, 0x6A, 0x2B, 0x65, 0x7C, 0x07, 0x10,
+         0x6E, 0x64, 0x47, 0x9E, 0xAC, 0x34, 0x34, 0xE9,
+         0x9C, 0xF0, 0x49, 0x75, 0x12, 0xF5, 0x89, 0x95,
+         0xC1, 0x39, 0x6C, 0x28, 0x71, 0x95, 0x01, 0xEE
+      },
+      //a1
+      {
+         0x00, 0x30, 0x86, 0xD2, 0x21, 0xA7, 0xD4, 0x6B,
+         0xCD, 0xE8, 0x6C, 0x90, 0xE4, 0x92, 0x84, 0xEB,
+         0x15
+      },
+      //-b1
+      {
+         0x00, 0xE4, 0x43, 0x7E, 0xD6, 0x01, 0x0E, 0x88,
+         0x28, 0x6F, 0x54, 0x7F, 0xA9, 0x0A, 0xBF, 0xE4,
+         0xC3
+      },
+      //a2
+      {
+         0x01, 0x14, 0xCA, 0x50, 0xF7, 0xA8, 0xE2, 0xF3,
+         0xF6, 0x57, 0xC1, 0x10, 0x8D, 0x9D, 0x44, 0xCF,
+         0xD8
+      },
+      //b2
+      {
+         0x00, 0x30, 0x86, 0xD2, 0x21, 0xA7, 0xD4, 0x6B,
+         0xCD, 0xE8, 0x6C, 0x90, 0xE4, 0x92, 0x84, 0xEB,
+         0x15
+      },
+      //g1
+      {
+         0x30, 0x86, 0xD2, 0x21, 0xA7, 0xD4, 0x6B, 0xCD,
+         0xE8, 0x6C, 0x90, 0xE4, 0x92, 0x84, 0xEB, 0x15,
+         0x3D, 0xAA, 0x8A, 0x14, 0x71, 0xE8, 0xCA, 0x7F,
+         0xE8, 0x93, 0x20, 0x9A, 0x45, 0xDB, 0xB0, 0x31
+      },
+      //g2
+      {
+         0xE4, 0x43, 0x7E, 0xD6, 0x01, 0x0E, 0x88, 0x28,
+         0x6F, 0x54, 0x7F, 0xA9, 0x0A, 0xBF, 0xE4, 0xC4,
+         0x22, 0x12, 0x08, 0xAC, 0x9D, 0xF5, 0x06, 0xC6,
+         0x15, 0x71, 0xB4, 0xAE, 0x8A, 0xC4, 0x7F, 0x71
+      }
+   }
+};
+
+
+/**
+ * @brief Retrieve the endomorphism parameters of a curve
+ * @param[in] params EC domain parameters
+ * @return Endomorphism parameters (NULL if the curve has no known
+ *   efficiently computable endomorphism)
+ **/
+
+const EcGlvParams *ecGlvGetParams(const EcDomainParameters *params)
+{
+   uint_t i;
+
+   //Only Koblitz curves have such an endomorphism
+   if(params->type != EC_CURVE_TYPE_SECP_K1 || params->name == NULL)
+      return NULL;
+
+   //Loop through the list of supported curves
+   for(i = 0; i < arraysize(ecGlvCurves); i++)
+   {
+      //Matching curve name?
+      if(!osStrcmp(params->name, ecGlvCurves[i].name))
+         return &ecGlvCurves[i];
+   }
+
+   //The curve is not supported
+   return NULL;
+}
+
+
+/**
+ * @brief Split a scalar using the GLV endomorphism
+ *
+ * The halves are computed as k1 = k - c1.a1 - c2.a2 and k2 = -c1.b1 - c2.b2,
+ * where c1 = round(b2.k / q) and c2 = round(-b1.k / q). Both of them may be
+ * negative, and their absolute value does not exceed 128 bits
+ *
+ * @param[in] params EC domain parameters
+ * @param[out] k1 First half
+ * @param[out] k2 Second half
+ * @param[in] k An integer such as 0 <= k < q
+ * @return Error code
+ **/
+
+error_t ecGlvSplit(const EcDomainParameters *params, Mpi *k1, Mpi *k2,
+   const Mpi *k)
+{
+   error_t error;
+   const EcGlvParams *glv;
+   Mpi c1;
+   Mpi c2;
+   Mpi t;
+   Mpi u;
+
+   //Retrieve the endomorphism parameters
+   glv = ecGlvGetParams(params);
+   //Not supported by the curve?
+   if(glv == NULL)
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //The scalar must be in the range 0 <= k < q
+   if(k->sign < 0 || mpiComp(k, &params->q) >= 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Initialize multiple precision integers
+   mpiInit(&c1);
+   mpiInit(&c2);
+   mpiInit(&t);
+   mpiInit(&u);
+
+   //Compute c1 = round(k * g1 / 2^384)
+   MPI_CHECK(mpiImport(&t, glv->g1, sizeof(glv->g1), MPI_FORMAT_BIG_ENDIAN));
+   MPI_CHECK(mpiMul(&c1, k, &t));
+   MPI_CHECK(mpiShiftRight(&c1, 383));
+   MPI_CHECK(mpiAddInt(&c1, &c1, 1));
+   MPI_CHECK(mpiShiftRight(&c1, 1));
+
+   //Compute c2 = round(k * g2 / 2^384)
+   MPI_CHECK(mpiImport(&t, glv->g2, sizeof(glv->g2), MPI_FORMAT_BIG_ENDIAN));
+   MPI_CHECK(mpiMul(&c2, k, &t));
+   MPI_CHECK(mpiShiftRight(&c2, 383));
+   MPI_CHECK(mpiAddInt(&c2, &c2, 1));
+   MPI_CHECK(mpiShiftRight(&c2, 1));
+
+   //Compute k1 = k - c1.a1 - c2.a2
+   MPI_CHECK(mpiImport(&t, glv->a1, sizeof(glv->a1), MPI_FORMAT_BIG_ENDIAN));
+   MPI_CHECK(mpiMul(&u, &c1, &t));
+   MPI_CHECK(mpiSub(k1, k, &u));
+   MPI_CHECK(mpiImport(&t, glv->a2, sizeof(glv->a2), MPI_FORMAT_BIG_ENDIAN));
+   MPI_CHECK(mpiMul(&u, &c2, &t));
+   MPI_CHECK(mpiSub(k1, k1, &u));
+
+   //Compute k2 = c1.(-b1) - c2.b2
+   MPI_CHECK(mpiImport(&t, glv->minusB1, sizeof(glv->minusB1),
+      MPI_FORMAT_BIG_ENDIAN));
+   MPI_CHECK(mpiMul(k2, &c1, &t));
+   MPI_CHECK(mpiImport(&t, glv->b2, sizeof(glv->b2), MPI_FORMAT_BIG_ENDIAN));
+   MPI_CHECK(mpiMul(&u, &c2, &t));
+   MPI_CHECK(mpiSub(k2, k2, &u));
+
+end:
+   //Release multiple precision integers
+   mpiFree(&c1);
+   mpiFree(&c2);
+   mpiFree(&t);
+   mpiFree(&u);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Scalar multiplication using the GLV endomorphism
+ * @param[in] params EC domain parameters
+ * @param[out] r Resulting point R = d.S
+ * @param[in] d An integer d such as 0 <= d < q
+ * @param[in] s EC point
+ * @return Error code
+ **/
+
+error_t ecGlvMult(const EcDomainParameters *params, EcPoint *r,
+   const Mpi *d, const EcPoint *s)
+{
+   error_t error;
+   Mpi k1;
+   Mpi k2;
+   EcWnafTerm terms[2];
+
+   //Initialize multiple precision integers
+   mpiInit(&k1);
+   mpiInit(&k2);
+
+   //Split d = k1 + k2.lambda
+   error = ecGlvSplit(params, &k1, &k2, d);
+
+   //Check status code
+   if(!error)
+   {
+      //Compute R = k1.S + k2.phi(S)
+      ecWnafSetTerm(&terms[0], &k1, s, NULL, FALSE);
+      ecWnafSetTerm(&terms[1], &k2, s, NULL, TRUE);
+
+      //Both terms share the same doublings
+      error = ecWnafMultiMult(params, r, terms, 2);
+   }
+
+   //Release multiple precision integers
+   mpiFree(&k1);
+   mpiFree(&k2);
+
+   //Return status code
+   return error;
+}
+
+#endif
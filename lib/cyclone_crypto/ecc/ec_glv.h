@@ -0,0 +1,88 @@
+/**
+ * @file ec_glv.h
+ * @brief GLV endomorphism for Koblitz curves
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _EC_GLV_H
+#define _EC_GLV_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+
+//GLV endomorphism support
+#ifndef EC_GLV_SUPPORT
+   #define EC_GLV_SUPPORT ENABLED
+#elif (EC_GLV_SUPPORT != ENABLED && EC_GLV_SUPPORT != DISABLED)
+   #error EC_GLV_SUPPORT parameter is not valid
+#endif
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Endomorphism parameters
+ *
+ * The map phi(x, y) = (beta.x, y) acts on the points of the curve as the
+ * multiplication by lambda. The reduced basis (a1, b1), (a2, b2) of the
+ * lattice {(x, y) | x + y.lambda = 0 mod q} is used to split scalars, with
+ * g1 = round(2^384 * b2 / q) and g2 = round(2^384 * -b1 / q)
+ *
+ **/
+
+typedef struct
+{
+   const char_t *name;   ///<Curve name
+   uint8_t beta[32];     ///<Cube root of unity modulo p
+   uint8_t a1[17];       ///<First basis vector (a1)
+   uint8_t minusB1[17];  ///<First basis vector (-b1)
+   uint8_t a2[17];       ///<Second basis vector (a2)
+   uint8_t b2[17];       ///<Second basis vector (b2)
+   uint8_t g1[32];       ///<Rounding constant g1
+   uint8_t g2[32];       ///<Rounding constant g2
+} EcGlvParams;
+
+
+//GLV endomorphism related functions
+const EcGlvParams *ecGlvGetParams(const EcDomainParameters *params);
+
+error_t ecGlvSplit(const EcDomainParameters *params, Mpi *k1, Mpi *k2,
+   const Mpi *k);
+
+error_t ecGlvMult(const EcDomainParameters *params, EcPoint *r,
+   const Mpi *d, const EcPoint *s);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,191 @@
+/**
+ * @file ec_registry.c
+ * @brief Registry of shared EC domain parameters
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * Loading EC domain parameters requires the prime modulus, the curve
+ * coefficients, the base point and its order to be imported from their
+ * byte representation for every operation. The registry loads the domain
+ * parameters of a given curve only once, together with the fast modular
+ * reduction routine and the precomputed multiples of the base point, and
+ * hands out read-only pointers that remain valid until the registry itself
+ * is released
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_registry.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (EC_SUPPORT == ENABLED && EC_REGISTRY_SUPPORT == ENABLED)
+
+//Registry used when retrieving EC domain parameters
+static EcRegistry *ecRegistry = NULL;
+
+
+/**
+ * @brief Check whether a registry entry matches a curve
+ * @param[in] entry Registry entry
+ * @param[in] key Elliptic curve parameters
+ * @return TRUE if the entry matches, else FALSE
+ **/
+
+static bool_t ecRegistryMatchEntry(const void *entry, const void *key)
+{
+   return ((const EcRegistryEntry *) entry)->curveInfo == key;
+}
+
+
+/**
+ * @brief Load the domain parameters of a curve into a new registry entry
+ * @param[out] entry Registry entry
+ * @param[in] key Elliptic curve parameters
+ * @return Error code
+ **/
+
+static error_t ecRegistryBuildEntry(void *entry, const void *key)
+{
+   EcRegistryEntry *p;
+
+   //Point to the registry entry
+   p = (EcRegistryEntry *) entry;
+
+   //Load EC domain parameters
+   p->curveInfo = key;
+   ecInitDomainParameters(&p->params);
+   return ecLoadDomainParameters(&p->params, key);
+}
+
+
+/**
+ * @brief Release a registry entry
+ * @param[in] entry Registry entry
+ **/
+
+static void ecRegistryReleaseEntry(void *entry)
+{
+   ecFreeDomainParameters(&((EcRegistryEntry *) entry)->params);
+}
+
+
+//Type of the registry entries
+static const CryptoCacheAlgo ecRegistryAlgo =
+{
+   sizeof(EcRegistryEntry),
+   ecRegistryMatchEntry,
+   ecRegistryBuildEntry,
+   ecRegistryReleaseEntry
+};
+
+
+/**
+ * @brief Registry initialization
+ * @param[in] size Maximum number of registry entries
+ * @return Handle referencing the fully initialized registry
+ **/
+
+EcRegistry *ecInitRegistry(uint_t size)
+{
+   return cryptoInitCache(size);
+}
+
+
+/**
+ * @brief Release registry
+ * @param[in] registry Pointer to the registry
+ **/
+
+void ecFreeRegistry(EcRegistry *registry)
+{
+   cryptoFreeCache(registry, &ecRegistryAlgo);
+}
+
+
+/**
+ * @brief Retrieve the shared EC domain parameters of a curve
+ * @param[in] registry Pointer to the registry
+ * @param[in] curveInfo Elliptic curve parameters
+ * @param[out] params Pointer to the shared EC domain parameters
+ * @return Error code
+ **/
+
+error_t ecRegistryGetDomainParameters(EcRegistry *registry,
+   const EcCurveInfo *curveInfo, const EcDomainParameters **params)
+{
+   error_t error;
+   void *entry;
+
+   //Check parameters
+   if(registry == NULL || curveInfo == NULL || params == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Retrieve the matching entry, loading the domain parameters if necessary
+   error = cryptoCacheGet(registry, &ecRegistryAlgo, curveInfo, &entry);
+
+   //Return a pointer to the shared EC domain parameters
+   *params = (entry != NULL) ? &((EcRegistryEntry *) entry)->params : NULL;
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Register the registry used when retrieving EC domain parameters
+ * @param[in] registry Pointer to the registry (NULL to disable the registry)
+ * @return Error code
+ **/
+
+error_t ecRegisterRegistry(EcRegistry *registry)
+{
+   //Save the registry
+   ecRegistry = registry;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Get the registered registry
+ * @return Pointer to the registry (NULL if no registry has been registered)
+ **/
+
+EcRegistry *ecGetRegistry(void)
+{
+   //Return the registered registry
+   return ecRegistry;
+}
+
+#endif
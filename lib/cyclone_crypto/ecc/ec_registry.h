@@ -0,0 +1,85 @@
+/**
+ * @file ec_registry.h
+ * @brief Registry of shared EC domain parameters
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _EC_REGISTRY_H
+#define _EC_REGISTRY_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "core/crypto_cache.h"
+#include "ecc/ec.h"
+
+//Shared EC domain parameters support
+#ifndef EC_REGISTRY_SUPPORT
+   #define EC_REGISTRY_SUPPORT DISABLED
+#elif (EC_REGISTRY_SUPPORT != ENABLED && EC_REGISTRY_SUPPORT != DISABLED)
+   #error EC_REGISTRY_SUPPORT parameter is not valid
+#endif
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Registry entry
+ **/
+
+typedef struct
+{
+   const EcCurveInfo *curveInfo; ///<Elliptic curve parameters
+   EcDomainParameters params;    ///<EC domain parameters
+} EcRegistryEntry;
+
+
+/**
+ * @brief Registry of shared EC domain parameters
+ **/
+
+typedef CryptoCache EcRegistry;
+
+
+//Registry related functions
+EcRegistry *ecInitRegistry(uint_t size);
+void ecFreeRegistry(EcRegistry *registry);
+
+error_t ecRegistryGetDomainParameters(EcRegistry *registry,
+   const EcCurveInfo *curveInfo, const EcDomainParameters **params);
+
+error_t ecRegisterRegistry(EcRegistry *registry);
+EcRegistry *ecGetRegistry(void);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
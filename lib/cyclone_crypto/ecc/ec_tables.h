@@ -0,0 +1,76 @@
+/**
+ * @file ec_tables.h
+ * @brief Precomputed EC tables compiled into the library
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _EC_TABLES_H
+#define _EC_TABLES_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_comb.h"
+
+//Ed25519 supported?
+#if (ED25519_SUPPORT == ENABLED)
+   #include "ecc/ed25519.h"
+#endif
+
+//Precomputed tables compiled into the library
+#ifndef EC_STATIC_TABLE_SUPPORT
+   #define EC_STATIC_TABLE_SUPPORT DISABLED
+#elif (EC_STATIC_TABLE_SUPPORT != ENABLED && EC_STATIC_TABLE_SUPPORT != DISABLED)
+   #error EC_STATIC_TABLE_SUPPORT parameter is not valid
+#endif
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//The tables are emitted by the ec_table_gen tool at build time
+#if (EC_STATIC_TABLE_SUPPORT == ENABLED)
+
+//Precomputed multiples of the base point G (P-256 and P-384)
+#if (EC_COMB_SUPPORT == ENABLED)
+const EcCombTable *ecGetStaticCombTable(const EcCurveInfo *curveInfo);
+#endif
+
+//Precomputed multiples of the base point B (Ed25519)
+#if (ED25519_SUPPORT == ENABLED && ED25519_BASE_TABLE_SUPPORT == ENABLED)
+extern const Ed25519BaseTable ed25519StaticBaseTable;
+#endif
+
+#endif
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
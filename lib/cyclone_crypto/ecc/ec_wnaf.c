@@ -0,0 +1,921 @@
+/**
+ * @file ec_wnaf.c
+ * @brief Precomputed width-w NAF tables
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * A twin multiplication d0.S + d1.T recodes both scalars in width-w NAF and
+ * processes them in an interleaved fashion (Strauss-Shamir), so that they
+ * share the same doublings. The odd multiples of a point that is used over
+ * and over again (base point, long-lived public key) can be computed once
+ * and kept in a table, which allows a wider window for that point. The odd
+ * multiples of any other point are computed on the fly. The same technique
+ * is applied to more than two scalars when a curve endomorphism is used to
+ * split each of them into two halves
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_wnaf.h"
+#include "ecc/ec_glv.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (EC_SUPPORT == ENABLED)
+
+
+/**
+ * @brief Compute the odd multiples of an EC point
+ * @param[in] params EC domain parameters
+ * @param[out] t Resulting points T[i] = (2i + 1).S, in affine coordinates
+ * @param[in] n Number of points to compute
+ * @param[in] s EC point
+ * @return Error code
+ **/
+
+static error_t ecWnafPrecompute(const EcDomainParameters *params, EcPoint *t,
+   uint_t n, const EcPoint *s)
+{
+   error_t error;
+   uint_t i;
+   EcPoint x;
+
+   //Initialize EC point
+   ecInit(&x);
+
+   //Let T[0] = S and X = 2.S
+   EC_CHECK(ecCopy(&t[0], s));
+   EC_CHECK(ecDouble(params, &x, &t[0]));
+
+   //Compute T[i] = (2i + 1).S
+   for(i = 1; i < n; i++)
+   {
+      EC_CHECK(ecFullAdd(params, &t[i], &t[i - 1], &x));
+   }
+
+   //Normalize the points so that mixed additions can be used
+   EC_CHECK(ecAffinifyBatch(params, t, n));
+
+end:
+   //Release EC point
+   ecFree(&x);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Initialize a width-w NAF table
+ * @param[in] table Pointer to the table
+ **/
+
+void ecWnafInit(EcWnafTable *table)
+{
+   //Clear the structure
+   osMemset(table, 0, sizeof(EcWnafTable));
+}
+
+
+/**
+ * @brief Release a width-w NAF table
+ * @param[in] table Pointer to the table
+ **/
+
+void ecWnafFree(EcWnafTable *table)
+{
+   uint_t i;
+
+   //Valid table?
+   if(table->points != NULL)
+   {
+      //Release EC points
+      for(i = 0; i < (1U << (table->w - 2)); i++)
+      {
+         ecFree(&table->points[i]);
+      }
+
+      cryptoFreeMem(table->points);
+   }
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+   //Valid points in fixed-width representation?
+   if(table->fixedPoints != NULL)
+   {
+      cryptoFreeMem(table->fixedPoints);
+   }
+#endif
+
+   //Clear the structure
+   ecWnafInit(table);
+}
+
+
+/**
+ * @brief Precompute the odd multiples of an EC point
+ * @param[in] params EC domain parameters
+ * @param[out] table Pointer to the table
+ * @param[in] s EC point
+ * @param[in] w Width of the NAF window (2 <= w <= 8)
+ * @return Error code
+ **/
+
+error_t ecWnafBuild(const EcDomainParameters *params, EcWnafTable *table,
+   const EcPoint *s, uint_t w)
+{
+   error_t error;
+   uint_t i;
+   uint_t n;
+#if (EC_FIXED_SUPPORT == ENABLED)
+   EcFixedCurve curve;
+#endif
+
+   //Check parameters
+   if(params == NULL || table == NULL || s == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Check the width of the window
+   if(w < 2 || w > 8)
+      return ERROR_INVALID_PARAMETER;
+
+   //Only Weierstrass curves are supported
+   if(params->type != EC_CURVE_TYPE_SECP_K1 &&
+      params->type != EC_CURVE_TYPE_SECP_R1 &&
+      params->type != EC_CURVE_TYPE_SECP_R2 &&
+      params->type != EC_CURVE_TYPE_BRAINPOOLP_R1)
+   {
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+   }
+
+   //Release previously allocated resources
+   ecWnafFree(table);
+
+   //Number of odd multiples
+   table->w = w;
+   n = 1 << (w - 2);
+
+   //Allocate a memory buffer to hold the precomputed points
+   table->points = cryptoAllocMem(n * sizeof(EcPoint));
+   //Failed to allocate memory?
+   if(table->points == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Initialize EC points
+   for(i = 0; i < n; i++)
+   {
+      ecInit(&table->points[i]);
+   }
+
+   //Compute the odd multiples of S
+   EC_CHECK(ecWnafPrecompute(params, table->points, n, s));
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+   //Keep a copy of the points in fixed-width representation, so that they
+   //do not have to be converted on every use
+   if(!ecFixedInit(&curve, params))
+   {
+      //Allocate a memory buffer to hold the converted points
+      table->fixedPoints = cryptoAllocMem(n * sizeof(EcFixedPoint));
+      //Failed to allocate memory?
+      if(table->fixedPoints == NULL)
+      {
+         error = ERROR_OUT_OF_MEMORY;
+         goto end;
+      }
+
+      //Convert the points
+      for(i = 0; i < n; i++)
+      {
+         EC_CHECK(ecFixedImport(&curve, &table->fixedPoints[i],
+            &table->points[i]));
+      }
+   }
+#endif
+
+end:
+   //Any error to report?
+   if(error)
+   {
+      //Clean up side effects
+      ecWnafFree(table);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Set up a term of a multi-scalar multiplication
+ * @param[out] term Pointer to the term
+ * @param[in] d Scalar (may be negative)
+ * @param[in] s EC point (ignored if a table is provided)
+ * @param[in] table Odd multiples of S (optional parameter)
+ * @param[in] endo Multiply phi(S) rather than S (GLV endomorphism)
+ **/
+
+void ecWnafSetTerm(EcWnafTerm *term, const Mpi *d, const EcPoint *s,
+   const EcWnafTable *table, bool_t endo)
+{
+   //Save parameters
+   term->d = d;
+   term->s = s;
+   term->table = table;
+   term->endo = endo;
+}
+
+
+/**
+ * @brief Set up the terms of a twin multiplication
+ *
+ * On curves with an efficiently computable endomorphism, each scalar is
+ * split into two halves, which yields four terms that need half as many
+ * doublings
+ *
+ * @param[in] params EC domain parameters
+ * @param[out] terms Terms of the multi-scalar multiplication
+ * @param[out] n Number of terms
+ * @param[out] k Halves of the scalars (4 integers)
+ * @param[in] d0 An integer d such as 0 <= d0 < p
+ * @param[in] s EC point (ignored if a table is provided)
+ * @param[in] t0 Odd multiples of S (optional parameter)
+ * @param[in] d1 An integer d such as 0 <= d1 < p
+ * @param[in] t EC point (ignored if a table is provided)
+ * @param[in] t1 Odd multiples of T (optional parameter)
+ * @return Error code
+ **/
+
+static error_t ecWnafTwinTerms(const EcDomainParameters *params,
+   EcWnafTerm *terms, uint_t *n, Mpi *k, const Mpi *d0, const EcPoint *s,
+   const EcWnafTable *t0, const Mpi *d1, const EcPoint *t,
+   const EcWnafTable *t1)
+{
+   error_t error;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+#if (EC_GLV_SUPPORT == ENABLED)
+   //Curve with an efficiently computable endomorphism?
+   if(ecGlvGetParams(params) != NULL && mpiComp(d0, &params->q) < 0 &&
+      mpiComp(d1, &params->q) < 0)
+   {
+      //Split d0 = k0 + k1.lambda
+      error = ecGlvSplit(params, &k[0], &k[1], d0);
+
+      //Check status code
+      if(!error)
+      {
+         //Split d1 = k2 + k3.lambda
+         error = ecGlvSplit(params, &k[2], &k[3], d1);
+      }
+
+      //The odd multiples of phi(S) and phi(T) are derived from those of S
+      //and T
+      ecWnafSetTerm(&terms[0], &k[0], s, t0, FALSE);
+      ecWnafSetTerm(&terms[1], &k[1], s, t0, TRUE);
+      ecWnafSetTerm(&terms[2], &k[2], t, t1, FALSE);
+      ecWnafSetTerm(&terms[3], &k[3], t, t1, TRUE);
+      *n = 4;
+   }
+   else
+#endif
+   {
+      //Regular twin multiplication
+      ecWnafSetTerm(&terms[0], d0, s, t0, FALSE);
+      ecWnafSetTerm(&terms[1], d1, t, t1, FALSE);
+      *n = 2;
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Multi-scalar multiplication using precomputed tables
+ *
+ * Each point is given either directly, in which case its odd multiples are
+ * computed on the fly using a window of EC_MULT_WINDOW_SIZE bits, or
+ * through a precomputed table. A term that applies the endomorphism to the
+ * same point as the preceding term reuses its odd multiples
+ *
+ * @param[in] params EC domain parameters
+ * @param[out] r Resulting point R = d[0].S[0] + ... + d[n-1].S[n-1]
+ * @param[in] terms Terms of the multi-scalar multiplication
+ * @param[in] n Number of terms (1 <= n <= EC_WNAF_MAX_TERMS)
+ * @return Error code
+ **/
+
+error_t ecWnafMultiMult(const EcDomainParameters *params, EcPoint *r,
+   const EcWnafTerm *terms, uint_t n)
+{
+   error_t error;
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   uint_t m;
+   int_t u;
+   uint_t w[EC_WNAF_MAX_TERMS];
+   uint_t len[EC_WNAF_MAX_TERMS];
+   int8_t *naf[EC_WNAF_MAX_TERMS];
+   int8_t *buffer;
+   const EcPoint *p[EC_WNAF_MAX_TERMS];
+   const EcPoint *v;
+   const EcGlvParams *glv;
+   Mpi beta;
+   EcPoint q;
+   EcPoint e;
+   EcPoint t[EC_WNAF_MAX_TERMS][1 << (EC_MULT_WINDOW_SIZE - 2)];
+
+   //Check parameters
+   if(params == NULL || r == NULL || terms == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Check the number of terms
+   if(n < 1 || n > EC_WNAF_MAX_TERMS)
+      return ERROR_INVALID_PARAMETER;
+
+   //Each point must be given either directly or through a table
+   for(i = 0; i < n; i++)
+   {
+      if(terms[i].d == NULL || (terms[i].s == NULL && terms[i].table == NULL))
+         return ERROR_INVALID_PARAMETER;
+   }
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+   //Use fixed-width field arithmetic whenever the curve allows it
+   error = ecWnafMultiMultFixed(params, r, terms, n);
+   //Unless the operation is not supported, the result is final
+   if(error != ERROR_UNSUPPORTED_ELLIPTIC_CURVE)
+      return error;
+#endif
+
+   //Initialize multiple precision integer
+   mpiInit(&beta);
+   //Initialize EC points
+   ecInit(&q);
+   ecInit(&e);
+
+   for(i = 0; i < EC_WNAF_MAX_TERMS; i++)
+   {
+      for(j = 0; j < arraysize(t[i]); j++)
+      {
+         ecInit(&t[i][j]);
+      }
+   }
+
+   //Initialize pointer
+   glv = NULL;
+
+   //Each NAF representation is at most one digit longer than the scalar
+   for(m = 0, i = 0; i < n; i++)
+   {
+      m += mpiGetBitLength(terms[i].d) + 1;
+   }
+
+   //Allocate a memory buffer to hold the NAF representations
+   buffer = cryptoAllocMem(m);
+   //Failed to allocate memory?
+   if(buffer == NULL)
+   {
+      error = ERROR_OUT_OF_MEMORY;
+      goto end;
+   }
+
+   //Process each term
+   for(m = 0, i = 0; i < n; i++)
+   {
+      //Retrieve the odd multiples of the point
+      if(terms[i].table != NULL)
+      {
+         p[i] = terms[i].table->points;
+         w[i] = terms[i].table->w;
+      }
+      else if(i > 0 && terms[i].endo && terms[i - 1].table == NULL &&
+         terms[i - 1].s == terms[i].s)
+      {
+         p[i] = p[i - 1];
+         w[i] = w[i - 1];
+      }
+      else
+      {
+         EC_CHECK(ecWnafPrecompute(params, t[i], arraysize(t[i]),
+            terms[i].s));
+
+         p[i] = t[i];
+         w[i] = EC_MULT_WINDOW_SIZE;
+      }
+
+      //Compute the width-w NAF representation of |d|
+      naf[i] = buffer + m;
+      len[i] = ecComputeWnaf(naf[i], terms[i].d, w[i]);
+      m += mpiGetBitLength(terms[i].d) + 1;
+
+      //Negative scalar?
+      if(terms[i].d->sign < 0)
+      {
+         for(j = 0; j < len[i]; j++)
+         {
+            naf[i][j] = -naf[i][j];
+         }
+      }
+
+      //The endomorphism phi(x, y) = (beta.x, y) is applied to the odd
+      //multiples on the fly
+      if(terms[i].endo && glv == NULL)
+      {
+         //Retrieve the endomorphism parameters
+         glv = ecGlvGetParams(params);
+         //Not supported by the curve?
+         if(glv == NULL)
+         {
+            error = ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+            goto end;
+         }
+
+         //Load the cube root of unity beta
+         MPI_CHECK(mpiImport(&beta, glv->beta, sizeof(glv->beta),
+            MPI_FORMAT_BIG_ENDIAN));
+      }
+   }
+
+   //Set Q = (1, 1, 0)
+   MPI_CHECK(mpiSetValue(&q.x, 1));
+   MPI_CHECK(mpiSetValue(&q.y, 1));
+   MPI_CHECK(mpiSetValue(&q.z, 0));
+
+   //Length of the longest NAF representation
+   for(k = 0, i = 0; i < n; i++)
+   {
+      k = MAX(k, len[i]);
+   }
+
+   //The doublings are shared between all the scalars
+   for(; k > 0; k--)
+   {
+      //Point doubling
+      EC_CHECK(ecDouble(params, &q, &q));
+
+      //Process the current digit of each scalar
+      for(i = 0; i < n; i++)
+      {
+         u = (k <= len[i]) ? naf[i][k - 1] : 0;
+
+         //Nonzero digit?
+         if(u != 0)
+         {
+            //Select the relevant odd multiple
+            v = &p[i][((u > 0) ? u : -u) / 2];
+
+            //Apply the endomorphism if necessary
+            if(terms[i].endo)
+            {
+               EC_CHECK(ecCopy(&e, v));
+               EC_CHECK(ecMulMod(params, &e.x, &e.x, &beta));
+               v = &e;
+            }
+
+            //Add or subtract the odd multiple
+            if(u > 0)
+            {
+               EC_CHECK(ecFullAdd(params, &q, &q, v));
+            }
+            else
+            {
+               EC_CHECK(ecFullSub(params, &q, &q, v));
+            }
+         }
+      }
+   }
+
+   //Copy the result
+   EC_CHECK(ecCopy(r, &q));
+
+end:
+   //Release multiple precision integer
+   mpiFree(&beta);
+   //Release EC points
+   ecFree(&q);
+   ecFree(&e);
+
+   for(i = 0; i < EC_WNAF_MAX_TERMS; i++)
+   {
+      for(j = 0; j < arraysize(t[i]); j++)
+      {
+         ecFree(&t[i][j]);
+      }
+   }
+
+   //Release NAF representations
+   if(buffer != NULL)
+   {
+      cryptoFreeMem(buffer);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Twin multiplication using precomputed tables
+ *
+ * Each point is given either directly, in which case its odd multiples are
+ * computed on the fly using a window of EC_MULT_WINDOW_SIZE bits, or
+ * through a precomputed table
+ *
+ * @param[in] params EC domain parameters
+ * @param[out] r Resulting point R = d0.S + d1.T
+ * @param[in] d0 An integer d such as 0 <= d0 < p
+ * @param[in] s EC point (ignored if a table is provided)
+ * @param[in] t0 Odd multiples of S (optional parameter)
+ * @param[in] d1 An integer d such as 0 <= d1 < p
+ * @param[in] t EC point (ignored if a table is provided)
+ * @param[in] t1 Odd multiples of T (optional parameter)
+ * @return Error code
+ **/
+
+error_t ecWnafTwinMult(const EcDomainParameters *params, EcPoint *r,
+   const Mpi *d0, const EcPoint *s, const EcWnafTable *t0,
+   const Mpi *d1, const EcPoint *t, const EcWnafTable *t1)
+{
+   error_t error;
+   uint_t i;
+   uint_t n;
+   Mpi k[4];
+   EcWnafTerm terms[4];
+
+   //Check parameters
+   if(params == NULL || r == NULL || d0 == NULL || d1 == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The scalars must be non-negative integers
+   if(d0->sign < 0 || d1->sign < 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Initialize multiple precision integers
+   for(i = 0; i < arraysize(k); i++)
+   {
+      mpiInit(&k[i]);
+   }
+
+   //Set up the terms of the multiplication
+   error = ecWnafTwinTerms(params, terms, &n, k, d0, s, t0, d1, t, t1);
+
+   //Check status code
+   if(!error)
+   {
+      //Compute R = d0.S + d1.T
+      error = ecWnafMultiMult(params, r, terms, n);
+   }
+
+   //Release multiple precision integers
+   for(i = 0; i < arraysize(k); i++)
+   {
+      mpiFree(&k[i]);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+
+/**
+ * @brief Compute the odd multiples of an EC point (fixed-width field
+ *   arithmetic)
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] t Resulting points T[i] = (2i + 1).S, in affine coordinates
+ * @param[in] n Number of points to compute
+ * @param[in] s EC point
+ * @return Error code
+ **/
+
+static error_t ecWnafPrecomputeFixed(const EcFixedCurve *curve,
+   EcFixedPoint *t, uint_t n, const EcPoint *s)
+{
+   error_t error;
+
+   //Import the point S
+   error = ecFixedImport(curve, &t[0], s);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Compute T[i] = (2i + 1).S
+   ecFixedPrecompute(curve, t, n);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Multi-scalar multiplication using precomputed tables (fixed-width
+ *   field arithmetic)
+ * @param[in] params EC domain parameters
+ * @param[out] r Resulting point R = d[0].S[0] + ... + d[n-1].S[n-1]
+ * @param[in] terms Terms of the multi-scalar multiplication
+ * @param[in] n Number of terms (1 <= n <= EC_WNAF_MAX_TERMS)
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+error_t ecWnafMultiMultFixed(const EcDomainParameters *params, EcPoint *r,
+   const EcWnafTerm *terms, uint_t n)
+{
+   error_t error;
+   EcFixedCurve curve;
+   EcFixedPoint q;
+
+   //Load curve parameters
+   error = ecFixedInit(&curve, params);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Compute Q = d[0].S[0] + ... + d[n-1].S[n-1]
+   error = ecWnafMultiMultFixedPoint(params, &curve, &q, terms, n);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Convert the result to projective representation
+   return ecFixedExport(&curve, r, &q);
+}
+
+
+/**
+ * @brief Multi-scalar multiplication using precomputed tables (fixed-width
+ *   representation)
+ *
+ * A term whose table only provides the fixed-width representation of the
+ * odd multiples (points set to NULL) is accepted, so that the operation
+ * can be carried out without converting any point to projective
+ * representation
+ *
+ * @param[in] params EC domain parameters
+ * @param[in] curve Curve parameters in fixed-width representation
+ * @param[out] r Resulting point R = d[0].S[0] + ... + d[n-1].S[n-1]
+ * @param[in] terms Terms of the multi-scalar multiplication
+ * @param[in] n Number of terms (1 <= n <= EC_WNAF_MAX_TERMS)
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+error_t ecWnafMultiMultFixedPoint(const EcDomainParameters *params,
+   const EcFixedCurve *curve, EcFixedPoint *r, const EcWnafTerm *terms,
+   uint_t n)
+{
+   error_t error;
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   int_t u;
+   uint_t w[EC_WNAF_MAX_TERMS];
+   uint_t len[EC_WNAF_MAX_TERMS];
+   const EcFixedPoint *p[EC_WNAF_MAX_TERMS];
+   const EcFixedPoint *v;
+   const EcGlvParams *glv;
+   Mpi beta;
+   EcFixedPoint e;
+   MpiFixedWord betaMont[EC_FIXED_MAX_WORDS];
+   EcFixedPoint t[EC_WNAF_MAX_TERMS][1 << (EC_MULT_WINDOW_SIZE - 2)];
+   int8_t naf[EC_WNAF_MAX_TERMS][EC_FIXED_MAX_WORDS * MPI_FIXED_WORD_SIZE + 1];
+
+   //Check the number of terms
+   if(n < 1 || n > EC_WNAF_MAX_TERMS)
+      return ERROR_INVALID_PARAMETER;
+
+   //The tables must be available in fixed-width representation, and the
+   //scalars that do not fit in a field element are handled by the generic
+   //implementation
+   for(i = 0; i < n; i++)
+   {
+      if(terms[i].table != NULL && terms[i].table->fixedPoints == NULL)
+         return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+      if(mpiGetBitLength(terms[i].d) >= sizeof(naf[i]))
+         return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+   }
+
+   //Initialize pointer
+   glv = NULL;
+
+   //Process each term
+   for(i = 0; i < n; i++)
+   {
+      //Retrieve the odd multiples of the point
+      if(terms[i].table != NULL)
+      {
+         p[i] = terms[i].table->fixedPoints;
+         w[i] = terms[i].table->w;
+      }
+      else if(i > 0 && terms[i].endo && terms[i - 1].table == NULL &&
+         terms[i - 1].s == terms[i].s)
+      {
+         p[i] = p[i - 1];
+         w[i] = w[i - 1];
+      }
+      else
+      {
+         error = ecWnafPrecomputeFixed(curve, t[i], arraysize(t[i]),
+            terms[i].s);
+         //Any error to report?
+         if(error)
+            return error;
+
+         p[i] = t[i];
+         w[i] = EC_MULT_WINDOW_SIZE;
+      }
+
+      //Compute the width-w NAF representation of |d|
+      len[i] = ecComputeWnaf(naf[i], terms[i].d, w[i]);
+
+      //Negative scalar?
+      if(terms[i].d->sign < 0)
+      {
+         for(j = 0; j < len[i]; j++)
+         {
+            naf[i][j] = -naf[i][j];
+         }
+      }
+
+      //The endomorphism phi(x, y) = (beta.x, y) is applied to the odd
+      //multiples on the fly
+      if(terms[i].endo && glv == NULL)
+      {
+         //Retrieve the endomorphism parameters
+         glv = ecGlvGetParams(params);
+         //Not supported by the curve?
+         if(glv == NULL)
+            return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+         //Initialize multiple precision integer
+         mpiInit(&beta);
+
+         //Load the cube root of unity beta
+         error = mpiImport(&beta, glv->beta, sizeof(glv->beta),
+            MPI_FORMAT_BIG_ENDIAN);
+
+         //Check status code
+         if(!error)
+         {
+            error = mpiFixedImport(betaMont, &beta, curve->n);
+         }
+
+         //Release multiple precision integer
+         mpiFree(&beta);
+
+         //Any error to report?
+         if(error)
+            return error;
+
+         //Convert beta to Montgomery representation
+         ecFixedMulMod(curve, betaMont, betaMont, curve->r2);
+      }
+   }
+
+   //Set R = (1, 1, 0)
+   osMemcpy(r->x, curve->one, curve->n * sizeof(MpiFixedWord));
+   osMemcpy(r->y, curve->one, curve->n * sizeof(MpiFixedWord));
+   osMemset(r->z, 0, curve->n * sizeof(MpiFixedWord));
+
+   //Length of the longest NAF representation
+   for(k = 0, i = 0; i < n; i++)
+   {
+      k = MAX(k, len[i]);
+   }
+
+   //The doublings are shared between all the scalars
+   for(; k > 0; k--)
+   {
+      //Point doubling
+      ecFixedDouble(curve, r, r);
+
+      //Process the current digit of each scalar
+      for(i = 0; i < n; i++)
+      {
+         u = (k <= len[i]) ? naf[i][k - 1] : 0;
+
+         //Nonzero digit?
+         if(u != 0)
+         {
+            //Select the relevant odd multiple
+            v = &p[i][((u > 0) ? u : -u) / 2];
+
+            //Apply the endomorphism if necessary
+            if(terms[i].endo)
+            {
+               ecFixedMulMod(curve, e.x, v->x, betaMont);
+               osMemcpy(e.y, v->y, curve->n * sizeof(MpiFixedWord));
+               osMemcpy(e.z, v->z, curve->n * sizeof(MpiFixedWord));
+               v = &e;
+            }
+
+            //Add or subtract the odd multiple
+            if(u > 0)
+            {
+               ecFixedAdd(curve, r, r, v);
+            }
+            else
+            {
+               ecFixedSub(curve, r, r, v);
+            }
+         }
+      }
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Twin multiplication using precomputed tables (fixed-width field
+ *   arithmetic)
+ * @param[in] params EC domain parameters
+ * @param[out] r Resulting point R = d0.S + d1.T
+ * @param[in] d0 An integer d such as 0 <= d0 < p
+ * @param[in] s EC point (ignored if a table is provided)
+ * @param[in] t0 Odd multiples of S (optional parameter)
+ * @param[in] d1 An integer d such as 0 <= d1 < p
+ * @param[in] t EC point (ignored if a table is provided)
+ * @param[in] t1 Odd multiples of T (optional parameter)
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+error_t ecWnafTwinMultFixed(const EcDomainParameters *params, EcPoint *r,
+   const Mpi *d0, const EcPoint *s, const EcWnafTable *t0,
+   const Mpi *d1, const EcPoint *t, const EcWnafTable *t1)
+{
+   error_t error;
+   uint_t i;
+   uint_t n;
+   Mpi k[4];
+   EcWnafTerm terms[4];
+
+   //Negative scalars are handled by the generic implementation
+   if(d0->sign < 0 || d1->sign < 0)
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //Initialize multiple precision integers
+   for(i = 0; i < arraysize(k); i++)
+   {
+      mpiInit(&k[i]);
+   }
+
+   //Set up the terms of the multiplication
+   error = ecWnafTwinTerms(params, terms, &n, k, d0, s, t0, d1, t, t1);
+
+   //Check status code
+   if(!error)
+   {
+      //Compute R = d0.S + d1.T
+      error = ecWnafMultiMultFixed(params, r, terms, n);
+   }
+
+   //Release multiple precision integers
+   for(i = 0; i < arraysize(k); i++)
+   {
+      mpiFree(&k[i]);
+   }
+
+   //Return status code
+   return error;
+}
+
+#endif
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file ec_wnaf.h
+ * @brief Precomputed width-w NAF tables
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _EC_WNAF_H
+#define _EC_WNAF_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_fixed.h"
+
+//Width of the NAF window used by precomputed tables
+#ifndef EC_WNAF_TABLE_WIDTH
+   #define EC_WNAF_TABLE_WIDTH 6
+#elif (EC_WNAF_TABLE_WIDTH < 2 || EC_WNAF_TABLE_WIDTH > 8)
+   #error EC_WNAF_TABLE_WIDTH parameter is not valid
+#endif
+
+//Maximum number of terms in a multi-scalar multiplication
+#define EC_WNAF_MAX_TERMS 4
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Odd multiples of an EC point
+ **/
+
+typedef struct
+{
+   uint_t w;          ///<Width of the NAF window
+   EcPoint *points;   ///<Odd multiples (2i + 1).S in affine coordinates (2^(w - 2) entries)
+#if (EC_FIXED_SUPPORT == ENABLED)
+   EcFixedPoint *fixedPoints; ///<Same points in fixed-width representation
+#endif
+} EcWnafTable;
+
+
+/**
+ * @brief Term of a multi-scalar multiplication
+ **/
+
+typedef struct
+{
+   const Mpi *d;             ///<Scalar (may be negative)
+   const EcPoint *s;         ///<EC point (ignored if a table is provided)
+   const EcWnafTable *table; ///<Odd multiples of S (optional)
+   bool_t endo;              ///<Multiply phi(S) rather than S (GLV endomorphism)
+} EcWnafTerm;
+
+
+//Width-w NAF related functions
+void ecWnafInit(EcWnafTable *table);
+void ecWnafFree(EcWnafTable *table);
+
+error_t ecWnafBuild(const EcDomainParameters *params, EcWnafTable *table,
+   const EcPoint *s, uint_t w);
+
+void ecWnafSetTerm(EcWnafTerm *term, const Mpi *d, const EcPoint *s,
+   const EcWnafTable *table, bool_t endo);
+
+error_t ecWnafMultiMult(const EcDomainParameters *params, EcPoint *r,
+   const EcWnafTerm *terms, uint_t n);
+
+error_t ecWnafTwinMult(const EcDomainParameters *params, EcPoint *r,
+   const Mpi *d0, const EcPoint *s, const EcWnafTable *t0,
+   const Mpi *d1, const EcPoint *t, const EcWnafTable *t1);
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+
+error_t ecWnafMultiMultFixed(const EcDomainParameters *params, EcPoint *r,
+   const EcWnafTerm *terms, uint_t n);
+
+error_t ecWnafMultiMultFixedPoint(const EcDomainParameters *params,
+   const EcFixedCurve *curve, EcFixedPoint *r, const EcWnafTerm *terms,
+   uint_t n);
+
+error_t ecWnafTwinMultFixed(const EcDomainParameters *params, EcPoint *r,
+   const Mpi *d0, const EcPoint *s, const EcWnafTable *t0,
+   const Mpi *d1, const EcPoint *t, const EcWnafTable *t1);
+
+#endif
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,578 @@
+/**
+ * @file ec_workspace.c
+ * @brief Allocation-free EC operations
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * The generic ECDSA and ECDH implementations rely on multiple precision
+ * integers, which are grown and released by every arithmetic operation. In
+ * particular, each modular inversion performs hundreds of allocations. The
+ * routines provided here keep the coordinates, the scalars and the integers
+ * modulo q in fixed-size arrays held by a workspace, so that a complete
+ * signature generation, signature verification or key agreement runs
+ * without touching the heap. Multiple precision integers are only used at
+ * the API boundary
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_fixed.h"
+#include "ecc/ec_wnaf.h"
+#include "ecc/ec_comb.h"
+#include "ecc/ec_complete.h"
+#include "ecc/ec_glv.h"
+#include "ecc/ec_workspace.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (EC_SUPPORT == ENABLED && EC_WORKSPACE_SUPPORT == ENABLED)
+
+
+/**
+ * @brief Load a scalar in the format expected by the NAF recoding
+ * @param[in] ws Pointer to the workspace
+ * @param[in] index Index of the scalar
+ * @param[in] d Fixed-width integer
+ * @return Pointer to the resulting scalar
+ **/
+
+static const Mpi *ecWorkspaceLoadScalar(EcWorkspace *ws, uint_t index,
+   const MpiFixedWord *d)
+{
+   Mpi *k;
+
+   //Point to the scalar
+   k = &ws->k[index];
+
+   //The storage is large enough to hold any scalar, so that no memory is
+   //allocated by the conversion
+   mpiFixedExport(k, d, ws->order.n);
+
+   //Return a pointer to the scalar
+   return k;
+}
+
+
+/**
+ * @brief Initialize a workspace
+ * @param[out] ws Pointer to the workspace
+ * @param[in] params EC domain parameters
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+error_t ecWorkspaceInit(EcWorkspace *ws, const EcDomainParameters *params)
+{
+   error_t error;
+   uint_t i;
+
+#if (EC_GLV_SUPPORT == ENABLED)
+   //Curves with an efficiently computable endomorphism are handled by the
+   //GLV implementation
+   if(ecGlvGetParams(params) != NULL)
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+#endif
+
+   //Load the prime modulus
+   error = ecFixedInit(&ws->curve, params);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Load the order of the base point
+   error = ecFixedInitOrder(&ws->order, params);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //The x-coordinate of a point is reduced modulo q
+   if(ws->order.n != ws->curve.n)
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //Save EC domain parameters
+   ws->params = params;
+
+   //Attach the scalars to their storage
+   for(i = 0; i < EC_WORKSPACE_SCALARS; i++)
+   {
+      ws->k[i].sign = 1;
+      ws->k[i].size = EC_WORKSPACE_SCALAR_SIZE;
+      ws->k[i].data = ws->buffer[i];
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Import an integer modulo q
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting fixed-width integer
+ * @param[in] a An integer such as 0 <= A < q
+ * @return Error code
+ **/
+
+error_t ecWorkspaceImportScalar(EcWorkspace *ws, MpiFixedWord *r,
+   const Mpi *a)
+{
+   error_t error;
+
+   //The integer must be positive
+   if(a->sign < 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Import the integer
+   error = mpiFixedImport(r, a, ws->order.n);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Make sure A < q
+   if(mpiFixedComp(r, ws->order.p, ws->order.n) >= 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Convert a message digest to an integer modulo q
+ *
+ * The leftmost N bits of the digest are kept, where N is the bit length of
+ * q, and the resulting value is reduced modulo q
+ *
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting fixed-width integer
+ * @param[in] digest Message digest
+ * @param[in] digestLen Length in octets of the digest
+ * @return Error code
+ **/
+
+error_t ecWorkspaceImportDigest(EcWorkspace *ws, MpiFixedWord *r,
+   const uint8_t *digest, size_t digestLen)
+{
+   error_t error;
+   uint_t i;
+   uint_t k;
+   uint_t n;
+
+   //Let N be the bit length of q
+   n = mpiGetBitLength(&ws->params->q);
+   //Compute N = MIN(N, outlen)
+   n = MIN(n, digestLen * 8);
+
+   //Convert the digest to a fixed-width integer
+   error = mpiFixedImportRaw(r, ws->order.n, digest, (n + 7) / 8);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Keep the leftmost N bits of the hash value
+   if((n % 8) != 0)
+   {
+      //Number of bits to discard
+      k = 8 - (n % 8);
+
+      for(i = 0; i < (ws->order.n - 1); i++)
+      {
+         r[i] = (r[i] >> k) | (r[i + 1] << (MPI_FIXED_WORD_SIZE - k));
+      }
+
+      r[i] >>= k;
+   }
+
+   //The resulting value is less than 2q, hence a single subtraction is
+   //enough to reduce it modulo q
+   if(mpiFixedComp(r, ws->order.p, ws->order.n) >= 0)
+   {
+      ecFixedSubMod(&ws->order, r, r, ws->order.p);
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Generate a random integer such as 0 < R < q
+ *
+ * Candidates of the same bit length as q are drawn until one of them falls
+ * in the expected range
+ *
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting fixed-width integer
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @return Error code
+ **/
+
+error_t ecWorkspaceRandScalar(EcWorkspace *ws, MpiFixedWord *r,
+   const PrngAlgo *prngAlgo, void *prngContext)
+{
+   error_t error;
+   uint_t n;
+   size_t length;
+   uint8_t buffer[EC_FIXED_MAX_WORDS * sizeof(MpiFixedWord)];
+
+   //Get the bit length of q
+   n = mpiGetBitLength(&ws->params->q);
+   //Length of the candidates, in octets
+   length = (n + 7) / 8;
+
+   //Generate candidates until one of them is acceptable
+   do
+   {
+      //Generate a random octet string
+      error = prngAlgo->read(prngContext, buffer, length);
+      //Any error to report?
+      if(error)
+         break;
+
+      //Discard the excess bits of the leading octet
+      if((n % 8) != 0)
+      {
+         buffer[0] &= (1 << (n % 8)) - 1;
+      }
+
+      //Convert the octet string to a fixed-width integer
+      error = mpiFixedImportRaw(r, ws->order.n, buffer, length);
+      //Any error to report?
+      if(error)
+         break;
+
+      //Reject the candidate unless 0 < R < q
+   } while(ecFixedIsZero(&ws->order, r) ||
+      mpiFixedComp(r, ws->order.p, ws->order.n) >= 0);
+
+   //Erase the random octet string
+   osMemset(buffer, 0, sizeof(buffer));
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Modular addition
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting integer R = (A + B) mod q
+ * @param[in] a An integer such as 0 <= A < q
+ * @param[in] b An integer such as 0 <= B < q
+ **/
+
+void ecWorkspaceAddMod(EcWorkspace *ws, MpiFixedWord *r,
+   const MpiFixedWord *a, const MpiFixedWord *b)
+{
+   ecFixedAddMod(&ws->order, r, a, b);
+}
+
+
+/**
+ * @brief Modular multiplication
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting integer R = (A * B) mod q
+ * @param[in] a An integer such as 0 <= A < q
+ * @param[in] b An integer such as 0 <= B < q
+ **/
+
+void ecWorkspaceMulMod(EcWorkspace *ws, MpiFixedWord *r,
+   const MpiFixedWord *a, const MpiFixedWord *b)
+{
+   MpiFixedWord t[EC_FIXED_MAX_WORDS];
+
+   //Compute T = A * 2^(n * w) mod q
+   ecFixedMulMod(&ws->order, t, a, ws->order.r2);
+   //The Montgomery factor cancels out, so that R = A * B mod q
+   ecFixedMulMod(&ws->order, r, t, b);
+}
+
+
+/**
+ * @brief Modular inversion
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting integer R = A^-1 mod q
+ * @param[in] a An integer such as 0 < A < q
+ **/
+
+void ecWorkspaceInvMod(EcWorkspace *ws, MpiFixedWord *r,
+   const MpiFixedWord *a)
+{
+   MpiFixedWord t[EC_FIXED_MAX_WORDS];
+   MpiFixedWord u[EC_FIXED_MAX_WORDS];
+
+   //Convert A to Montgomery representation
+   ecFixedMulMod(&ws->order, t, a, ws->order.r2);
+   //Since q is prime, the inverse is computed as A^(q - 2) mod q
+   ecFixedInvMod(&ws->order, t, t);
+
+   //Let U = 1
+   osMemset(u, 0, ws->order.n * sizeof(MpiFixedWord));
+   u[0] = 1;
+
+   //Convert the result back from Montgomery representation
+   ecFixedMulMod(&ws->order, r, t, u);
+}
+
+
+/**
+ * @brief Reduce an integer modulo q
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting integer R = A mod q
+ * @param[in] a An integer such as 0 <= A < p
+ **/
+
+void ecWorkspaceReduce(EcWorkspace *ws, MpiFixedWord *r,
+   const MpiFixedWord *a)
+{
+   //Copy the integer
+   osMemcpy(r, a, ws->order.n * sizeof(MpiFixedWord));
+
+   //Subtract q as many times as necessary (once at most for curves whose
+   //cofactor is 1)
+   while(mpiFixedComp(r, ws->order.p, ws->order.n) >= 0)
+   {
+      ecFixedSubMod(&ws->order, r, r, ws->order.p);
+   }
+}
+
+
+/**
+ * @brief Import an EC point given in affine coordinates
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting point (Montgomery representation)
+ * @param[in] s Affine representation of the point (the z-coordinate is
+ *   ignored)
+ * @return Error code
+ **/
+
+error_t ecWorkspaceImportPoint(EcWorkspace *ws, EcFixedPoint *r,
+   const EcPoint *s)
+{
+   error_t error;
+
+   //The coordinates must be positive
+   if(s->x.sign < 0 || s->y.sign < 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Import the x-coordinate
+   error = mpiFixedImport(r->x, &s->x, ws->curve.n);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Import the y-coordinate
+   error = mpiFixedImport(r->y, &s->y, ws->curve.n);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Verify that 0 <= Sx < p and 0 <= Sy < p
+   if(mpiFixedComp(r->x, ws->curve.p, ws->curve.n) >= 0 ||
+      mpiFixedComp(r->y, ws->curve.p, ws->curve.n) >= 0)
+   {
+      return ERROR_INVALID_PARAMETER;
+   }
+
+   //Convert the coordinates to Montgomery representation
+   ecFixedMulMod(&ws->curve, r->x, r->x, ws->curve.r2);
+   ecFixedMulMod(&ws->curve, r->y, r->y, ws->curve.r2);
+
+   //Set Rz = 1
+   osMemcpy(r->z, ws->curve.one, ws->curve.n * sizeof(MpiFixedWord));
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Recover the affine x-coordinate of an EC point
+ * @param[in] ws Pointer to the workspace
+ * @param[out] x Affine x-coordinate (0 <= x < p)
+ * @param[in] s EC point (Montgomery representation)
+ * @return Error code
+ **/
+
+error_t ecWorkspaceGetAffineX(EcWorkspace *ws, MpiFixedWord *x,
+   const EcFixedPoint *s)
+{
+   MpiFixedWord t[EC_FIXED_MAX_WORDS];
+   MpiFixedWord u[EC_FIXED_MAX_WORDS];
+
+   //Point at the infinity?
+   if(ecFixedIsZero(&ws->curve, s->z))
+      return ERROR_INVALID_PARAMETER;
+
+   //Compute T = 1 / Sz^2
+   ecFixedInvMod(&ws->curve, t, s->z);
+   ecFixedSqrMod(&ws->curve, t, t);
+   //Compute T = Sx / Sz^2
+   ecFixedMulMod(&ws->curve, t, t, s->x);
+
+   //Let U = 1
+   osMemset(u, 0, ws->curve.n * sizeof(MpiFixedWord));
+   u[0] = 1;
+
+   //Convert the result back from Montgomery representation
+   ecFixedMulMod(&ws->curve, x, t, u);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Fixed-base scalar multiplication
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting point R = d.G
+ * @param[in] d An integer d such as 0 <= d < q
+ * @return Error code
+ **/
+
+error_t ecWorkspaceMultBase(EcWorkspace *ws, EcFixedPoint *r,
+   const MpiFixedWord *d)
+{
+   error_t error;
+   const Mpi *k;
+
+   //Load the scalar
+   k = ecWorkspaceLoadScalar(ws, 0, d);
+
+#if (EC_COMB_SUPPORT == ENABLED)
+   //Precomputed multiples of G available?
+   if(ws->params->comb != NULL)
+   {
+      //Use the comb method
+      return ecCombMultFixedPoint(&ws->curve, ws->params->comb, r, k);
+   }
+#endif
+
+   //Import the base point G
+   error = ecFixedImport(&ws->curve, &ws->t[0], &ws->params->g);
+   //Any error to report?
+   if(error)
+      return error;
+
+#if (EC_COMPLETE_SUPPORT == ENABLED)
+   //Use the complete addition formulas on curves with a = -3
+   if(ws->curve.aType == EC_FIXED_COEF_A_MINUS_3)
+   {
+      return ecCompleteMultPoint(&ws->curve, r, k, &ws->t[0]);
+   }
+#endif
+
+   //Compute R = d.G
+   return ecFixedMultPoint(&ws->curve, r, k, &ws->t[0]);
+}
+
+
+/**
+ * @brief Scalar multiplication
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting point R = d.S
+ * @param[in] d An integer d such as 0 <= d < q
+ * @param[in] s EC point
+ * @return Error code
+ **/
+
+error_t ecWorkspaceMult(EcWorkspace *ws, EcFixedPoint *r,
+   const MpiFixedWord *d, const EcFixedPoint *s)
+{
+   const Mpi *k;
+
+   //Load the scalar
+   k = ecWorkspaceLoadScalar(ws, 0, d);
+
+#if (EC_COMPLETE_SUPPORT == ENABLED)
+   //Use the complete addition formulas on curves with a = -3
+   if(ws->curve.aType == EC_FIXED_COEF_A_MINUS_3)
+   {
+      return ecCompleteMultPoint(&ws->curve, r, k, s);
+   }
+#endif
+
+   //Compute R = d.S
+   return ecFixedMultPoint(&ws->curve, r, k, s);
+}
+
+
+/**
+ * @brief Twin multiplication involving the base point
+ * @param[in] ws Pointer to the workspace
+ * @param[out] r Resulting point R = d0.G + d1.T
+ * @param[in] d0 An integer d such as 0 <= d0 < q
+ * @param[in] d1 An integer d such as 0 <= d1 < q
+ * @param[in] t EC point
+ * @return Error code
+ **/
+
+error_t ecWorkspaceTwinMult(EcWorkspace *ws, EcFixedPoint *r,
+   const MpiFixedWord *d0, const MpiFixedWord *d1, const EcFixedPoint *t)
+{
+   const EcWnafTable *t0;
+   EcWnafTable t1;
+   EcWnafTerm terms[2];
+
+   //Initialize pointer
+   t0 = NULL;
+
+#if (EC_COMB_SUPPORT == ENABLED)
+   //Odd multiples of G available?
+   if(ws->params->comb != NULL && ws->params->comb->wnaf.fixedPoints != NULL)
+   {
+      t0 = &ws->params->comb->wnaf;
+   }
+#endif
+
+   //Precompute the odd multiples of T in the workspace
+   ws->t[0] = *t;
+   ecFixedPrecompute(&ws->curve, ws->t, arraysize(ws->t));
+
+   //The table only provides the fixed-width representation of the points
+   t1.w = EC_MULT_WINDOW_SIZE;
+   t1.points = NULL;
+   t1.fixedPoints = ws->t;
+
+   //Set up the terms of the multiplication
+   ecWnafSetTerm(&terms[0], ecWorkspaceLoadScalar(ws, 0, d0),
+      &ws->params->g, t0, FALSE);
+
+   ecWnafSetTerm(&terms[1], ecWorkspaceLoadScalar(ws, 1, d1), NULL, &t1,
+      FALSE);
+
+   //Compute R = d0.G + d1.T
+   return ecWnafMultiMultFixedPoint(ws->params, &ws->curve, r, terms, 2);
+}
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * @file ec_workspace.h
+ * @brief Allocation-free EC operations
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _EC_WORKSPACE_H
+#define _EC_WORKSPACE_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_fixed.h"
+
+//Allocation-free EC operations support
+#ifndef EC_WORKSPACE_SUPPORT
+   #if (EC_FIXED_SUPPORT == ENABLED)
+      #define EC_WORKSPACE_SUPPORT ENABLED
+   #else
+      #define EC_WORKSPACE_SUPPORT DISABLED
+   #endif
+#elif (EC_WORKSPACE_SUPPORT != ENABLED && EC_WORKSPACE_SUPPORT != DISABLED)
+   #error EC_WORKSPACE_SUPPORT parameter is not valid
+#elif (EC_WORKSPACE_SUPPORT == ENABLED && EC_FIXED_SUPPORT != ENABLED)
+   #error EC_WORKSPACE_SUPPORT requires EC_FIXED_SUPPORT
+#endif
+
+//Number of scalars held by a workspace
+#define EC_WORKSPACE_SCALARS 2
+
+//Size of a scalar, in words
+#define EC_WORKSPACE_SCALAR_SIZE (EC_FIXED_MAX_WORDS * sizeof(MpiFixedWord) / MPI_INT_SIZE)
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief EC workspace
+ *
+ * The workspace holds everything an ECDSA or ECDH operation needs, sized
+ * for the largest enabled curve, so that it can be declared on the stack
+ * and no memory is allocated from the heap. The scalars are backed by the
+ * workspace itself and must never be released nor resized
+ *
+ **/
+
+typedef struct
+{
+   const EcDomainParameters *params;                         ///<EC domain parameters
+   EcFixedCurve curve;                                       ///<Arithmetic modulo p
+   EcFixedCurve order;                                       ///<Arithmetic modulo q
+   EcFixedPoint t[1 << (EC_MULT_WINDOW_SIZE - 2)];           ///<Odd multiples of the variable point
+   uint_t buffer[EC_WORKSPACE_SCALARS][EC_WORKSPACE_SCALAR_SIZE]; ///<Storage of the scalars
+   Mpi k[EC_WORKSPACE_SCALARS];                              ///<Scalars
+} EcWorkspace;
+
+
+//EC workspace related functions
+error_t ecWorkspaceInit(EcWorkspace *ws, const EcDomainParameters *params);
+
+error_t ecWorkspaceImportScalar(EcWorkspace *ws, MpiFixedWord *r,
+   const Mpi *a);
+
+error_t ecWorkspaceImportDigest(EcWorkspace *ws, MpiFixedWord *r,
+   const uint8_t *digest, size_t digestLen);
+
+error_t ecWorkspaceRandScalar(EcWorkspace *ws, MpiFixedWord *r,
+   const PrngAlgo *prngAlgo, void *prngContext);
+
+void ecWorkspaceAddMod(EcWorkspace *ws, MpiFixedWord *r,
+   const MpiFixedWord *a, const MpiFixedWord *b);
+
+void ecWorkspaceMulMod(EcWorkspace *ws, MpiFixedWord *r,
+   const MpiFixedWord *a, const MpiFixedWord *b);
+
+void ecWorkspaceInvMod(EcWorkspace *ws, MpiFixedWord *r,
+   const MpiFixedWord *a);
+
+void ecWorkspaceReduce(EcWorkspace *ws, MpiFixedWord *r,
+   const MpiFixedWord *a);
+
+error_t ecWorkspaceImportPoint(EcWorkspace *ws, EcFixedPoint *r,
+   const EcPoint *s);
+
+error_t ecWorkspaceGetAffineX(EcWorkspace *ws, MpiFixedWord *x,
+   const EcFixedPoint *s);
+
+error_t ecWorkspaceMultBase(EcWorkspace *ws, EcFixedPoint *r,
+   const MpiFixedWord *d);
+
+error_t ecWorkspaceMult(EcWorkspace *ws, EcFixedPoint *r,
+   const MpiFixedWord *d, const EcFixedPoint *s);
+
+error_t ecWorkspaceTwinMult(EcWorkspace *ws, EcFixedPoint *r,
+   const MpiFixedWord *d0, const MpiFixedWord *d1, const EcFixedPoint *t);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
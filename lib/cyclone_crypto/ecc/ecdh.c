@@ -34,6 +34,7 @@
 //Dependencies
 #include "core/crypto.h"
 #include "ecc/ecdh.h"
+#include "ecc/ec_workspace.h"
 #include "debug.h"
 
 //Check crypto library configuration
@@ -49,6 +50,7 @@ void ecdhInit(EcdhContext *context)
 {
    //Initialize EC domain parameters
    ecInitDomainParameters(&context->params);
+   context->sharedParams = NULL;
 
    //Initialize private and public keys
    ecInitPrivateKey(&context->da);
@@ -64,8 +66,10 @@ void ecdhInit(EcdhContext *context)
 
 void ecdhFree(EcdhContext *context)
 {
-   //Release EC domain parameters
+   //Release EC domain parameters (the shared parameters are owned by
+   //the registry)
    ecFreeDomainParameters(&context->params);
+   context->sharedParams = NULL;
 
    //Release private and public keys
    ecFreePrivateKey(&context->da);
@@ -74,6 +78,69 @@ void ecdhFree(EcdhContext *context)
 }
 
 
+/**
+ * @brief Select the elliptic curve to be used
+ *
+ * The shared EC domain parameters are used whenever a registry has been
+ * registered. Otherwise, the domain parameters are loaded into the context
+ *
+ * @param[in] context Pointer to the ECDH context
+ * @param[in] curveInfo Elliptic curve parameters
+ * @return Error code
+ **/
+
+error_t ecdhSetCurve(EcdhContext *context, const EcCurveInfo *curveInfo)
+{
+   error_t error;
+   const EcDomainParameters *params;
+
+   //Check parameters
+   if(context == NULL || curveInfo == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Retrieve EC domain parameters
+   error = ecGetDomainParameters(curveInfo, &context->params, &params);
+
+   //Check status code
+   if(!error)
+   {
+      //Shared EC domain parameters?
+      if(params != &context->params)
+      {
+         context->sharedParams = params;
+      }
+      else
+      {
+         context->sharedParams = NULL;
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Get the EC domain parameters used by an ECDH context
+ * @param[in] context Pointer to the ECDH context
+ * @return Pointer to the EC domain parameters
+ **/
+
+const EcDomainParameters *ecdhGetDomainParameters(const EcdhContext *context)
+{
+   //Shared EC domain parameters take precedence over the ones loaded in
+   //the context
+   if(context->sharedParams != NULL)
+   {
+      return context->sharedParams;
+   }
+   else
+   {
+      return &context->params;
+   }
+}
+
+
 /**
  * @brief ECDH key pair generation
  * @param[in] context Pointer to the ECDH context
@@ -86,26 +153,30 @@ error_t ecdhGenerateKeyPair(EcdhContext *context, const PrngAlgo *prngAlgo,
    void *prngContext)
 {
    error_t error;
+   const EcDomainParameters *params;
+
+   //Point to the EC domain parameters
+   params = ecdhGetDomainParameters(context);
 
    //Debug message
    TRACE_DEBUG("Generating ECDH key pair...\r\n");
 
    //Weierstrass elliptic curve?
-   if(context->params.type == EC_CURVE_TYPE_SECT_K1 ||
-      context->params.type == EC_CURVE_TYPE_SECT_R1 ||
-      context->params.type == EC_CURVE_TYPE_SECT_R2 ||
-      context->params.type == EC_CURVE_TYPE_SECP_K1 ||
-      context->params.type == EC_CURVE_TYPE_SECP_R1 ||
-      context->params.type == EC_CURVE_TYPE_SECP_R2 ||
-      context->params.type == EC_CURVE_TYPE_BRAINPOOLP_R1)
+   if(params->type == EC_CURVE_TYPE_SECT_K1 ||
+      params->type == EC_CURVE_TYPE_SECT_R1 ||
+      params->type == EC_CURVE_TYPE_SECT_R2 ||
+      params->type == EC_CURVE_TYPE_SECP_K1 ||
+      params->type == EC_CURVE_TYPE_SECP_R1 ||
+      params->type == EC_CURVE_TYPE_SECP_R2 ||
+      params->type == EC_CURVE_TYPE_BRAINPOOLP_R1)
    {
       //Generate an EC key pair
-      error = ecGenerateKeyPair(prngAlgo, prngContext, &context->params,
+      error = ecGenerateKeyPair(prngAlgo, prngContext, params,
          &context->da, &context->qa);
    }
 #if (X25519_SUPPORT == ENABLED)
    //Curve25519 elliptic curve?
-   else if(context->params.type == EC_CURVE_TYPE_X25519)
+   else if(params->type == EC_CURVE_TYPE_X25519)
    {
       uint8_t da[CURVE25519_BYTE_LEN];
       uint8_t qa[CURVE25519_BYTE_LEN];
@@ -122,7 +193,7 @@ error_t ecdhGenerateKeyPair(EcdhContext *context, const PrngAlgo *prngAlgo,
          TRACE_DEBUG_ARRAY("    ", da, CURVE25519_BYTE_LEN);
 
          //Get the u-coordinate of the base point
-         error = mpiExport(&context->params.g.x, g, CURVE25519_BYTE_LEN,
+         error = mpiExport(&params->g.x, g, CURVE25519_BYTE_LEN,
             MPI_FORMAT_LITTLE_ENDIAN);
       }
 
@@ -156,7 +227,7 @@ error_t ecdhGenerateKeyPair(EcdhContext *context, const PrngAlgo *prngAlgo,
 #endif
 #if (X448_SUPPORT == ENABLED)
    //Curve448 elliptic curve?
-   else if(context->params.type == EC_CURVE_TYPE_X448)
+   else if(params->type == EC_CURVE_TYPE_X448)
    {
       uint8_t da[CURVE448_BYTE_LEN];
       uint8_t qa[CURVE448_BYTE_LEN];
@@ -173,7 +244,7 @@ error_t ecdhGenerateKeyPair(EcdhContext *context, const PrngAlgo *prngAlgo,
          TRACE_DEBUG_ARRAY("    ", da, CURVE448_BYTE_LEN);
 
          //Get the u-coordinate of the base point
-         error = mpiExport(&context->params.g.x, g, CURVE448_BYTE_LEN,
+         error = mpiExport(&params->g.x, g, CURVE448_BYTE_LEN,
             MPI_FORMAT_LITTLE_ENDIAN);
       }
 
@@ -328,6 +399,87 @@ error_t ecdhCheckPublicKey(const EcDomainParameters *params, EcPoint *publicKey)
 }
 
 
+#if (EC_WORKSPACE_SUPPORT == ENABLED)
+
+/**
+ * @brief Compute ECDH shared secret (allocation-free implementation)
+ * @param[in] params EC domain parameters
+ * @param[in] privateKey Our private key
+ * @param[in] publicKey Peer's public key
+ * @param[out] output Buffer where to store the shared secret
+ * @param[in] length Length of the shared secret
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+static error_t ecdhComputeSharedSecretFixed(const EcDomainParameters *params,
+   const EcPrivateKey *privateKey, const EcPublicKey *publicKey,
+   uint8_t *output, size_t length)
+{
+   error_t error;
+   EcWorkspace ws;
+   EcFixedPoint qb;
+   EcFixedPoint z;
+   MpiFixedWord da[EC_FIXED_MAX_WORDS];
+   MpiFixedWord x[EC_FIXED_MAX_WORDS];
+
+   //Initialize the workspace
+   error = ecWorkspaceInit(&ws, params);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Import our private key
+   error = ecWorkspaceImportScalar(&ws, da, &privateKey->d);
+
+   //Check status code
+   if(!error)
+   {
+      //Import the peer's public key
+      error = ecWorkspaceImportPoint(&ws, &qb, &publicKey->q);
+   }
+
+   //Values that are not properly reduced are handled by the generic
+   //implementation
+   if(error)
+   {
+      //Erase the private key
+      osMemset(da, 0, sizeof(da));
+      osMemset(ws.buffer, 0, sizeof(ws.buffer));
+
+      //Report an error
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+   }
+
+   //Compute Z = da.Qb
+   error = ecWorkspaceMult(&ws, &z, da, &qb);
+
+   //Check status code
+   if(!error)
+   {
+      //Convert Z to affine representation
+      error = ecWorkspaceGetAffineX(&ws, x, &z);
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //The shared secret is the x-coordinate of Z
+      error = mpiFixedExportRaw(x, ws.curve.n, output, length);
+   }
+
+   //Erase the private key and the shared secret
+   osMemset(da, 0, sizeof(da));
+   osMemset(x, 0, sizeof(x));
+   osMemset(ws.buffer, 0, sizeof(ws.buffer));
+
+   //Return status code
+   return error;
+}
+
+#endif
+
+
 /**
  * @brief Compute ECDH shared secret
  * @param[in] context Pointer to the ECDH context
@@ -341,24 +493,28 @@ error_t ecdhComputeSharedSecret(EcdhContext *context,
    uint8_t *output, size_t outputSize, size_t *outputLen)
 {
    error_t error;
+   const EcDomainParameters *params;
+
+   //Point to the EC domain parameters
+   params = ecdhGetDomainParameters(context);
 
    //Debug message
    TRACE_DEBUG("Computing Diffie-Hellman shared secret...\r\n");
 
    //Weierstrass elliptic curve?
-   if(context->params.type == EC_CURVE_TYPE_SECT_K1 ||
-      context->params.type == EC_CURVE_TYPE_SECT_R1 ||
-      context->params.type == EC_CURVE_TYPE_SECT_R2 ||
-      context->params.type == EC_CURVE_TYPE_SECP_K1 ||
-      context->params.type == EC_CURVE_TYPE_SECP_R1 ||
-      context->params.type == EC_CURVE_TYPE_SECP_R2 ||
-      context->params.type == EC_CURVE_TYPE_BRAINPOOLP_R1)
+   if(params->type == EC_CURVE_TYPE_SECT_K1 ||
+      params->type == EC_CURVE_TYPE_SECT_R1 ||
+      params->type == EC_CURVE_TYPE_SECT_R2 ||
+      params->type == EC_CURVE_TYPE_SECP_K1 ||
+      params->type == EC_CURVE_TYPE_SECP_R1 ||
+      params->type == EC_CURVE_TYPE_SECP_R2 ||
+      params->type == EC_CURVE_TYPE_BRAINPOOLP_R1)
    {
       size_t k;
       EcPoint z;
 
       //Get the length in octets of the prime modulus
-      k = mpiGetByteLength(&context->params.p);
+      k = mpiGetByteLength(&params->p);
 
       //Make sure that the output buffer is large enough
       if(outputSize >= k)
@@ -366,35 +522,45 @@ error_t ecdhComputeSharedSecret(EcdhContext *context,
          //Length of the resulting shared secret
          *outputLen = k;
 
-         //Initialize EC points
-         ecInit(&z);
-
-         //Convert the peer's public key to projective representation
-         error = ecProjectify(&context->params, &context->qb.q, &context->qb.q);
+#if (EC_WORKSPACE_SUPPORT == ENABLED)
+         //Use the allocation-free implementation whenever the curve allows it
+         error = ecdhComputeSharedSecretFixed(params, &context->da,
+            &context->qb, output, k);
 
-         //Check status code
-         if(!error)
+         //Fall back to the generic implementation if necessary
+         if(error == ERROR_UNSUPPORTED_ELLIPTIC_CURVE)
+#endif
          {
-            //Compute Z = da.Qb
-            error = ecMult(&context->params, &z, &context->da.d, &context->qb.q);
-         }
+            //Initialize EC points
+            ecInit(&z);
 
-         //Check status code
-         if(!error)
-         {
-            //Convert Z to affine representation
-            error = ecAffinify(&context->params, &z, &z);
-         }
+            //Convert the peer's public key to projective representation
+            error = ecProjectify(params, &context->qb.q, &context->qb.q);
 
-         //Check status code
-         if(!error)
-         {
-            //The shared secret is the x-coordinate of Z
-            error = mpiExport(&z.x, output, k, MPI_FORMAT_BIG_ENDIAN);
-         }
+            //Check status code
+            if(!error)
+            {
+               //Compute Z = da.Qb
+               error = ecMult(params, &z, &context->da.d, &context->qb.q);
+            }
+
+            //Check status code
+            if(!error)
+            {
+               //Convert Z to affine representation
+               error = ecAffinify(params, &z, &z);
+            }
+
+            //Check status code
+            if(!error)
+            {
+               //The shared secret is the x-coordinate of Z
+               error = mpiExport(&z.x, output, k, MPI_FORMAT_BIG_ENDIAN);
+            }
 
-         //Release EC point
-         ecFree(&z);
+            //Release EC point
+            ecFree(&z);
+         }
       }
       else
       {
@@ -404,7 +570,7 @@ error_t ecdhComputeSharedSecret(EcdhContext *context,
    }
 #if (X25519_SUPPORT == ENABLED)
    //Curve25519 elliptic curve?
-   else if(context->params.type == EC_CURVE_TYPE_X25519)
+   else if(params->type == EC_CURVE_TYPE_X25519)
    {
       uint_t i;
       uint8_t mask;
@@ -463,7 +629,7 @@ error_t ecdhComputeSharedSecret(EcdhContext *context,
 #endif
 #if (X448_SUPPORT == ENABLED)
    //Curve448 elliptic curve?
-   else if(context->params.type == EC_CURVE_TYPE_X448)
+   else if(params->type == EC_CURVE_TYPE_X448)
    {
       uint_t i;
       uint8_t mask;
@@ -58,6 +58,7 @@ extern "C" {
 typedef struct
 {
    EcDomainParameters params; ///<EC domain parameters
+   const EcDomainParameters *sharedParams; ///<Shared EC domain parameters (optional)
    EcPrivateKey da;           ///<One's own EC private key
    EcPublicKey qa;            ///<One's own EC public key
    EcPublicKey qb;            ///<Peer's EC public key
@@ -68,6 +69,10 @@ typedef struct
 void ecdhInit(EcdhContext *context);
 void ecdhFree(EcdhContext *context);
 
+error_t ecdhSetCurve(EcdhContext *context, const EcCurveInfo *curveInfo);
+
+const EcDomainParameters *ecdhGetDomainParameters(const EcdhContext *context);
+
 error_t ecdhGenerateKeyPair(EcdhContext *context, const PrngAlgo *prngAlgo,
    void *prngContext);
 
@@ -34,6 +34,8 @@
 //Dependencies
 #include "core/crypto.h"
 #include "ecc/ecdsa.h"
+#include "ecc/ec_comb.h"
+#include "ecc/ec_workspace.h"
 #include "mpi/mpi.h"
 #include "encoding/asn1.h"
 #include "debug.h"
@@ -60,6 +62,11 @@ const uint8_t ECDSA_WITH_SHA3_384_OID[9] = {0x60, 0x86, 0x48, 0x01, 0x65, 0x03,
 //ECDSA with SHA-3-512 OID (2.16.840.1.101.3.4.3.12)
 const uint8_t ECDSA_WITH_SHA3_512_OID[9] = {0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0C};
 
+#if (ECDSA_NONCE_POOL_SUPPORT == ENABLED)
+//Registered pool of precomputed nonces
+static EcdsaNoncePool *ecdsaNoncePool = NULL;
+#endif
+
 
 /**
  * @brief Initialize an ECDSA signature
@@ -377,8 +384,233 @@ error_t ecdsaReadSignature(const uint8_t *data, size_t length,
 }
 
 
+/**
+ * @brief Generate a per-message secret and the matching r component
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @param[in] params EC domain parameters
+ * @param[out] kinv Inverse of the per-message secret k
+ * @param[out] r Resulting value r = x1 mod q, where (x1, y1) = k.G
+ * @return Error code
+ **/
+
+static error_t ecdsaComputeNonce(const PrngAlgo *prngAlgo, void *prngContext,
+   const EcDomainParameters *params, Mpi *kinv, Mpi *r)
+{
+   error_t error;
+   Mpi k;
+   EcPoint r1;
+
+   //Initialize multiple precision integer
+   mpiInit(&k);
+   //Initialize EC point
+   ecInit(&r1);
+
+   //Generate a random number k such as 0 < k < q - 1
+   MPI_CHECK(mpiRandRange(&k, &params->q, prngAlgo, prngContext));
+
+   //Debug message
+   TRACE_DEBUG("  k:\r\n");
+   TRACE_DEBUG_MPI("    ", &k);
+
+   //Compute R1 = (x1, y1) = k.G
+   EC_CHECK(ecMult(params, &r1, &k, &params->g));
+   EC_CHECK(ecAffinify(params, &r1, &r1));
+
+   //Debug message
+   TRACE_DEBUG("  x1:\r\n");
+   TRACE_DEBUG_MPI("    ", &r1.x);
+   TRACE_DEBUG("  y1:\r\n");
+   TRACE_DEBUG_MPI("    ", &r1.y);
+
+   //Compute r = x1 mod q
+   MPI_CHECK(mpiMod(r, &r1.x, &params->q));
+
+   //Compute k ^ -1 mod q
+   MPI_CHECK(mpiInvMod(kinv, &k, &params->q));
+
+end:
+   //Release multiple precision integer
+   mpiFree(&k);
+   //Release EC point
+   ecFree(&r1);
+
+   //Return status code
+   return error;
+}
+
+
+#if (ECDSA_NONCE_POOL_SUPPORT == ENABLED)
+
+/**
+ * @brief Take a precomputed nonce from the registered pool
+ * @param[in] params EC domain parameters
+ * @param[out] kinv Inverse of the per-message secret k
+ * @param[out] r Value r = x1 mod q, where (x1, y1) = k.G
+ * @return Error code (ERROR_BUFFER_EMPTY if no nonce is available for
+ *   the specified curve)
+ **/
+
+static error_t ecdsaTakeNonce(const EcDomainParameters *params, Mpi *kinv,
+   Mpi *r)
+{
+   //No pool, or pool dedicated to another curve?
+   if(ecdsaNoncePool == NULL || params->name == NULL ||
+      osStrcmp(ecdsaNoncePool->name, params->name) ||
+      mpiComp(&ecdsaNoncePool->p, &params->p))
+   {
+      return ERROR_BUFFER_EMPTY;
+   }
+
+   //Take the most recently computed nonce
+   return signNoncePoolTake(&ecdsaNoncePool->pool, kinv, r);
+}
+
+#endif
+
+
+#if (EC_WORKSPACE_SUPPORT == ENABLED)
+
+/**
+ * @brief ECDSA signature generation (allocation-free implementation)
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @param[in] params EC domain parameters
+ * @param[in] privateKey Signer's EC private key
+ * @param[in] digest Digest of the message to be signed
+ * @param[in] digestLen Length in octets of the digest
+ * @param[out] signature (R, S) integer pair
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+static error_t ecdsaGenerateSignatureFixed(const PrngAlgo *prngAlgo,
+   void *prngContext, const EcDomainParameters *params,
+   const EcPrivateKey *privateKey, const uint8_t *digest, size_t digestLen,
+   EcdsaSignature *signature)
+{
+   error_t error;
+   EcWorkspace ws;
+   EcFixedPoint r1;
+   MpiFixedWord d[EC_FIXED_MAX_WORDS];
+   MpiFixedWord k[EC_FIXED_MAX_WORDS];
+   MpiFixedWord kinv[EC_FIXED_MAX_WORDS];
+   MpiFixedWord r[EC_FIXED_MAX_WORDS];
+   MpiFixedWord s[EC_FIXED_MAX_WORDS];
+   MpiFixedWord z[EC_FIXED_MAX_WORDS];
+
+   //Initialize the workspace
+   error = ecWorkspaceInit(&ws, params);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Private keys that are not reduced modulo q are handled by the generic
+   //implementation
+   if(ecWorkspaceImportScalar(&ws, d, &privateKey->d))
+   {
+      //Erase the private key
+      osMemset(d, 0, sizeof(d));
+      osMemset(ws.buffer, 0, sizeof(ws.buffer));
+
+      //Report an error
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+   }
+
+#if (ECDSA_NONCE_POOL_SUPPORT == ENABLED)
+   //Use a precomputed nonce, if available (the integers are backed by the
+   //workspace, so that the copy does not allocate any memory)
+   error = ecdsaTakeNonce(params, &ws.k[0], &ws.k[1]);
+
+   //Check status code
+   if(!error)
+   {
+      //Load k ^ -1 mod q and r
+      error = ecWorkspaceImportScalar(&ws, kinv, &ws.k[0]);
+
+      //Check status code
+      if(!error)
+      {
+         error = ecWorkspaceImportScalar(&ws, r, &ws.k[1]);
+      }
+   }
+
+   //Fall back to inline computation when the pool is empty
+   if(error)
+#endif
+   {
+      //Generate a random number k such as 0 < k < q
+      error = ecWorkspaceRandScalar(&ws, k, prngAlgo, prngContext);
+
+      //Check status code
+      if(!error)
+      {
+         //Compute R1 = (x1, y1) = k.G
+         error = ecWorkspaceMultBase(&ws, &r1, k);
+      }
+
+      //Check status code
+      if(!error)
+      {
+         //Retrieve x1
+         error = ecWorkspaceGetAffineX(&ws, r, &r1);
+      }
+
+      //Check status code
+      if(!error)
+      {
+         //Compute r = x1 mod q
+         ecWorkspaceReduce(&ws, r, r);
+         //Compute k ^ -1 mod q
+         ecWorkspaceInvMod(&ws, kinv, k);
+      }
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //Convert the digest to an integer modulo q
+      error = ecWorkspaceImportDigest(&ws, z, digest, digestLen);
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //Compute s = k ^ -1 * (z + x * r) mod q
+      ecWorkspaceMulMod(&ws, s, d, r);
+      ecWorkspaceAddMod(&ws, s, s, z);
+      ecWorkspaceMulMod(&ws, s, s, kinv);
+
+      //Save the (R, S) integer pair
+      error = mpiFixedExport(&signature->r, r, ws.order.n);
+
+      //Check status code
+      if(!error)
+      {
+         error = mpiFixedExport(&signature->s, s, ws.order.n);
+      }
+   }
+
+   //Erase the private key and the per-message secret
+   osMemset(d, 0, sizeof(d));
+   osMemset(k, 0, sizeof(k));
+   osMemset(kinv, 0, sizeof(kinv));
+   osMemset(ws.buffer, 0, sizeof(ws.buffer));
+
+   //Return status code
+   return error;
+}
+
+#endif
+
+
 /**
  * @brief ECDSA signature generation
+ *
+ * When a nonce pool is registered, the precomputed values k ^ -1 mod q and
+ * r are used, so that no scalar multiplication is needed. Otherwise, they
+ * are computed inline
+ *
  * @param[in] prngAlgo PRNG algorithm
  * @param[in] prngContext Pointer to the PRNG context
  * @param[in] params EC domain parameters
@@ -395,9 +627,8 @@ __weak_func error_t ecdsaGenerateSignature(const PrngAlgo *prngAlgo, void *prngC
 {
    error_t error;
    uint_t n;
-   Mpi k;
+   Mpi kinv;
    Mpi z;
-   EcPoint r1;
 
    //Check parameters
    if(params == NULL || privateKey == NULL || digest == NULL || signature == NULL)
@@ -410,18 +641,50 @@ __weak_func error_t ecdsaGenerateSignature(const PrngAlgo *prngAlgo, void *prngC
    TRACE_DEBUG("  digest:\r\n");
    TRACE_DEBUG_ARRAY("    ", digest, digestLen);
 
+#if (EC_WORKSPACE_SUPPORT == ENABLED)
+   //Use the allocation-free implementation whenever the curve allows it
+   error = ecdsaGenerateSignatureFixed(prngAlgo, prngContext, params,
+      privateKey, digest, digestLen, signature);
+
+   //Unless the operation is not supported, the result is final
+   if(error != ERROR_UNSUPPORTED_ELLIPTIC_CURVE)
+   {
+      //Check status code
+      if(!error)
+      {
+         //Dump ECDSA signature
+         TRACE_DEBUG("  r:\r\n");
+         TRACE_DEBUG_MPI("    ", &signature->r);
+         TRACE_DEBUG("  s:\r\n");
+         TRACE_DEBUG_MPI("    ", &signature->s);
+      }
+      else
+      {
+         //Release (R, S) integer pair
+         mpiFree(&signature->r);
+         mpiFree(&signature->s);
+      }
+
+      //Return status code
+      return error;
+   }
+#endif
+
    //Initialize multiple precision integers
-   mpiInit(&k);
+   mpiInit(&kinv);
    mpiInit(&z);
-   //Initialize EC point
-   ecInit(&r1);
-
-   //Generate a random number k such as 0 < k < q - 1
-   MPI_CHECK(mpiRandRange(&k, &params->q, prngAlgo, prngContext));
 
-   //Debug message
-   TRACE_DEBUG("  k:\r\n");
-   TRACE_DEBUG_MPI("    ", &k);
+#if (ECDSA_NONCE_POOL_SUPPORT == ENABLED)
+   //Use a precomputed nonce, if available
+   error = ecdsaTakeNonce(params, &kinv, &signature->r);
+   //Fall back to inline computation when the pool is empty
+   if(error)
+#endif
+   {
+      //Generate k and compute r and k ^ -1 mod q
+      EC_CHECK(ecdsaComputeNonce(prngAlgo, prngContext, params, &kinv,
+         &signature->r));
+   }
 
    //Let N be the bit length of q
    n = mpiGetBitLength(&params->q);
@@ -441,27 +704,11 @@ __weak_func error_t ecdsaGenerateSignature(const PrngAlgo *prngAlgo, void *prngC
    TRACE_DEBUG("  z:\r\n");
    TRACE_DEBUG_MPI("    ", &z);
 
-   //Compute R1 = (x1, y1) = k.G
-   EC_CHECK(ecMult(params, &r1, &k, &params->g));
-   EC_CHECK(ecAffinify(params, &r1, &r1));
-
-   //Debug message
-   TRACE_DEBUG("  x1:\r\n");
-   TRACE_DEBUG_MPI("    ", &r1.x);
-   TRACE_DEBUG("  y1:\r\n");
-   TRACE_DEBUG_MPI("    ", &r1.y);
-
-   //Compute r = x1 mod q
-   MPI_CHECK(mpiMod(&signature->r, &r1.x, &params->q));
-
-   //Compute k ^ -1 mod q
-   MPI_CHECK(mpiInvMod(&k, &k, &params->q));
-
    //Compute s = k ^ -1 * (z + x * r) mod q
    MPI_CHECK(mpiMul(&signature->s, &privateKey->d, &signature->r));
    MPI_CHECK(mpiAdd(&signature->s, &signature->s, &z));
    MPI_CHECK(mpiMod(&signature->s, &signature->s, &params->q));
-   MPI_CHECK(mpiMulMod(&signature->s, &signature->s, &k, &params->q));
+   MPI_CHECK(mpiMulMod(&signature->s, &signature->s, &kinv, &params->q));
 
    //Dump ECDSA signature
    TRACE_DEBUG("  r:\r\n");
@@ -471,10 +718,8 @@ __weak_func error_t ecdsaGenerateSignature(const PrngAlgo *prngAlgo, void *prngC
 
 end:
    //Release multiple precision integers
-   mpiFree(&k);
+   mpiFree(&kinv);
    mpiFree(&z);
-   //Release EC point
-   ecFree(&r1);
 
    //Clean up side effects if necessary
    if(error)
@@ -489,96 +734,358 @@ end:
 }
 
 
+#if (ECDSA_NONCE_POOL_SUPPORT == ENABLED)
+
 /**
- * @brief ECDSA signature verification
+ * @brief Compute a nonce on behalf of the pool
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
  * @param[in] params EC domain parameters
- * @param[in] publicKey Signer's EC public key
- * @param[in] digest Digest of the message whose signature is to be verified
- * @param[in] digestLen Length in octets of the digest
- * @param[in] signature (R, S) integer pair
+ * @param[out] kinv Inverse of the per-message secret k
+ * @param[out] r Resulting value r = x1 mod q, where (x1, y1) = k.G
  * @return Error code
  **/
 
-__weak_func error_t ecdsaVerifySignature(const EcDomainParameters *params,
-   const EcPublicKey *publicKey, const uint8_t *digest, size_t digestLen,
-   const EcdsaSignature *signature)
+static error_t ecdsaComputePoolNonce(const PrngAlgo *prngAlgo,
+   void *prngContext, const void *params, Mpi *kinv, Mpi *r)
 {
-   error_t error;
-   uint_t n;
-   Mpi w;
-   Mpi z;
-   Mpi u1;
-   Mpi u2;
-   Mpi v;
-   EcPoint v0;
-   EcPoint v1;
+   return ecdsaComputeNonce(prngAlgo, prngContext, params, kinv, r);
+}
 
-   //Check parameters
-   if(params == NULL || publicKey == NULL || digest == NULL || signature == NULL)
-      return ERROR_INVALID_PARAMETER;
 
-   //Debug message
-   TRACE_DEBUG("ECDSA signature verification...\r\n");
-   TRACE_DEBUG("  public key X:\r\n");
-   TRACE_DEBUG_MPI("    ", &publicKey->q.x);
-   TRACE_DEBUG("  public key Y:\r\n");
-   TRACE_DEBUG_MPI("    ", &publicKey->q.y);
-   TRACE_DEBUG("  digest:\r\n");
-   TRACE_DEBUG_ARRAY("    ", digest, digestLen);
-   TRACE_DEBUG("  r:\r\n");
-   TRACE_DEBUG_MPI("    ", &signature->r);
-   TRACE_DEBUG("  s:\r\n");
-   TRACE_DEBUG_MPI("    ", &signature->s);
+/**
+ * @brief Create a pool of precomputed nonces
+ * @param[in] params EC domain parameters
+ * @param[in] size Maximum number of nonces held by the pool
+ * @return Pointer to the newly created pool
+ **/
 
-   //The verifier shall check that 0 < r < q
-   if(mpiCompInt(&signature->r, 0) <= 0 ||
-      mpiComp(&signature->r, &params->q) >= 0)
-   {
-      //If the condition is violated, the signature shall be rejected as invalid
-      return ERROR_INVALID_SIGNATURE;
-   }
+EcdsaNoncePool *ecdsaInitNoncePool(const EcDomainParameters *params,
+   uint_t size)
+{
+   EcdsaNoncePool *pool;
 
-   //The verifier shall check that 0 < s < q
-   if(mpiCompInt(&signature->s, 0) <= 0 ||
-      mpiComp(&signature->s, &params->q) >= 0)
+   //Make sure the parameters are acceptable
+   if(params == NULL || params->name == NULL || size < 1)
+      return NULL;
+
+   //Allocate a memory buffer to hold the pool
+   pool = cryptoAllocMem(sizeof(EcdsaNoncePool));
+   //Failed to allocate memory?
+   if(pool == NULL)
+      return NULL;
+
+   //The nonces are only valid for the specified curve
+   pool->name = params->name;
+   mpiInit(&pool->p);
+
+   //Save the prime modulus
+   if(mpiCopy(&pool->p, &params->p) || signNoncePoolInit(&pool->pool, size))
    {
-      //If the condition is violated, the signature shall be rejected as invalid
-      return ERROR_INVALID_SIGNATURE;
+      //Clean up side effects
+      mpiFree(&pool->p);
+      cryptoFreeMem(pool);
+      //Report an error
+      return NULL;
    }
 
-   //Initialize multiple precision integers
-   mpiInit(&w);
-   mpiInit(&z);
-   mpiInit(&u1);
-   mpiInit(&u2);
-   mpiInit(&v);
-   //Initialize EC points
-   ecInit(&v0);
-   ecInit(&v1);
+   //Return a pointer to the newly created pool
+   return pool;
+}
 
-   //Let N be the bit length of q
-   n = mpiGetBitLength(&params->q);
-   //Compute N = MIN(N, outlen)
-   n = MIN(n, digestLen * 8);
 
-   //Convert the digest to a multiple precision integer
-   MPI_CHECK(mpiReadRaw(&z, digest, (n + 7) / 8));
+/**
+ * @brief Release a pool of precomputed nonces
+ * @param[in] pool Pointer to the pool (must not be registered)
+ **/
 
-   //Keep the leftmost N bits of the hash value
-   if((n % 8) != 0)
+void ecdsaFreeNoncePool(EcdsaNoncePool *pool)
+{
+   //Valid pool?
+   if(pool != NULL)
    {
-      MPI_CHECK(mpiShiftRight(&z, 8 - (n % 8)));
+      //Release previously allocated resources
+      signNoncePoolFree(&pool->pool);
+      mpiFree(&pool->p);
+      cryptoFreeMem(pool);
    }
+}
 
-   //Compute w = s ^ -1 mod q
-   MPI_CHECK(mpiInvMod(&w, &signature->s, &params->q));
-   //Compute u1 = z * w mod q
-   MPI_CHECK(mpiMulMod(&u1, &z, &w, &params->q));
-   //Compute u2 = r * w mod q
-   MPI_CHECK(mpiMulMod(&u2, &signature->r, &w, &params->q));
 
-   //Compute V0 = (x0, y0) = u1.G + u2.Q
-   EC_CHECK(ecProjectify(params, &v1, &publicKey->q));
+/**
+ * @brief Fill a pool of precomputed nonces
+ * @param[in] pool Pointer to the pool
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @param[in] params EC domain parameters
+ * @return Error code
+ **/
+
+error_t ecdsaFillNoncePool(EcdsaNoncePool *pool, const PrngAlgo *prngAlgo,
+   void *prngContext, const EcDomainParameters *params)
+{
+   //Check parameters
+   if(pool == NULL || params == NULL || params->name == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The pool is dedicated to a single curve
+   if(osStrcmp(pool->name, params->name) || mpiComp(&pool->p, &params->p))
+      return ERROR_INVALID_PARAMETER;
+
+   //Fill the pool up to its maximum depth
+   return signNoncePoolFill(&pool->pool, ecdsaComputePoolNonce, prngAlgo,
+      prngContext, params);
+}
+
+
+/**
+ * @brief Get the number of precomputed nonces available in a pool
+ * @param[in] pool Pointer to the pool
+ * @return Number of available nonces
+ **/
+
+uint_t ecdsaGetNoncePoolCount(EcdsaNoncePool *pool)
+{
+   //Invalid pool?
+   if(pool == NULL)
+      return 0;
+
+   //Retrieve the number of available nonces
+   return signNoncePoolGetCount(&pool->pool);
+}
+
+
+/**
+ * @brief Register the pool used by signature generation
+ * @param[in] pool Pointer to the pool (NULL to disable the pool)
+ * @return Error code
+ **/
+
+error_t ecdsaRegisterNoncePool(EcdsaNoncePool *pool)
+{
+   //Save the pool
+   ecdsaNoncePool = pool;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Get the registered pool
+ * @return Pointer to the pool (NULL if no pool has been registered)
+ **/
+
+EcdsaNoncePool *ecdsaGetNoncePool(void)
+{
+   //Return the registered pool
+   return ecdsaNoncePool;
+}
+
+#endif
+
+
+#if (EC_WORKSPACE_SUPPORT == ENABLED)
+
+/**
+ * @brief ECDSA signature verification (allocation-free implementation)
+ * @param[in] params EC domain parameters
+ * @param[in] publicKey Signer's EC public key
+ * @param[in] digest Digest of the message whose signature is to be verified
+ * @param[in] digestLen Length in octets of the digest
+ * @param[in] signature (R, S) integer pair, such as 0 < r < q and 0 < s < q
+ * @return Error code (ERROR_UNSUPPORTED_ELLIPTIC_CURVE if the operation
+ *   must be handled by the generic implementation)
+ **/
+
+static error_t ecdsaVerifySignatureFixed(const EcDomainParameters *params,
+   const EcPublicKey *publicKey, const uint8_t *digest, size_t digestLen,
+   const EcdsaSignature *signature)
+{
+   error_t error;
+   EcWorkspace ws;
+   EcFixedPoint q;
+   EcFixedPoint v0;
+   MpiFixedWord r[EC_FIXED_MAX_WORDS];
+   MpiFixedWord s[EC_FIXED_MAX_WORDS];
+   MpiFixedWord w[EC_FIXED_MAX_WORDS];
+   MpiFixedWord z[EC_FIXED_MAX_WORDS];
+   MpiFixedWord u1[EC_FIXED_MAX_WORDS];
+   MpiFixedWord u2[EC_FIXED_MAX_WORDS];
+   MpiFixedWord v[EC_FIXED_MAX_WORDS];
+
+   //Initialize the workspace
+   error = ecWorkspaceInit(&ws, params);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Import the (R, S) integer pair
+   error = ecWorkspaceImportScalar(&ws, r, &signature->r);
+
+   //Check status code
+   if(!error)
+   {
+      error = ecWorkspaceImportScalar(&ws, s, &signature->s);
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //Import the signer's public key
+      error = ecWorkspaceImportPoint(&ws, &q, &publicKey->q);
+   }
+
+   //Values that are not properly reduced are handled by the generic
+   //implementation
+   if(error)
+      return ERROR_UNSUPPORTED_ELLIPTIC_CURVE;
+
+   //Convert the digest to an integer modulo q
+   error = ecWorkspaceImportDigest(&ws, z, digest, digestLen);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Compute w = s ^ -1 mod q
+   ecWorkspaceInvMod(&ws, w, s);
+   //Compute u1 = z * w mod q
+   ecWorkspaceMulMod(&ws, u1, z, w);
+   //Compute u2 = r * w mod q
+   ecWorkspaceMulMod(&ws, u2, r, w);
+
+   //Compute V0 = (x0, y0) = u1.G + u2.Q
+   error = ecWorkspaceTwinMult(&ws, &v0, u1, u2, &q);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Retrieve x0
+   error = ecWorkspaceGetAffineX(&ws, v, &v0);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Compute v = x0 mod q
+   ecWorkspaceReduce(&ws, v, v);
+
+   //If v = r, then the signature is verified. If v does not equal r,
+   //then the message or the signature may have been modified
+   if(!mpiFixedComp(v, r, ws.order.n))
+   {
+      error = NO_ERROR;
+   }
+   else
+   {
+      error = ERROR_INVALID_SIGNATURE;
+   }
+
+   //Return status code
+   return error;
+}
+
+#endif
+
+
+/**
+ * @brief ECDSA signature verification
+ * @param[in] params EC domain parameters
+ * @param[in] publicKey Signer's EC public key
+ * @param[in] digest Digest of the message whose signature is to be verified
+ * @param[in] digestLen Length in octets of the digest
+ * @param[in] signature (R, S) integer pair
+ * @return Error code
+ **/
+
+__weak_func error_t ecdsaVerifySignature(const EcDomainParameters *params,
+   const EcPublicKey *publicKey, const uint8_t *digest, size_t digestLen,
+   const EcdsaSignature *signature)
+{
+   error_t error;
+   uint_t n;
+   Mpi w;
+   Mpi z;
+   Mpi u1;
+   Mpi u2;
+   Mpi v;
+   EcPoint v0;
+   EcPoint v1;
+
+   //Check parameters
+   if(params == NULL || publicKey == NULL || digest == NULL || signature == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Debug message
+   TRACE_DEBUG("ECDSA signature verification...\r\n");
+   TRACE_DEBUG("  public key X:\r\n");
+   TRACE_DEBUG_MPI("    ", &publicKey->q.x);
+   TRACE_DEBUG("  public key Y:\r\n");
+   TRACE_DEBUG_MPI("    ", &publicKey->q.y);
+   TRACE_DEBUG("  digest:\r\n");
+   TRACE_DEBUG_ARRAY("    ", digest, digestLen);
+   TRACE_DEBUG("  r:\r\n");
+   TRACE_DEBUG_MPI("    ", &signature->r);
+   TRACE_DEBUG("  s:\r\n");
+   TRACE_DEBUG_MPI("    ", &signature->s);
+
+   //The verifier shall check that 0 < r < q
+   if(mpiCompInt(&signature->r, 0) <= 0 ||
+      mpiComp(&signature->r, &params->q) >= 0)
+   {
+      //If the condition is violated, the signature shall be rejected as invalid
+      return ERROR_INVALID_SIGNATURE;
+   }
+
+   //The verifier shall check that 0 < s < q
+   if(mpiCompInt(&signature->s, 0) <= 0 ||
+      mpiComp(&signature->s, &params->q) >= 0)
+   {
+      //If the condition is violated, the signature shall be rejected as invalid
+      return ERROR_INVALID_SIGNATURE;
+   }
+
+#if (EC_WORKSPACE_SUPPORT == ENABLED)
+   //Use the allocation-free implementation whenever the curve allows it
+   error = ecdsaVerifySignatureFixed(params, publicKey, digest, digestLen,
+      signature);
+   //Unless the operation is not supported, the result is final
+   if(error != ERROR_UNSUPPORTED_ELLIPTIC_CURVE)
+      return error;
+#endif
+
+   //Initialize multiple precision integers
+   mpiInit(&w);
+   mpiInit(&z);
+   mpiInit(&u1);
+   mpiInit(&u2);
+   mpiInit(&v);
+   //Initialize EC points
+   ecInit(&v0);
+   ecInit(&v1);
+
+   //Let N be the bit length of q
+   n = mpiGetBitLength(&params->q);
+   //Compute N = MIN(N, outlen)
+   n = MIN(n, digestLen * 8);
+
+   //Convert the digest to a multiple precision integer
+   MPI_CHECK(mpiReadRaw(&z, digest, (n + 7) / 8));
+
+   //Keep the leftmost N bits of the hash value
+   if((n % 8) != 0)
+   {
+      MPI_CHECK(mpiShiftRight(&z, 8 - (n % 8)));
+   }
+
+   //Compute w = s ^ -1 mod q
+   MPI_CHECK(mpiInvMod(&w, &signature->s, &params->q));
+   //Compute u1 = z * w mod q
+   MPI_CHECK(mpiMulMod(&u1, &z, &w, &params->q));
+   //Compute u2 = r * w mod q
+   MPI_CHECK(mpiMulMod(&u2, &signature->r, &w, &params->q));
+
+   //Compute V0 = (x0, y0) = u1.G + u2.Q
+   EC_CHECK(ecProjectify(params, &v1, &publicKey->q));
    EC_CHECK(ecTwinMult(params, &v0, &u1, &params->g, &u2, &v1));
    EC_CHECK(ecAffinify(params, &v0, &v0));
 
@@ -621,4 +1128,415 @@ end:
    return error;
 }
 
+
+/**
+ * @brief Initialize an ECDSA verification key
+ * @param[in] key Pointer to the verification key
+ **/
+
+void ecdsaInitVerifyKey(EcdsaVerifyKey *key)
+{
+   //Initialize the table
+   ecWnafInit(&key->table);
+}
+
+
+/**
+ * @brief Release an ECDSA verification key
+ * @param[in] key Pointer to the verification key
+ **/
+
+void ecdsaFreeVerifyKey(EcdsaVerifyKey *key)
+{
+   //Release the table
+   ecWnafFree(&key->table);
+}
+
+
+/**
+ * @brief Build an ECDSA verification key from a public key
+ *
+ * The odd multiples of the public key are computed once, so that every
+ * subsequent verification only has to process the scalars
+ *
+ * @param[in] params EC domain parameters
+ * @param[in] publicKey Signer's EC public key
+ * @param[out] key Resulting verification key
+ * @return Error code
+ **/
+
+error_t ecdsaBuildVerifyKey(const EcDomainParameters *params,
+   const EcPublicKey *publicKey, EcdsaVerifyKey *key)
+{
+   error_t error;
+   EcPoint q;
+
+   //Check parameters
+   if(params == NULL || publicKey == NULL || key == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Initialize EC point
+   ecInit(&q);
+
+   //Convert the public key to projective representation
+   EC_CHECK(ecProjectify(params, &q, &publicKey->q));
+
+   //Precompute the odd multiples of the public key
+   EC_CHECK(ecWnafBuild(params, &key->table, &q, EC_WNAF_TABLE_WIDTH));
+
+end:
+   //Release EC point
+   ecFree(&q);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief ECDSA signature verification using a verification key
+ * @param[in] params EC domain parameters
+ * @param[in] key Signer's verification key
+ * @param[in] digest Digest of the message whose signature is to be verified
+ * @param[in] digestLen Length in octets of the digest
+ * @param[in] signature (R, S) integer pair
+ * @return Error code
+ **/
+
+error_t ecdsaVerifySignatureWithKey(const EcDomainParameters *params,
+   const EcdsaVerifyKey *key, const uint8_t *digest, size_t digestLen,
+   const EcdsaSignature *signature)
+{
+   error_t error;
+   uint_t n;
+   Mpi w;
+   Mpi z;
+   Mpi u1;
+   Mpi u2;
+   Mpi v;
+   EcPoint v0;
+   const EcWnafTable *table;
+
+   //Check parameters
+   if(params == NULL || key == NULL || digest == NULL || signature == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Make sure the verification key has been built
+   if(key->table.points == NULL)
+      return ERROR_INVALID_KEY;
+
+   //Debug message
+   TRACE_DEBUG("ECDSA signature verification (verification key)...\r\n");
+
+   //The verifier shall check that 0 < r < q
+   if(mpiCompInt(&signature->r, 0) <= 0 ||
+      mpiComp(&signature->r, &params->q) >= 0)
+   {
+      //If the condition is violated, the signature shall be rejected as invalid
+      return ERROR_INVALID_SIGNATURE;
+   }
+
+   //The verifier shall check that 0 < s < q
+   if(mpiCompInt(&signature->s, 0) <= 0 ||
+      mpiComp(&signature->s, &params->q) >= 0)
+   {
+      //If the condition is violated, the signature shall be rejected as invalid
+      return ERROR_INVALID_SIGNATURE;
+   }
+
+   //Initialize multiple precision integers
+   mpiInit(&w);
+   mpiInit(&z);
+   mpiInit(&u1);
+   mpiInit(&u2);
+   mpiInit(&v);
+   //Initialize EC point
+   ecInit(&v0);
+
+   //Let N be the bit length of q
+   n = mpiGetBitLength(&params->q);
+   //Compute N = MIN(N, outlen)
+   n = MIN(n, digestLen * 8);
+
+   //Convert the digest to a multiple precision integer
+   MPI_CHECK(mpiReadRaw(&z, digest, (n + 7) / 8));
+
+   //Keep the leftmost N bits of the hash value
+   if((n % 8) != 0)
+   {
+      MPI_CHECK(mpiShiftRight(&z, 8 - (n % 8)));
+   }
+
+   //Compute w = s ^ -1 mod q
+   MPI_CHECK(mpiInvMod(&w, &signature->s, &params->q));
+   //Compute u1 = z * w mod q
+   MPI_CHECK(mpiMulMod(&u1, &z, &w, &params->q));
+   //Compute u2 = r * w mod q
+   MPI_CHECK(mpiMulMod(&u2, &signature->r, &w, &params->q));
+
+#if (EC_COMB_SUPPORT == ENABLED)
+   //Use the precomputed odd multiples of G, if available
+   table = (params->comb != NULL && params->comb->wnaf.points != NULL) ?
+      &params->comb->wnaf : NULL;
+#else
+   //The odd multiples of G are computed on the fly
+   table = NULL;
+#endif
+
+   //Compute V0 = (x0, y0) = u1.G + u2.Q
+   EC_CHECK(ecWnafTwinMult(params, &v0, &u1, &params->g, table, &u2, NULL,
+      &key->table));
+   EC_CHECK(ecAffinify(params, &v0, &v0));
+
+   //Compute v = x0 mod q
+   MPI_CHECK(mpiMod(&v, &v0.x, &params->q));
+
+   //If v = r, then the signature is verified. If v does not equal r,
+   //then the message or the signature may have been modified
+   if(!mpiComp(&v, &signature->r))
+   {
+      error = NO_ERROR;
+   }
+   else
+   {
+      error = ERROR_INVALID_SIGNATURE;
+   }
+
+end:
+   //Release multiple precision integers
+   mpiFree(&w);
+   mpiFree(&z);
+   mpiFree(&u1);
+   mpiFree(&u2);
+   mpiFree(&v);
+   //Release EC point
+   ecFree(&v0);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief ECDSA batch signature verification
+ *
+ * Each signature is checked individually and the outcome is reported in
+ * the result field of the corresponding item. The signatures are processed
+ * by groups of ECDSA_BATCH_SIZE, so that the modular inversions of s and
+ * the conversions of the resulting points to affine coordinates are shared
+ * between all the signatures of a group (Montgomery's trick)
+ *
+ * @param[in] params EC domain parameters
+ * @param[in,out] items Signatures to be verified
+ * @param[in] n Number of signatures
+ * @return Error code (ERROR_INVALID_SIGNATURE if at least one signature
+ *   is not valid)
+ **/
+
+error_t ecdsaVerifySignatureBatch(const EcDomainParameters *params,
+   EcdsaBatchItem *items, uint_t n)
+{
+   error_t error;
+   bool_t valid;
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   uint_t m;
+   uint_t t;
+   uint_t bitLen;
+   uint_t index[ECDSA_BATCH_SIZE];
+   EcdsaBatchItem *item;
+   Mpi w;
+   Mpi z;
+   Mpi u1;
+   Mpi u2;
+   Mpi v;
+   Mpi c[ECDSA_BATCH_SIZE];
+   EcPoint q;
+   EcPoint v0[ECDSA_BATCH_SIZE];
+
+   //Check parameters
+   if(params == NULL || (items == NULL && n > 0))
+      return ERROR_INVALID_PARAMETER;
+
+   //Debug message
+   TRACE_DEBUG("ECDSA batch signature verification (%u signatures)...\r\n", n);
+
+   //Initialize multiple precision integers
+   mpiInit(&w);
+   mpiInit(&z);
+   mpiInit(&u1);
+   mpiInit(&u2);
+   mpiInit(&v);
+   //Initialize EC point
+   ecInit(&q);
+
+   for(j = 0; j < ECDSA_BATCH_SIZE; j++)
+   {
+      mpiInit(&c[j]);
+      ecInit(&v0[j]);
+   }
+
+   //Let N be the bit length of q
+   bitLen = mpiGetBitLength(&params->q);
+   //All the signatures are assumed to be valid until proven otherwise
+   valid = TRUE;
+
+   //Process the signatures by groups
+   for(i = 0; i < n; i += k)
+   {
+      //Number of signatures in the current group
+      k = MIN(n - i, ECDSA_BATCH_SIZE);
+
+      //Check each signature of the group
+      for(m = 0, j = 0; j < k; j++)
+      {
+         //Point to the current item
+         item = &items[i + j];
+
+         //Check the parameters of the item
+         if(item->publicKey == NULL || item->digest == NULL ||
+            item->signature == NULL)
+         {
+            item->result = ERROR_INVALID_PARAMETER;
+         }
+         //The verifier shall check that 0 < r < q and 0 < s < q
+         else if(mpiCompInt(&item->signature->r, 0) <= 0 ||
+            mpiComp(&item->signature->r, &params->q) >= 0 ||
+            mpiCompInt(&item->signature->s, 0) <= 0 ||
+            mpiComp(&item->signature->s, &params->q) >= 0)
+         {
+            //If the condition is violated, the signature shall be rejected
+            //as invalid
+            item->result = ERROR_INVALID_SIGNATURE;
+         }
+         else
+         {
+            //Compute C[m] = s[0] * s[1] * ... * s[m] mod q
+            if(m == 0)
+            {
+               MPI_CHECK(mpiCopy(&c[m], &item->signature->s));
+            }
+            else
+            {
+               MPI_CHECK(mpiMulMod(&c[m], &c[m - 1], &item->signature->s,
+                  &params->q));
+            }
+
+            //Save the index of the item
+            index[m++] = i + j;
+         }
+      }
+
+      //Skip the group if none of its signatures passed the range checks
+      if(m == 0)
+         continue;
+
+      //Compute W = 1 / (s[0] * s[1] * ... * s[m - 1]) mod q
+      MPI_CHECK(mpiInvMod(&w, &c[m - 1], &params->q));
+
+      //The signatures are processed in reverse order
+      for(j = m; j > 0; j--)
+      {
+         //Point to the current item
+         item = &items[index[j - 1]];
+
+         //Compute u2 = s[j - 1] ^ -1 mod q
+         if(j > 1)
+         {
+            MPI_CHECK(mpiMulMod(&u2, &w, &c[j - 2], &params->q));
+            //Update W = 1 / (s[0] * s[1] * ... * s[j - 2]) mod q
+            MPI_CHECK(mpiMulMod(&w, &w, &item->signature->s, &params->q));
+         }
+         else
+         {
+            MPI_CHECK(mpiCopy(&u2, &w));
+         }
+
+         //Compute N = MIN(N, outlen)
+         t = MIN(bitLen, item->digestLen * 8);
+
+         //Convert the digest to a multiple precision integer
+         MPI_CHECK(mpiReadRaw(&z, item->digest, (t + 7) / 8));
+
+         //Keep the leftmost N bits of the hash value
+         if((t % 8) != 0)
+         {
+            MPI_CHECK(mpiShiftRight(&z, 8 - (t % 8)));
+         }
+
+         //Compute u1 = z * w mod q
+         MPI_CHECK(mpiMulMod(&u1, &z, &u2, &params->q));
+         //Compute u2 = r * w mod q
+         MPI_CHECK(mpiMulMod(&u2, &item->signature->r, &u2, &params->q));
+
+         //Compute V0 = (x0, y0) = u1.G + u2.Q
+         EC_CHECK(ecProjectify(params, &q, &item->publicKey->q));
+         EC_CHECK(ecTwinMult(params, &v0[j - 1], &u1, &params->g, &u2, &q));
+      }
+
+      //Convert the resulting points to affine coordinates
+      EC_CHECK(ecAffinifyBatch(params, v0, m));
+
+      //Compare the x-coordinates with the r values
+      for(j = 0; j < m; j++)
+      {
+         //Point to the current item
+         item = &items[index[j]];
+
+         //The point at the infinity cannot match any r value
+         if(mpiCompInt(&v0[j].z, 0) == 0)
+         {
+            item->result = ERROR_INVALID_SIGNATURE;
+         }
+         else
+         {
+            //Compute v = x0 mod q
+            MPI_CHECK(mpiMod(&v, &v0[j].x, &params->q));
+
+            //If v = r, then the signature is verified
+            if(!mpiComp(&v, &item->signature->r))
+            {
+               item->result = NO_ERROR;
+            }
+            else
+            {
+               item->result = ERROR_INVALID_SIGNATURE;
+            }
+         }
+      }
+
+      //Check whether each signature of the group is valid
+      for(j = 0; j < k; j++)
+      {
+         if(items[i + j].result)
+         {
+            valid = FALSE;
+         }
+      }
+   }
+
+   //Report an error if at least one signature is not valid
+   error = valid ? NO_ERROR : ERROR_INVALID_SIGNATURE;
+
+end:
+   //Release multiple precision integers
+   mpiFree(&w);
+   mpiFree(&z);
+   mpiFree(&u1);
+   mpiFree(&u2);
+   mpiFree(&v);
+   //Release EC point
+   ecFree(&q);
+
+   for(j = 0; j < ECDSA_BATCH_SIZE; j++)
+   {
+      mpiFree(&c[j]);
+      ecFree(&v0[j]);
+   }
+
+   //Return status code
+   return error;
+}
+
 #endif
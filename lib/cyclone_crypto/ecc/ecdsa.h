@@ -34,6 +34,22 @@
 //Dependencies
 #include "core/crypto.h"
 #include "ecc/ec.h"
+#include "ecc/ec_wnaf.h"
+#include "pkc/sign_nonce_pool.h"
+
+//Number of signatures processed together by batch verification
+#ifndef ECDSA_BATCH_SIZE
+   #define ECDSA_BATCH_SIZE 16
+#elif (ECDSA_BATCH_SIZE < 1)
+   #error ECDSA_BATCH_SIZE parameter is not valid
+#endif
+
+//Precomputed nonce pool support
+#ifndef ECDSA_NONCE_POOL_SUPPORT
+   #define ECDSA_NONCE_POOL_SUPPORT DISABLED
+#elif (ECDSA_NONCE_POOL_SUPPORT != ENABLED && ECDSA_NONCE_POOL_SUPPORT != DISABLED)
+   #error ECDSA_NONCE_POOL_SUPPORT parameter is not valid
+#endif
 
 //C++ guard
 #ifdef __cplusplus
@@ -52,6 +68,42 @@ typedef struct
 } EcdsaSignature;
 
 
+/**
+ * @brief ECDSA verification key (precomputed odd multiples of Q)
+ **/
+
+typedef struct
+{
+   EcWnafTable table; ///<Odd multiples of the public key
+} EcdsaVerifyKey;
+
+
+/**
+ * @brief Signature to be checked by batch verification
+ **/
+
+typedef struct
+{
+   const EcPublicKey *publicKey;    ///<Signer's EC public key
+   const uint8_t *digest;           ///<Digest of the message
+   size_t digestLen;                ///<Length in octets of the digest
+   const EcdsaSignature *signature; ///<(R, S) integer pair
+   error_t result;                  ///<Verification result
+} EcdsaBatchItem;
+
+
+/**
+ * @brief Pool of precomputed ECDSA nonces
+ **/
+
+typedef struct
+{
+   SignNoncePool pool; ///<Precomputed nonces
+   const char_t *name; ///<Curve name
+   Mpi p;              ///<Prime
+} EcdsaNoncePool;
+
+
 //ECDSA related constants
 extern const uint8_t ECDSA_WITH_SHA1_OID[7];
 extern const uint8_t ECDSA_WITH_SHA224_OID[8];
@@ -81,6 +133,32 @@ error_t ecdsaVerifySignature(const EcDomainParameters *params,
    const EcPublicKey *publicKey, const uint8_t *digest, size_t digestLen,
    const EcdsaSignature *signature);
 
+EcdsaNoncePool *ecdsaInitNoncePool(const EcDomainParameters *params,
+   uint_t size);
+
+void ecdsaFreeNoncePool(EcdsaNoncePool *pool);
+
+error_t ecdsaFillNoncePool(EcdsaNoncePool *pool, const PrngAlgo *prngAlgo,
+   void *prngContext, const EcDomainParameters *params);
+
+uint_t ecdsaGetNoncePoolCount(EcdsaNoncePool *pool);
+
+error_t ecdsaRegisterNoncePool(EcdsaNoncePool *pool);
+EcdsaNoncePool *ecdsaGetNoncePool(void);
+
+void ecdsaInitVerifyKey(EcdsaVerifyKey *key);
+void ecdsaFreeVerifyKey(EcdsaVerifyKey *key);
+
+error_t ecdsaBuildVerifyKey(const EcDomainParameters *params,
+   const EcPublicKey *publicKey, EcdsaVerifyKey *key);
+
+error_t ecdsaVerifySignatureWithKey(const EcDomainParameters *params,
+   const EcdsaVerifyKey *key, const uint8_t *digest, size_t digestLen,
+   const EcdsaSignature *signature);
+
+error_t ecdsaVerifySignatureBatch(const EcDomainParameters *params,
+   EcdsaBatchItem *items, uint_t n);
+
 //C++ guard
 #ifdef __cplusplus
 }
@@ -36,11 +36,181 @@
 #include "ecc/ec_curves.h"
 #include "ecc/curve25519.h"
 #include "ecc/ed25519.h"
+#include "ecc/ec_tables.h"
+#include "mpi/mpi_fixed.h"
 #include "debug.h"
 
 //Check crypto library configuration
 #if (ED25519_SUPPORT == ENABLED)
 
+//Width of the NAF window used for the base point
+#define ED25519_B_WNAF_WIDTH 5
+//Size of a scalar, in words
+#define ED25519_SCALAR_WORDS (256 / MPI_FIXED_WORD_SIZE)
+
+#if (CURVE25519_64BIT_SUPPORT == ENABLED)
+
+//Base point B
+static const Ed25519Point ED25519_B =
+{
+   {
+      0x00062D608F25D51A, 0x000412A4B4F6592A, 0x00075B7171A4B31D,
+      0x0001FF60527118FE, 0x000216936D3CD6E5
+   },
+   {
+      0x0006666666666658, 0x0004CCCCCCCCCCCC, 0x0001999999999999,
+      0x0003333333333333, 0x0006666666666666
+   },
+   {
+      0x0000000000000001, 0x0000000000000000, 0x0000000000000000,
+      0x0000000000000000, 0x0000000000000000
+   },
+   {
+      0x00068AB3A5B7DDA3, 0x00000EEA2A5EADBB, 0x0002AF8DF483C27E,
+      0x000332B375274732, 0x00067875F0FD78B7
+   }
+};
+
+//Zero (constant)
+static const Curve25519Limb ED25519_ZERO[5] =
+{
+   0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+   0x0000000000000000, 0x0000000000000000
+};
+
+//Curve parameter d
+static const Curve25519Limb ED25519_D[5] =
+{
+   0x00034DCA135978A3, 0x0001A8283B156EBD, 0x0005E7A26001C029,
+   0x000739C663A03CBB, 0x00052036CEE2B6FF
+};
+
+//Pre-computed value of 2 * d
+static const Curve25519Limb ED25519_2D[5] =
+{
+   0x00069B9426B2F159, 0x00035050762ADD7A, 0x0003CF44C0038052,
+   0x0006738CC7407977, 0x0002406D9DC56DFF
+};
+
+//Odd multiples (2i + 1) * B of the base point
+static const Ed25519PrecompPoint ED25519_B_ODD[8] =
+{
+   {
+      {
+         0x000493C6F58C3B85, 0x0000DF7181C325F7, 0x0000F50B0B3E4CB7,
+         0x0005329385A44C32, 0x00007CF9D3A33D4B
+      },
+      {
+         0x00003905D740913E, 0x0000BA2817D673A2, 0x00023E2827F4E67C,
+         0x000133D2E0C21A34, 0x00044FD2F9298F81
+      },
+      {
+         0x00011205877AAA68, 0x000479955893D579, 0x00050D66309B67A0,
+         0x0002D42D0DBEE5EE, 0x0006F117B689F0C6
+      }
+   },
+   {
+      {
+         0x0005B0A84CEE9730, 0x00061D10C97155E4, 0x0004059CC8096A10,
+         0x00047A608DA8014F, 0x0007A164E1B9A80F
+      },
+      {
+         0x00011FE8A4FCD265, 0x0007BCB8374FAACC, 0x00052F5AF4EF4D4F,
+         0x0005314098F98D10, 0x0002AB91587555BD
+      },
+      {
+         0x0006933F0DD0D889, 0x00044386BB4C4295, 0x0003CB6D3162508C,
+         0x00026368B872A2C6, 0x0005A2826AF12B9B
+      }
+   },
+   {
+      {
+         0x0002BC4408A5BB33, 0x000078EBDDA05442, 0x0002FFB112354123,
+         0x000375EE8DF5862D, 0x0002945CCF146E20
+      },
+      {
+         0x000182C3A447D6BA, 0x00022964E536EFF2, 0x000192821F540053,
+         0x0002F9F19E788E5C, 0x000154A7E73EB1B5
+      },
+      {
+         0x0003DBF1812A8285, 0x0000FA17BA3F9797, 0x0006F69CB49C3820,
+         0x00034D5A0DB3858D, 0x00043AABE696B3BB
+      }
+   },
+   {
+      {
+         0x00025CD0944EA3BF, 0x00075673B81A4D63, 0x000150B925D1C0D4,
+         0x00013F38D9294114, 0x000461BEA69283C9
+      },
+      {
+         0x00072C9AAA3221B1, 0x000267774474F74D, 0x000064B0E9B28085,
+         0x0003F04EF53B27C9, 0x0001D6EDD5D2E531
+      },
+      {
+         0x00036DC801B8B3A2, 0x0000E0A7D4935E30, 0x0001DEB7CECC0D7D,
+         0x000053A94E20DD2C, 0x0007A9FBB1C6A0F9
+      }
+   },
+   {
+      {
+         0x0006678AA6A8632F, 0x0005EA3788D8B365, 0x00021BD6D6994279,
+         0x0007ACE75919E4E3, 0x00034B9ED338ADD7
+      },
+      {
+         0x0006217E039D8064, 0x0006DEA408337E6D, 0x00057AC112628206,
+         0x000647CB65E30473, 0x00049C05A51FADC9
+      },
+      {
+         0x0004E8BF9045AF1B, 0x000514E33A45E0D6, 0x0007533C5B8BFE0F,
+         0x000583557B7E14C9, 0x00073C172021B008
+      }
+   },
+   {
+      {
+         0x000700848A802ADE, 0x0001E04605C4E5F7, 0x0005C0D01B9767FB,
+         0x0007D7889F42388B, 0x0004275AAE2546D8
+      },
+      {
+         0x00075B0249864348, 0x00052EE11070262B, 0x000237AE54FB5ACD,
+         0x0003BFD1D03AAAB5, 0x00018AB598029D5C
+      },
+      {
+         0x00032CC5FD6089E9, 0x000426505C949B05, 0x00046A18880C7AD2,
+         0x0004A4221888CCDA, 0x0003DC65522B53DF
+      }
+   },
+   {
+      {
+         0x0000C222A2007F6D, 0x000356B79BDB77EE, 0x00041EE81EFE12CE,
+         0x000120A9BD07097D, 0x000234FD7EEC346F
+      },
+      {
+         0x0007013B327FBF93, 0x0001336EEDED6A0D, 0x0002B565A2BBF3AF,
+         0x000253CE89591955, 0x0000267882D17602
+      },
+      {
+         0x0000A119732EA378, 0x00063BF1BA8E2A6C, 0x00069F94CC90DF9A,
+         0x000431D1779BFC48, 0x000497BA6FDAA097
+      }
+   },
+   {
+      {
+         0x0006CC0313CFEAA0, 0x0001A313848DA499, 0x0007CB534219230A,
+         0x00039596DEDEFD60, 0x00061E22917F12DE
+      },
+      {
+         0x0003CD86468CCF0B, 0x00048553221AC081, 0x0006C9464B4E0A6E,
+         0x00075FBA84180403, 0x00043B5CD4218D05
+      },
+      {
+         0x0002762F9BD0B516, 0x0001C6E7FBDDCBB3, 0x00075909C3ACE2BD,
+         0x00042101972D3EC9, 0x000511D61210AE4D
+      }
+   }
+};
+
+#else
+
 //Base point B
 static const Ed25519Point ED25519_B =
 {
@@ -63,26 +233,145 @@ static const Ed25519Point ED25519_B =
 };
 
 //Zero (constant)
-static const uint32_t ED25519_ZERO[8] =
+static const Curve25519Limb ED25519_ZERO[8] =
 {
    0x00000000, 0x00000000, 0x00000000, 0x00000000,
    0x00000000, 0x00000000, 0x00000000, 0x00000000
 };
 
 //Curve parameter d
-static const uint32_t ED25519_D[8] =
+static const Curve25519Limb ED25519_D[8] =
 {
    0x135978A3, 0x75EB4DCA, 0x4141D8AB, 0x00700A4D,
    0x7779E898, 0x8CC74079, 0x2B6FFE73, 0x52036CEE
 };
 
 //Pre-computed value of 2 * d
-static const uint32_t ED25519_2D[8] =
+static const Curve25519Limb ED25519_2D[8] =
 {
    0x26B2F159, 0xEBD69B94, 0x8283B156, 0x00E0149A,
    0xEEF3D130, 0x198E80F2, 0x56DFFCE7, 0x2406D9DC
 };
 
+//Odd multiples (2i + 1) * B of the base point
+static const Ed25519PrecompPoint ED25519_B_ODD[8] =
+{
+   {
+      {
+         0xF58C3B85, 0x2FBC93C6, 0xFB8C0E19, 0xCF932DC6,
+         0x643D42C2, 0x270B4898, 0x33D4BA65, 0x07CF9D3A
+      },
+      {
+         0xD740913E, 0x9D103905, 0xD140BEB3, 0xFD399F05,
+         0x688F8A09, 0xA5C18434, 0x98F81267, 0x44FD2F92
+      },
+      {
+         0x877AAA68, 0xABC91205, 0xCCAAC49E, 0x26D9E823,
+         0xDD43598C, 0x5A1B7DCB, 0x9F0C65A8, 0x6F117B68
+      }
+   },
+   {
+      {
+         0x4CEE9730, 0xAF25B0A8, 0xE8864B8A, 0x025A8430,
+         0x9F016732, 0xC11B5002, 0x9A80F8F4, 0x7A164E1B
+      },
+      {
+         0xA4FCD265, 0x56611FE8, 0xE5C1BA7D, 0x3BD353FD,
+         0x214BD6BD, 0x8131F31A, 0x555BDA62, 0x2AB91587
+      },
+      {
+         0x0DD0D889, 0x14AE933F, 0x1C35DA62, 0x58942322,
+         0x8CF2DB4C, 0xD170E545, 0x12B9B4C6, 0x5A2826AF
+      }
+   },
+   {
+      {
+         0x08A5BB33, 0xA212BC44, 0xC75EED02, 0x8D5048C3,
+         0x5ABFEC44, 0xDD1BEB0C, 0x46E206EB, 0x2945CCF1
+      },
+      {
+         0xA447D6BA, 0x7F9182C3, 0x4B2729B7, 0xD50014D1,
+         0xB864A087, 0xE33CF11C, 0xEB1B55F3, 0x154A7E73
+      },
+      {
+         0x812A8285, 0xBCBBDBF1, 0xD0BDD1FC, 0x270E0807,
+         0x1BBDA72D, 0xB41B670B, 0x6B3BB69A, 0x43AABE69
+      }
+   },
+   {
+      {
+         0x944EA3BF, 0x6B1A5CD0, 0xB39DC0D2, 0x7470353A,
+         0x28542E49, 0x71B25282, 0x283C927E, 0x461BEA69
+      },
+      {
+         0xAA3221B1, 0xBA6F2C9A, 0x3BBA23A7, 0x6CA02153,
+         0x92192C3A, 0x9DEA764F, 0x2E5317E0, 0x1D6EDD5D
+      },
+      {
+         0x01B8B3A2, 0xF1836DC8, 0x053EA49A, 0xB3035F47,
+         0x5877ADF3, 0x529C41BA, 0x6A0F90A7, 0x7A9FBB1C
+      }
+   },
+   {
+      {
+         0xA6A8632F, 0x9B2E678A, 0x51BC46C5, 0xA6509E6F,
+         0xC686F5B5, 0xCEB233C9, 0x8ADD7F59, 0x34B9ED33
+      },
+      {
+         0x039D8064, 0xF36E217E, 0xF520419B, 0x98A081B6,
+         0xE75EB044, 0x96CBC608, 0xFADC9C8F, 0x49C05A51
+      },
+      {
+         0x9045AF1B, 0x06B4E8BF, 0xA719D22F, 0xE2FF83E8,
+         0x93D4CF16, 0xAAF6FC29, 0x1B008B06, 0x73C17202
+      }
+   },
+   {
+      {
+         0x8A802ADE, 0x2FBF0084, 0x02302E27, 0xE5D9FECF,
+         0x17703406, 0x113E8471, 0x546D8FAF, 0x4275AAE2
+      },
+      {
+         0x49864348, 0x315F5B02, 0x77088381, 0x3ED6B369,
+         0x6A8DEB95, 0xA3A07555, 0x29D5C77F, 0x18AB5980
+      },
+      {
+         0xFD6089E9, 0xD82B2CC5, 0x3282E4A4, 0x031EB4A1,
+         0xB51A8622, 0x44311199, 0xB53DF948, 0x3DC65522
+      }
+   },
+   {
+      {
+         0xA2007F6D, 0xBF70C222, 0xB5BCDEDB, 0xBF84B39A,
+         0xFB07BA07, 0x537A0E12, 0xC346F241, 0x234FD7EE
+      },
+      {
+         0x327FBF93, 0x506F013B, 0x9B776F6B, 0xAEFCEBC9,
+         0xAAAD5968, 0x9D12B232, 0x176024A7, 0x0267882D
+      },
+      {
+         0x732EA378, 0x5360A119, 0xDF8DD471, 0x2437E6B1,
+         0x91A7E533, 0xA2EF37F8, 0xAA097863, 0x497BA6FD
+      }
+   },
+   {
+      {
+         0x13CFEAA0, 0x24CECC03, 0x189C246D, 0x8648C28D,
+         0xC1F2D4D0, 0x2DBDBDFA, 0xF12DE72B, 0x61E22917
+      },
+      {
+         0x468CCF0B, 0x040BCD86, 0x2A9910D6, 0xD3829BA4,
+         0x07B25192, 0x75083008, 0x18D05EBF, 0x43B5CD42
+      },
+      {
+         0x9BD0B516, 0x5D9A762F, 0x373FDEEE, 0xEB38AF4E,
+         0x93D64270, 0x032E5A7D, 0x0AE4D842, 0x511D6121
+      }
+   }
+};
+
+#endif
+
 //Order of the base point L
 static const uint8_t ED25519_L[33] =
 {
@@ -93,16 +382,53 @@ static const uint8_t ED25519_L[33] =
    0x00,
 };
 
-//Pre-computed value of mu = b^(2 * k) / L with b = 2^8 and k = 32
-static const uint8_t ED25519_MU[33] =
+#if (MPI_FIXED_WORD_SIZE == 64)
+
+//Order of the base point L
+static const MpiFixedWord ED25519_L_WORDS[4] =
+{
+   0x5812631A5CF5D3ED, 0x14DEF9DEA2F79CD6, 0x0000000000000000, 0x1000000000000000
+};
+
+//Pre-computed value of mu = b^(2 * k) / L with b = 2^64 and k = 4
+static const MpiFixedWord ED25519_MU_WORDS[5] =
+{
+   0xED9CE5A30A2C131B, 0x2106215D086329A7, 0xFFFFFFFFFFFFFFEB, 0xFFFFFFFFFFFFFFFF,
+   0x000000000000000F
+};
+
+#else
+
+//Order of the base point L
+static const MpiFixedWord ED25519_L_WORDS[8] =
+{
+   0x5CF5D3ED, 0x5812631A, 0xA2F79CD6, 0x14DEF9DE,
+   0x00000000, 0x00000000, 0x00000000, 0x10000000
+};
+
+//Pre-computed value of mu = b^(2 * k) / L with b = 2^32 and k = 8
+static const MpiFixedWord ED25519_MU_WORDS[9] =
 {
-   0x1B, 0x13, 0x2C, 0x0A, 0xA3, 0xE5, 0x9C, 0xED,
-   0xA7, 0x29, 0x63, 0x08, 0x5D, 0x21, 0x06, 0x21,
-   0xEB, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-   0x0F
+   0x0A2C131B, 0xED9CE5A3, 0x086329A7, 0x2106215D,
+   0xFFFFFFEB, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+   0x0000000F
 };
 
+#endif
+
+#if (ED25519_BASE_TABLE_SUPPORT == ENABLED)
+
+#if (EC_STATIC_TABLE_SUPPORT == ENABLED)
+//Registered base point table (the table compiled into the library is used
+//by default)
+static const Ed25519BaseTable *ed25519BaseTable = &ed25519StaticBaseTable;
+#else
+//Registered base point table
+static const Ed25519BaseTable *ed25519BaseTable = NULL;
+#endif
+
+#endif
+
 
 /**
  * @brief EdDSA key pair generation
@@ -197,7 +523,7 @@ error_t ed25519GeneratePublicKey(const uint8_t *privateKey, uint8_t *publicKey)
    s[31] |= 0x40;
 
    //Perform a fixed-base scalar multiplication s * B
-   ed25519Mul(state, &state->sb, s, &ED25519_B);
+   ed25519MulBase(state, &state->sb, s);
    //The public key A is the encoding of the point s * B
    ed25519Encode(&state->sb, publicKey);
 
@@ -264,7 +590,6 @@ error_t ed25519GenerateSignatureEx(const uint8_t *privateKey,
    const void *context, uint8_t contextLen, uint8_t flag, uint8_t *signature)
 {
    uint_t i;
-   uint8_t c;
    Ed25519State *state;
 
    //Check parameters
@@ -301,7 +626,7 @@ error_t ed25519GenerateSignatureEx(const uint8_t *privateKey,
    if(publicKey == NULL)
    {
       //Perform a fixed-base scalar multiplication s * B
-      ed25519Mul(state, &state->sb, state->s, &ED25519_B);
+      ed25519MulBase(state, &state->sb, state->s);
       //The public key A is the encoding of the point s * B
       ed25519Encode(&state->sb, state->k);
       //Point to the resulting public key
@@ -342,7 +667,7 @@ error_t ed25519GenerateSignatureEx(const uint8_t *privateKey,
    //Reduce the 64-octet digest as a little-endian integer r
    ed25519RedInt(state->r, state->sha512Context.digest);
    //Compute the point r * B
-   ed25519Mul(state, &state->rb, state->r, &ED25519_B);
+   ed25519MulBase(state, &state->rb, state->r);
    //Let the string R be the encoding of this point
    ed25519Encode(&state->rb, signature);
 
@@ -378,13 +703,7 @@ error_t ed25519GenerateSignatureEx(const uint8_t *privateKey,
 
    //Compute S = (r + k * s) mod L. For efficiency, reduce k modulo L first
    ed25519RedInt(state->p, state->k);
-   ed25519MulInt(state->k, state->k + 32, state->p, state->s, 32);
-   ed25519RedInt(state->p, state->k);
-   ed25519AddInt(state->s, state->p, state->r, 32);
-
-   //Perform modular reduction
-   c = ed25519SubInt(state->p, state->s, ED25519_L, 32);
-   ed25519SelectInt(signature + 32, state->p, state->s, c, 32);
+   ed25519MulAddInt(signature + 32, state->p, state->s, state->r);
 
    //Erase working state
    osMemset(state, 0, sizeof(Ed25519State));
@@ -445,13 +764,123 @@ error_t ed25519VerifySignature(const uint8_t *publicKey, const void *message,
 error_t ed25519VerifySignatureEx(const uint8_t *publicKey,
    const EddsaMessageChunk *messageChunks, const void *context,
    uint8_t contextLen, uint8_t flag, const uint8_t *signature)
+{
+   error_t error;
+   Ed25519VerifyKey *key;
+
+   //Check parameters
+   if(publicKey == NULL || signature == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a memory buffer to hold the verification key
+   key = cryptoAllocMem(sizeof(Ed25519VerifyKey));
+   //Failed to allocate memory?
+   if(key == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Decode the public key and compute its odd multiples
+   error = ed25519BuildVerifyKey(publicKey, key);
+
+   //Check status code
+   if(!error)
+   {
+      //Verify the signature
+      error = ed25519VerifySignatureWithKey(key, messageChunks, context,
+         contextLen, flag, signature);
+   }
+   else if(error == ERROR_INVALID_KEY)
+   {
+      //A public key that cannot be decoded invalidates the signature
+      error = ERROR_INVALID_SIGNATURE;
+   }
+
+   //Release the verification key
+   cryptoFreeMem(key);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Build an Ed25519 verification key
+ *
+ * The public key A is decoded once and the odd multiples of -A are
+ * precomputed, so that every subsequent verification saves the point
+ * decompression and most of the point additions
+ *
+ * @param[in] publicKey Signer's EdDSA public key (32 bytes)
+ * @param[out] key Resulting verification key
+ * @return Error code
+ **/
+
+error_t ed25519BuildVerifyKey(const uint8_t *publicKey, Ed25519VerifyKey *key)
 {
    uint_t i;
    uint32_t ret;
    Ed25519State *state;
 
    //Check parameters
-   if(publicKey == NULL || signature == NULL)
+   if(publicKey == NULL || key == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate working state
+   state = cryptoAllocMem(sizeof(Ed25519State));
+   //Failed to allocate memory?
+   if(state == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Save the encoded public key
+   osMemcpy(key->publicKey, publicKey, ED25519_PUBLIC_KEY_LEN);
+
+   //Decode the public key A as point A'
+   ret = ed25519Decode(&key->a[0], publicKey);
+
+   //Compute -A'
+   curve25519Sub(key->a[0].x, ED25519_ZERO, key->a[0].x);
+   curve25519Sub(key->a[0].t, ED25519_ZERO, key->a[0].t);
+
+   //Compute U = -2 * A'
+   ed25519Double(state, &state->u, &key->a[0]);
+
+   //Precompute the odd multiples -(2i + 1) * A'
+   for(i = 1; i < arraysize(key->a); i++)
+   {
+      ed25519Add(state, &key->a[i], &key->a[i - 1], &state->u);
+   }
+
+   //Erase working state
+   osMemset(state, 0, sizeof(Ed25519State));
+   //Release working state
+   cryptoFreeMem(state);
+
+   //Return status code
+   return (ret == 0) ? NO_ERROR : ERROR_INVALID_KEY;
+}
+
+
+/**
+ * @brief EdDSA signature verification using a verification key
+ * @param[in] key Signer's verification key
+ * @param[in] messageChunks Collection of chunks representing the message
+ *   whose signature is to be verified
+ * @param[in] context Constant string specified by the protocol using it
+ * @param[in] contextLen Length of the context, in bytes
+ * @param[in] flag Prehash flag for Ed25519ph scheme
+ * @param[in] signature EdDSA signature (64 bytes)
+ * @return Error code
+ **/
+
+error_t ed25519VerifySignatureWithKey(const Ed25519VerifyKey *key,
+   const EddsaMessageChunk *messageChunks, const void *context,
+   uint8_t contextLen, uint8_t flag, const uint8_t *signature)
+{
+   uint_t i;
+   uint32_t ret;
+   Ed25519State *state;
+
+   //Check parameters
+   if(key == NULL || signature == NULL)
       return ERROR_INVALID_PARAMETER;
    if(messageChunks == NULL)
       return ERROR_INVALID_PARAMETER;
@@ -477,9 +906,6 @@ error_t ed25519VerifySignatureEx(const uint8_t *publicKey,
    ret = 1 ^ ed25519SubInt(state->p, state->s, ED25519_L,
       ED25519_SIGNATURE_LEN / 2);
 
-   //Decode the public key A as point A'
-   ret |= ed25519Decode(&state->ka, publicKey);
-
    //Initialize SHA-512 context
    sha512Init(&state->sha512Context);
 
@@ -496,7 +922,7 @@ error_t ed25519VerifySignatureEx(const uint8_t *publicKey,
 
    //Digest R || A
    sha512Update(&state->sha512Context, state->r, ED25519_SIGNATURE_LEN / 2);
-   sha512Update(&state->sha512Context, publicKey, ED25519_PUBLIC_KEY_LEN);
+   sha512Update(&state->sha512Context, key->publicKey, ED25519_PUBLIC_KEY_LEN);
 
    //The message is split over multiple chunks
    for(i = 0; messageChunks[i].buffer != NULL; i++)
@@ -513,12 +939,11 @@ error_t ed25519VerifySignatureEx(const uint8_t *publicKey,
    //For efficiency, reduce k modulo L first
    ed25519RedInt(state->k, state->k);
 
-   //Compute the point P = s * B - k * A'
-   curve25519Sub(state->ka.x, ED25519_ZERO, state->ka.x);
-   curve25519Sub(state->ka.t, ED25519_ZERO, state->ka.t);
-   ed25519Mul(state, &state->sb, state->s, &ED25519_B);
-   ed25519Mul(state, &state->ka, state->k, &state->ka);
-   ed25519Add(state, &state->ka, &state->sb, &state->ka);
+   //Compute the point P = s * B - k * A'. All the values involved are
+   //public, so that both terms can be computed at once by interleaving
+   //their width-w NAF representations
+   ed25519MulWnafTwin(state, &state->ka, state->s, state->k, key->a,
+      ED25519_WNAF_WIDTH);
 
    //Encode of the resulting point P
    ed25519Encode(&state->ka, state->p);
@@ -538,41 +963,767 @@ error_t ed25519VerifySignatureEx(const uint8_t *publicKey,
 
 
 /**
- * @brief Scalar multiplication on Ed25519 curve
- * @param[in] state Pointer to the working state
- * @param[out] r Resulting point R = d * S
- * @param[in] k Input scalar
- * @param[in] p Input point
+ * @brief Batch verification of Ed25519 signatures
+ *
+ * The signatures are combined using random coefficients z[i], and the
+ * cofactored equation 8 * (S * B - sum(z[i] * (R[i] + k[i] * A[i]))) = 0,
+ * with S = sum(z[i] * s[i]), is checked using a single multi-scalar
+ * multiplication (refer to RFC 8032, section 5.1.7). Should the batch be
+ * rejected, each signature is checked individually, so that the result of
+ * every item is reported
+ *
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @param[in,out] items Signatures to be verified (the verification result of
+ *   each item is stored in its result field)
+ * @param[in] n Number of signatures
+ * @return Error code (NO_ERROR if all the signatures are valid)
  **/
 
-void ed25519Mul(Ed25519State *state, Ed25519Point *r, const uint8_t *k,
-   const Ed25519Point *p)
+error_t ed25519VerifySignatureBatch(const PrngAlgo *prngAlgo,
+   void *prngContext, Ed25519BatchItem *items, uint_t n)
 {
-   int_t i;
-   uint8_t b;
-
-   //The neutral element is represented by (0, 1, 1, 0)
-   curve25519SetInt(state->u.x, 0);
-   curve25519SetInt(state->u.y, 1);
-   curve25519SetInt(state->u.z, 1);
-   curve25519SetInt(state->u.t, 0);
+   error_t error;
+   uint_t i;
+   uint_t j;
+   uint_t m;
+   uint_t first;
+   uint32_t ret;
+   Ed25519BatchState *batch;
+   Ed25519State *state;
+
+   //Check parameters
+   if(prngAlgo == NULL || prngContext == NULL)
+      return ERROR_INVALID_PARAMETER;
+   if(items == NULL && n != 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate working state
+   batch = cryptoAllocMem(sizeof(Ed25519BatchState));
+   //Failed to allocate memory?
+   if(batch == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Point to the working state of the underlying operations
+   state = &batch->state;
+   //Initialize status code
+   error = NO_ERROR;
+
+   //The signatures are processed in chunks of ED25519_BATCH_SIZE items
+   for(first = 0; first < n && !error; first += m)
+   {
+      //Number of signatures in the current chunk
+      m = MIN(n - first, ED25519_BATCH_SIZE);
+
+      //The coefficient of the base point is accumulated in S
+      osMemset(state->s, 0, 32);
+
+      //Terms of the multi-scalar multiplication (the first one is S * B)
+      for(i = 0, j = 1; i < m; i++)
+      {
+         Ed25519BatchItem *item = &items[first + i];
+
+         //Check the parameters of the current item
+         if(item->publicKey == NULL || item->signature == NULL ||
+            (item->message == NULL && item->messageLen != 0))
+         {
+            item->result = ERROR_INVALID_PARAMETER;
+            continue;
+         }
+
+         //The second half of the signature must be in the range 0 <= s < L
+         ret = 1 ^ ed25519SubInt(state->p, item->signature + 32, ED25519_L,
+            32);
+
+         //Decode the public key A and the first half of the signature R
+         ret |= ed25519Decode(&batch->p[j], item->publicKey);
+         ret |= ed25519Decode(&batch->p[j + 1], item->signature);
+
+         //Malformed signature?
+         if(ret != 0)
+         {
+            item->result = ERROR_INVALID_SIGNATURE;
+            continue;
+         }
+
+         //Compute -A and -R
+         curve25519Sub(batch->p[j].x, ED25519_ZERO, batch->p[j].x);
+         curve25519Sub(batch->p[j].t, ED25519_ZERO, batch->p[j].t);
+         curve25519Sub(batch->p[j + 1].x, ED25519_ZERO, batch->p[j + 1].x);
+         curve25519Sub(batch->p[j + 1].t, ED25519_ZERO, batch->p[j + 1].t);
+
+         //Compute k = SHA512(R || A || M) mod L
+         sha512Init(&state->sha512Context);
+         sha512Update(&state->sha512Context, item->signature, 32);
+         sha512Update(&state->sha512Context, item->publicKey, 32);
+         sha512Update(&state->sha512Context, item->message, item->messageLen);
+         sha512Final(&state->sha512Context, state->k);
+         ed25519RedInt(state->k, state->k);
+
+         //Generate a random 128-bit coefficient z
+         osMemset(batch->z, 0, 32);
+         error = prngAlgo->read(prngContext, batch->z, 16);
+         //Any error to report?
+         if(error)
+            break;
+
+         //The coefficient of -R is z
+         osMemcpy(batch->k[j + 1], batch->z, 32);
+
+         //The coefficient of -A is z * k mod L
+         ed25519MulAddInt(batch->k[j], batch->z, state->k, NULL);
+         //Compute S = S + z * s mod L
+         ed25519MulAddInt(state->s, batch->z, item->signature + 32, state->s);
+
+         //Save the position of the item
+         batch->index[(j - 1) / 2] = first + i;
+         j += 2;
+      }
+
+      //Any error to report?
+      if(error)
+         break;
+
+      //The first term is S * B
+      curve25519Copy(batch->p[0].x, ED25519_B.x);
+      curve25519Copy(batch->p[0].y, ED25519_B.y);
+      curve25519Copy(batch->p[0].z, ED25519_B.z);
+      curve25519Copy(batch->p[0].t, ED25519_B.t);
+      osMemcpy(batch->k[0], state->s, 32);
+
+      //Compute Q = S * B - sum(z[i] * (R[i] + k[i] * A[i]))
+      error = ed25519MulMulti(state, &state->ka, batch->k, batch->p, j);
+      //Any error to report?
+      if(error)
+         break;
+
+      //Multiply the result by the cofactor
+      ed25519Double(state, &state->ka, &state->ka);
+      ed25519Double(state, &state->ka, &state->ka);
+      ed25519Double(state, &state->ka, &state->ka);
+
+      //The batch is valid if 8 * Q is the neutral element (0, 1)
+      ret = curve25519Comp(state->ka.x, ED25519_ZERO);
+      ret |= curve25519Comp(state->ka.y, state->ka.z);
+
+      //Loop through the well-formed signatures of the chunk
+      for(i = 0; i < (j - 1) / 2; i++)
+      {
+         Ed25519BatchItem *item = &items[batch->index[i]];
+
+         //If the batch is rejected, check the signature individually
+         if(ret == 0)
+         {
+            item->result = NO_ERROR;
+         }
+         else
+         {
+            item->result = ed25519VerifySignature(item->publicKey,
+               item->message, item->messageLen, NULL, 0, 0, item->signature);
+         }
+      }
+   }
+
+   //Check whether all the signatures are valid
+   for(i = 0; i < n && !error; i++)
+   {
+      if(items[i].result != NO_ERROR)
+         error = ERROR_INVALID_SIGNATURE;
+   }
+
+   //Erase working state
+   osMemset(batch, 0, sizeof(Ed25519BatchState));
+   //Release working state
+   cryptoFreeMem(batch);
+
+   //Return status code
+   return error;
+}
+
+
+#if (ED25519_BASE_TABLE_SUPPORT == ENABLED)
+
+/**
+ * @brief Build the precomputed multiples of the base point
+ * @param[out] table Resulting table
+ * @return Error code
+ **/
+
+error_t ed25519BuildBaseTable(Ed25519BaseTable *table)
+{
+   uint_t i;
+   uint_t j;
+   Ed25519State *state;
+
+   //Check parameters
+   if(table == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate working state
+   state = cryptoAllocMem(sizeof(Ed25519State));
+   //Failed to allocate memory?
+   if(state == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Start with V = B
+   curve25519Copy(state->v.x, ED25519_B.x);
+   curve25519Copy(state->v.y, ED25519_B.y);
+   curve25519Copy(state->v.z, ED25519_B.z);
+   curve25519Copy(state->v.t, ED25519_B.t);
+
+   //Loop through the rows of the table
+   for(i = 0; i < 32; i++)
+   {
+      //Compute the multiples j * V, for 1 <= j <= 8
+      curve25519Copy(state->u.x, state->v.x);
+      curve25519Copy(state->u.y, state->v.y);
+      curve25519Copy(state->u.z, state->v.z);
+      curve25519Copy(state->u.t, state->v.t);
+
+      for(j = 0; j < 8; j++)
+      {
+         //Compute U = (j + 1) * V
+         if(j > 0)
+         {
+            ed25519Add(state, &state->u, &state->u, &state->v);
+         }
+
+         //Retrieve the affine coordinates of U
+         curve25519Inv(state->a, state->u.z);
+         curve25519Mul(state->b, state->u.x, state->a);
+         curve25519Mul(state->c, state->u.y, state->a);
+
+         //Save the point as (y + x, y - x, 2 * d * x * y)
+         curve25519Add(table->points[i][j].yPlusX, state->c, state->b);
+         curve25519Sub(table->points[i][j].yMinusX, state->c, state->b);
+         curve25519Mul(state->d, state->b, state->c);
+         curve25519Mul(table->points[i][j].xy2d, state->d, ED25519_2D);
+      }
+
+      //Compute V = 256 * V
+      for(j = 0; j < 8; j++)
+      {
+         ed25519Double(state, &state->v, &state->v);
+      }
+   }
+
+   //Release working state
+   cryptoFreeMem(state);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Register precomputed multiples of the base point
+ *
+ * Once registered, the table is used by key generation and signature
+ * generation. It must remain valid as long as it is registered
+ *
+ * @param[in] table Pointer to the table (NULL to unregister)
+ * @return Error code
+ **/
+
+error_t ed25519RegisterBaseTable(const Ed25519BaseTable *table)
+{
+   //Save the table
+   ed25519BaseTable = table;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Get the registered base point table
+ * @return Pointer to the table (NULL if no table has been registered)
+ **/
+
+const Ed25519BaseTable *ed25519GetBaseTable(void)
+{
+   //Return the registered table
+   return ed25519BaseTable;
+}
+
+#endif
+
+
+/**
+ * @brief Scalar multiplication on Ed25519 curve
+ * @param[in] state Pointer to the working state
+ * @param[out] r Resulting point R = d * S
+ * @param[in] k Input scalar
+ * @param[in] p Input point
+ **/
+
+void ed25519Mul(Ed25519State *state, Ed25519Point *r, const uint8_t *k,
+   const Ed25519Point *p)
+{
+   int_t i;
+   uint8_t b;
+
+   //The neutral element is represented by (0, 1, 1, 0)
+   curve25519SetInt(state->u.x, 0);
+   curve25519SetInt(state->u.y, 1);
+   curve25519SetInt(state->u.z, 1);
+   curve25519SetInt(state->u.t, 0);
 
    //Perform scalar multiplication
    for(i = CURVE25519_BIT_LEN - 1; i >= 0; i--)
    {
-      //The scalar is processed in a left-to-right fashion
-      b = (k[i / 8] >> (i % 8)) & 1;
+      //The scalar is processed in a left-to-right fashion
+      b = (k[i / 8] >> (i % 8)) & 1;
+
+      //Compute U = 2 * U
+      ed25519Double(state, &state->u, &state->u);
+      //Compute V = U + P
+      ed25519Add(state, &state->v, &state->u, p);
+
+      //If b is set, then U = V
+      curve25519Select(state->u.x, state->u.x, state->v.x, b);
+      curve25519Select(state->u.y, state->u.y, state->v.y, b);
+      curve25519Select(state->u.z, state->u.z, state->v.z, b);
+      curve25519Select(state->u.t, state->u.t, state->v.t, b);
+   }
+
+   //Copy result
+   curve25519Copy(r->x, state->u.x);
+   curve25519Copy(r->y, state->u.y);
+   curve25519Copy(r->z, state->u.z);
+   curve25519Copy(r->t, state->u.t);
+}
+
+
+/**
+ * @brief Fixed-base scalar multiplication
+ *
+ * The registered base point table is used when available
+ *
+ * @param[in] state Pointer to the working state
+ * @param[out] r Resulting point R = k * B
+ * @param[in] k Input scalar (32 bytes)
+ **/
+
+void ed25519MulBase(Ed25519State *state, Ed25519Point *r, const uint8_t *k)
+{
+#if (ED25519_BASE_TABLE_SUPPORT == ENABLED)
+   //Any precomputed table?
+   if(ed25519BaseTable != NULL)
+   {
+      //Use the signed radix-16 method
+      ed25519MulBaseTable(state, r, k, ed25519BaseTable);
+   }
+   else
+#endif
+   {
+      //Use the double-and-add method
+      ed25519Mul(state, r, k, &ED25519_B);
+   }
+}
+
+
+#if (ED25519_BASE_TABLE_SUPPORT == ENABLED)
+
+/**
+ * @brief Fixed-base scalar multiplication using a precomputed table
+ *
+ * The scalar is recoded as k = e[0] + 16 * e[1] + ... + 16^63 * e[63], with
+ * -8 <= e[i] <= 8. Then k * B is the sum of the terms e[2i + 1] * 256^i * B,
+ * multiplied by 16, plus the sum of the terms e[2i] * 256^i * B. Each term is
+ * read from the table in constant time
+ *
+ * @param[in] state Pointer to the working state
+ * @param[out] r Resulting point R = k * B
+ * @param[in] k Input scalar (32 bytes, the most significant bit must be
+ *   cleared)
+ * @param[in] table Precomputed multiples of the base point
+ **/
+
+void ed25519MulBaseTable(Ed25519State *state, Ed25519Point *r,
+   const uint8_t *k, const Ed25519BaseTable *table)
+{
+   uint_t i;
+   int8_t c;
+   int8_t e[64];
+   Ed25519PrecompPoint q;
+
+   //Split the scalar into 4-bit digits
+   for(i = 0; i < 32; i++)
+   {
+      e[2 * i] = k[i] & 0x0F;
+      e[2 * i + 1] = (k[i] >> 4) & 0x0F;
+   }
+
+   //Recode the digits in the range -8 to 8
+   for(c = 0, i = 0; i < 63; i++)
+   {
+      e[i] += c;
+      c = (e[i] + 8) >> 4;
+      e[i] -= c * 16;
+   }
+
+   //The most significant digit absorbs the last carry
+   e[63] += c;
+
+   //The neutral element is represented by (0, 1, 1, 0)
+   curve25519SetInt(state->u.x, 0);
+   curve25519SetInt(state->u.y, 1);
+   curve25519SetInt(state->u.z, 1);
+   curve25519SetInt(state->u.t, 0);
+
+   //Accumulate the terms selected by the odd digits
+   for(i = 1; i < 64; i += 2)
+   {
+      ed25519SelectPrecomp(&q, table->points[i / 2], e[i]);
+      ed25519AddPrecomp(state, &state->u, &state->u, &q);
+   }
+
+   //Compute U = 16 * U
+   ed25519Double(state, &state->u, &state->u);
+   ed25519Double(state, &state->u, &state->u);
+   ed25519Double(state, &state->u, &state->u);
+   ed25519Double(state, &state->u, &state->u);
+
+   //Accumulate the terms selected by the even digits
+   for(i = 0; i < 64; i += 2)
+   {
+      ed25519SelectPrecomp(&q, table->points[i / 2], e[i]);
+      ed25519AddPrecomp(state, &state->u, &state->u, &q);
+   }
+
+   //Copy result
+   curve25519Copy(r->x, state->u.x);
+   curve25519Copy(r->y, state->u.y);
+   curve25519Copy(r->z, state->u.z);
+   curve25519Copy(r->t, state->u.t);
+
+   //The digits and the selected points depend on the secret scalar
+   osMemset(e, 0, sizeof(e));
+   osMemset(&q, 0, sizeof(Ed25519PrecompPoint));
+}
+
+#endif
+
+
+/**
+ * @brief Scalar multiplication using precomputed odd multiples
+ *
+ * The execution time depends on the value of the scalar, so that this
+ * function must only be used with public data
+ *
+ * @param[in] state Pointer to the working state
+ * @param[out] r Resulting point R = k * P
+ * @param[in] k Input scalar (32 bytes)
+ * @param[in] t Odd multiples T[i] = (2i + 1) * P
+ * @param[in] w Width of the NAF window (2^(w - 2) odd multiples)
+ **/
+
+void ed25519MulWnaf(Ed25519State *state, Ed25519Point *r, const uint8_t *k,
+   const Ed25519Point *t, uint_t w)
+{
+   uint_t i;
+   uint_t n;
+   int_t u;
+   int8_t naf[CURVE25519_BYTE_LEN * 8 + 1];
+
+   //Compute the width-w NAF representation of k
+   n = ed25519ComputeWnaf(naf, k, w);
+
+   //The neutral element is represented by (0, 1, 1, 0)
+   curve25519SetInt(state->u.x, 0);
+   curve25519SetInt(state->u.y, 1);
+   curve25519SetInt(state->u.z, 1);
+   curve25519SetInt(state->u.t, 0);
+
+   //The digits are processed in a left-to-right fashion
+   for(i = n; i > 0; i--)
+   {
+      //Compute U = 2 * U
+      ed25519Double(state, &state->u, &state->u);
+
+      //Retrieve the current digit
+      u = naf[i - 1];
+
+      //Check whether the digit is positive or negative
+      if(u > 0)
+      {
+         //Compute U = U + T[(u - 1) / 2]
+         ed25519Add(state, &state->u, &state->u, &t[(u - 1) / 2]);
+      }
+      else if(u < 0)
+      {
+         //Compute V = -T[(-u - 1) / 2]
+         curve25519Sub(state->v.x, ED25519_ZERO, t[(-u - 1) / 2].x);
+         curve25519Copy(state->v.y, t[(-u - 1) / 2].y);
+         curve25519Copy(state->v.z, t[(-u - 1) / 2].z);
+         curve25519Sub(state->v.t, ED25519_ZERO, t[(-u - 1) / 2].t);
+
+         //Compute U = U + V
+         ed25519Add(state, &state->u, &state->u, &state->v);
+      }
+   }
+
+   //Copy result
+   curve25519Copy(r->x, state->u.x);
+   curve25519Copy(r->y, state->u.y);
+   curve25519Copy(r->z, state->u.z);
+   curve25519Copy(r->t, state->u.t);
+}
+
+
+/**
+ * @brief Twin multiplication with the base point
+ *
+ * The execution time depends on the value of the scalars, so that this
+ * function must only be used with public data
+ *
+ * @param[in] state Pointer to the working state
+ * @param[out] r Resulting point R = s * B + k * P
+ * @param[in] s First scalar (32 bytes)
+ * @param[in] k Second scalar (32 bytes)
+ * @param[in] t Odd multiples T[i] = (2i + 1) * P
+ * @param[in] w Width of the NAF window used for P
+ **/
+
+void ed25519MulWnafTwin(Ed25519State *state, Ed25519Point *r,
+   const uint8_t *s, const uint8_t *k, const Ed25519Point *t, uint_t w)
+{
+   uint_t i;
+   uint_t n;
+   int_t u;
+   int8_t naf1[CURVE25519_BYTE_LEN * 8 + 1];
+   int8_t naf2[CURVE25519_BYTE_LEN * 8 + 1];
+   Ed25519PrecompPoint q;
+
+   //Compute the width-w NAF representations of s and k. Both recodings
+   //have the same number of entries, padded with zero digits
+   n = ed25519ComputeWnaf(naf1, s, ED25519_B_WNAF_WIDTH);
+   n = MAX(n, ed25519ComputeWnaf(naf2, k, w));
+
+   //The neutral element is represented by (0, 1, 1, 0)
+   curve25519SetInt(state->u.x, 0);
+   curve25519SetInt(state->u.y, 1);
+   curve25519SetInt(state->u.z, 1);
+   curve25519SetInt(state->u.t, 0);
+
+   //Both scalars share the same doublings
+   for(i = n; i > 0; i--)
+   {
+      //Compute U = 2 * U
+      ed25519Double(state, &state->u, &state->u);
+
+      //Retrieve the current digit of s
+      u = naf1[i - 1];
+
+      //Check whether the digit is positive or negative
+      if(u > 0)
+      {
+         //Compute U = U + (u * B)
+         ed25519AddPrecomp(state, &state->u, &state->u,
+            &ED25519_B_ODD[(u - 1) / 2]);
+      }
+      else if(u < 0)
+      {
+         //The negative of (y + x, y - x, 2 * d * x * y) is obtained by
+         //swapping the first two coordinates and negating the third one
+         curve25519Copy(q.yPlusX, ED25519_B_ODD[(-u - 1) / 2].yMinusX);
+         curve25519Copy(q.yMinusX, ED25519_B_ODD[(-u - 1) / 2].yPlusX);
+         curve25519Sub(q.xy2d, ED25519_ZERO, ED25519_B_ODD[(-u - 1) / 2].xy2d);
+
+         //Compute U = U - (-u * B)
+         ed25519AddPrecomp(state, &state->u, &state->u, &q);
+      }
+
+      //Retrieve the current digit of k
+      u = naf2[i - 1];
+
+      //Check whether the digit is positive or negative
+      if(u > 0)
+      {
+         //Compute U = U + T[(u - 1) / 2]
+         ed25519Add(state, &state->u, &state->u, &t[(u - 1) / 2]);
+      }
+      else if(u < 0)
+      {
+         //Compute V = -T[(-u - 1) / 2]
+         curve25519Sub(state->v.x, ED25519_ZERO, t[(-u - 1) / 2].x);
+         curve25519Copy(state->v.y, t[(-u - 1) / 2].y);
+         curve25519Copy(state->v.z, t[(-u - 1) / 2].z);
+         curve25519Sub(state->v.t, ED25519_ZERO, t[(-u - 1) / 2].t);
+
+         //Compute U = U + V
+         ed25519Add(state, &state->u, &state->u, &state->v);
+      }
+   }
+
+   //Copy result
+   curve25519Copy(r->x, state->u.x);
+   curve25519Copy(r->y, state->u.y);
+   curve25519Copy(r->z, state->u.z);
+   curve25519Copy(r->t, state->u.t);
+}
+
+
+/**
+ * @brief Multi-scalar multiplication
+ *
+ * Pippenger's bucket method is used. The scalars are recoded with signed
+ * digits in radix 2^c, and the points sharing the same digit value are
+ * accumulated into a common bucket, so that the cost per term decreases
+ * as the number of terms grows. The execution time depends on the value
+ * of the scalars, so that this function must only be used with public data
+ *
+ * @param[in] state Pointer to the working state
+ * @param[out] r Resulting point R = k[0] * P[0] + ... + k[n - 1] * P[n - 1]
+ * @param[in] k Scalars (32 bytes each)
+ * @param[in] p Points
+ * @param[in] n Number of terms
+ * @return Error code
+ **/
+
+error_t ed25519MulMulti(Ed25519State *state, Ed25519Point *r,
+   const uint8_t (*k)[32], const Ed25519Point *p, uint_t n)
+{
+   uint_t i;
+   uint_t j;
+   uint_t c;
+   uint_t m;
+   uint_t w;
+   uint_t cost;
+   uint_t bits;
+   uint_t carry;
+   int_t u;
+   int16_t *digits;
+   Ed25519Point *buckets;
+
+   //Select the window size that minimizes the number of point additions.
+   //Each of the ceil(256 / c) windows costs n additions for the terms plus
+   //2^c additions for the aggregation of the 2^(c - 1) buckets
+   for(c = 2, cost = 0, i = 2; i <= ED25519_MULTI_MAX_WINDOW; i++)
+   {
+      j = ((256 + i - 1) / i + 1) * (n + (1U << i));
+
+      if(cost == 0 || j < cost)
+      {
+         c = i;
+         cost = j;
+      }
+   }
+
+   //Number of signed digits (the last one absorbs the final carry)
+   m = (256 + c - 1) / c + 1;
+
+   //Allocate memory
+   digits = cryptoAllocMem(n * m * sizeof(int16_t));
+   buckets = cryptoAllocMem((1U << (c - 1)) * sizeof(Ed25519Point));
+
+   //Failed to allocate memory?
+   if(digits == NULL || buckets == NULL)
+   {
+      //Clean up side effects
+      if(digits != NULL)
+         cryptoFreeMem(digits);
+      if(buckets != NULL)
+         cryptoFreeMem(buckets);
 
-      //Compute U = 2 * U
-      ed25519Double(state, &state->u, &state->u);
-      //Compute V = U + P
-      ed25519Add(state, &state->v, &state->u, p);
+      //Report an error
+      return ERROR_OUT_OF_MEMORY;
+   }
 
-      //If b is set, then U = V
-      curve25519Select(state->u.x, state->u.x, state->v.x, b);
-      curve25519Select(state->u.y, state->u.y, state->v.y, b);
-      curve25519Select(state->u.z, state->u.z, state->v.z, b);
-      curve25519Select(state->u.t, state->u.t, state->v.t, b);
+   //Recode each scalar with digits in the range -2^(c - 1) < d <= 2^(c - 1)
+   for(i = 0; i < n; i++)
+   {
+      for(carry = 0, w = 0; w < m; w++)
+      {
+         //Extract the next c bits and add the pending carry
+         for(bits = carry, j = 0; j < c; j++)
+         {
+            if((w * c + j) < 256)
+            {
+               bits += ((k[i][(w * c + j) / 8] >> ((w * c + j) % 8)) & 1) << j;
+            }
+         }
+
+         //Select the signed digit
+         if(bits > (1U << (c - 1)))
+         {
+            digits[i * m + w] = (int16_t) bits - (int16_t) (1U << c);
+            carry = 1;
+         }
+         else
+         {
+            digits[i * m + w] = (int16_t) bits;
+            carry = 0;
+         }
+      }
+   }
+
+   //The neutral element is represented by (0, 1, 1, 0)
+   curve25519SetInt(state->u.x, 0);
+   curve25519SetInt(state->u.y, 1);
+   curve25519SetInt(state->u.z, 1);
+   curve25519SetInt(state->u.t, 0);
+
+   //The windows are processed in a left-to-right fashion
+   for(w = m; w > 0; w--)
+   {
+      //Compute U = 2^c * U
+      for(j = 0; j < c && w < m; j++)
+      {
+         ed25519Double(state, &state->u, &state->u);
+      }
+
+      //Empty the buckets
+      for(j = 0; j < (1U << (c - 1)); j++)
+      {
+         curve25519SetInt(buckets[j].x, 0);
+         curve25519SetInt(buckets[j].y, 1);
+         curve25519SetInt(buckets[j].z, 1);
+         curve25519SetInt(buckets[j].t, 0);
+      }
+
+      //Add each point to the bucket matching its digit
+      for(i = 0; i < n; i++)
+      {
+         u = digits[i * m + w - 1];
+
+         //Check whether the digit is positive or negative
+         if(u > 0)
+         {
+            ed25519Add(state, &buckets[u - 1], &buckets[u - 1], &p[i]);
+         }
+         else if(u < 0)
+         {
+            //Compute V = -P[i]
+            curve25519Sub(state->v.x, ED25519_ZERO, p[i].x);
+            curve25519Copy(state->v.y, p[i].y);
+            curve25519Copy(state->v.z, p[i].z);
+            curve25519Sub(state->v.t, ED25519_ZERO, p[i].t);
+
+            ed25519Add(state, &buckets[-u - 1], &buckets[-u - 1], &state->v);
+         }
+      }
+
+      //Compute the sum of j * S[j - 1] with running sums
+      curve25519Copy(state->v.x, buckets[(1U << (c - 1)) - 1].x);
+      curve25519Copy(state->v.y, buckets[(1U << (c - 1)) - 1].y);
+      curve25519Copy(state->v.z, buckets[(1U << (c - 1)) - 1].z);
+      curve25519Copy(state->v.t, buckets[(1U << (c - 1)) - 1].t);
+
+      curve25519Copy(state->ka.x, state->v.x);
+      curve25519Copy(state->ka.y, state->v.y);
+      curve25519Copy(state->ka.z, state->v.z);
+      curve25519Copy(state->ka.t, state->v.t);
+
+      for(j = (1U << (c - 1)) - 1; j > 0; j--)
+      {
+         ed25519Add(state, &state->v, &state->v, &buckets[j - 1]);
+         ed25519Add(state, &state->ka, &state->ka, &state->v);
+      }
+
+      //Accumulate the contribution of the current window
+      ed25519Add(state, &state->u, &state->u, &state->ka);
    }
 
    //Copy result
@@ -580,6 +1731,95 @@ void ed25519Mul(Ed25519State *state, Ed25519Point *r, const uint8_t *k,
    curve25519Copy(r->y, state->u.y);
    curve25519Copy(r->z, state->u.z);
    curve25519Copy(r->t, state->u.t);
+
+   //Release previously allocated memory
+   cryptoFreeMem(digits);
+   cryptoFreeMem(buckets);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Width-w NAF recoding of a scalar
+ * @param[out] naf Digits of the width-w NAF, least significant first (257
+ *   entries)
+ * @param[in] k Input scalar (32 bytes, little-endian)
+ * @param[in] w Window size (2 <= w <= 8)
+ * @return Number of digits (the most significant digit is nonzero)
+ **/
+
+uint_t ed25519ComputeWnaf(int8_t *naf, const uint8_t *k, uint_t w)
+{
+   uint_t i;
+   uint_t j;
+   uint_t n;
+   uint_t c;
+   int_t u;
+
+   //The width-w NAF of k is at most one digit longer than k
+   n = CURVE25519_BYTE_LEN * 8 + 1;
+
+   //Compute the digits from right to left
+   for(i = 0, c = 0; i < n; )
+   {
+      //Extract the next w bits of k and add the pending carry
+      for(u = c, j = 0; j < w; j++)
+      {
+         if((i + j) < (CURVE25519_BYTE_LEN * 8))
+         {
+            u += ((k[(i + j) / 8] >> ((i + j) % 8)) & 1) << j;
+         }
+      }
+
+      //Odd window?
+      if((u & 1) != 0)
+      {
+         //Select the digit in the range -2^(w-1) < u < 2^(w-1)
+         if(u >= (1 << (w - 1)))
+         {
+            u -= 1 << w;
+            c = 1;
+         }
+         else
+         {
+            c = 0;
+         }
+
+         //Save the nonzero digit
+         naf[i++] = (int8_t) u;
+
+         //A nonzero digit is always followed by w - 1 zero digits
+         for(j = 1; j < w && i < n; j++)
+         {
+            naf[i++] = 0;
+         }
+      }
+      else
+      {
+         //Propagate the carry
+         if(i < (CURVE25519_BYTE_LEN * 8))
+         {
+            c = (((k[i / 8] >> (i % 8)) & 1) + c) >> 1;
+         }
+         else
+         {
+            c = 0;
+         }
+
+         naf[i++] = 0;
+      }
+   }
+
+   //Skip leading zero digits
+   while(n > 0 && naf[n - 1] == 0)
+   {
+      n--;
+   }
+
+   //Return the number of digits
+   return n;
 }
 
 
@@ -627,6 +1867,96 @@ void ed25519Add(Ed25519State *state, Ed25519Point *r, const Ed25519Point *p,
 }
 
 
+/**
+ * @brief Point addition with a precomputed point
+ * @param[in] state Pointer to the working state
+ * @param[out] r Resulting point R = P + Q
+ * @param[in] p First operand
+ * @param[in] q Second operand (precomputed affine point)
+ **/
+
+void ed25519AddPrecomp(Ed25519State *state, Ed25519Point *r,
+   const Ed25519Point *p, const Ed25519PrecompPoint *q)
+{
+   //Compute A = (Y1 + X1) * (y2 + x2)
+   curve25519Add(state->c, p->y, p->x);
+   curve25519Mul(state->a, state->c, q->yPlusX);
+   //Compute B = (Y1 - X1) * (y2 - x2)
+   curve25519Sub(state->c, p->y, p->x);
+   curve25519Mul(state->b, state->c, q->yMinusX);
+   //Compute C = 2 * Z1
+   curve25519Add(state->c, p->z, p->z);
+   //Compute D = T1 * (2 * d * x2 * y2)
+   curve25519Mul(state->d, p->t, q->xy2d);
+   //Compute E = A + B
+   curve25519Add(state->e, state->a, state->b);
+   //Compute F = A - B
+   curve25519Sub(state->f, state->a, state->b);
+   //Compute G = C + D
+   curve25519Add(state->g, state->c, state->d);
+   //Compute H = C - D
+   curve25519Sub(state->h, state->c, state->d);
+   //Compute X3 = F * H
+   curve25519Mul(r->x, state->f, state->h);
+   //Compute Y3 = E * G
+   curve25519Mul(r->y, state->e, state->g);
+   //Compute Z3 = G * H
+   curve25519Mul(r->z, state->g, state->h);
+   //Compute T3 = E * F
+   curve25519Mul(r->t, state->e, state->f);
+}
+
+
+#if (ED25519_BASE_TABLE_SUPPORT == ENABLED)
+
+/**
+ * @brief Select a precomputed point in constant time
+ * @param[out] r Resulting point R = b * T[0]
+ * @param[in] t Precomputed multiples T[j - 1] = j * T[0], for 1 <= j <= 8
+ * @param[in] b Signed digit in the range -8 to 8
+ **/
+
+void ed25519SelectPrecomp(Ed25519PrecompPoint *r,
+   const Ed25519PrecompPoint *t, int8_t b)
+{
+   uint_t i;
+   uint32_t c;
+   uint32_t neg;
+   uint32_t v;
+   Curve25519Limb u[CURVE25519_LIMB_LEN];
+
+   //Retrieve the sign and the absolute value of the digit
+   neg = ((uint8_t) b) >> 7;
+   v = (uint32_t) ((b ^ -(int_t) neg) + (int_t) neg);
+
+   //The neutral element is represented by (1, 1, 0)
+   curve25519SetInt(r->yPlusX, 1);
+   curve25519SetInt(r->yMinusX, 1);
+   curve25519SetInt(r->xy2d, 0);
+
+   //Read every entry of the row, so that the memory access pattern does not
+   //depend on the digit
+   for(i = 0; i < 8; i++)
+   {
+      //Check whether the entry matches the absolute value of the digit
+      c = ((v ^ (i + 1)) - 1) >> 31;
+
+      //Constant time implementation
+      curve25519Select(r->yPlusX, r->yPlusX, t[i].yPlusX, c);
+      curve25519Select(r->yMinusX, r->yMinusX, t[i].yMinusX, c);
+      curve25519Select(r->xy2d, r->xy2d, t[i].xy2d, c);
+   }
+
+   //The negative of (y + x, y - x, 2 * d * x * y) is obtained by swapping
+   //the first two coordinates and negating the third one
+   curve25519Swap(r->yPlusX, r->yMinusX, neg);
+   curve25519Sub(u, ED25519_ZERO, r->xy2d);
+   curve25519Select(r->xy2d, r->xy2d, u, neg);
+}
+
+#endif
+
+
 /**
  * @brief Point doubling
  * @param[in] state Pointer to the working state
@@ -685,6 +2015,7 @@ void ed25519Encode(Ed25519Point *p, uint8_t *data)
 
    //Copy the least significant bit of the x-coordinate to the most significant
    //bit of the final octet
+   curve25519Red(p->x, p->x);
    data[31] |= (p->x[0] & 1) << 7;
 }
 
@@ -700,29 +2031,29 @@ uint32_t ed25519Decode(Ed25519Point *p, const uint8_t *data)
    uint_t i;
    uint8_t x0;
    uint32_t ret;
-   uint64_t temp;
-   uint32_t u[8];
-   uint32_t v[8];
+   Curve25519Limb mask;
+   Curve25519Limb u[CURVE25519_LIMB_LEN];
+   Curve25519Limb v[CURVE25519_LIMB_LEN];
 
    //First, interpret the string as an integer in little-endian representation.
    //Bit 255 of this number is the least significant bit of the x-coordinate
    //and denote this value x_0
    x0 = data[31] >> 7;
 
-   //The y-coordinate is recovered simply by clearing this bit
+   //The y-coordinate is recovered simply by clearing this bit (this is done
+   //by curve25519Import)
    curve25519Import(p->y, data);
-   p->y[7] &= 0x7FFFFFFF;
 
-   //Compute u = y + 19
-   for(temp = 19, i = 0; i < 8; i++)
+   //Reduce the y-coordinate modulo p
+   curve25519Red(u, p->y);
+
+   //If the y-coordinate is >= p, decoding fails
+   for(mask = 0, i = 0; i < CURVE25519_LIMB_LEN; i++)
    {
-      temp += p->y[i];
-      u[i] = temp & 0xFFFFFFFF;
-      temp >>= 32;
+      mask |= u[i] ^ p->y[i];
    }
 
-   //If the y-coordinate is >= p, decoding fails
-   ret = (u[7] >> 31) & 1;
+   ret = (uint32_t) ((mask | (~mask + 1)) >> (sizeof(Curve25519Limb) * 8 - 1));
 
    //The curve equation implies x^2 = (y^2 - 1) / (d * y^2 + 1) mod p
    //Let u = y^2 - 1 and v = d * y^2 + 1
@@ -733,6 +2064,8 @@ uint32_t ed25519Decode(Ed25519Point *p, const uint8_t *data)
 
    //Compute u = sqrt(u / v)
    ret |= curve25519Sqrt(u, u, v);
+   //The parity is checked on the canonical representative of u
+   curve25519Red(u, u);
 
    //If x = 0, and x_0 = 1, decoding fails
    ret |= (curve25519Comp(u, ED25519_ZERO) ^ 1) & x0;
@@ -753,39 +2086,241 @@ uint32_t ed25519Decode(Ed25519Point *p, const uint8_t *data)
 
 
 /**
- * @brief Reduce an integer modulo L
+ * @brief Load a little-endian integer into words
+ * @param[out] r Resulting integer, least significant word first
+ * @param[in] n Size of the resulting integer, in words
+ * @param[in] a Little-endian integer
+ * @param[in] length Length of the little-endian integer, in bytes
+ **/
+
+static void ed25519LoadWords(MpiFixedWord *r, uint_t n, const uint8_t *a,
+   uint_t length)
+{
+   uint_t i;
+
+   //Clear the resulting integer
+   for(i = 0; i < n; i++)
+   {
+      r[i] = 0;
+   }
+
+   //Convert the little-endian integer
+   for(i = 0; i < length && (i / sizeof(MpiFixedWord)) < n; i++)
+   {
+      r[i / sizeof(MpiFixedWord)] |= (MpiFixedWord) a[i] <<
+         ((i % sizeof(MpiFixedWord)) * 8);
+   }
+}
+
+
+/**
+ * @brief Store an integer as a little-endian octet string
+ * @param[out] r Little-endian integer
+ * @param[in] length Length of the little-endian integer, in bytes
+ * @param[in] a Integer to be stored, least significant word first
+ * @param[in] n Size of the integer, in words
+ **/
+
+static void ed25519StoreWords(uint8_t *r, uint_t length, const MpiFixedWord *a,
+   uint_t n)
+{
+   uint_t i;
+
+   //Convert the integer to little-endian format
+   for(i = 0; i < length; i++)
+   {
+      if((i / sizeof(MpiFixedWord)) < n)
+      {
+         r[i] = (uint8_t) (a[i / sizeof(MpiFixedWord)] >>
+            ((i % sizeof(MpiFixedWord)) * 8));
+      }
+      else
+      {
+         r[i] = 0;
+      }
+   }
+}
+
+
+/**
+ * @brief Multiplication of two integers
+ * @param[out] r Resulting integer R = A * B (m + n words)
+ * @param[in] a First operand A (m words)
+ * @param[in] m Size of the first operand, in words
+ * @param[in] b Second operand B (n words)
+ * @param[in] n Size of the second operand, in words
+ **/
+
+static void ed25519MulWords(MpiFixedWord *r, const MpiFixedWord *a, uint_t m,
+   const MpiFixedWord *b, uint_t n)
+{
+   uint_t i;
+   uint_t j;
+   MpiFixedWord c;
+
+   //Clear the resulting integer
+   for(i = 0; i < (m + n); i++)
+   {
+      r[i] = 0;
+   }
+
+   //Schoolbook multiplication
+   for(i = 0; i < m; i++)
+   {
+      //Compute R = R + a[i] * B * b^i
+      for(c = 0, j = 0; j < n; j++)
+      {
+         MPI_FIXED_MUL_ACC(r[i + j], a[i], b[j], c);
+      }
+
+      //Save the carry
+      r[i + n] = c;
+   }
+}
+
+
+/**
+ * @brief Subtraction of two integers
+ * @param[out] r Resulting integer R = A - B
+ * @param[in] a First operand A
+ * @param[in] b Second operand B
+ * @param[in] n Size of the operands, in words
+ * @return 1 if the result is negative, else 0
+ **/
+
+static MpiFixedWord ed25519SubWords(MpiFixedWord *r, const MpiFixedWord *a,
+   const MpiFixedWord *b, uint_t n)
+{
+   uint_t i;
+   MpiFixedWord c;
+   MpiFixedDword temp;
+
+   //Compute R = A - B
+   for(c = 0, i = 0; i < n; i++)
+   {
+      temp = (MpiFixedDword) a[i] - b[i] - c;
+      r[i] = (MpiFixedWord) temp;
+      c = (MpiFixedWord) (temp >> MPI_FIXED_WORD_SIZE) & 1;
+   }
+
+   //Return 1 if the result of the subtraction is negative
+   return c;
+}
+
+
+/**
+ * @brief Barrett reduction modulo L
  *
- * This function implements Barrett reduction with b = 2^8 and k = 32. The
- * algorithm requires the precomputation of the quantity mu = b^(2 * k) / L
+ * The reduction operates on words of w bits, where w is the word size of
+ * the fixed-width kernels, with b = 2^w and k = 256 / w. The algorithm
+ * requires the precomputation of the quantity mu = b^(2 * k) / L
  *
- * @param[out] r Resulting integer R = A mod L
- * @param[in] a An integer such as 0 <= A < b^(2 * k)
+ * @param[out] r Resulting integer R = A mod L (k words)
+ * @param[in] a An integer such as 0 <= A < b^(2 * k) (2 * k words)
  **/
 
-void ed25519RedInt(uint8_t *r, const uint8_t *a)
+static void ed25519RedWords(MpiFixedWord *r, const MpiFixedWord *a)
 {
-   uint8_t c;
-   uint8_t u[33];
-   uint8_t v[33];
+   uint_t i;
+   uint_t j;
+   MpiFixedWord c;
+   MpiFixedWord q[2 * ED25519_SCALAR_WORDS + 2];
+   MpiFixedWord v[2 * ED25519_SCALAR_WORDS + 1];
+   MpiFixedWord u[ED25519_SCALAR_WORDS];
+
+   //Compute the estimate of the quotient q = ((a / b^(k - 1)) * mu) / b^(k + 1)
+   ed25519MulWords(q, a + ED25519_SCALAR_WORDS - 1, ED25519_SCALAR_WORDS + 1,
+      ED25519_MU_WORDS, ED25519_SCALAR_WORDS + 1);
 
-   //Compute the estimate of the quotient u = ((a / b^(k - 1)) * mu) / b^(k + 1)
-   ed25519MulInt(NULL, u, a + 31, ED25519_MU, 33);
-   //Compute v = u * L mod b^(k + 1)
-   ed25519MulInt(v, NULL, u, ED25519_L, 33);
+   //Compute v = q * L
+   ed25519MulWords(v, q + ED25519_SCALAR_WORDS + 1, ED25519_SCALAR_WORDS + 1,
+      ED25519_L_WORDS, ED25519_SCALAR_WORDS);
 
-   //Compute the estimate of the remainder u = a mod b^(k + 1) - v
-   //If u < 0, then u = u + b^(k + 1)
-   ed25519SubInt(u, a, v, 33);
+   //The estimate of the remainder a - v is less than 3 * L, so that it can be
+   //computed modulo b^k
+   ed25519SubWords(r, a, v, ED25519_SCALAR_WORDS);
 
    //This estimation implies that at most two subtractions of L are required to
    //obtain the correct remainder r
-   c = ed25519SubInt(v, u, ED25519_L, 33);
-   ed25519SelectInt(u, v, u, c, 33);
-   c = ed25519SubInt(v, u, ED25519_L, 33);
-   ed25519SelectInt(u, v, u, c, 33);
+   for(j = 0; j < 2; j++)
+   {
+      c = ed25519SubWords(u, r, ED25519_L_WORDS, ED25519_SCALAR_WORDS);
+
+      //Constant time implementation
+      for(i = 0; i < ED25519_SCALAR_WORDS; i++)
+      {
+         r[i] = (u[i] & (c - 1)) | (r[i] & ~(c - 1));
+      }
+   }
+}
+
+
+/**
+ * @brief Reduce an integer modulo L
+ * @param[out] r Resulting integer R = A mod L
+ * @param[in] a An integer such as 0 <= A < 2^512
+ **/
+
+void ed25519RedInt(uint8_t *r, const uint8_t *a)
+{
+   MpiFixedWord u[2 * ED25519_SCALAR_WORDS];
+   MpiFixedWord v[ED25519_SCALAR_WORDS];
 
+   //Convert the 64-octet integer to words
+   ed25519LoadWords(u, 2 * ED25519_SCALAR_WORDS, a, 64);
+   //Perform Barrett reduction
+   ed25519RedWords(v, u);
    //Copy the resulting remainder
-   ed25519CopyInt(r, u, 32);
+   ed25519StoreWords(r, 32, v, ED25519_SCALAR_WORDS);
+}
+
+
+/**
+ * @brief Modular multiplication and addition
+ * @param[out] r Resulting integer R = (A * B + C) mod L
+ * @param[in] a An integer such as 0 <= A < 2^256
+ * @param[in] b An integer such as 0 <= B < 2^256
+ * @param[in] c An integer such as 0 <= C < 2^256 (may be NULL)
+ **/
+
+void ed25519MulAddInt(uint8_t *r, const uint8_t *a, const uint8_t *b,
+   const uint8_t *c)
+{
+   uint_t i;
+   MpiFixedDword temp;
+   MpiFixedWord u[ED25519_SCALAR_WORDS];
+   MpiFixedWord v[ED25519_SCALAR_WORDS];
+   MpiFixedWord w[2 * ED25519_SCALAR_WORDS];
+
+   //Compute W = A * B
+   ed25519LoadWords(u, ED25519_SCALAR_WORDS, a, 32);
+   ed25519LoadWords(v, ED25519_SCALAR_WORDS, b, 32);
+   ed25519MulWords(w, u, ED25519_SCALAR_WORDS, v, ED25519_SCALAR_WORDS);
+
+   //The addend is optional
+   if(c != NULL)
+   {
+      ed25519LoadWords(u, ED25519_SCALAR_WORDS, c, 32);
+
+      //Compute W = W + C. The result is always less than 2^512
+      for(temp = 0, i = 0; i < (2 * ED25519_SCALAR_WORDS); i++)
+      {
+         temp += w[i];
+
+         if(i < ED25519_SCALAR_WORDS)
+         {
+            temp += u[i];
+         }
+
+         w[i] = (MpiFixedWord) temp;
+         temp >>= MPI_FIXED_WORD_SIZE;
+      }
+   }
+
+   //Perform Barrett reduction
+   ed25519RedWords(u, w);
+   //Copy the result
+   ed25519StoreWords(r, 32, u, ED25519_SCALAR_WORDS);
 }
 
 
@@ -34,6 +34,7 @@
 //Dependencies
 #include "core/crypto.h"
 #include "ecc/eddsa.h"
+#include "ecc/curve25519.h"
 #include "hash/sha512.h"
 
 //Length of EdDSA private keys
@@ -48,6 +49,34 @@
 //Prehash function output size
 #define ED25519_PH_SIZE 64
 
+//Width of the NAF window used by verification keys
+#ifndef ED25519_WNAF_WIDTH
+   #define ED25519_WNAF_WIDTH 5
+#elif (ED25519_WNAF_WIDTH < 2 || ED25519_WNAF_WIDTH > 8)
+   #error ED25519_WNAF_WIDTH parameter is not valid
+#endif
+
+//Maximum number of signatures combined by batch verification
+#ifndef ED25519_BATCH_SIZE
+   #define ED25519_BATCH_SIZE 64
+#elif (ED25519_BATCH_SIZE < 1)
+   #error ED25519_BATCH_SIZE parameter is not valid
+#endif
+
+//Maximum window size of the multi-scalar multiplication
+#ifndef ED25519_MULTI_MAX_WINDOW
+   #define ED25519_MULTI_MAX_WINDOW 10
+#elif (ED25519_MULTI_MAX_WINDOW < 2 || ED25519_MULTI_MAX_WINDOW > 14)
+   #error ED25519_MULTI_MAX_WINDOW parameter is not valid
+#endif
+
+//Precomputed base point table support
+#ifndef ED25519_BASE_TABLE_SUPPORT
+   #define ED25519_BASE_TABLE_SUPPORT DISABLED
+#elif (ED25519_BASE_TABLE_SUPPORT != ENABLED && ED25519_BASE_TABLE_SUPPORT != DISABLED)
+   #error ED25519_BASE_TABLE_SUPPORT parameter is not valid
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 extern "C" {
@@ -60,10 +89,10 @@ extern "C" {
 
 typedef struct
 {
-   uint32_t x[8];
-   uint32_t y[8];
-   uint32_t z[8];
-   uint32_t t[8];
+   Curve25519Limb x[CURVE25519_LIMB_LEN];
+   Curve25519Limb y[CURVE25519_LIMB_LEN];
+   Curve25519Limb z[CURVE25519_LIMB_LEN];
+   Curve25519Limb t[CURVE25519_LIMB_LEN];
 } Ed25519Point;
 
 
@@ -83,17 +112,78 @@ typedef struct
    Ed25519Point sb;
    Ed25519Point u;
    Ed25519Point v;
-   uint32_t a[8];
-   uint32_t b[8];
-   uint32_t c[8];
-   uint32_t d[8];
-   uint32_t e[8];
-   uint32_t f[8];
-   uint32_t g[8];
-   uint32_t h[8];
+   Curve25519Limb a[CURVE25519_LIMB_LEN];
+   Curve25519Limb b[CURVE25519_LIMB_LEN];
+   Curve25519Limb c[CURVE25519_LIMB_LEN];
+   Curve25519Limb d[CURVE25519_LIMB_LEN];
+   Curve25519Limb e[CURVE25519_LIMB_LEN];
+   Curve25519Limb f[CURVE25519_LIMB_LEN];
+   Curve25519Limb g[CURVE25519_LIMB_LEN];
+   Curve25519Limb h[CURVE25519_LIMB_LEN];
 } Ed25519State;
 
 
+/**
+ * @brief Ed25519 verification key (precomputed odd multiples of -A)
+ **/
+
+typedef struct
+{
+   uint8_t publicKey[ED25519_PUBLIC_KEY_LEN];      ///<Encoded public key
+   Ed25519Point a[1 << (ED25519_WNAF_WIDTH - 2)]; ///<Odd multiples of -A
+} Ed25519VerifyKey;
+
+
+/**
+ * @brief Signature to be checked by batch verification
+ **/
+
+typedef struct
+{
+   const uint8_t *publicKey; ///<Signer's EdDSA public key (32 bytes)
+   const void *message;      ///<Message whose signature is to be verified
+   size_t messageLen;        ///<Length of the message, in bytes
+   const uint8_t *signature; ///<EdDSA signature (64 bytes)
+   error_t result;           ///<Verification result
+} Ed25519BatchItem;
+
+
+/**
+ * @brief Working state of batch verification
+ **/
+
+typedef struct
+{
+   Ed25519State state;
+   uint8_t z[32];
+   uint_t index[ED25519_BATCH_SIZE];
+   uint8_t k[2 * ED25519_BATCH_SIZE + 1][32];
+   Ed25519Point p[2 * ED25519_BATCH_SIZE + 1];
+} Ed25519BatchState;
+
+
+/**
+ * @brief Precomputed point (affine coordinates)
+ **/
+
+typedef struct
+{
+   Curve25519Limb yPlusX[CURVE25519_LIMB_LEN];  ///<y + x
+   Curve25519Limb yMinusX[CURVE25519_LIMB_LEN]; ///<y - x
+   Curve25519Limb xy2d[CURVE25519_LIMB_LEN];    ///<2 * d * x * y
+} Ed25519PrecompPoint;
+
+
+/**
+ * @brief Precomputed multiples of the base point (row i holds j * 256^i * B)
+ **/
+
+typedef struct
+{
+   Ed25519PrecompPoint points[32][8]; ///<Precomputed multiples of B
+} Ed25519BaseTable;
+
+
 //Ed25519 related functions
 error_t ed25519GenerateKeyPair(const PrngAlgo *prngAlgo, void *prngContext,
    uint8_t *privateKey, uint8_t *publicKey);
@@ -119,12 +209,47 @@ error_t ed25519VerifySignatureEx(const uint8_t *publicKey,
    const EddsaMessageChunk *messageChunks, const void *context,
    uint8_t contextLen, uint8_t flag, const uint8_t *signature);
 
+error_t ed25519BuildVerifyKey(const uint8_t *publicKey, Ed25519VerifyKey *key);
+
+error_t ed25519VerifySignatureWithKey(const Ed25519VerifyKey *key,
+   const EddsaMessageChunk *messageChunks, const void *context,
+   uint8_t contextLen, uint8_t flag, const uint8_t *signature);
+
+error_t ed25519VerifySignatureBatch(const PrngAlgo *prngAlgo,
+   void *prngContext, Ed25519BatchItem *items, uint_t n);
+
+error_t ed25519BuildBaseTable(Ed25519BaseTable *table);
+error_t ed25519RegisterBaseTable(const Ed25519BaseTable *table);
+const Ed25519BaseTable *ed25519GetBaseTable(void);
+
 void ed25519Mul(Ed25519State *state, Ed25519Point *r, const uint8_t *k,
    const Ed25519Point *p);
 
+void ed25519MulBase(Ed25519State *state, Ed25519Point *r, const uint8_t *k);
+
+void ed25519MulBaseTable(Ed25519State *state, Ed25519Point *r,
+   const uint8_t *k, const Ed25519BaseTable *table);
+
+void ed25519MulWnaf(Ed25519State *state, Ed25519Point *r, const uint8_t *k,
+   const Ed25519Point *t, uint_t w);
+
+void ed25519MulWnafTwin(Ed25519State *state, Ed25519Point *r,
+   const uint8_t *s, const uint8_t *k, const Ed25519Point *t, uint_t w);
+
+error_t ed25519MulMulti(Ed25519State *state, Ed25519Point *r,
+   const uint8_t (*k)[32], const Ed25519Point *p, uint_t n);
+
+uint_t ed25519ComputeWnaf(int8_t *naf, const uint8_t *k, uint_t w);
+
 void ed25519Add(Ed25519State *state, Ed25519Point *r, const Ed25519Point *p,
    const Ed25519Point *q);
 
+void ed25519AddPrecomp(Ed25519State *state, Ed25519Point *r,
+   const Ed25519Point *p, const Ed25519PrecompPoint *q);
+
+void ed25519SelectPrecomp(Ed25519PrecompPoint *r,
+   const Ed25519PrecompPoint *t, int8_t b);
+
 void ed25519Double(Ed25519State *state, Ed25519Point *r, const Ed25519Point *p);
 
 void ed25519Encode(Ed25519Point *p, uint8_t *data);
@@ -132,6 +257,9 @@ uint32_t ed25519Decode(Ed25519Point *p, const uint8_t *data);
 
 void ed25519RedInt(uint8_t *r, const uint8_t *a);
 
+void ed25519MulAddInt(uint8_t *r, const uint8_t *a, const uint8_t *b,
+   const uint8_t *c);
+
 void ed25519AddInt(uint8_t *r, const uint8_t *a, const uint8_t *b, uint_t n);
 uint8_t ed25519SubInt(uint8_t *r, const uint8_t *a, const uint8_t *b, uint_t n);
 
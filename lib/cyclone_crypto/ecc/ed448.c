@@ -36,11 +36,50 @@
 #include "ecc/ec_curves.h"
 #include "ecc/curve448.h"
 #include "ecc/ed448.h"
+#include "mpi/mpi_fixed.h"
 #include "debug.h"
 
 //Check crypto library configuration
 #if (ED448_SUPPORT == ENABLED)
 
+//Size of a scalar, in words
+#define ED448_SCALAR_WORDS (448 / MPI_FIXED_WORD_SIZE)
+
+#if (CURVE448_64BIT_SUPPORT == ENABLED)
+
+//Base point B
+static const Ed448Point ED448_B =
+{
+   {
+      0x0026A82BC70CC05E, 0x0080E18B00938E26, 0x00F72AB66511433B, 0x00A3D3A46412AE1A,
+      0x000F1767EA6DE324, 0x0036DA9E14657047, 0x00ED221D15A622BF, 0x004F1970C66BED0D
+   },
+   {
+      0x0008795BF230FA14, 0x00132C4ED7C8AD98, 0x001CE67C39C4FDBD, 0x0005A0C2D73AD3FF,
+      0x00A3984087789C1E, 0x00C7624BEA73736C, 0x00248876203756C9, 0x00693F46716EB6BC
+   },
+   {
+      0x0000000000000001, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+      0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000
+   }
+};
+
+//Zero (constant)
+static const Curve448Limb ED448_ZERO[8] =
+{
+   0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+   0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000
+};
+
+//Curve parameter d
+static const Curve448Limb ED448_D[8] =
+{
+   0x00FFFFFFFFFF6756, 0x00FFFFFFFFFFFFFF, 0x00FFFFFFFFFFFFFF, 0x00FFFFFFFFFFFFFF,
+   0x00FFFFFFFFFFFFFE, 0x00FFFFFFFFFFFFFF, 0x00FFFFFFFFFFFFFF, 0x00FFFFFFFFFFFFFF
+};
+
+#else
+
 //Base point B
 static const Ed448Point ED448_B =
 {
@@ -59,19 +98,21 @@ static const Ed448Point ED448_B =
 };
 
 //Zero (constant)
-static const uint32_t ED448_ZERO[14] =
+static const Curve448Limb ED448_ZERO[14] =
 {
    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000
 };
 
 //Curve parameter d
-static const uint32_t ED448_D[14] =
+static const Curve448Limb ED448_D[14] =
 {
    0xFFFF6756, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
    0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF
 };
 
+#endif
+
 //Order of the base point L
 static const uint8_t ED448_L[60] =
 {
@@ -81,15 +122,43 @@ static const uint8_t ED448_L[60] =
    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x00, 0x00
 };
 
-//Pre-computed value of mu = b^(2 * k) / L with b = 2^24 and k = 19
-static const uint8_t ED448_MU[60] =
+#if (MPI_FIXED_WORD_SIZE == 64)
+
+//Order of the base point L
+static const MpiFixedWord ED448_L_WORDS[7] =
+{
+   0x2378C292AB5844F3, 0x216CC2728DC58F55, 0xC44EDB49AED63690, 0xFFFFFFFF7CCA23E9,
+   0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0x3FFFFFFFFFFFFFFF
+};
+
+//Pre-computed value of mu = b^(2 * k + 1) / L with b = 2^64 and k = 7
+static const MpiFixedWord ED448_MU_WORDS[9] =
 {
-   0x0A, 0xD0, 0xE0, 0xB0, 0x7B, 0x4A, 0xD5, 0xD6, 0x73, 0xC8, 0xAD, 0x0A, 0xA7, 0x23, 0xD7, 0xD8,
-   0x33, 0xE9, 0xFD, 0x96, 0x9C, 0x12, 0x65, 0x4B, 0x12, 0xBB, 0x63, 0xC1, 0x5D, 0x33, 0x08, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00
+   0xD00AA4E7E08EDCA4, 0xC873D6D54A7BB0E0, 0xE933D8D723A70AAD, 0xBB124B65129C96FD,
+   0x00000008335DC163, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+   0x0000000000000004
 };
 
+#else
+
+//Order of the base point L
+static const MpiFixedWord ED448_L_WORDS[14] =
+{
+   0xAB5844F3, 0x2378C292, 0x8DC58F55, 0x216CC272, 0xAED63690, 0xC44EDB49, 0x7CCA23E9,
+   0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x3FFFFFFF
+};
+
+//Pre-computed value of mu = b^(2 * k + 1) / L with b = 2^32 and k = 14
+static const MpiFixedWord ED448_MU_WORDS[16] =
+{
+   0xD00AA4E7, 0x4A7BB0E0, 0xC873D6D5, 0x23A70AAD,
+   0xE933D8D7, 0x129C96FD, 0xBB124B65, 0x335DC163,
+   0x00000008, 0x00000000, 0x00000000, 0x00000000,
+   0x00000000, 0x00000000, 0x00000000, 0x00000004
+};
+
+#endif
+
 
 /**
  * @brief EdDSA key pair generation
@@ -251,7 +320,6 @@ error_t ed448GenerateSignatureEx(const uint8_t *privateKey,
    const void *context, uint8_t contextLen, uint8_t flag, uint8_t *signature)
 {
    uint_t i;
-   uint8_t c;
    Ed448State *state;
 
    //Check parameters
@@ -353,13 +421,7 @@ error_t ed448GenerateSignatureEx(const uint8_t *privateKey,
 
    //Compute S = (r + k * s) mod L. For efficiency, reduce k modulo L first
    ed448RedInt(state->p, state->k);
-   ed448MulInt(state->k, state->k + 57, state->p, state->s, 57);
-   ed448RedInt(state->p, state->k);
-   ed448AddInt(state->s, state->p, state->r, 57);
-
-   //Perform modular reduction
-   c = ed448SubInt(state->p, state->s, ED448_L, 57);
-   ed448SelectInt(signature + 57, state->p, state->s, c, 57);
+   ed448MulAddInt(signature + 57, state->p, state->s, state->r);
 
    //Erase working state
    osMemset(state, 0, sizeof(Ed448State));
@@ -646,6 +708,7 @@ void ed448Encode(Ed448Point *p, uint8_t *data)
 
    //Copy the least significant bit of the x-coordinate to the most significant
    //bit of the final octet
+   curve448Red(p->x, p->x, 0);
    data[56] |= (p->x[0] & 1) << 7;
 }
 
@@ -661,9 +724,9 @@ uint32_t ed448Decode(Ed448Point *p, const uint8_t *data)
    uint_t i;
    uint8_t x0;
    uint32_t ret;
-   uint64_t temp;
-   uint32_t u[14];
-   uint32_t v[14];
+   Curve448Limb mask;
+   Curve448Limb u[CURVE448_LIMB_LEN];
+   Curve448Limb v[CURVE448_LIMB_LEN];
 
    //First, interpret the string as an integer in little-endian representation.
    //Bit 455 of this number is the least significant bit of the x-coordinate
@@ -673,26 +736,18 @@ uint32_t ed448Decode(Ed448Point *p, const uint8_t *data)
    //The y-coordinate is recovered simply by clearing this bit
    curve448Import(p->y, data);
 
-   //Compute u = y + 2^224 + 1
-   for(temp = 1, i = 0; i < 7; i++)
-   {
-      temp += p->y[i];
-      u[i] = temp & 0xFFFFFFFF;
-      temp >>= 32;
-   }
+   //Reduce the y-coordinate modulo p
+   curve448Red(u, p->y, 0);
 
-   for(temp += 1, i = 7; i < 14; i++)
+   //If the y-coordinate is >= p, decoding fails
+   for(mask = 0, i = 0; i < CURVE448_LIMB_LEN; i++)
    {
-      temp += p->y[i];
-      u[i] = temp & 0xFFFFFFFF;
-      temp >>= 32;
+      mask |= u[i] ^ p->y[i];
    }
 
-   temp += data[56] & 0x7F;
-   ret = temp & 0xFFFFFFFF;
-
-   //If the y-coordinate is >= p, decoding fails
-   ret = (ret | (~ret + 1)) >> 31;
+   ret = (uint32_t) ((mask | (~mask + 1)) >> (sizeof(Curve448Limb) * 8 - 1));
+   //The final octet must not carry any other bit
+   ret |= (data[56] & 0x7F) != 0;
 
    //The curve equation implies x^2 = (y^2 - 1) / (d * y^2 - 1) mod p
    //Let u = y^2 - 1 and v = d * y^2 - 1
@@ -703,6 +758,8 @@ uint32_t ed448Decode(Ed448Point *p, const uint8_t *data)
 
    //Compute u = sqrt(u / v)
    ret |= curve448Sqrt(u, u, v);
+   //The parity is checked on the canonical representative of u
+   curve448Red(u, u, 0);
 
    //If x = 0, and x_0 = 1, decoding fails
    ret |= (curve448Comp(u, ED448_ZERO) ^ 1) & x0;
@@ -722,39 +779,245 @@ uint32_t ed448Decode(Ed448Point *p, const uint8_t *data)
 
 
 /**
- * @brief Reduce an integer modulo L
+ * @brief Load a little-endian integer into words
+ * @param[out] r Resulting integer, least significant word first
+ * @param[in] n Size of the resulting integer, in words
+ * @param[in] a Little-endian integer
+ * @param[in] length Length of the little-endian integer, in bytes
+ **/
+
+static void ed448LoadWords(MpiFixedWord *r, uint_t n, const uint8_t *a,
+   uint_t length)
+{
+   uint_t i;
+
+   //Clear the resulting integer
+   for(i = 0; i < n; i++)
+   {
+      r[i] = 0;
+   }
+
+   //Convert the little-endian integer
+   for(i = 0; i < length && (i / sizeof(MpiFixedWord)) < n; i++)
+   {
+      r[i / sizeof(MpiFixedWord)] |= (MpiFixedWord) a[i] <<
+         ((i % sizeof(MpiFixedWord)) * 8);
+   }
+}
+
+
+/**
+ * @brief Store an integer as a little-endian octet string
+ * @param[out] r Little-endian integer
+ * @param[in] length Length of the little-endian integer, in bytes
+ * @param[in] a Integer to be stored, least significant word first
+ * @param[in] n Size of the integer, in words
+ **/
+
+static void ed448StoreWords(uint8_t *r, uint_t length, const MpiFixedWord *a,
+   uint_t n)
+{
+   uint_t i;
+
+   //Convert the integer to little-endian format
+   for(i = 0; i < length; i++)
+   {
+      if((i / sizeof(MpiFixedWord)) < n)
+      {
+         r[i] = (uint8_t) (a[i / sizeof(MpiFixedWord)] >>
+            ((i % sizeof(MpiFixedWord)) * 8));
+      }
+      else
+      {
+         r[i] = 0;
+      }
+   }
+}
+
+
+/**
+ * @brief Multiplication of two integers
+ * @param[out] r Resulting integer R = A * B (m + n words)
+ * @param[in] a First operand A (m words)
+ * @param[in] m Size of the first operand, in words
+ * @param[in] b Second operand B (n words)
+ * @param[in] n Size of the second operand, in words
+ **/
+
+static void ed448MulWords(MpiFixedWord *r, const MpiFixedWord *a, uint_t m,
+   const MpiFixedWord *b, uint_t n)
+{
+   uint_t i;
+   uint_t j;
+   MpiFixedWord c;
+
+   //Clear the resulting integer
+   for(i = 0; i < (m + n); i++)
+   {
+      r[i] = 0;
+   }
+
+   //Schoolbook multiplication
+   for(i = 0; i < m; i++)
+   {
+      //Compute R = R + a[i] * B * b^i
+      for(c = 0, j = 0; j < n; j++)
+      {
+         MPI_FIXED_MUL_ACC(r[i + j], a[i], b[j], c);
+      }
+
+      //Save the carry
+      r[i + n] = c;
+   }
+}
+
+
+/**
+ * @brief Subtraction of two integers
+ * @param[out] r Resulting integer R = A - B
+ * @param[in] a First operand A
+ * @param[in] b Second operand B
+ * @param[in] n Size of the operands, in words
+ * @return 1 if the result is negative, else 0
+ **/
+
+static MpiFixedWord ed448SubWords(MpiFixedWord *r, const MpiFixedWord *a,
+   const MpiFixedWord *b, uint_t n)
+{
+   uint_t i;
+   MpiFixedWord c;
+   MpiFixedDword temp;
+
+   //Compute R = A - B
+   for(c = 0, i = 0; i < n; i++)
+   {
+      temp = (MpiFixedDword) a[i] - b[i] - c;
+      r[i] = (MpiFixedWord) temp;
+      c = (MpiFixedWord) (temp >> MPI_FIXED_WORD_SIZE) & 1;
+   }
+
+   //Return 1 if the result of the subtraction is negative
+   return c;
+}
+
+
+/**
+ * @brief Barrett reduction modulo L
  *
- * This function implements Barrett reduction with b = 2^24 and k = 19. The
- * algorithm requires the precomputation of the quantity mu = b^(2 * k) / L
+ * The reduction operates on words of w bits, where w is the word size of
+ * the fixed-width kernels, with b = 2^w and k = 448 / w. One additional
+ * word is needed to hold the 114-octet digests, so that the algorithm
+ * requires the precomputation of the quantity mu = b^(2 * k + 1) / L
  *
- * @param[out] r Resulting integer R = A mod L
- * @param[in] a An integer such as 0 <= A < b^(2 * k)
+ * @param[out] r Resulting integer R = A mod L (k words)
+ * @param[in] a An integer such as 0 <= A < b^(2 * k + 1) (2 * k + 1 words)
  **/
 
-void ed448RedInt(uint8_t *r, const uint8_t *a)
+static void ed448RedWords(MpiFixedWord *r, const MpiFixedWord *a)
 {
-   uint8_t c;
-   uint8_t u[60];
-   uint8_t v[60];
+   uint_t i;
+   uint_t j;
+   MpiFixedWord c;
+   MpiFixedWord q[2 * ED448_SCALAR_WORDS + 4];
+   MpiFixedWord v[2 * ED448_SCALAR_WORDS + 2];
+   MpiFixedWord u[ED448_SCALAR_WORDS];
+
+   //Compute the estimate of the quotient q = ((a / b^(k - 1)) * mu) / b^(k + 2)
+   ed448MulWords(q, a + ED448_SCALAR_WORDS - 1, ED448_SCALAR_WORDS + 2,
+      ED448_MU_WORDS, ED448_SCALAR_WORDS + 2);
 
-   //Compute the estimate of the quotient u = ((a / b^(k - 1)) * mu) / b^(k + 1)
-   ed448MulInt(NULL, u, a + 54, ED448_MU, 60);
-   //Compute v = u * L mod b^(k + 1)
-   ed448MulInt(v, NULL, u, ED448_L, 60);
+   //Compute v = q * L
+   ed448MulWords(v, q + ED448_SCALAR_WORDS + 2, ED448_SCALAR_WORDS + 2,
+      ED448_L_WORDS, ED448_SCALAR_WORDS);
 
-   //Compute the estimate of the remainder u = a mod b^(k + 1) - v
-   //If u < 0, then u = u + b^(k + 1)
-   ed448SubInt(u, a, v, 60);
+   //The estimate of the remainder a - v is less than 3 * L, so that it can be
+   //computed modulo b^k
+   ed448SubWords(r, a, v, ED448_SCALAR_WORDS);
 
    //This estimation implies that at most two subtractions of L are required to
    //obtain the correct remainder r
-   c = ed448SubInt(v, u, ED448_L, 60);
-   ed448SelectInt(u, v, u, c, 60);
-   c = ed448SubInt(v, u, ED448_L, 60);
-   ed448SelectInt(u, v, u, c, 60);
+   for(j = 0; j < 2; j++)
+   {
+      c = ed448SubWords(u, r, ED448_L_WORDS, ED448_SCALAR_WORDS);
+
+      //Constant time implementation
+      for(i = 0; i < ED448_SCALAR_WORDS; i++)
+      {
+         r[i] = (u[i] & (c - 1)) | (r[i] & ~(c - 1));
+      }
+   }
+}
+
 
+/**
+ * @brief Reduce an integer modulo L
+ * @param[out] r Resulting integer R = A mod L
+ * @param[in] a An integer such as 0 <= A < 2^912
+ **/
+
+void ed448RedInt(uint8_t *r, const uint8_t *a)
+{
+   MpiFixedWord u[2 * ED448_SCALAR_WORDS + 1];
+   MpiFixedWord v[ED448_SCALAR_WORDS];
+
+   //Convert the 114-octet integer to words
+   ed448LoadWords(u, 2 * ED448_SCALAR_WORDS + 1, a, 114);
+   //Perform Barrett reduction
+   ed448RedWords(v, u);
    //Copy the resulting remainder
-   ed448CopyInt(r, u, 57);
+   ed448StoreWords(r, 57, v, ED448_SCALAR_WORDS);
+}
+
+
+/**
+ * @brief Modular multiplication and addition
+ * @param[out] r Resulting integer R = (A * B + C) mod L
+ * @param[in] a An integer such as 0 <= A < 2^448
+ * @param[in] b An integer such as 0 <= B < 2^448
+ * @param[in] c An integer such as 0 <= C < 2^448 (may be NULL)
+ **/
+
+void ed448MulAddInt(uint8_t *r, const uint8_t *a, const uint8_t *b,
+   const uint8_t *c)
+{
+   uint_t i;
+   MpiFixedDword temp;
+   MpiFixedWord u[ED448_SCALAR_WORDS];
+   MpiFixedWord v[ED448_SCALAR_WORDS];
+   MpiFixedWord w[2 * ED448_SCALAR_WORDS + 1];
+
+   //Compute W = A * B
+   ed448LoadWords(u, ED448_SCALAR_WORDS, a, 57);
+   ed448LoadWords(v, ED448_SCALAR_WORDS, b, 57);
+   ed448MulWords(w, u, ED448_SCALAR_WORDS, v, ED448_SCALAR_WORDS);
+
+   //Clear the most significant word
+   w[2 * ED448_SCALAR_WORDS] = 0;
+
+   //The addend is optional
+   if(c != NULL)
+   {
+      ed448LoadWords(u, ED448_SCALAR_WORDS, c, 57);
+
+      //Compute W = W + C
+      for(temp = 0, i = 0; i <= (2 * ED448_SCALAR_WORDS); i++)
+      {
+         temp += w[i];
+
+         if(i < ED448_SCALAR_WORDS)
+         {
+            temp += u[i];
+         }
+
+         w[i] = (MpiFixedWord) temp;
+         temp >>= MPI_FIXED_WORD_SIZE;
+      }
+   }
+
+   //Perform Barrett reduction
+   ed448RedWords(u, w);
+   //Copy the result
+   ed448StoreWords(r, 57, u, ED448_SCALAR_WORDS);
 }
 
 
@@ -34,6 +34,7 @@
 //Dependencies
 #include "core/crypto.h"
 #include "ecc/eddsa.h"
+#include "ecc/curve448.h"
 #include "xof/shake.h"
 
 //Length of EdDSA private keys
@@ -60,9 +61,9 @@ extern "C" {
 
 typedef struct
 {
-   uint32_t x[14];
-   uint32_t y[14];
-   uint32_t z[14];
+   Curve448Limb x[CURVE448_LIMB_LEN];
+   Curve448Limb y[CURVE448_LIMB_LEN];
+   Curve448Limb z[CURVE448_LIMB_LEN];
 } Ed448Point;
 
 
@@ -83,13 +84,13 @@ typedef struct
    Ed448Point sb;
    Ed448Point u;
    Ed448Point v;
-   uint32_t a[14];
-   uint32_t b[14];
-   uint32_t c[14];
-   uint32_t d[14];
-   uint32_t e[14];
-   uint32_t f[14];
-   uint32_t g[14];
+   Curve448Limb a[CURVE448_LIMB_LEN];
+   Curve448Limb b[CURVE448_LIMB_LEN];
+   Curve448Limb c[CURVE448_LIMB_LEN];
+   Curve448Limb d[CURVE448_LIMB_LEN];
+   Curve448Limb e[CURVE448_LIMB_LEN];
+   Curve448Limb f[CURVE448_LIMB_LEN];
+   Curve448Limb g[CURVE448_LIMB_LEN];
 } Ed448State;
 
 
@@ -131,6 +132,9 @@ uint32_t ed448Decode(Ed448Point *p, const uint8_t *data);
 
 void ed448RedInt(uint8_t *r, const uint8_t *a);
 
+void ed448MulAddInt(uint8_t *r, const uint8_t *a, const uint8_t *b,
+   const uint8_t *c);
+
 void ed448AddInt(uint8_t *r, const uint8_t *a, const uint8_t *b, uint_t n);
 uint8_t ed448SubInt(uint8_t *r, const uint8_t *a, const uint8_t *b, uint_t n);
 
@@ -36,12 +36,102 @@
 #include "ecc/ec_curves.h"
 #include "ecc/curve25519.h"
 #include "ecc/x25519.h"
+#include "ecc/x25519_avx2.h"
+#include "ecc/ed25519.h"
 #include "debug.h"
 
 //Check crypto library configuration
 #if (X25519_SUPPORT == ENABLED)
 
 
+#if (ED25519_SUPPORT == ENABLED && ED25519_BASE_TABLE_SUPPORT == ENABLED)
+
+/**
+ * @brief Check whether a u-coordinate is the base point
+ * @param[in] u Input u-coordinate
+ * @return TRUE if u = 9, else FALSE
+ **/
+
+static bool_t x25519IsBasePoint(const uint8_t *u)
+{
+   uint_t i;
+   uint8_t c;
+
+   //The most significant bit of the final byte is ignored
+   c = (u[0] ^ 9) | (u[31] & 0x7F);
+
+   //Check the remaining bytes
+   for(i = 1; i < 31; i++)
+   {
+      c |= u[i];
+   }
+
+   //Return TRUE if the u-coordinate is 9
+   return (c == 0) ? TRUE : FALSE;
+}
+
+
+/**
+ * @brief Fixed-base X25519 function
+ *
+ * The base point u = 9 is the image of the Ed25519 base point B under the
+ * birational map u = (1 + y) / (1 - y), so that k * B can be computed with
+ * the precomputed Ed25519 table
+ *
+ * @param[out] r Output u-coordinate
+ * @param[in] k Input scalar
+ * @param[in] table Precomputed multiples of the Ed25519 base point
+ * @return Error code
+ **/
+
+static error_t x25519MulBase(uint8_t *r, const uint8_t *k,
+   const Ed25519BaseTable *table)
+{
+   Ed25519State *state;
+
+   //Allocate working state
+   state = cryptoAllocMem(sizeof(Ed25519State));
+   //Failed to allocate memory?
+   if(state == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Copy scalar
+   osMemcpy(state->s, k, 32);
+
+   //Set the three least significant bits of the first byte and the most
+   //significant bit of the last to zero, set the second most significant
+   //bit of the last byte to 1
+   state->s[0] &= 0xF8;
+   state->s[31] &= 0x7F;
+   state->s[31] |= 0x40;
+
+   //Compute the point k * B in extended coordinates
+   ed25519MulBaseTable(state, &state->sb, state->s, table);
+
+   //The scalar is a nonzero multiple of 8 smaller than 8 * L, so that k * B
+   //is never the neutral element and Z - Y is invertible
+   curve25519Add(state->a, state->sb.z, state->sb.y);
+   curve25519Sub(state->b, state->sb.z, state->sb.y);
+
+   //Compute u = (Z + Y) / (Z - Y)
+   curve25519Inv(state->b, state->b);
+   curve25519Mul(state->a, state->a, state->b);
+
+   //Copy output u-coordinate
+   curve25519Export(state->a, r);
+
+   //Erase working state
+   osMemset(state, 0, sizeof(Ed25519State));
+   //Release working state
+   cryptoFreeMem(state);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+#endif
+
+
 /**
  * @brief X25519 function (scalar multiplication on Curve25519)
  * @param[out] r Output u-coordinate
@@ -61,6 +151,15 @@ error_t x25519(uint8_t *r, const uint8_t *k, const uint8_t *u)
    if(r == NULL || k == NULL || u == NULL)
       return ERROR_INVALID_PARAMETER;
 
+#if (ED25519_SUPPORT == ENABLED && ED25519_BASE_TABLE_SUPPORT == ENABLED)
+   //Key generation uses the base point, whose multiples may have been
+   //precomputed
+   if(x25519IsBasePoint(u) && ed25519GetBaseTable() != NULL)
+   {
+      return x25519MulBase(r, k, ed25519GetBaseTable());
+   }
+#endif
+
    //Allocate working state
    state = cryptoAllocMem(sizeof(X25519State));
    //Failed to allocate memory?
@@ -68,21 +167,19 @@ error_t x25519(uint8_t *r, const uint8_t *k, const uint8_t *u)
       return ERROR_OUT_OF_MEMORY;
 
    //Copy scalar
-   curve25519Import(state->k, k);
+   osMemcpy(state->k, k, 32);
 
    //Set the three least significant bits of the first byte and the most
    //significant bit of the last to zero, set the second most significant
    //bit of the last byte to 1
-   state->k[0] &= 0xFFFFFFF8;
-   state->k[7] &= 0x7FFFFFFF;
-   state->k[7] |= 0x40000000;
+   state->k[0] &= 0xF8;
+   state->k[31] &= 0x7F;
+   state->k[31] |= 0x40;
 
-   //Copy input u-coordinate
+   //Copy input u-coordinate. Implementations must mask the most significant
+   //bit in the final byte (this is done by curve25519Import)
    curve25519Import(state->u, u);
 
-   //Implementations must mask the most significant bit in the final byte
-   state->u[7] &= 0x7FFFFFFF;
-
    //Implementations must accept non-canonical values and process them as
    //if they had been reduced modulo the field prime (refer to RFC 7748,
    //section 5)
@@ -104,7 +201,7 @@ error_t x25519(uint8_t *r, const uint8_t *k, const uint8_t *u)
    for(i = CURVE25519_BIT_LEN - 1; i >= 0; i--)
    {
       //The scalar is processed in a left-to-right fashion
-      b = (state->k[i / 32] >> (i % 32)) & 1;
+      b = (state->k[i / 8] >> (i % 8)) & 1;
 
       //Conditional swap
       curve25519Swap(state->x1, state->x2, swap ^ b);
@@ -171,4 +268,56 @@ error_t x25519(uint8_t *r, const uint8_t *k, const uint8_t *u)
    return NO_ERROR;
 }
 
+
+/**
+ * @brief Multi-buffer X25519 function
+ *
+ * Independent X25519 computations are processed four at a time using AVX2
+ * instructions when the CPU supports them. Remaining computations, or all of
+ * them when AVX2 is not available, are processed one at a time
+ *
+ * @param[out] r Output u-coordinates (n x 32 bytes)
+ * @param[in] k Input scalars (n x 32 bytes)
+ * @param[in] u Input u-coordinates (n x 32 bytes)
+ * @param[in] n Number of X25519 computations
+ * @return Error code
+ **/
+
+error_t x25519Multi(uint8_t *r, const uint8_t *k, const uint8_t *u,
+   uint_t n)
+{
+   error_t error;
+   uint_t i;
+
+   //Check parameters
+   if(r == NULL || k == NULL || u == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Initialize status code
+   error = NO_ERROR;
+   //Index of the first computation
+   i = 0;
+
+#if (X25519_AVX2_SUPPORT == ENABLED)
+   //Check whether the CPU supports AVX2 instructions
+   if(x25519Avx2IsSupported())
+   {
+      //Run four Montgomery ladders in parallel
+      for(; (i + X25519_AVX2_LANES) <= n && !error; i += X25519_AVX2_LANES)
+      {
+         error = x25519Avx2(r + 32 * i, k + 32 * i, u + 32 * i);
+      }
+   }
+#endif
+
+   //Process the remaining computations
+   for(; i < n && !error; i++)
+   {
+      error = x25519(r + 32 * i, k + 32 * i, u + 32 * i);
+   }
+
+   //Return status code
+   return error;
+}
+
 #endif
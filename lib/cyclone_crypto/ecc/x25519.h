@@ -35,6 +35,19 @@
 #include "core/crypto.h"
 #include "ecc/curve25519.h"
 
+//4-way AVX2 implementation (selected at runtime)
+#ifndef X25519_AVX2_SUPPORT
+   #if defined(__GNUC__) && defined(__x86_64__)
+      #define X25519_AVX2_SUPPORT ENABLED
+   #else
+      #define X25519_AVX2_SUPPORT DISABLED
+   #endif
+#elif (X25519_AVX2_SUPPORT != ENABLED && X25519_AVX2_SUPPORT != DISABLED)
+   #error X25519_AVX2_SUPPORT parameter is not valid
+#elif (X25519_AVX2_SUPPORT == ENABLED && !(defined(__GNUC__) && defined(__x86_64__)))
+   #error X25519_AVX2_SUPPORT requires a GCC-compatible x86-64 compiler
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 extern "C" {
@@ -47,20 +60,23 @@ extern "C" {
 
 typedef struct
 {
-   uint32_t k[8];
-   uint32_t u[8];
-   uint32_t x1[8];
-   uint32_t z1[8];
-   uint32_t x2[8];
-   uint32_t z2[8];
-   uint32_t t1[8];
-   uint32_t t2[8];
+   uint8_t k[32];
+   Curve25519Limb u[CURVE25519_LIMB_LEN];
+   Curve25519Limb x1[CURVE25519_LIMB_LEN];
+   Curve25519Limb z1[CURVE25519_LIMB_LEN];
+   Curve25519Limb x2[CURVE25519_LIMB_LEN];
+   Curve25519Limb z2[CURVE25519_LIMB_LEN];
+   Curve25519Limb t1[CURVE25519_LIMB_LEN];
+   Curve25519Limb t2[CURVE25519_LIMB_LEN];
 } X25519State;
 
 
 //X25519 related functions
 error_t x25519(uint8_t *r, const uint8_t *k, const uint8_t *u);
 
+error_t x25519Multi(uint8_t *r, const uint8_t *k, const uint8_t *u,
+   uint_t n);
+
 //C++ guard
 #ifdef __cplusplus
 }
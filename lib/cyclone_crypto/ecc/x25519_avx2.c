@@ -0,0 +1,901 @@
+/**
+ * @file x25519_avx2.c
+ * @brief X25519 function (4-way AVX2 implementation)
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * Four independent Montgomery ladders are run in the 64-bit lanes of AVX2
+ * registers. Field elements are represented in radix 2^25.5, i.e. with ten
+ * limbs of alternately 26 and 25 bits, so that the partial products can be
+ * computed with the 32x32-bit vector multiplier. Each vector holds the same
+ * limb of four field elements
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/curve25519.h"
+#include "ecc/x25519.h"
+#include "ecc/x25519_avx2.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (X25519_SUPPORT == ENABLED && X25519_AVX2_SUPPORT == ENABLED)
+
+//AVX2 intrinsics
+#include <immintrin.h>
+
+//Functions making use of AVX2 instructions
+#define __avx2_func __attribute__((target("avx2")))
+
+//Number of limbs in a field element
+#define X25519_AVX2_LIMB_LEN 10
+
+//Masks of the even (26-bit) and odd (25-bit) limbs
+#define X25519_AVX2_MASK26 0x03FFFFFF
+#define X25519_AVX2_MASK25 0x01FFFFFF
+
+//Limbs of 2p
+#define X25519_AVX2_2P0 0x07FFFFDA
+#define X25519_AVX2_2P_EVEN 0x07FFFFFE
+#define X25519_AVX2_2P_ODD 0x03FFFFFE
+
+
+/**
+ * @brief Working state (four X25519 computations)
+ **/
+
+typedef struct
+{
+   uint8_t k[X25519_AVX2_LANES][32];
+   __m256i u[X25519_AVX2_LIMB_LEN];
+   __m256i x1[X25519_AVX2_LIMB_LEN];
+   __m256i z1[X25519_AVX2_LIMB_LEN];
+   __m256i x2[X25519_AVX2_LIMB_LEN];
+   __m256i z2[X25519_AVX2_LIMB_LEN];
+   __m256i t1[X25519_AVX2_LIMB_LEN];
+   __m256i t2[X25519_AVX2_LIMB_LEN];
+} X25519Avx2State;
+
+
+/**
+ * @brief Check whether the CPU supports AVX2 instructions
+ * @return TRUE if the AVX2 implementation can be used, else FALSE
+ **/
+
+bool_t x25519Avx2IsSupported(void)
+{
+   //Query the processor features (the check also covers the saving of the
+   //YMM registers by the operating system)
+   __builtin_cpu_init();
+
+   //Return TRUE if AVX2 instructions are available
+   return __builtin_cpu_supports("avx2") ? TRUE : FALSE;
+}
+
+
+/**
+ * @brief Propagate the carry of a single limb
+ * @param[in,out] h Integer whose limbs are less than 2^63
+ * @param[in] i Index of the limb (0 to 8)
+ **/
+
+static __avx2_func void x25519Avx2CarryLimb(__m256i *h, uint_t i)
+{
+   __m256i c;
+
+   //Even limbs are 26-bit wide, odd limbs are 25-bit wide
+   if((i & 1) == 0)
+   {
+      c = _mm256_srli_epi64(h[i], 26);
+      h[i] = _mm256_and_si256(h[i], _mm256_set1_epi64x(X25519_AVX2_MASK26));
+   }
+   else
+   {
+      c = _mm256_srli_epi64(h[i], 25);
+      h[i] = _mm256_and_si256(h[i], _mm256_set1_epi64x(X25519_AVX2_MASK25));
+   }
+
+   //Add the carry to the next limb
+   h[i + 1] = _mm256_add_epi64(h[i + 1], c);
+}
+
+
+/**
+ * @brief Propagate the carries of a product
+ *
+ * Two interleaved carry chains are used to shorten the dependency path.
+ * The limbs of the result do not exceed 2^26 (even limbs) and 2^25 + 2^17
+ * (odd limbs)
+ *
+ * @param[out] r Resulting integer R = H mod p
+ * @param[in,out] h Integer whose limbs are less than 2^63
+ **/
+
+static __avx2_func void x25519Avx2Carry(__m256i *r, __m256i *h)
+{
+   __m256i c;
+
+   //Carry from limbs 0 to 4 and from limbs 4 to 8 at the same time
+   x25519Avx2CarryLimb(h, 0);
+   x25519Avx2CarryLimb(h, 4);
+   x25519Avx2CarryLimb(h, 1);
+   x25519Avx2CarryLimb(h, 5);
+   x25519Avx2CarryLimb(h, 2);
+   x25519Avx2CarryLimb(h, 6);
+   x25519Avx2CarryLimb(h, 3);
+   x25519Avx2CarryLimb(h, 7);
+   x25519Avx2CarryLimb(h, 4);
+   x25519Avx2CarryLimb(h, 8);
+
+   //Reduce the bits above 2^255 (2^255 = 19 mod p). The carry may exceed
+   //32 bits, so the multiplication by 19 is done with shifts
+   c = _mm256_srli_epi64(h[9], 25);
+   h[9] = _mm256_and_si256(h[9], _mm256_set1_epi64x(X25519_AVX2_MASK25));
+   h[0] = _mm256_add_epi64(h[0], c);
+   h[0] = _mm256_add_epi64(h[0], _mm256_slli_epi64(c, 1));
+   h[0] = _mm256_add_epi64(h[0], _mm256_slli_epi64(c, 4));
+
+   //Carry from limb 0 to limb 1
+   x25519Avx2CarryLimb(h, 0);
+
+   //Copy the resulting integer
+   r[0] = h[0];
+   r[1] = h[1];
+   r[2] = h[2];
+   r[3] = h[3];
+   r[4] = h[4];
+   r[5] = h[5];
+   r[6] = h[6];
+   r[7] = h[7];
+   r[8] = h[8];
+   r[9] = h[9];
+}
+
+
+/**
+ * @brief Modular addition
+ *
+ * The carries are not propagated. The limbs of the result do not exceed
+ * 2^27 (even limbs) and 2^26 + 2^18 (odd limbs), which is still suitable
+ * for a subsequent multiplication
+ *
+ * @param[out] r Resulting integer R = (A + B) mod p
+ * @param[in] a Integer whose carries have been propagated
+ * @param[in] b Integer whose carries have been propagated
+ **/
+
+static __avx2_func void x25519Avx2Add(__m256i *r, const __m256i *a,
+   const __m256i *b)
+{
+   //Compute R = A + B
+   r[0] = _mm256_add_epi64(a[0], b[0]);
+   r[1] = _mm256_add_epi64(a[1], b[1]);
+   r[2] = _mm256_add_epi64(a[2], b[2]);
+   r[3] = _mm256_add_epi64(a[3], b[3]);
+   r[4] = _mm256_add_epi64(a[4], b[4]);
+   r[5] = _mm256_add_epi64(a[5], b[5]);
+   r[6] = _mm256_add_epi64(a[6], b[6]);
+   r[7] = _mm256_add_epi64(a[7], b[7]);
+   r[8] = _mm256_add_epi64(a[8], b[8]);
+   r[9] = _mm256_add_epi64(a[9], b[9]);
+}
+
+
+/**
+ * @brief Modular subtraction
+ *
+ * The carries are not propagated. The limbs of the result do not exceed
+ * 3 * 2^26 (even limbs) and 3 * 2^25 + 2^17 (odd limbs), which is still
+ * suitable for a subsequent multiplication
+ *
+ * @param[out] r Resulting integer R = (A - B) mod p
+ * @param[in] a Integer whose carries have been propagated
+ * @param[in] b Integer whose carries have been propagated
+ **/
+
+static __avx2_func void x25519Avx2Sub(__m256i *r, const __m256i *a,
+   const __m256i *b)
+{
+   __m256i p0;
+   __m256i p1;
+   __m256i p2;
+
+   //Load the limbs of 2p
+   p0 = _mm256_set1_epi64x(X25519_AVX2_2P0);
+   p1 = _mm256_set1_epi64x(X25519_AVX2_2P_ODD);
+   p2 = _mm256_set1_epi64x(X25519_AVX2_2P_EVEN);
+
+   //Compute R = A + 2p - B, so that no limb can underflow
+   r[0] = _mm256_sub_epi64(_mm256_add_epi64(a[0], p0), b[0]);
+   r[1] = _mm256_sub_epi64(_mm256_add_epi64(a[1], p1), b[1]);
+   r[2] = _mm256_sub_epi64(_mm256_add_epi64(a[2], p2), b[2]);
+   r[3] = _mm256_sub_epi64(_mm256_add_epi64(a[3], p1), b[3]);
+   r[4] = _mm256_sub_epi64(_mm256_add_epi64(a[4], p2), b[4]);
+   r[5] = _mm256_sub_epi64(_mm256_add_epi64(a[5], p1), b[5]);
+   r[6] = _mm256_sub_epi64(_mm256_add_epi64(a[6], p2), b[6]);
+   r[7] = _mm256_sub_epi64(_mm256_add_epi64(a[7], p1), b[7]);
+   r[8] = _mm256_sub_epi64(_mm256_add_epi64(a[8], p2), b[8]);
+   r[9] = _mm256_sub_epi64(_mm256_add_epi64(a[9], p1), b[9]);
+}
+
+
+/**
+ * @brief Modular multiplication
+ * @param[out] r Resulting integer R = (A * B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < p
+ **/
+
+static __avx2_func void x25519Avx2Mul(__m256i *r, const __m256i *a,
+   const __m256i *b)
+{
+   __m256i nineteen;
+   __m256i a2[X25519_AVX2_LIMB_LEN];
+   __m256i b19[X25519_AVX2_LIMB_LEN];
+   __m256i h[X25519_AVX2_LIMB_LEN];
+
+   //The product of two odd limbs has an extra factor of 2, since their
+   //weights are 2^(25.5 * i) rounded up (only the odd limbs of 2 * A are
+   //needed)
+   a2[1] = _mm256_add_epi64(a[1], a[1]);
+   a2[3] = _mm256_add_epi64(a[3], a[3]);
+   a2[5] = _mm256_add_epi64(a[5], a[5]);
+   a2[7] = _mm256_add_epi64(a[7], a[7]);
+   a2[9] = _mm256_add_epi64(a[9], a[9]);
+
+   //The partial products of weight 2^255 and above are folded using
+   //2^255 = 19 mod p
+   nineteen = _mm256_set1_epi64x(19);
+   b19[1] = _mm256_mul_epu32(b[1], nineteen);
+   b19[2] = _mm256_mul_epu32(b[2], nineteen);
+   b19[3] = _mm256_mul_epu32(b[3], nineteen);
+   b19[4] = _mm256_mul_epu32(b[4], nineteen);
+   b19[5] = _mm256_mul_epu32(b[5], nineteen);
+   b19[6] = _mm256_mul_epu32(b[6], nineteen);
+   b19[7] = _mm256_mul_epu32(b[7], nineteen);
+   b19[8] = _mm256_mul_epu32(b[8], nineteen);
+   b19[9] = _mm256_mul_epu32(b[9], nineteen);
+
+   //Compute H = A * B (schoolbook multiplication)
+   h[0] = _mm256_mul_epu32(a[0], b[0]);
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a2[1], b19[9]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a[2], b19[8]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a2[3], b19[7]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a[4], b19[6]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a2[5], b19[5]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a[6], b19[4]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a2[7], b19[3]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a[8], b19[2]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a2[9], b19[1]));
+
+   h[1] = _mm256_mul_epu32(a[0], b[1]);
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a[1], b[0]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a[2], b19[9]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a[3], b19[8]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a[4], b19[7]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a[5], b19[6]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a[6], b19[5]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a[7], b19[4]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a[8], b19[3]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a[9], b19[2]));
+
+   h[2] = _mm256_mul_epu32(a[0], b[2]);
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a2[1], b[1]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a[2], b[0]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a2[3], b19[9]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a[4], b19[8]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a2[5], b19[7]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a[6], b19[6]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a2[7], b19[5]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a[8], b19[4]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a2[9], b19[3]));
+
+   h[3] = _mm256_mul_epu32(a[0], b[3]);
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a[1], b[2]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a[2], b[1]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a[3], b[0]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a[4], b19[9]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a[5], b19[8]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a[6], b19[7]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a[7], b19[6]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a[8], b19[5]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a[9], b19[4]));
+
+   h[4] = _mm256_mul_epu32(a[0], b[4]);
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a2[1], b[3]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a[2], b[2]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a2[3], b[1]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a[4], b[0]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a2[5], b19[9]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a[6], b19[8]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a2[7], b19[7]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a[8], b19[6]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a2[9], b19[5]));
+
+   h[5] = _mm256_mul_epu32(a[0], b[5]);
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a[1], b[4]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a[2], b[3]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a[3], b[2]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a[4], b[1]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a[5], b[0]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a[6], b19[9]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a[7], b19[8]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a[8], b19[7]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a[9], b19[6]));
+
+   h[6] = _mm256_mul_epu32(a[0], b[6]);
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a2[1], b[5]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a[2], b[4]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a2[3], b[3]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a[4], b[2]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a2[5], b[1]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a[6], b[0]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a2[7], b19[9]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a[8], b19[8]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a2[9], b19[7]));
+
+   h[7] = _mm256_mul_epu32(a[0], b[7]);
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a[1], b[6]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a[2], b[5]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a[3], b[4]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a[4], b[3]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a[5], b[2]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a[6], b[1]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a[7], b[0]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a[8], b19[9]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a[9], b19[8]));
+
+   h[8] = _mm256_mul_epu32(a[0], b[8]);
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a2[1], b[7]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a[2], b[6]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a2[3], b[5]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a[4], b[4]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a2[5], b[3]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a[6], b[2]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a2[7], b[1]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a[8], b[0]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a2[9], b19[9]));
+
+   h[9] = _mm256_mul_epu32(a[0], b[9]);
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a[1], b[8]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a[2], b[7]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a[3], b[6]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a[4], b[5]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a[5], b[4]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a[6], b[3]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a[7], b[2]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a[8], b[1]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a[9], b[0]));
+
+   //Propagate the carries
+   x25519Avx2Carry(r, h);
+}
+
+
+/**
+ * @brief Modular squaring
+ * @param[out] r Resulting integer R = (A ^ 2) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ **/
+
+static __avx2_func void x25519Avx2Sqr(__m256i *r, const __m256i *a)
+{
+   __m256i nineteen;
+   __m256i a2[X25519_AVX2_LIMB_LEN];
+   __m256i a4[X25519_AVX2_LIMB_LEN];
+   __m256i a19[X25519_AVX2_LIMB_LEN];
+   __m256i h[X25519_AVX2_LIMB_LEN];
+
+   //Pre-compute 2 * A. The cross products of two odd limbs require the
+   //odd limbs of 4 * A
+   a2[0] = _mm256_add_epi64(a[0], a[0]);
+   a2[1] = _mm256_add_epi64(a[1], a[1]);
+   a2[2] = _mm256_add_epi64(a[2], a[2]);
+   a2[3] = _mm256_add_epi64(a[3], a[3]);
+   a2[4] = _mm256_add_epi64(a[4], a[4]);
+   a2[5] = _mm256_add_epi64(a[5], a[5]);
+   a2[6] = _mm256_add_epi64(a[6], a[6]);
+   a2[7] = _mm256_add_epi64(a[7], a[7]);
+   a2[8] = _mm256_add_epi64(a[8], a[8]);
+   a2[9] = _mm256_add_epi64(a[9], a[9]);
+   a4[1] = _mm256_add_epi64(a2[1], a2[1]);
+   a4[3] = _mm256_add_epi64(a2[3], a2[3]);
+   a4[5] = _mm256_add_epi64(a2[5], a2[5]);
+   a4[7] = _mm256_add_epi64(a2[7], a2[7]);
+
+   //The partial products of weight 2^255 and above are folded using
+   //2^255 = 19 mod p
+   nineteen = _mm256_set1_epi64x(19);
+   a19[1] = _mm256_mul_epu32(a[1], nineteen);
+   a19[2] = _mm256_mul_epu32(a[2], nineteen);
+   a19[3] = _mm256_mul_epu32(a[3], nineteen);
+   a19[4] = _mm256_mul_epu32(a[4], nineteen);
+   a19[5] = _mm256_mul_epu32(a[5], nineteen);
+   a19[6] = _mm256_mul_epu32(a[6], nineteen);
+   a19[7] = _mm256_mul_epu32(a[7], nineteen);
+   a19[8] = _mm256_mul_epu32(a[8], nineteen);
+   a19[9] = _mm256_mul_epu32(a[9], nineteen);
+
+   //Compute H = A^2. The cross products appear twice, hence only 55
+   //partial products are required
+   h[0] = _mm256_mul_epu32(a[0], a[0]);
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a4[1], a19[9]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a2[2], a19[8]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a4[3], a19[7]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a2[4], a19[6]));
+   h[0] = _mm256_add_epi64(h[0], _mm256_mul_epu32(a2[5], a19[5]));
+
+   h[1] = _mm256_mul_epu32(a2[0], a[1]);
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a2[2], a19[9]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a2[3], a19[8]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a2[4], a19[7]));
+   h[1] = _mm256_add_epi64(h[1], _mm256_mul_epu32(a2[5], a19[6]));
+
+   h[2] = _mm256_mul_epu32(a2[0], a[2]);
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a2[1], a[1]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a4[3], a19[9]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a2[4], a19[8]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a4[5], a19[7]));
+   h[2] = _mm256_add_epi64(h[2], _mm256_mul_epu32(a[6], a19[6]));
+
+   h[3] = _mm256_mul_epu32(a2[0], a[3]);
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a2[1], a[2]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a2[4], a19[9]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a2[5], a19[8]));
+   h[3] = _mm256_add_epi64(h[3], _mm256_mul_epu32(a2[6], a19[7]));
+
+   h[4] = _mm256_mul_epu32(a2[0], a[4]);
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a4[1], a[3]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a[2], a[2]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a4[5], a19[9]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a2[6], a19[8]));
+   h[4] = _mm256_add_epi64(h[4], _mm256_mul_epu32(a2[7], a19[7]));
+
+   h[5] = _mm256_mul_epu32(a2[0], a[5]);
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a2[1], a[4]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a2[2], a[3]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a2[6], a19[9]));
+   h[5] = _mm256_add_epi64(h[5], _mm256_mul_epu32(a2[7], a19[8]));
+
+   h[6] = _mm256_mul_epu32(a2[0], a[6]);
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a4[1], a[5]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a2[2], a[4]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a2[3], a[3]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a4[7], a19[9]));
+   h[6] = _mm256_add_epi64(h[6], _mm256_mul_epu32(a[8], a19[8]));
+
+   h[7] = _mm256_mul_epu32(a2[0], a[7]);
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a2[1], a[6]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a2[2], a[5]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a2[3], a[4]));
+   h[7] = _mm256_add_epi64(h[7], _mm256_mul_epu32(a2[8], a19[9]));
+
+   h[8] = _mm256_mul_epu32(a2[0], a[8]);
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a4[1], a[7]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a2[2], a[6]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a4[3], a[5]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a[4], a[4]));
+   h[8] = _mm256_add_epi64(h[8], _mm256_mul_epu32(a2[9], a19[9]));
+
+   h[9] = _mm256_mul_epu32(a2[0], a[9]);
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a2[1], a[8]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a2[2], a[7]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a2[3], a[6]));
+   h[9] = _mm256_add_epi64(h[9], _mm256_mul_epu32(a2[4], a[5]));
+
+   //Propagate the carries
+   x25519Avx2Carry(r, h);
+}
+
+
+/**
+ * @brief Modular multiplication
+ * @param[out] r Resulting integer R = (A * B) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] b An integer such as 0 <= B < 2^26
+ **/
+
+static __avx2_func void x25519Avx2MulInt(__m256i *r, const __m256i *a,
+   uint32_t b)
+{
+   __m256i t;
+   __m256i h[X25519_AVX2_LIMB_LEN];
+
+   //Load the multiplier
+   t = _mm256_set1_epi64x(b);
+
+   //Compute H = A * B
+   h[0] = _mm256_mul_epu32(a[0], t);
+   h[1] = _mm256_mul_epu32(a[1], t);
+   h[2] = _mm256_mul_epu32(a[2], t);
+   h[3] = _mm256_mul_epu32(a[3], t);
+   h[4] = _mm256_mul_epu32(a[4], t);
+   h[5] = _mm256_mul_epu32(a[5], t);
+   h[6] = _mm256_mul_epu32(a[6], t);
+   h[7] = _mm256_mul_epu32(a[7], t);
+   h[8] = _mm256_mul_epu32(a[8], t);
+   h[9] = _mm256_mul_epu32(a[9], t);
+
+   //Propagate the carries
+   x25519Avx2Carry(r, h);
+}
+
+
+/**
+ * @brief Raise an integer to power 2^n
+ * @param[out] r Resulting integer R = (A ^ (2^n)) mod p
+ * @param[in] a An integer such as 0 <= A < p
+ * @param[in] n An integer such as n >= 1
+ **/
+
+static __avx2_func void x25519Avx2Pwr2(__m256i *r, const __m256i *a,
+   uint_t n)
+{
+   uint_t i;
+
+   //Pre-compute (A ^ 2) mod p
+   x25519Avx2Sqr(r, a);
+
+   //Compute R = (A ^ (2^n)) mod p
+   for(i = 1; i < n; i++)
+   {
+      x25519Avx2Sqr(r, r);
+   }
+}
+
+
+/**
+ * @brief Modular multiplicative inverse
+ * @param[out] r Resulting integer R = A^-1 mod p
+ * @param[in] a An integer such as 0 <= A < p
+ **/
+
+static __avx2_func void x25519Avx2Inv(__m256i *r, const __m256i *a)
+{
+   __m256i u[X25519_AVX2_LIMB_LEN];
+   __m256i v[X25519_AVX2_LIMB_LEN];
+
+   //Since GF(p) is a prime field, the Fermat's little theorem can be
+   //used to find the multiplicative inverse of A modulo p
+   x25519Avx2Sqr(u, a);
+   x25519Avx2Mul(u, u, a); //A^(2^2 - 1)
+   x25519Avx2Sqr(u, u);
+   x25519Avx2Mul(v, u, a); //A^(2^3 - 1)
+   x25519Avx2Pwr2(u, v, 3);
+   x25519Avx2Mul(u, u, v); //A^(2^6 - 1)
+   x25519Avx2Sqr(u, u);
+   x25519Avx2Mul(v, u, a); //A^(2^7 - 1)
+   x25519Avx2Pwr2(u, v, 7);
+   x25519Avx2Mul(u, u, v); //A^(2^14 - 1)
+   x25519Avx2Sqr(u, u);
+   x25519Avx2Mul(v, u, a); //A^(2^15 - 1)
+   x25519Avx2Pwr2(u, v, 15);
+   x25519Avx2Mul(u, u, v); //A^(2^30 - 1)
+   x25519Avx2Sqr(u, u);
+   x25519Avx2Mul(v, u, a); //A^(2^31 - 1)
+   x25519Avx2Pwr2(u, v, 31);
+   x25519Avx2Mul(v, u, v); //A^(2^62 - 1)
+   x25519Avx2Pwr2(u, v, 62);
+   x25519Avx2Mul(u, u, v); //A^(2^124 - 1)
+   x25519Avx2Sqr(u, u);
+   x25519Avx2Mul(v, u, a); //A^(2^125 - 1)
+   x25519Avx2Pwr2(u, v, 125);
+   x25519Avx2Mul(u, u, v); //A^(2^250 - 1)
+   x25519Avx2Sqr(u, u);
+   x25519Avx2Sqr(u, u);
+   x25519Avx2Mul(u, u, a);
+   x25519Avx2Sqr(u, u);
+   x25519Avx2Sqr(u, u);
+   x25519Avx2Mul(u, u, a);
+   x25519Avx2Sqr(u, u);
+   x25519Avx2Mul(r, u, a); //A^(2^255 - 21)
+}
+
+
+/**
+ * @brief Conditional swap
+ * @param[in,out] a Pointer to the first integer
+ * @param[in,out] b Pointer to the second integer
+ * @param[in] c Condition variable (0 or 1 in each lane)
+ **/
+
+static __avx2_func void x25519Avx2Swap(__m256i *a, __m256i *b, __m256i c)
+{
+   uint_t i;
+   __m256i mask;
+   __m256i dummy;
+
+   //The mask is the all-1 or all-0 word
+   mask = _mm256_sub_epi64(_mm256_setzero_si256(), c);
+
+   //Conditional swap
+   for(i = 0; i < X25519_AVX2_LIMB_LEN; i++)
+   {
+      //Constant time implementation
+      dummy = _mm256_and_si256(mask, _mm256_xor_si256(a[i], b[i]));
+      a[i] = _mm256_xor_si256(a[i], dummy);
+      b[i] = _mm256_xor_si256(b[i], dummy);
+   }
+}
+
+
+/**
+ * @brief Import four octet strings
+ *
+ * Bit 255 of each octet string is ignored
+ *
+ * @param[out] a Pointer to resulting integer
+ * @param[in] data Octet strings to be converted (32 bytes each)
+ **/
+
+static __avx2_func void x25519Avx2Import(__m256i *a, const uint8_t *data)
+{
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   uint_t n;
+   uint_t w;
+   uint64_t acc;
+   uint64_t t[X25519_AVX2_LANES][X25519_AVX2_LIMB_LEN];
+
+   //Process each octet string
+   for(j = 0; j < X25519_AVX2_LANES; j++)
+   {
+      //Split the integer into limbs of 26 and 25 bits
+      for(acc = 0, n = 0, k = 0, i = 0; i < X25519_AVX2_LIMB_LEN; i++)
+      {
+         //Width of the current limb
+         w = 26 - (i & 1);
+
+         //Read as many bytes as necessary
+         while(n < w)
+         {
+            acc |= (uint64_t) data[32 * j + k++] << n;
+            n += 8;
+         }
+
+         //Extract the current limb
+         t[j][i] = acc & ((1U << w) - 1);
+         acc >>= w;
+         n -= w;
+      }
+   }
+
+   //Each vector holds the same limb of the four integers
+   for(i = 0; i < X25519_AVX2_LIMB_LEN; i++)
+   {
+      a[i] = _mm256_set_epi64x(t[3][i], t[2][i], t[1][i], t[0][i]);
+   }
+}
+
+
+/**
+ * @brief Export four octet strings
+ * @param[in] a Pointer to the integer to be exported
+ * @param[out] data Octet strings resulting from the conversion (32 bytes
+ *   each)
+ **/
+
+static __avx2_func void x25519Avx2Export(const __m256i *a, uint8_t *data)
+{
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   uint_t n;
+   uint_t w;
+   uint64_t c;
+   uint64_t acc;
+   uint64_t t[X25519_AVX2_LIMB_LEN][X25519_AVX2_LANES];
+   Curve25519Limb u[CURVE25519_LIMB_LEN];
+
+   //Retrieve the limbs of the four integers
+   for(i = 0; i < X25519_AVX2_LIMB_LEN; i++)
+   {
+      _mm256_storeu_si256((__m256i *) t[i], a[i]);
+   }
+
+   //Process each integer
+   for(j = 0; j < X25519_AVX2_LANES; j++)
+   {
+      //Three carry passes leave limbs that fit their width, so that the
+      //integer is less than 2^255
+      for(k = 0; k < 3; k++)
+      {
+         for(i = 0; i < X25519_AVX2_LIMB_LEN - 1; i++)
+         {
+            w = 26 - (i & 1);
+            t[i + 1][j] += t[i][j] >> w;
+            t[i][j] &= (1U << w) - 1;
+         }
+
+         //Reduce the bits above 2^255 (2^255 = 19 mod p)
+         c = t[9][j] >> 25;
+         t[9][j] &= X25519_AVX2_MASK25;
+         t[0][j] += c * 19;
+      }
+
+      //Pack the limbs into a little-endian octet string
+      for(acc = 0, n = 0, k = 0, i = 0; i < X25519_AVX2_LIMB_LEN; i++)
+      {
+         acc |= t[i][j] << n;
+         n += 26 - (i & 1);
+
+         while(n >= 8)
+         {
+            data[32 * j + k++] = acc & 0xFF;
+            acc >>= 8;
+            n -= 8;
+         }
+      }
+
+      data[32 * j + k] = acc & 0xFF;
+
+      //The integer may still be greater than p. Retrieve its canonical
+      //representative using the scalar implementation
+      curve25519Import(u, data + 32 * j);
+      curve25519Red(u, u);
+      curve25519Export(u, data + 32 * j);
+   }
+
+   //Erase temporary values
+   osMemset(t, 0, sizeof(t));
+   osMemset(u, 0, sizeof(u));
+}
+
+
+/**
+ * @brief Four X25519 functions computed in parallel
+ * @param[out] r Output u-coordinates (4 x 32 bytes)
+ * @param[in] k Input scalars (4 x 32 bytes)
+ * @param[in] u Input u-coordinates (4 x 32 bytes)
+ * @return Error code
+ **/
+
+__avx2_func error_t x25519Avx2(uint8_t *r, const uint8_t *k, const uint8_t *u)
+{
+   int_t i;
+   uint_t j;
+   uint64_t b[X25519_AVX2_LANES];
+   __m256i bit;
+   __m256i swap;
+   X25519Avx2State state;
+
+   //Check parameters
+   if(r == NULL || k == NULL || u == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The working state holds AVX2 vectors, which require 32-byte alignment.
+   //It is therefore kept on the stack rather than allocated dynamically
+   for(j = 0; j < X25519_AVX2_LANES; j++)
+   {
+      //Copy scalar
+      osMemcpy(state.k[j], k + 32 * j, 32);
+
+      //Set the three least significant bits of the first byte and the most
+      //significant bit of the last to zero, set the second most significant
+      //bit of the last byte to 1
+      state.k[j][0] &= 0xF8;
+      state.k[j][31] &= 0x7F;
+      state.k[j][31] |= 0x40;
+   }
+
+   //Copy input u-coordinates. Non-canonical values are processed as if
+   //they had been reduced modulo the field prime
+   x25519Avx2Import(state.u, u);
+
+   //Set X1 = 1, Z1 = 0, X2 = U and Z2 = 1
+   for(j = 0; j < X25519_AVX2_LIMB_LEN; j++)
+   {
+      state.x1[j] = _mm256_set1_epi64x(j == 0);
+      state.z1[j] = _mm256_setzero_si256();
+      state.x2[j] = state.u[j];
+      state.z2[j] = _mm256_set1_epi64x(j == 0);
+   }
+
+   //Set swap = 0
+   swap = _mm256_setzero_si256();
+
+   //Montgomery ladder
+   for(i = CURVE25519_BIT_LEN - 1; i >= 0; i--)
+   {
+      //The scalars are processed in a left-to-right fashion
+      for(j = 0; j < X25519_AVX2_LANES; j++)
+      {
+         b[j] = (state.k[j][i / 8] >> (i % 8)) & 1;
+      }
+
+      bit = _mm256_set_epi64x(b[3], b[2], b[1], b[0]);
+
+      //Conditional swap
+      swap = _mm256_xor_si256(swap, bit);
+      x25519Avx2Swap(state.x1, state.x2, swap);
+      x25519Avx2Swap(state.z1, state.z2, swap);
+
+      //Save current bit value
+      swap = bit;
+
+      //Compute T1 = X2 + Z2
+      x25519Avx2Add(state.t1, state.x2, state.z2);
+      //Compute X2 = X2 - Z2
+      x25519Avx2Sub(state.x2, state.x2, state.z2);
+      //Compute Z2 = X1 + Z1
+      x25519Avx2Add(state.z2, state.x1, state.z1);
+      //Compute X1 = X1 - Z1
+      x25519Avx2Sub(state.x1, state.x1, state.z1);
+      //Compute T1 = T1 * X1
+      x25519Avx2Mul(state.t1, state.t1, state.x1);
+      //Compute X2 = X2 * Z2
+      x25519Avx2Mul(state.x2, state.x2, state.z2);
+      //Compute Z2 = Z2 * Z2
+      x25519Avx2Sqr(state.z2, state.z2);
+      //Compute X1 = X1 * X1
+      x25519Avx2Sqr(state.x1, state.x1);
+      //Compute T2 = Z2 - X1
+      x25519Avx2Sub(state.t2, state.z2, state.x1);
+      //Compute Z1 = T2 * a24
+      x25519Avx2MulInt(state.z1, state.t2, CURVE25519_A24);
+      //Compute Z1 = Z1 + X1
+      x25519Avx2Add(state.z1, state.z1, state.x1);
+      //Compute Z1 = Z1 * T2
+      x25519Avx2Mul(state.z1, state.z1, state.t2);
+      //Compute X1 = X1 * Z2
+      x25519Avx2Mul(state.x1, state.x1, state.z2);
+      //Compute Z2 = T1 - X2
+      x25519Avx2Sub(state.z2, state.t1, state.x2);
+      //Compute Z2 = Z2 * Z2
+      x25519Avx2Sqr(state.z2, state.z2);
+      //Compute Z2 = Z2 * U
+      x25519Avx2Mul(state.z2, state.z2, state.u);
+      //Compute X2 = X2 + T1
+      x25519Avx2Add(state.x2, state.x2, state.t1);
+      //Compute X2 = X2 * X2
+      x25519Avx2Sqr(state.x2, state.x2);
+   }
+
+   //Conditional swap
+   x25519Avx2Swap(state.x1, state.x2, swap);
+   x25519Avx2Swap(state.z1, state.z2, swap);
+
+   //Retrieve affine representation
+   x25519Avx2Inv(state.u, state.z1);
+   x25519Avx2Mul(state.u, state.u, state.x1);
+
+   //Copy output u-coordinates
+   x25519Avx2Export(state.u, r);
+
+   //Erase working state
+   osMemset(&state, 0, sizeof(X25519Avx2State));
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file x25519_avx2.h
+ * @brief X25519 function (4-way AVX2 implementation)
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _X25519_AVX2_H
+#define _X25519_AVX2_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "ecc/x25519.h"
+
+//Number of X25519 functions computed in parallel
+#define X25519_AVX2_LANES 4
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//AVX2 implementation of X25519
+bool_t x25519Avx2IsSupported(void);
+error_t x25519Avx2(uint8_t *r, const uint8_t *k, const uint8_t *u);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
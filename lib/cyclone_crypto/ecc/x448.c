@@ -68,12 +68,12 @@ error_t x448(uint8_t *r, const uint8_t *k, const uint8_t *u)
       return ERROR_OUT_OF_MEMORY;
 
    //Copy scalar
-   curve448Import(state->k, k);
+   osMemcpy(state->k, k, 56);
 
    //Set the two least significant bits of the first byte to 0, and the most
    //significant bit of the last byte to 1
-   state->k[0] &= 0xFFFFFFFC;
-   state->k[13] |= 0x80000000;
+   state->k[0] &= 0xFC;
+   state->k[55] |= 0x80;
 
    //Copy input u-coordinate
    curve448Import(state->u, u);
@@ -99,7 +99,7 @@ error_t x448(uint8_t *r, const uint8_t *k, const uint8_t *u)
    for(i = CURVE448_BIT_LEN - 1; i >= 0; i--)
    {
       //The scalar is processed in a left-to-right fashion
-      b = (state->k[i / 32] >> (i % 32)) & 1;
+      b = (state->k[i / 8] >> (i % 8)) & 1;
 
       //Conditional swap
       curve448Swap(state->x1, state->x2, swap ^ b);
@@ -47,14 +47,14 @@ extern "C" {
 
 typedef struct
 {
-   uint32_t k[14];
-   uint32_t u[14];
-   uint32_t x1[14];
-   uint32_t z1[14];
-   uint32_t x2[14];
-   uint32_t z2[14];
-   uint32_t t1[14];
-   uint32_t t2[14];
+   uint8_t k[56];
+   Curve448Limb u[CURVE448_LIMB_LEN];
+   Curve448Limb x1[CURVE448_LIMB_LEN];
+   Curve448Limb z1[CURVE448_LIMB_LEN];
+   Curve448Limb x2[CURVE448_LIMB_LEN];
+   Curve448Limb z2[CURVE448_LIMB_LEN];
+   Curve448Limb t1[CURVE448_LIMB_LEN];
+   Curve448Limb t2[CURVE448_LIMB_LEN];
 } X448State;
 
 
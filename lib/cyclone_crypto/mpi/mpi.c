@@ -34,11 +34,21 @@
 //Dependencies
 #include "core/crypto.h"
 #include "mpi/mpi.h"
+#include "mpi/mpi_fixed.h"
 #include "debug.h"
 
 //Check crypto library configuration
 #if (MPI_SUPPORT == ENABLED)
 
+//Small primes used for trial division and as Miller-Rabin bases
+static const uint8_t mpiSmallPrimes[] =
+{
+   2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+   59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131,
+   137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223,
+   227, 229, 233, 239, 241, 251
+};
+
 
 /**
  * @brief Initialize a multiple precision integer
@@ -551,14 +561,160 @@ end:
 
 /**
  * @brief Test whether a number is probable prime
+ *
+ * Trial division by the small primes is followed by a series of Miller-Rabin
+ * tests. The number of rounds depends on the size of the number to be tested
+ * and the first primes are used as bases
+ *
+ * Since the bases are fixed, composites that pass the test can be crafted on
+ * purpose. This function is only suitable for randomly generated candidates
+ * and must not be used to validate untrusted input, such as parameters
+ * received from a peer
+ *
  * @param[in] a Pointer to a multiple precision integer
  * @return Error code
  **/
 
 __weak_func error_t mpiCheckProbablePrime(const Mpi *a)
 {
-   //The algorithm is implemented by hardware
-   return ERROR_NOT_IMPLEMENTED;
+   error_t error;
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   uint_t n;
+   uint_t s;
+   uint_t r;
+   Mpi b;
+   Mpi d;
+   Mpi m;
+   Mpi y;
+
+   //Negative integers, 0 and 1 are not prime
+   if(mpiCompInt(a, 2) < 0)
+      return ERROR_INVALID_VALUE;
+
+   //Trial division by the small primes
+   for(i = 0; i < arraysize(mpiSmallPrimes); i++)
+   {
+      //The number is one of the small primes?
+      if(mpiCompInt(a, mpiSmallPrimes[i]) == 0)
+         return NO_ERROR;
+
+      //Compute A mod p
+      error = mpiModInt(&r, a, mpiSmallPrimes[i]);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //The number is not prime if it is divisible by p
+      if(r == 0)
+         return ERROR_INVALID_VALUE;
+   }
+
+   //Retrieve the length of the input integer, in bits
+   n = mpiGetBitLength(a);
+
+   //The number of repetitions controls the error probability
+   if(n >= 1300)
+   {
+      k = 2;
+   }
+   else if(n >= 850)
+   {
+      k = 3;
+   }
+   else if(n >= 650)
+   {
+      k = 4;
+   }
+   else if(n >= 550)
+   {
+      k = 5;
+   }
+   else if(n >= 450)
+   {
+      k = 6;
+   }
+   else if(n >= 400)
+   {
+      k = 7;
+   }
+   else if(n >= 350)
+   {
+      k = 8;
+   }
+   else if(n >= 300)
+   {
+      k = 9;
+   }
+   else if(n >= 250)
+   {
+      k = 12;
+   }
+   else if(n >= 200)
+   {
+      k = 15;
+   }
+   else if(n >= 150)
+   {
+      k = 18;
+   }
+   else
+   {
+      k = 27;
+   }
+
+   //Initialize multiple precision integers
+   mpiInit(&b);
+   mpiInit(&d);
+   mpiInit(&m);
+   mpiInit(&y);
+
+   //Compute M = A - 1
+   MPI_CHECK(mpiSubInt(&m, a, 1));
+
+   //Write A - 1 as 2^s * D, where D is odd
+   s = 0;
+   while(!mpiGetBitValue(&m, s)) s++;
+
+   MPI_CHECK(mpiCopy(&d, &m));
+   MPI_CHECK(mpiShiftRight(&d, s));
+
+   //Miller-Rabin test
+   for(i = 0; i < k && !error; i++)
+   {
+      //Select the base
+      MPI_CHECK(mpiSetValue(&b, mpiSmallPrimes[i]));
+
+      //Compute Y = B^D mod A
+      MPI_CHECK(mpiExpMod(&y, &b, &d, a));
+
+      //Y = 1 or Y = A - 1?
+      if(mpiCompInt(&y, 1) == 0 || mpiComp(&y, &m) == 0)
+         continue;
+
+      //Square Y up to s - 1 times until A - 1 is reached
+      for(j = 1; j < s && mpiComp(&y, &m) != 0; j++)
+      {
+         MPI_CHECK(mpiMulMod(&y, &y, &y, a));
+      }
+
+      //The number is composite if A - 1 has not been reached
+      if(mpiComp(&y, &m) != 0)
+      {
+         error = ERROR_INVALID_VALUE;
+      }
+   }
+
+end:
+   //Release multiple precision integers
+   mpiFree(&b);
+   mpiFree(&d);
+   mpiFree(&m);
+   mpiFree(&y);
+
+   //Return status code
+   return error;
 }
 
 
@@ -1420,6 +1576,43 @@ end:
    return error;
 }
 
+/**
+ * @brief Modular reduction by an integer
+ * @param[out] r Resulting integer R = A mod P
+ * @param[in] a The multiple precision integer to be reduced
+ * @param[in] p The modulus P
+ * @return Error code
+ **/
+
+error_t mpiModInt(uint_t *r, const Mpi *a, uint_t p)
+{
+   int_t i;
+   uint64_t c;
+
+   //The modulus P must be non-zero
+   if(p == 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Process the words from the most significant to the least significant
+   for(c = 0, i = mpiGetLength(a) - 1; i >= 0; i--)
+   {
+      c = ((c << (MPI_INT_SIZE * 8)) | a->data[i]) % p;
+   }
+
+   //The sign of the result matches the sign of the modulus
+   if(a->sign < 0 && c != 0)
+   {
+      c = p - c;
+   }
+
+   //Return the residue
+   *r = (uint_t) c;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
 
 
 /**
@@ -1589,6 +1782,14 @@ __weak_func error_t mpiExpMod(Mpi *r, const Mpi *a, const Mpi *e, const Mpi *p)
    Mpi t;
    Mpi s[8];
 
+#if (MPI_FIXED_SUPPORT == ENABLED)
+   //Use the fixed-width kernels when the modulus has one of the common sizes
+   if(mpiGetFixedKernel(p) != NULL)
+   {
+      return mpiExpModFixed(r, a, e, p);
+   }
+#endif
+
    //Initialize multiple precision integers
    mpiInit(&b);
    mpiInit(&c2);
@@ -1788,6 +1989,289 @@ __weak_func error_t mpiExpModRegular(Mpi *r, const Mpi *a, const Mpi *e, const M
 }
 
 
+/**
+ * @brief Simultaneous modular exponentiation with two bases
+ * @param[out] r Resulting integer R = A1 ^ E1 * A2 ^ E2 mod P
+ * @param[in] a1 First base
+ * @param[in] e1 First exponent
+ * @param[in] a2 Second base
+ * @param[in] e2 Second exponent
+ * @param[in] p Modulus
+ * @return Error code
+ **/
+
+__weak_func error_t mpiExpMod2(Mpi *r, const Mpi *a1, const Mpi *e1,
+   const Mpi *a2, const Mpi *e2, const Mpi *p)
+{
+   const Mpi *a[2];
+   const Mpi *e[2];
+
+   //Bases
+   a[0] = a1;
+   a[1] = a2;
+
+   //Exponents
+   e[0] = e1;
+   e[1] = e2;
+
+   //Compute R = A1 ^ E1 * A2 ^ E2 mod P
+   return mpiMultiExpMod(r, a, e, 2, p);
+}
+
+
+/**
+ * @brief Simultaneous modular exponentiation
+ *
+ * The product of powers is evaluated with interleaved sliding windows
+ * (Straus' method): each base has its own table of odd powers, and the
+ * squarings are shared between all the bases
+ *
+ * @param[out] r Resulting integer R = A[0] ^ E[0] * ... * A[n-1] ^ E[n-1] mod P
+ * @param[in] a Bases
+ * @param[in] e Exponents
+ * @param[in] n Number of bases
+ * @param[in] p Modulus
+ * @return Error code
+ **/
+
+__weak_func error_t mpiMultiExpMod(Mpi *r, const Mpi *const *a,
+   const Mpi *const *e, uint_t n, const Mpi *p)
+{
+   error_t error;
+   int_t i;
+   int_t j;
+   int_t m;
+   uint_t k;
+   bool_t one;
+   int_t pos[MPI_MAX_EXP_BASES];
+   uint_t u[MPI_MAX_EXP_BASES];
+   uint_t d[MPI_MAX_EXP_BASES];
+   Mpi b;
+   Mpi c2;
+   Mpi t;
+   Mpi x;
+   Mpi s[MPI_MAX_EXP_BASES][8];
+
+   //Check parameters
+   if(r == NULL || a == NULL || e == NULL || p == NULL || n == 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Large products are split into groups of MPI_MAX_EXP_BASES bases
+   if(n > MPI_MAX_EXP_BASES)
+   {
+      //Initialize multiple precision integer
+      mpiInit(&x);
+
+      //Process the first group
+      error = mpiMultiExpMod(&x, a, e, MPI_MAX_EXP_BASES, p);
+
+      //Check status code
+      if(!error)
+      {
+         //Process the remaining bases
+         error = mpiMultiExpMod(r, a + MPI_MAX_EXP_BASES, e + MPI_MAX_EXP_BASES,
+            n - MPI_MAX_EXP_BASES, p);
+      }
+
+      //Check status code
+      if(!error)
+      {
+         //Combine the partial products
+         error = mpiMulMod(r, r, &x, p);
+      }
+
+      //Release multiple precision integer
+      mpiFree(&x);
+
+      //Return status code
+      return error;
+   }
+
+#if (MPI_FIXED_SUPPORT == ENABLED)
+   //Use the fixed-width kernels when the modulus has one of the common sizes
+   if(mpiGetFixedKernel(p) != NULL)
+   {
+      return mpiMultiExpModFixed(r, a, e, n, p);
+   }
+#endif
+
+   //Initialize multiple precision integers
+   mpiInit(&b);
+   mpiInit(&c2);
+   mpiInit(&t);
+   mpiInit(&x);
+
+   //Initialize precomputed values
+   for(i = 0; i < (int_t) n; i++)
+   {
+      for(j = 0; j < arraysize(s[i]); j++)
+      {
+         mpiInit(&s[i][j]);
+      }
+   }
+
+   //Even modulus?
+   if(mpiIsEven(p))
+   {
+      //Let X = 1
+      MPI_CHECK(mpiSetValue(&x, 1));
+
+      //Montgomery arithmetic cannot be used, so the powers are computed
+      //separately
+      for(i = 0; i < (int_t) n; i++)
+      {
+         MPI_CHECK(mpiExpMod(&t, a[i], e[i], p));
+         MPI_CHECK(mpiMulMod(&x, &x, &t, p));
+      }
+   }
+   else
+   {
+      //Compute the smaller C = (2^32)^k such as C > P
+      k = mpiGetLength(p);
+
+      //Compute C^2 mod P
+      MPI_CHECK(mpiSetValue(&c2, 1));
+      MPI_CHECK(mpiShiftLeft(&c2, 2 * k * (MPI_INT_SIZE * 8)));
+      MPI_CHECK(mpiMod(&c2, &c2, p));
+
+      //Precompute the odd powers of each base
+      for(i = 0; i < (int_t) n; i++)
+      {
+         //Very small exponents are often selected with low Hamming weight.
+         //The sliding window mechanism should be disabled in that case
+         d[i] = (mpiGetBitLength(e[i]) <= 32) ? 1 : 4;
+
+         //Let B = A * C mod P
+         if(a[i]->sign < 0 || mpiComp(a[i], p) >= 0)
+         {
+            MPI_CHECK(mpiMod(&b, a[i], p));
+            MPI_CHECK(mpiMontgomeryMul(&b, &b, &c2, k, p, &t));
+         }
+         else
+         {
+            MPI_CHECK(mpiMontgomeryMul(&b, a[i], &c2, k, p, &t));
+         }
+
+         //Let X = B^2 * C^-1 mod P
+         MPI_CHECK(mpiMontgomeryMul(&x, &b, &b, k, p, &t));
+         //Let S[0] = B
+         MPI_CHECK(mpiCopy(&s[i][0], &b));
+
+         //Precompute S[j] = B^(2 * j + 1) * C^-1 mod P
+         for(j = 1; j < (1 << (d[i] - 1)); j++)
+         {
+            MPI_CHECK(mpiMontgomeryMul(&s[i][j], &s[i][j - 1], &x, k, p, &t));
+         }
+
+         //Find the first window of the exponent
+         pos[i] = mpiGetExpWindow(e[i], mpiGetBitLength(e[i]) - 1, d[i], &u[i]);
+      }
+
+      //Let X = C mod P
+      MPI_CHECK(mpiCopy(&x, &c2));
+      MPI_CHECK(mpiMontgomeryRed(&x, &x, k, p, &t));
+
+      //Get the length of the longest exponent
+      for(m = 0, i = 0; i < (int_t) n; i++)
+      {
+         m = MAX(m, (int_t) mpiGetBitLength(e[i]));
+      }
+
+      //The exponents are processed in a left-to-right fashion
+      for(one = TRUE, j = m - 1; j >= 0; j--)
+      {
+         //Compute X = X^2 * C^-1 mod P (unless X = 1)
+         if(!one)
+         {
+            MPI_CHECK(mpiMontgomeryMul(&x, &x, &x, k, p, &t));
+         }
+
+         //Loop through the bases
+         for(i = 0; i < (int_t) n; i++)
+         {
+            //Does a window end at the current position?
+            if(pos[i] == j)
+            {
+               //Compute X = X * S[u/2] * C^-1 mod P
+               MPI_CHECK(mpiMontgomeryMul(&x, &x, &s[i][u[i] >> 1], k, p, &t));
+               //Find the next window of the exponent
+               pos[i] = mpiGetExpWindow(e[i], j - 1, d[i], &u[i]);
+               //X is no longer equal to 1
+               one = FALSE;
+            }
+         }
+      }
+
+      //Compute X = X * C^-1 mod P
+      MPI_CHECK(mpiMontgomeryRed(&x, &x, k, p, &t));
+   }
+
+   //Copy the result
+   MPI_CHECK(mpiCopy(r, &x));
+
+end:
+   //Release multiple precision integers
+   mpiFree(&b);
+   mpiFree(&c2);
+   mpiFree(&t);
+   mpiFree(&x);
+
+   //Release precomputed values
+   for(i = 0; i < (int_t) n; i++)
+   {
+      for(j = 0; j < arraysize(s[i]); j++)
+      {
+         mpiFree(&s[i][j]);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Find the next window of a sliding window exponentiation
+ * @param[in] e Exponent
+ * @param[in] i Position of the first bit to be examined
+ * @param[in] d Maximum size of the window, in bits
+ * @param[out] u Value of the window (always odd)
+ * @return Position of the least significant bit of the window (-1 if the
+ *   remaining bits of the exponent are all zero)
+ **/
+
+int_t mpiGetExpWindow(const Mpi *e, int_t i, uint_t d, uint_t *u)
+{
+   int_t j;
+   int_t n;
+
+   //Skip the zero bits
+   while(i >= 0 && !mpiGetBitValue(e, i))
+   {
+      i--;
+   }
+
+   //The remaining bits are all zero?
+   if(i < 0)
+      return -1;
+
+   //Find the longest window
+   n = MAX(i - (int_t) d + 1, 0);
+
+   //The least significant bit of the window must be equal to 1
+   while(!mpiGetBitValue(e, n)) n++;
+
+   //Compute the value of the window
+   for(*u = 0, j = i; j >= n; j--)
+   {
+      *u = (*u << 1) | mpiGetBitValue(e, j);
+   }
+
+   //Return the position of the least significant bit
+   return n;
+}
+
+
 /**
  * @brief Montgomery multiplication
  * @param[out] r Resulting integer R = A * B / 2^k mod P
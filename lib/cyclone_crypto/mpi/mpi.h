@@ -38,6 +38,13 @@
 //Size of the sub data type
 #define MPI_INT_SIZE sizeof(uint_t)
 
+//Maximum number of bases processed simultaneously by mpiMultiExpMod
+#ifndef MPI_MAX_EXP_BASES
+   #define MPI_MAX_EXP_BASES 4
+#elif (MPI_MAX_EXP_BASES < 2)
+   #error MPI_MAX_EXP_BASES parameter is not valid
+#endif
+
 //Error code checking
 #define MPI_CHECK(f) if((error = f) != NO_ERROR) goto end
 
@@ -124,6 +131,7 @@ error_t mpiDiv(Mpi *q, Mpi *r, const Mpi *a, const Mpi *b);
 error_t mpiDivInt(Mpi *q, Mpi *r, const Mpi *a, int_t b);
 
 error_t mpiMod(Mpi *r, const Mpi *a, const Mpi *p);
+error_t mpiModInt(uint_t *r, const Mpi *a, uint_t p);
 error_t mpiAddMod(Mpi *r, const Mpi *a, const Mpi *b, const Mpi *p);
 error_t mpiSubMod(Mpi *r, const Mpi *a, const Mpi *b, const Mpi *p);
 error_t mpiMulMod(Mpi *r, const Mpi *a, const Mpi *b, const Mpi *p);
@@ -133,6 +141,14 @@ error_t mpiExpMod(Mpi *r, const Mpi *a, const Mpi *e, const Mpi *p);
 error_t mpiExpModFast(Mpi *r, const Mpi *a, const Mpi *e, const Mpi *p);
 error_t mpiExpModRegular(Mpi *r, const Mpi *a, const Mpi *e, const Mpi *p);
 
+error_t mpiExpMod2(Mpi *r, const Mpi *a1, const Mpi *e1, const Mpi *a2,
+   const Mpi *e2, const Mpi *p);
+
+error_t mpiMultiExpMod(Mpi *r, const Mpi *const *a, const Mpi *const *e,
+   uint_t n, const Mpi *p);
+
+int_t mpiGetExpWindow(const Mpi *e, int_t i, uint_t d, uint_t *u);
+
 error_t mpiMontgomeryMul(Mpi *r, const Mpi *a, const Mpi *b, uint_t k,
    const Mpi *p, Mpi *t);
 
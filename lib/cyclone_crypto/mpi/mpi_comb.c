@@ -0,0 +1,810 @@
+/**
+ * @file mpi_comb.c
+ * @brief Fixed-base modular exponentiation (Lim-Lee comb method)
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ * @section Description
+ *
+ * DH key generation and DSA signature generation raise the same generator g
+ * to a fresh exponent for every operation. The Lim-Lee comb method splits
+ * the exponent into h rows of a bits and each row into v blocks of b bits.
+ * The products of the powers g^(2^(i * a + j * b)) are precomputed for every
+ * combination of rows, so that an exponentiation costs only b squarings and
+ * v * b multiplications. The number of operations does not depend on the
+ * value of the exponent
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "mpi/mpi.h"
+#include "mpi/mpi_fixed.h"
+#include "mpi/mpi_comb.h"
+#include "hash/sha256.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (MPI_SUPPORT == ENABLED && MPI_FIXED_SUPPORT == ENABLED && \
+   MPI_COMB_SUPPORT == ENABLED)
+
+//Precomputed table cache used by the key generation routines
+static MpiCombCache *mpiCombCache = NULL;
+
+
+/**
+ * @brief Key identifying cached tables
+ **/
+
+typedef struct
+{
+   const Mpi *g;  ///<Base
+   const Mpi *p;  ///<Modulus
+   uint_t expLen; ///<Maximum length of the exponent, in bits
+} MpiCombKey;
+
+//Forward declaration of functions
+static error_t mpiCombSetup(MpiCombTable *table, const Mpi *g, const Mpi *p,
+   uint_t expLen, uint_t h, uint_t v);
+
+
+/**
+ * @brief Initialize fixed-base precomputed tables
+ * @param[in] table Pointer to the precomputed tables
+ **/
+
+void mpiCombInit(MpiCombTable *table)
+{
+   //Clear the structure
+   osMemset(table, 0, sizeof(MpiCombTable));
+
+   //Initialize multiple precision integers
+   mpiInit(&table->g);
+   mpiInit(&table->p);
+}
+
+
+/**
+ * @brief Release fixed-base precomputed tables
+ * @param[in] table Pointer to the precomputed tables
+ **/
+
+void mpiCombFree(MpiCombTable *table)
+{
+   //Valid tables?
+   if(table->pp != NULL)
+   {
+      //Erase the contents of the tables before releasing memory
+      osMemset(table->pp, 0, (1 + (table->v << table->h)) *
+         table->kernel->n * sizeof(MpiFixedWord));
+
+      cryptoFreeMem(table->pp);
+   }
+
+   //Release multiple precision integers
+   mpiFree(&table->g);
+   mpiFree(&table->p);
+
+   //Clear the structure
+   mpiCombInit(table);
+}
+
+
+/**
+ * @brief Build fixed-base precomputed tables
+ * @param[out] table Pointer to the precomputed tables
+ * @param[in] g Base
+ * @param[in] p Modulus
+ * @param[in] expLen Maximum length of the exponent, in bits
+ * @return Error code
+ **/
+
+error_t mpiCombBuild(MpiCombTable *table, const Mpi *g, const Mpi *p,
+   uint_t expLen)
+{
+   error_t error;
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   uint_t n;
+   uint_t u;
+   MpiFixedWord *s;
+   MpiFixedWord r2[MPI_FIXED_MAX_WORDS];
+   MpiFixedWord x[MPI_FIXED_MAX_WORDS];
+   Mpi c;
+
+   //Initialize multiple precision integer
+   mpiInit(&c);
+
+   //Allocate resources
+   MPI_CHECK(mpiCombSetup(table, g, p, expLen, MPI_COMB_TEETH,
+      MPI_COMB_TABLES));
+
+   //Number of words
+   k = table->kernel->n;
+   //Number of entries in each table
+   n = 1 << table->h;
+
+   //Compute R^2 mod P
+   mpiFixedMontgomerySetup(table->kernel, r2, table->pp, table->m);
+
+   //Let S[0][0] = R mod P
+   osMemset(x, 0, k * sizeof(MpiFixedWord));
+   x[0] = 1;
+   table->kernel->montMul(table->data, x, r2, table->pp, table->m);
+
+   //Reduce G modulo P
+   MPI_CHECK(mpiMod(&c, g, p));
+   MPI_CHECK(mpiFixedImport(x, &c, k));
+
+   //Let X = G * R mod P
+   table->kernel->montMul(x, x, r2, table->pp, table->m);
+
+   //The first table holds the products of G^(2^(i * a)) for every subset
+   //of rows
+   for(i = 0; i < table->h; i++)
+   {
+      //Let S[0][2^i] = G^(2^(i * a)) * R mod P
+      s = table->data + (1 << i) * k;
+      osMemcpy(s, x, k * sizeof(MpiFixedWord));
+
+      //Compute S[0][2^i + u] = S[0][u] * S[0][2^i] * R^-1 mod P
+      for(u = 1; u < (1U << i); u++)
+      {
+         table->kernel->montMul(s + u * k, table->data + u * k, x,
+            table->pp, table->m);
+      }
+
+      //Compute X = G^(2^((i + 1) * a)) * R mod P
+      if((i + 1) < table->h)
+      {
+         for(j = 0; j < table->a; j++)
+         {
+            table->kernel->montSqr(x, x, table->pp, table->m);
+         }
+      }
+   }
+
+   //Each subsequent table is obtained by raising the entries of the
+   //previous one to the power of 2^b
+   for(s = table->data + n * k, i = n; i < (n * table->v); i++, s += k)
+   {
+      osMemcpy(s, s - n * k, k * sizeof(MpiFixedWord));
+
+      for(j = 0; j < table->b; j++)
+      {
+         table->kernel->montSqr(s, s, table->pp, table->m);
+      }
+   }
+
+end:
+   //Erase the intermediate values
+   osMemset(x, 0, sizeof(x));
+
+   //Release multiple precision integer
+   mpiFree(&c);
+
+   //Any error to report?
+   if(error)
+   {
+      //Clean up side effects
+      mpiCombFree(table);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Load fixed-base precomputed tables from their serialized form
+ * @param[out] table Pointer to the precomputed tables
+ * @param[in] g Base
+ * @param[in] p Modulus
+ * @param[in] data Serialized tables
+ * @param[in] length Length of the serialized tables, in bytes
+ * @return Error code
+ **/
+
+error_t mpiCombImport(MpiCombTable *table, const Mpi *g, const Mpi *p,
+   const uint8_t *data, size_t length)
+{
+   error_t error;
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   uint_t n;
+   MpiFixedWord *s;
+   MpiFixedWord r2[MPI_FIXED_MAX_WORDS];
+   MpiFixedWord x[MPI_FIXED_MAX_WORDS];
+   uint8_t digest[SHA256_DIGEST_SIZE];
+   Mpi c;
+
+   //Check parameters
+   if(table == NULL || g == NULL || p == NULL || data == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Malformed header?
+   if(length < MPI_COMB_HEADER_SIZE)
+      return ERROR_INVALID_LENGTH;
+
+   //Initialize multiple precision integer
+   mpiInit(&c);
+
+   //Allocate resources
+   MPI_CHECK(mpiCombSetup(table, g, p, LOAD32BE(data + 4), data[0], data[1]));
+
+   //Number of words
+   k = table->kernel->n;
+   //Length of each entry, in bytes
+   n = table->kernel->bitLen / 8;
+
+   //The serialized tables must match the modulus
+   if((uint_t) LOAD16BE(data + 2) != n ||
+      length != MPI_COMB_HEADER_SIZE + (size_t) (table->v << table->h) * n)
+   {
+      error = ERROR_INVALID_LENGTH;
+      goto end;
+   }
+
+   //Digest the entries
+   error = sha256Compute(data + MPI_COMB_HEADER_SIZE,
+      length - MPI_COMB_HEADER_SIZE, digest);
+   //Any error to report?
+   if(error)
+      goto end;
+
+   //Check the integrity of the serialized tables
+   if(osMemcmp(digest, data + 8, SHA256_DIGEST_SIZE))
+   {
+      error = ERROR_INVALID_VALUE;
+      goto end;
+   }
+
+   //Point to the first entry
+   data += MPI_COMB_HEADER_SIZE;
+
+   //Entries are stored in big-endian byte order
+   for(s = table->data, i = 0; i < (table->v << table->h); i++, s += k)
+   {
+      osMemset(s, 0, k * sizeof(MpiFixedWord));
+
+      for(j = 0; j < n; j++)
+      {
+         s[j / sizeof(MpiFixedWord)] |= (MpiFixedWord) data[i * n + n - 1 - j] <<
+            ((j % sizeof(MpiFixedWord)) * 8);
+      }
+
+      //Each entry must be reduced modulo P
+      if(mpiFixedComp(s, table->pp, k) >= 0)
+      {
+         error = ERROR_INVALID_VALUE;
+         goto end;
+      }
+   }
+
+   //Compute R^2 mod P
+   mpiFixedMontgomerySetup(table->kernel, r2, table->pp, table->m);
+
+   //Reduce G modulo P
+   MPI_CHECK(mpiMod(&c, g, p));
+   MPI_CHECK(mpiFixedImport(x, &c, k));
+
+   //Compute G * R mod P
+   table->kernel->montMul(x, x, r2, table->pp, table->m);
+
+   //The tables must have been computed for the same base
+   if(osMemcmp(x, table->data + k, k * sizeof(MpiFixedWord)))
+   {
+      error = ERROR_INVALID_VALUE;
+      goto end;
+   }
+
+   //Compute R mod P
+   osMemset(x, 0, k * sizeof(MpiFixedWord));
+   x[0] = 1;
+   table->kernel->montMul(x, x, r2, table->pp, table->m);
+
+   //The first entry must be equal to 1 in Montgomery representation
+   if(osMemcmp(x, table->data, k * sizeof(MpiFixedWord)))
+   {
+      error = ERROR_INVALID_VALUE;
+   }
+
+end:
+   //Release multiple precision integer
+   mpiFree(&c);
+
+   //Any error to report?
+   if(error)
+   {
+      //Clean up side effects
+      mpiCombFree(table);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Serialize fixed-base precomputed tables
+ * @param[in] table Pointer to the precomputed tables
+ * @param[out] data Buffer where to store the serialized tables (optional parameter)
+ * @param[out] written Length of the serialized tables, in bytes
+ * @return Error code
+ **/
+
+error_t mpiCombExport(const MpiCombTable *table, uint8_t *data,
+   size_t *written)
+{
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   uint_t n;
+   error_t error;
+   const MpiFixedWord *s;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Check parameters
+   if(table == NULL || written == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The tables must be valid
+   if(table->pp == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Number of words
+   k = table->kernel->n;
+   //Length of each entry, in bytes
+   n = table->kernel->bitLen / 8;
+
+   //If the output parameter is NULL, then the function calculates the
+   //length of the serialized tables without copying any data
+   if(data != NULL)
+   {
+      //Format header
+      data[0] = table->h;
+      data[1] = table->v;
+      STORE16BE(n, data + 2);
+      STORE32BE(table->expLen, data + 4);
+
+      //Entries are stored in big-endian byte order
+      for(s = table->data, i = 0; i < (table->v << table->h); i++, s += k)
+      {
+         for(j = 0; j < n; j++)
+         {
+            data[MPI_COMB_HEADER_SIZE + i * n + n - 1 - j] =
+               (uint8_t) (s[j / sizeof(MpiFixedWord)] >>
+               ((j % sizeof(MpiFixedWord)) * 8));
+         }
+      }
+
+      //The header ends with the SHA-256 digest of the entries
+      error = sha256Compute(data + MPI_COMB_HEADER_SIZE,
+         (size_t) (table->v << table->h) * n, data + 8);
+   }
+
+   //Total length of the serialized tables
+   *written = MPI_COMB_HEADER_SIZE + (size_t) (table->v << table->h) * n;
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Fixed-base modular exponentiation
+ * @param[in] table Precomputed tables for base G and modulus P
+ * @param[out] r Resulting integer R = G ^ E mod P
+ * @param[in] e Exponent
+ * @return Error code
+ **/
+
+error_t mpiCombExpMod(const MpiCombTable *table, Mpi *r, const Mpi *e)
+{
+   error_t error;
+   int_t t;
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   uint_t u;
+   uint_t pos;
+   MpiFixedWord x[MPI_FIXED_MAX_WORDS];
+   MpiFixedWord y[MPI_FIXED_MAX_WORDS];
+
+   //Check parameters
+   if(table == NULL || table->pp == NULL || r == NULL || e == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The exponent must be a non-negative integer that fits in the tables
+   if(e->sign < 0 || mpiGetBitLength(e) > table->expLen)
+      return ERROR_INVALID_LENGTH;
+
+   //Number of words
+   k = table->kernel->n;
+
+   //Let X = R mod P
+   osMemcpy(x, table->data, k * sizeof(MpiFixedWord));
+
+   //The columns of the exponent are processed in a left-to-right fashion
+   for(t = table->b - 1; t >= 0; t--)
+   {
+      //Compute X = X^2 * R^-1 mod P
+      table->kernel->montSqr(x, x, table->pp, table->m);
+
+      //Loop through the tables
+      for(j = 0; j < table->v; j++)
+      {
+         //Bit position within each row
+         pos = j * table->b + t;
+
+         //Gather the bits of the current column from every row
+         for(u = 0, i = table->h; i > 0 && pos < table->a; i--)
+         {
+            u = (u << 1) | mpiGetBitValue(e, (i - 1) * table->a + pos);
+         }
+
+         //Compute X = X * S[j][u] * R^-1 mod P
+         table->kernel->montMul(x, x, table->data + ((j << table->h) + u) * k,
+            table->pp, table->m);
+      }
+   }
+
+   //Let U = 1
+   osMemset(y, 0, k * sizeof(MpiFixedWord));
+   y[0] = 1;
+
+   //Compute X = X * U * R^-1 mod P
+   table->kernel->montMul(x, x, y, table->pp, table->m);
+
+   //Copy the result
+   error = mpiFixedExport(r, x, k);
+
+   //Erase the intermediate value
+   osMemset(x, 0, sizeof(x));
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Check whether cached tables match a given base
+ * @param[in] entry Cached tables
+ * @param[in] key Base, modulus and exponent length
+ * @return TRUE if the tables match, else FALSE
+ **/
+
+static bool_t mpiCombMatchEntry(const void *entry, const void *key)
+{
+   const MpiCombTable *table;
+   const MpiCombKey *k;
+
+   //Point to the tables and the key
+   table = (const MpiCombTable *) entry;
+   k = (const MpiCombKey *) key;
+
+   //Compare exponent length, base and modulus
+   return table->expLen == k->expLen && !mpiComp(&table->g, k->g) &&
+      !mpiComp(&table->p, k->p);
+}
+
+
+/**
+ * @brief Build the tables for a given base
+ * @param[out] entry Tables to be built
+ * @param[in] key Base, modulus and exponent length
+ * @return Error code
+ **/
+
+static error_t mpiCombBuildEntry(void *entry, const void *key)
+{
+   const MpiCombKey *k;
+
+   //Point to the key
+   k = (const MpiCombKey *) key;
+
+   //Build the precomputed tables
+   mpiCombInit(entry);
+   return mpiCombBuild(entry, k->g, k->p, k->expLen);
+}
+
+
+/**
+ * @brief Release cached tables
+ * @param[in] entry Cached tables
+ **/
+
+static void mpiCombReleaseEntry(void *entry)
+{
+   mpiCombFree(entry);
+}
+
+
+//Type of the cache entries
+static const CryptoCacheAlgo mpiCombCacheAlgo =
+{
+   sizeof(MpiCombTable),
+   mpiCombMatchEntry,
+   mpiCombBuildEntry,
+   mpiCombReleaseEntry
+};
+
+
+/**
+ * @brief Fixed-base precomputed table cache initialization
+ * @param[in] size Maximum number of cache entries
+ * @return Handle referencing the fully initialized cache
+ **/
+
+MpiCombCache *mpiCombInitCache(uint_t size)
+{
+   return cryptoInitCache(size);
+}
+
+
+/**
+ * @brief Release fixed-base precomputed table cache
+ * @param[in] cache Pointer to the cache
+ **/
+
+void mpiCombFreeCache(MpiCombCache *cache)
+{
+   cryptoFreeCache(cache, &mpiCombCacheAlgo);
+}
+
+
+/**
+ * @brief Add serialized precomputed tables to the cache
+ * @param[in] cache Pointer to the cache
+ * @param[in] g Base
+ * @param[in] p Modulus
+ * @param[in] data Serialized tables
+ * @param[in] length Length of the serialized tables, in bytes
+ * @return Error code
+ **/
+
+error_t mpiCombLoadTable(MpiCombCache *cache, const Mpi *g, const Mpi *p,
+   const uint8_t *data, size_t length)
+{
+   error_t error;
+   MpiCombTable *table;
+
+   //Check parameters
+   if(cache == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a memory buffer to hold the precomputed tables
+   table = cryptoAllocMem(sizeof(MpiCombTable));
+   //Failed to allocate memory?
+   if(table == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Load the precomputed tables
+   mpiCombInit(table);
+   error = mpiCombImport(table, g, p, data, length);
+
+   //Check status code
+   if(!error)
+   {
+      //Save the precomputed tables
+      error = cryptoCacheAdd(cache, table);
+   }
+
+   //Any error to report?
+   if(error)
+   {
+      //Clean up side effects
+      mpiCombFree(table);
+      cryptoFreeMem(table);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Retrieve the precomputed tables for a given base
+ * @param[in] cache Pointer to the cache
+ * @param[in] g Base
+ * @param[in] p Modulus
+ * @param[in] expLen Maximum length of the exponent, in bits
+ * @param[out] table Precomputed tables for base G and modulus P
+ * @return Error code
+ **/
+
+error_t mpiCombGetTable(MpiCombCache *cache, const Mpi *g, const Mpi *p,
+   uint_t expLen, const MpiCombTable **table)
+{
+   error_t error;
+   void *entry;
+   MpiCombKey key;
+
+   //Check parameters
+   if(cache == NULL || g == NULL || p == NULL || table == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The tables are identified by the base, the modulus and the length of
+   //the exponent
+   key.g = g;
+   key.p = p;
+   key.expLen = expLen;
+
+   //Retrieve the matching tables, building them if necessary
+   error = cryptoCacheGet(cache, &mpiCombCacheAlgo, &key, &entry);
+
+   //Return the precomputed tables
+   *table = entry;
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Register the precomputed table cache used by the key generation routines
+ * @param[in] cache Pointer to the cache (NULL to disable the cache)
+ * @return Error code
+ **/
+
+error_t mpiCombRegisterCache(MpiCombCache *cache)
+{
+   //Save the precomputed table cache
+   mpiCombCache = cache;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Get the registered precomputed table cache
+ * @return Pointer to the cache (NULL if no cache has been registered)
+ **/
+
+MpiCombCache *mpiCombGetCache(void)
+{
+   //Return the registered precomputed table cache
+   return mpiCombCache;
+}
+
+
+/**
+ * @brief Modular exponentiation with a fixed base
+ *
+ * The precomputed tables held by the registered cache are used when
+ * available. Otherwise the function falls back to regular modular
+ * exponentiation
+ *
+ * @param[out] r Resulting integer R = G ^ E mod P
+ * @param[in] g Base
+ * @param[in] e Exponent
+ * @param[in] p Modulus
+ * @param[in] expLen Maximum length of the exponents used with this base, in bits
+ * @return Error code
+ **/
+
+error_t mpiExpModFixedBase(Mpi *r, const Mpi *g, const Mpi *e, const Mpi *p,
+   uint_t expLen)
+{
+   error_t error;
+   const MpiCombTable *table;
+
+   //Any registered cache?
+   if(mpiCombCache != NULL && e->sign >= 0 &&
+      mpiGetBitLength(e) <= expLen)
+   {
+      //Retrieve the precomputed tables for the base
+      error = mpiCombGetTable(mpiCombCache, g, p, expLen, &table);
+
+      //Check status code
+      if(!error)
+      {
+         //Perform fixed-base exponentiation
+         return mpiCombExpMod(table, r, e);
+      }
+   }
+
+   //Perform regular modular exponentiation
+   return mpiExpModRegular(r, g, e, p);
+}
+
+
+/**
+ * @brief Allocate fixed-base precomputed tables
+ * @param[out] table Pointer to the precomputed tables
+ * @param[in] g Base
+ * @param[in] p Modulus
+ * @param[in] expLen Maximum length of the exponent, in bits
+ * @param[in] h Number of bits combined into each table index
+ * @param[in] v Number of tables
+ * @return Error code
+ **/
+
+static error_t mpiCombSetup(MpiCombTable *table, const Mpi *g, const Mpi *p,
+   uint_t expLen, uint_t h, uint_t v)
+{
+   error_t error;
+   uint_t k;
+   const MpiFixedKernel *kernel;
+
+   //Release previously allocated resources
+   mpiCombFree(table);
+
+   //Check parameters
+   if(expLen == 0 || h < 1 || h > 8 || v < 1 || v > 8)
+      return ERROR_INVALID_PARAMETER;
+
+   //Retrieve the kernel that matches the modulus size
+   kernel = mpiGetFixedKernel(p);
+   //Unsupported modulus size?
+   if(kernel == NULL)
+      return ERROR_INVALID_LENGTH;
+
+   //Number of words
+   k = kernel->n;
+
+   //Allocate a memory buffer to hold the modulus and the tables
+   table->pp = cryptoAllocMem((1 + (v << h)) * k * sizeof(MpiFixedWord));
+   //Failed to allocate memory?
+   if(table->pp == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Save parameters
+   table->expLen = expLen;
+   table->h = h;
+   table->v = v;
+   table->kernel = kernel;
+   table->data = table->pp + k;
+
+   //The exponent is split into h rows of a bits, and each row is split
+   //into v blocks of b bits
+   table->a = (expLen + h - 1) / h;
+   table->b = (table->a + v - 1) / v;
+
+   //Save the base and the modulus
+   MPI_CHECK(mpiCopy(&table->g, g));
+   MPI_CHECK(mpiCopy(&table->p, p));
+
+   //Load the modulus
+   MPI_CHECK(mpiFixedImport(table->pp, p, k));
+
+   //Compute -1/P mod 2^w
+   table->m = mpiFixedMontgomeryInit(table->pp);
+
+end:
+   //Return status code
+   return error;
+}
+
+#endif
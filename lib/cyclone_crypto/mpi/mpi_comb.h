@@ -0,0 +1,133 @@
+/**
+ * @file mpi_comb.h
+ * @brief Fixed-base modular exponentiation (Lim-Lee comb method)
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+
+#ifndef _MPI_COMB_H
+#define _MPI_COMB_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "core/crypto_cache.h"
+#include "mpi/mpi.h"
+#include "mpi/mpi_fixed.h"
+
+//Fixed-base exponentiation support
+#ifndef MPI_COMB_SUPPORT
+   #define MPI_COMB_SUPPORT DISABLED
+#elif (MPI_COMB_SUPPORT != ENABLED && MPI_COMB_SUPPORT != DISABLED)
+   #error MPI_COMB_SUPPORT parameter is not valid
+#endif
+
+//Number of bits of the exponent combined into each table index
+#ifndef MPI_COMB_TEETH
+   #define MPI_COMB_TEETH 6
+#elif (MPI_COMB_TEETH < 1 || MPI_COMB_TEETH > 8)
+   #error MPI_COMB_TEETH parameter is not valid
+#endif
+
+//Number of precomputed tables
+#ifndef MPI_COMB_TABLES
+   #define MPI_COMB_TABLES 2
+#elif (MPI_COMB_TABLES < 1 || MPI_COMB_TABLES > 8)
+   #error MPI_COMB_TABLES parameter is not valid
+#endif
+
+//Size of the header of a serialized table
+#define MPI_COMB_HEADER_SIZE 40
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Fixed-base precomputed tables
+ **/
+
+typedef struct
+{
+   Mpi g;                         ///<Base
+   Mpi p;                         ///<Modulus
+   uint_t expLen;                 ///<Maximum length of the exponent, in bits
+   uint_t h;                      ///<Number of bits combined into each table index
+   uint_t v;                      ///<Number of tables
+   uint_t a;                      ///<Length of each row of the exponent, in bits
+   uint_t b;                      ///<Length of each column block, in bits
+   const MpiFixedKernel *kernel;  ///<Montgomery kernels
+   MpiFixedWord m;                ///<-1/P mod 2^w
+   MpiFixedWord *pp;              ///<Modulus (fixed-width representation)
+   MpiFixedWord *data;            ///<Precomputed values (v * 2^h entries)
+} MpiCombTable;
+
+
+/**
+ * @brief Fixed-base precomputed table cache
+ **/
+
+typedef CryptoCache MpiCombCache;
+
+
+//Fixed-base exponentiation related functions
+void mpiCombInit(MpiCombTable *table);
+void mpiCombFree(MpiCombTable *table);
+
+error_t mpiCombBuild(MpiCombTable *table, const Mpi *g, const Mpi *p,
+   uint_t expLen);
+
+error_t mpiCombImport(MpiCombTable *table, const Mpi *g, const Mpi *p,
+   const uint8_t *data, size_t length);
+
+error_t mpiCombExport(const MpiCombTable *table, uint8_t *data,
+   size_t *written);
+
+error_t mpiCombExpMod(const MpiCombTable *table, Mpi *r, const Mpi *e);
+
+MpiCombCache *mpiCombInitCache(uint_t size);
+void mpiCombFreeCache(MpiCombCache *cache);
+
+error_t mpiCombLoadTable(MpiCombCache *cache, const Mpi *g, const Mpi *p,
+   const uint8_t *data, size_t length);
+
+error_t mpiCombGetTable(MpiCombCache *cache, const Mpi *g, const Mpi *p,
+   uint_t expLen, const MpiCombTable **table);
+
+error_t mpiCombRegisterCache(MpiCombCache *cache);
+MpiCombCache *mpiCombGetCache(void);
+
+error_t mpiExpModFixedBase(Mpi *r, const Mpi *g, const Mpi *e, const Mpi *p,
+   uint_t expLen);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
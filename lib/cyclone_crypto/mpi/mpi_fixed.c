@@ -0,0 +1,833 @@
+/**
+ * @file mpi_fixed.c
+ * @brief Fixed-width modular arithmetic for common modulus sizes
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * The generic multiple precision arithmetic handles operands of any length
+ * and allocates memory on demand. Most moduli used in practice have one of a
+ * few sizes (1024, 1536, 2048, 3072, 4096, 6144 or 8192 bits), so this module
+ * instantiates dedicated Montgomery multiplication and squaring kernels for
+ * each of them.
+ * Loop bounds are compile-time constants, operands live in fixed-size arrays
+ * and the inner loops are unrolled, which lets the compiler generate
+ * straight-line code with no length checks and no memory allocation
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "mpi/mpi.h"
+#include "mpi/mpi_fixed.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (MPI_SUPPORT == ENABLED && MPI_FIXED_SUPPORT == ENABLED)
+
+//Multiply-accumulate step (4 words)
+#define MPI_FIXED_MUL_ACC_4(t, x, y, c) \
+{ \
+   MPI_FIXED_MUL_ACC((t)[0], x, (y)[0], c); \
+   MPI_FIXED_MUL_ACC((t)[1], x, (y)[1], c); \
+   MPI_FIXED_MUL_ACC((t)[2], x, (y)[2], c); \
+   MPI_FIXED_MUL_ACC((t)[3], x, (y)[3], c); \
+}
+
+//Multiplication: T = A * B (T is 2n words long)
+#define MPI_FIXED_MUL_CORE(t, a, b, n) \
+{ \
+   uint_t i; \
+   uint_t j; \
+   MpiFixedWord c; \
+   for(i = 0; i < (n); i++) \
+   { \
+      (t)[i] = 0; \
+   } \
+   for(i = 0; i < (n); i++) \
+   { \
+      c = 0; \
+      for(j = 0; j < (n); j += 4) \
+      { \
+         MPI_FIXED_MUL_ACC_4((t) + i + j, (a)[i], (b) + j, c); \
+      } \
+      (t)[i + (n)] = c; \
+   } \
+}
+
+//Squaring: T = A^2 (T is 2n words long)
+#define MPI_FIXED_SQR_CORE(t, a, n) \
+{ \
+   uint_t i; \
+   uint_t j; \
+   MpiFixedWord c; \
+   MpiFixedDword z; \
+   for(i = 0; i < 2 * (n); i++) \
+   { \
+      (t)[i] = 0; \
+   } \
+   for(i = 0; i < (n) - 1; i++) \
+   { \
+      c = 0; \
+      for(j = i + 1; j < (n); j++) \
+      { \
+         MPI_FIXED_MUL_ACC((t)[i + j], (a)[i], (a)[j], c); \
+      } \
+      (t)[i + (n)] = c; \
+   } \
+   for(c = 0, i = 0; i < 2 * (n); i++) \
+   { \
+      z = (MpiFixedDword) (t)[i] << 1 | c; \
+      (t)[i] = (MpiFixedWord) z; \
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE); \
+   } \
+   for(c = 0, i = 0; i < (n); i++) \
+   { \
+      z = (MpiFixedDword) (a)[i] * (a)[i] + (t)[2 * i] + c; \
+      (t)[2 * i] = (MpiFixedWord) z; \
+      z = (MpiFixedDword) (t)[2 * i + 1] + (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE); \
+      (t)[2 * i + 1] = (MpiFixedWord) z; \
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE); \
+   } \
+}
+
+//Montgomery reduction: R = T / 2^(n * w) mod P (T is 2n words long)
+#define MPI_FIXED_RED_CORE(r, t, p, m, n) \
+{ \
+   uint_t i; \
+   uint_t j; \
+   MpiFixedWord c; \
+   MpiFixedWord u; \
+   MpiFixedWord mask; \
+   MpiFixedWord carry; \
+   MpiFixedDword z; \
+   for(carry = 0, i = 0; i < (n); i++) \
+   { \
+      u = (t)[i] * (m); \
+      c = 0; \
+      for(j = 0; j < (n); j += 4) \
+      { \
+         MPI_FIXED_MUL_ACC_4((t) + i + j, u, (p) + j, c); \
+      } \
+      z = (MpiFixedDword) (t)[i + (n)] + c + carry; \
+      (t)[i + (n)] = (MpiFixedWord) z; \
+      carry = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE); \
+   } \
+   for(c = 0, i = 0; i < (n); i++) \
+   { \
+      z = (MpiFixedDword) (t)[i + (n)] - (p)[i] - c; \
+      (r)[i] = (MpiFixedWord) z; \
+      c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE) & 1; \
+   } \
+   mask = 0 - (c & (carry ^ 1)); \
+   for(i = 0; i < (n); i++) \
+   { \
+      (r)[i] = ((r)[i] & ~mask) | ((t)[i + (n)] & mask); \
+   } \
+}
+
+//Instantiate the Montgomery kernels for a given modulus size
+#define MPI_FIXED_KERNEL(bits) \
+static void mpiFixedMontgomeryMul##bits(MpiFixedWord *r, const MpiFixedWord *a, \
+   const MpiFixedWord *b, const MpiFixedWord *p, MpiFixedWord m) \
+{ \
+   MpiFixedWord t[2 * MPI_FIXED_WORDS(bits)]; \
+   MPI_FIXED_MUL_CORE(t, a, b, MPI_FIXED_WORDS(bits)); \
+   MPI_FIXED_RED_CORE(r, t, p, m, MPI_FIXED_WORDS(bits)); \
+} \
+static void mpiFixedMontgomerySqr##bits(MpiFixedWord *r, const MpiFixedWord *a, \
+   const MpiFixedWord *p, MpiFixedWord m) \
+{ \
+   MpiFixedWord t[2 * MPI_FIXED_WORDS(bits)]; \
+   MPI_FIXED_SQR_CORE(t, a, MPI_FIXED_WORDS(bits)); \
+   MPI_FIXED_RED_CORE(r, t, p, m, MPI_FIXED_WORDS(bits)); \
+}
+
+//Fixed-width kernels
+MPI_FIXED_KERNEL(1024)
+MPI_FIXED_KERNEL(1536)
+MPI_FIXED_KERNEL(2048)
+MPI_FIXED_KERNEL(3072)
+MPI_FIXED_KERNEL(4096)
+MPI_FIXED_KERNEL(6144)
+MPI_FIXED_KERNEL(8192)
+
+//Supported modulus sizes
+static const MpiFixedKernel mpiFixedKernels[] =
+{
+   {1024, MPI_FIXED_WORDS(1024), mpiFixedMontgomeryMul1024, mpiFixedMontgomerySqr1024},
+   {1536, MPI_FIXED_WORDS(1536), mpiFixedMontgomeryMul1536, mpiFixedMontgomerySqr1536},
+   {2048, MPI_FIXED_WORDS(2048), mpiFixedMontgomeryMul2048, mpiFixedMontgomerySqr2048},
+   {3072, MPI_FIXED_WORDS(3072), mpiFixedMontgomeryMul3072, mpiFixedMontgomerySqr3072},
+   {4096, MPI_FIXED_WORDS(4096), mpiFixedMontgomeryMul4096, mpiFixedMontgomerySqr4096},
+   {6144, MPI_FIXED_WORDS(6144), mpiFixedMontgomeryMul6144, mpiFixedMontgomerySqr6144},
+   {8192, MPI_FIXED_WORDS(8192), mpiFixedMontgomeryMul8192, mpiFixedMontgomerySqr8192}
+};
+
+
+/**
+ * @brief Get the fixed-width kernel matching a given modulus
+ * @param[in] p Modulus
+ * @return Pointer to the matching kernel (NULL if the modulus size is not supported)
+ **/
+
+const MpiFixedKernel *mpiGetFixedKernel(const Mpi *p)
+{
+   uint_t i;
+   uint_t n;
+
+   //Montgomery arithmetic requires an odd modulus
+   if(p->sign < 0 || !mpiIsOdd(p))
+      return NULL;
+
+   //Number of words required to hold the modulus
+   n = (mpiGetBitLength(p) + MPI_FIXED_WORD_SIZE - 1) / MPI_FIXED_WORD_SIZE;
+
+   //Loop through the supported modulus sizes
+   for(i = 0; i < arraysize(mpiFixedKernels); i++)
+   {
+      //Matching size?
+      if(mpiFixedKernels[i].n == n)
+      {
+         return &mpiFixedKernels[i];
+      }
+   }
+
+   //The modulus size is not supported
+   return NULL;
+}
+
+
+/**
+ * @brief Modular exponentiation using fixed-width kernels
+ * @param[out] r Resulting integer R = A ^ E mod P
+ * @param[in] a Pointer to a multiple precision integer
+ * @param[in] e Exponent
+ * @param[in] p Modulus
+ * @return Error code
+ **/
+
+error_t mpiExpModFixed(Mpi *r, const Mpi *a, const Mpi *e, const Mpi *p)
+{
+   error_t error;
+   int_t i;
+   int_t j;
+   int_t n;
+   uint_t d;
+   uint_t k;
+   uint_t u;
+   MpiFixedWord m;
+   MpiFixedWord *pp;
+   MpiFixedWord *r2;
+   MpiFixedWord *b;
+   MpiFixedWord *x;
+   MpiFixedWord *s;
+   MpiFixedWord *buffer;
+   const MpiFixedKernel *kernel;
+   Mpi c;
+
+   //Retrieve the kernel that matches the modulus size
+   kernel = mpiGetFixedKernel(p);
+   //Unsupported modulus size?
+   if(kernel == NULL)
+      return ERROR_INVALID_LENGTH;
+
+   //Number of words
+   k = kernel->n;
+
+   //Allocate a memory buffer to hold the modulus, the intermediate values
+   //and the precomputed table
+   buffer = cryptoAllocMem(12 * k * sizeof(MpiFixedWord));
+   //Failed to allocate memory?
+   if(buffer == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Point to the relevant locations
+   pp = buffer;
+   r2 = pp + k;
+   b = r2 + k;
+   x = b + k;
+   s = x + k;
+
+   //Initialize multiple precision integer
+   mpiInit(&c);
+
+   //Very small exponents are often selected with low Hamming weight.
+   //The sliding window mechanism should be disabled in that case
+   d = (mpiGetBitLength(e) <= 32) ? 1 : 4;
+
+   //Load the modulus
+   MPI_CHECK(mpiFixedImport(pp, p, k));
+
+   //Compute -1/P mod 2^w and R^2 mod P, where R = 2^(k * w)
+   m = mpiFixedMontgomeryInit(pp);
+   mpiFixedMontgomerySetup(kernel, r2, pp, m);
+
+   //Reduce A modulo P if necessary
+   if(a->sign < 0 || mpiComp(a, p) >= 0)
+   {
+      MPI_CHECK(mpiMod(&c, a, p));
+      MPI_CHECK(mpiFixedImport(b, &c, k));
+   }
+   else
+   {
+      MPI_CHECK(mpiFixedImport(b, a, k));
+   }
+
+   //Let B = A * R mod P
+   kernel->montMul(b, b, r2, pp, m);
+
+   //Let X = B^2 * R^-1 mod P
+   kernel->montSqr(x, b, pp, m);
+   //Let S[0] = B
+   osMemcpy(s, b, k * sizeof(MpiFixedWord));
+
+   //Precompute S[i] = B^(2 * i + 1) * R^-1 mod P
+   for(i = 1; i < (1 << (d - 1)); i++)
+   {
+      kernel->montMul(s + i * k, s + (i - 1) * k, x, pp, m);
+   }
+
+   //Let X = R mod P
+   osMemset(b, 0, k * sizeof(MpiFixedWord));
+   b[0] = 1;
+   kernel->montMul(x, b, r2, pp, m);
+
+   //The exponent is processed in a left-to-right fashion
+   i = mpiGetBitLength(e) - 1;
+
+   //Perform sliding window exponentiation
+   while(i >= 0)
+   {
+      //The sliding window exponentiation algorithm decomposes E
+      //into zero and nonzero windows
+      if(!mpiGetBitValue(e, i))
+      {
+         //Compute X = X^2 * R^-1 mod P
+         kernel->montSqr(x, x, pp, m);
+         //Next bit to be processed
+         i--;
+      }
+      else
+      {
+         //Find the longest window
+         n = MAX(i - d + 1, 0);
+
+         //The least significant bit of the window must be equal to 1
+         while(!mpiGetBitValue(e, n)) n++;
+
+         //The algorithm processes more than one bit per iteration
+         for(u = 0, j = i; j >= n; j--)
+         {
+            //Compute X = X^2 * R^-1 mod P
+            kernel->montSqr(x, x, pp, m);
+            //Compute the relevant index to be used in the precomputed table
+            u = (u << 1) | mpiGetBitValue(e, j);
+         }
+
+         //Compute X = X * S[u/2] * R^-1 mod P
+         kernel->montMul(x, x, s + (u >> 1) * k, pp, m);
+         //Next bit to be processed
+         i = n - 1;
+      }
+   }
+
+   //Compute X = X * R^-1 mod P
+   osMemset(b, 0, k * sizeof(MpiFixedWord));
+   b[0] = 1;
+   kernel->montMul(x, x, b, pp, m);
+
+   //Copy the result
+   MPI_CHECK(mpiFixedExport(r, x, k));
+
+end:
+   //Release multiple precision integer
+   mpiFree(&c);
+
+   //Erase the intermediate values before releasing memory
+   osMemset(buffer, 0, 12 * k * sizeof(MpiFixedWord));
+   cryptoFreeMem(buffer);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Simultaneous modular exponentiation using fixed-width kernels
+ * @param[out] r Resulting integer R = A[0] ^ E[0] * ... * A[n-1] ^ E[n-1] mod P
+ * @param[in] a Bases
+ * @param[in] e Exponents
+ * @param[in] n Number of bases (at most MPI_MAX_EXP_BASES)
+ * @param[in] p Modulus
+ * @return Error code
+ **/
+
+error_t mpiMultiExpModFixed(Mpi *r, const Mpi *const *a, const Mpi *const *e,
+   uint_t n, const Mpi *p)
+{
+   error_t error;
+   int_t i;
+   int_t j;
+   int_t t;
+   uint_t k;
+   bool_t one;
+   int_t pos[MPI_MAX_EXP_BASES];
+   uint_t u[MPI_MAX_EXP_BASES];
+   uint_t d[MPI_MAX_EXP_BASES];
+   MpiFixedWord m;
+   MpiFixedWord *pp;
+   MpiFixedWord *r2;
+   MpiFixedWord *b;
+   MpiFixedWord *x;
+   MpiFixedWord *s;
+   MpiFixedWord *buffer;
+   const MpiFixedKernel *kernel;
+   Mpi c;
+
+   //Check parameters
+   if(n == 0 || n > MPI_MAX_EXP_BASES)
+      return ERROR_INVALID_PARAMETER;
+
+   //Retrieve the kernel that matches the modulus size
+   kernel = mpiGetFixedKernel(p);
+   //Unsupported modulus size?
+   if(kernel == NULL)
+      return ERROR_INVALID_LENGTH;
+
+   //Number of words
+   k = kernel->n;
+
+   //Allocate a memory buffer to hold the modulus, the intermediate values
+   //and the precomputed tables (8 entries per base)
+   buffer = cryptoAllocMem((4 + 8 * n) * k * sizeof(MpiFixedWord));
+   //Failed to allocate memory?
+   if(buffer == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Point to the relevant locations
+   pp = buffer;
+   r2 = pp + k;
+   b = r2 + k;
+   x = b + k;
+   s = x + k;
+
+   //Initialize multiple precision integer
+   mpiInit(&c);
+
+   //Load the modulus
+   MPI_CHECK(mpiFixedImport(pp, p, k));
+
+   //Compute -1/P mod 2^m and R^2 mod P, where R = 2^(k * m)
+   m = mpiFixedMontgomeryInit(pp);
+   mpiFixedMontgomerySetup(kernel, r2, pp, m);
+
+   //Precompute the odd powers of each base
+   for(i = 0; i < (int_t) n; i++)
+   {
+      //Very small exponents are often selected with low Hamming weight.
+      //The sliding window mechanism should be disabled in that case
+      d[i] = (mpiGetBitLength(e[i]) <= 32) ? 1 : 4;
+
+      //Reduce A modulo P if necessary
+      if(a[i]->sign < 0 || mpiComp(a[i], p) >= 0)
+      {
+         MPI_CHECK(mpiMod(&c, a[i], p));
+         MPI_CHECK(mpiFixedImport(b, &c, k));
+      }
+      else
+      {
+         MPI_CHECK(mpiFixedImport(b, a[i], k));
+      }
+
+      //Let S[0] = A * R mod P
+      kernel->montMul(s + 8 * i * k, b, r2, pp, m);
+      //Let X = S[0]^2 * R^-1 mod P
+      kernel->montSqr(x, s + 8 * i * k, pp, m);
+
+      //Precompute S[j] = A^(2 * j + 1) * R mod P
+      for(j = 1; j < (1 << (d[i] - 1)); j++)
+      {
+         kernel->montMul(s + (8 * i + j) * k, s + (8 * i + j - 1) * k, x,
+            pp, m);
+      }
+
+      //Find the first window of the exponent
+      pos[i] = mpiGetExpWindow(e[i], mpiGetBitLength(e[i]) - 1, d[i], &u[i]);
+   }
+
+   //Let X = R mod P
+   osMemset(b, 0, k * sizeof(MpiFixedWord));
+   b[0] = 1;
+   kernel->montMul(x, b, r2, pp, m);
+
+   //Get the length of the longest exponent
+   for(t = 0, i = 0; i < (int_t) n; i++)
+   {
+      t = MAX(t, (int_t) mpiGetBitLength(e[i]));
+   }
+
+   //The exponents are processed in a left-to-right fashion
+   for(one = TRUE, j = t - 1; j >= 0; j--)
+   {
+      //Compute X = X^2 * R^-1 mod P (unless X = 1)
+      if(!one)
+      {
+         kernel->montSqr(x, x, pp, m);
+      }
+
+      //Loop through the bases
+      for(i = 0; i < (int_t) n; i++)
+      {
+         //Does a window end at the current position?
+         if(pos[i] == j)
+         {
+            //Compute X = X * S[u/2] * R^-1 mod P
+            kernel->montMul(x, x, s + (8 * i + (u[i] >> 1)) * k, pp, m);
+            //Find the next window of the exponent
+            pos[i] = mpiGetExpWindow(e[i], j - 1, d[i], &u[i]);
+            //X is no longer equal to 1
+            one = FALSE;
+         }
+      }
+   }
+
+   //Compute X = X * R^-1 mod P
+   kernel->montMul(x, x, b, pp, m);
+
+   //Copy the result
+   MPI_CHECK(mpiFixedExport(r, x, k));
+
+end:
+   //Release multiple precision integer
+   mpiFree(&c);
+
+   //Erase the intermediate values before releasing memory
+   osMemset(buffer, 0, (4 + 8 * n) * k * sizeof(MpiFixedWord));
+   cryptoFreeMem(buffer);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Convert a multiple precision integer to fixed-width representation
+ * @param[out] r Resulting fixed-width integer
+ * @param[in] a Multiple precision integer to be converted
+ * @param[in] n Size of the fixed-width integer, in words
+ * @return Error code
+ **/
+
+error_t mpiFixedImport(MpiFixedWord *r, const Mpi *a, uint_t n)
+{
+   uint_t i;
+   uint_t j;
+   uint_t length;
+
+   //Get the actual length of the integer, in words
+   length = mpiGetLength(a);
+
+   //Check the length of the integer
+   if(length * MPI_INT_SIZE > n * sizeof(MpiFixedWord))
+      return ERROR_INVALID_LENGTH;
+
+   //Clear the fixed-width integer
+   osMemset(r, 0, n * sizeof(MpiFixedWord));
+
+   //Copy the words of the multiple precision integer
+   for(i = 0; i < length; i++)
+   {
+      //Bit position of the current word
+      j = i * MPI_INT_SIZE * 8;
+      //Insert the current word
+      r[j / MPI_FIXED_WORD_SIZE] |= (MpiFixedWord) a->data[i] <<
+         (j % MPI_FIXED_WORD_SIZE);
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Convert a fixed-width integer to a multiple precision integer
+ * @param[out] r Resulting multiple precision integer
+ * @param[in] a Fixed-width integer to be converted
+ * @param[in] n Size of the fixed-width integer, in words
+ * @return Error code
+ **/
+
+error_t mpiFixedExport(Mpi *r, const MpiFixedWord *a, uint_t n)
+{
+   error_t error;
+   uint_t i;
+   uint_t j;
+   uint_t length;
+
+   //Size of the resulting integer, in words
+   length = n * sizeof(MpiFixedWord) / MPI_INT_SIZE;
+
+   //Ajust the size of the integer
+   error = mpiGrow(r, length);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Clear the contents of the multiple precision integer
+   osMemset(r->data, 0, r->size * MPI_INT_SIZE);
+   //Set the sign
+   r->sign = 1;
+
+   //Copy the words of the fixed-width integer
+   for(i = 0; i < length; i++)
+   {
+      //Bit position of the current word
+      j = i * MPI_INT_SIZE * 8;
+      //Extract the current word
+      r->data[i] = (uint_t) (a[j / MPI_FIXED_WORD_SIZE] >>
+         (j % MPI_FIXED_WORD_SIZE));
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Octet string to fixed-width integer conversion
+ * @param[out] r Resulting fixed-width integer
+ * @param[in] n Size of the fixed-width integer, in words
+ * @param[in] data Octet string to be converted (big-endian)
+ * @param[in] length Length of the octet string
+ * @return Error code
+ **/
+
+error_t mpiFixedImportRaw(MpiFixedWord *r, uint_t n, const uint8_t *data,
+   size_t length)
+{
+   uint_t i;
+
+   //Skip leading zeroes
+   while(length > 0 && data[0] == 0)
+   {
+      data++;
+      length--;
+   }
+
+   //Check the length of the octet string
+   if(length > n * sizeof(MpiFixedWord))
+      return ERROR_INVALID_LENGTH;
+
+   //Clear the fixed-width integer
+   osMemset(r, 0, n * sizeof(MpiFixedWord));
+
+   //Import the octet string, least significant byte first
+   for(i = 0; i < length; i++)
+   {
+      r[i / sizeof(MpiFixedWord)] |= (MpiFixedWord) data[length - 1 - i] <<
+         ((i % sizeof(MpiFixedWord)) * 8);
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Fixed-width integer to octet string conversion
+ * @param[in] a Fixed-width integer to be converted
+ * @param[in] n Size of the fixed-width integer, in words
+ * @param[out] data Octet string resulting from the conversion (big-endian)
+ * @param[in] length Length of the octet string
+ * @return Error code
+ **/
+
+error_t mpiFixedExportRaw(const MpiFixedWord *a, uint_t n, uint8_t *data,
+   size_t length)
+{
+   uint_t i;
+
+   //Make sure the integer fits in the octet string
+   for(i = length; i < n * sizeof(MpiFixedWord); i++)
+   {
+      if(((a[i / sizeof(MpiFixedWord)] >> ((i % sizeof(MpiFixedWord)) * 8)) &
+         0xFF) != 0)
+      {
+         return ERROR_INVALID_LENGTH;
+      }
+   }
+
+   //Export the integer, least significant byte first
+   for(i = 0; i < length; i++)
+   {
+      if(i < n * sizeof(MpiFixedWord))
+      {
+         data[length - 1 - i] = (uint8_t) (a[i / sizeof(MpiFixedWord)] >>
+            ((i % sizeof(MpiFixedWord)) * 8));
+      }
+      else
+      {
+         data[length - 1 - i] = 0;
+      }
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Compare two fixed-width integers
+ * @param[in] a First fixed-width integer
+ * @param[in] b Second fixed-width integer
+ * @param[in] n Size of the fixed-width integers, in words
+ * @return Comparison result (-1 if A < B, 0 if A = B, 1 if A > B)
+ **/
+
+int_t mpiFixedComp(const MpiFixedWord *a, const MpiFixedWord *b, uint_t n)
+{
+   uint_t i;
+
+   //Compare the words, most significant first
+   for(i = n; i > 0; i--)
+   {
+      if(a[i - 1] > b[i - 1])
+      {
+         return 1;
+      }
+      else if(a[i - 1] < b[i - 1])
+      {
+         return -1;
+      }
+   }
+
+   //The integers are equal
+   return 0;
+}
+
+
+/**
+ * @brief Compute the Montgomery constant -1/P mod 2^w
+ * @param[in] p Odd modulus
+ * @return Montgomery constant
+ **/
+
+MpiFixedWord mpiFixedMontgomeryInit(const MpiFixedWord *p)
+{
+   uint_t i;
+   MpiFixedWord m;
+
+   //The inverse of P[0] is correct to 3 bits (P[0] * P[0] = 1 mod 8)
+   m = p[0];
+
+   //Use Newton's method to compute the inverse of P[0] mod 2^w (each
+   //iteration doubles the number of correct bits)
+   for(i = 0; i < 5; i++)
+   {
+      m = m * (2 - m * p[0]);
+   }
+
+   //Return -1/P[0] mod 2^w
+   return ~m + 1;
+}
+
+
+/**
+ * @brief Compute R^2 mod P, where R = 2^(n * w)
+ * @param[in] kernel Fixed-width kernel that matches the modulus size
+ * @param[out] r2 Resulting value
+ * @param[in] p Odd modulus
+ * @param[in] m Montgomery constant -1/P mod 2^w
+ **/
+
+void mpiFixedMontgomerySetup(const MpiFixedKernel *kernel, MpiFixedWord *r2,
+   const MpiFixedWord *p, MpiFixedWord m)
+{
+   uint_t i;
+   uint_t j;
+   uint_t n;
+   uint_t s;
+   uint_t t;
+   MpiFixedWord c;
+   MpiFixedWord mask;
+   MpiFixedWord carry;
+   MpiFixedWord v[MPI_FIXED_MAX_WORDS];
+   MpiFixedDword z;
+
+   //Number of words
+   n = kernel->n;
+
+   //Decompose the bit length of R as t * 2^s, where t is odd
+   for(t = n * MPI_FIXED_WORD_SIZE, s = 0; (t & 1) == 0; s++)
+   {
+      t >>= 1;
+   }
+
+   //Let X = 1
+   osMemset(r2, 0, n * sizeof(MpiFixedWord));
+   r2[0] = 1;
+
+   //Compute X = R * 2^t mod P using modular doublings
+   for(i = 0; i < n * MPI_FIXED_WORD_SIZE + t; i++)
+   {
+      //Compute X = 2 * X
+      for(carry = 0, j = 0; j < n; j++)
+      {
+         c = r2[j] >> (MPI_FIXED_WORD_SIZE - 1);
+         r2[j] = (r2[j] << 1) | carry;
+         carry = c;
+      }
+
+      //Compute V = X - P
+      for(c = 0, j = 0; j < n; j++)
+      {
+         z = (MpiFixedDword) r2[j] - p[j] - c;
+         v[j] = (MpiFixedWord) z;
+         c = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE) & 1;
+      }
+
+      //Keep X if X < P, else replace X with V
+      mask = 0 - (c & (carry ^ 1));
+
+      for(j = 0; j < n; j++)
+      {
+         r2[j] = (r2[j] & mask) | (v[j] & ~mask);
+      }
+   }
+
+   //Each Montgomery squaring doubles the exponent of 2, so that
+   //R * 2^(t * 2^s) = R^2 mod P is obtained after s iterations
+   for(i = 0; i < s; i++)
+   {
+      kernel->montSqr(r2, r2, p, m);
+   }
+}
+
+#endif
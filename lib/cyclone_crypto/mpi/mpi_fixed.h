@@ -0,0 +1,150 @@
+/**
+ * @file mpi_fixed.h
+ * @brief Fixed-width modular arithmetic for common modulus sizes
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _MPI_FIXED_H
+#define _MPI_FIXED_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "mpi/mpi.h"
+
+//Fixed-width kernels for common modulus sizes
+#ifndef MPI_FIXED_SUPPORT
+   #define MPI_FIXED_SUPPORT ENABLED
+#elif (MPI_FIXED_SUPPORT != ENABLED && MPI_FIXED_SUPPORT != DISABLED)
+   #error MPI_FIXED_SUPPORT parameter is not valid
+#endif
+
+//Size of the words processed by the fixed-width kernels
+#ifndef MPI_FIXED_WORD_SIZE
+   #if defined(__SIZEOF_INT128__)
+      #define MPI_FIXED_WORD_SIZE 64
+   #else
+      #define MPI_FIXED_WORD_SIZE 32
+   #endif
+#elif (MPI_FIXED_WORD_SIZE != 32 && MPI_FIXED_WORD_SIZE != 64)
+   #error MPI_FIXED_WORD_SIZE parameter is not valid
+#endif
+
+//Number of words required to hold an integer of the specified bit length
+#define MPI_FIXED_WORDS(bits) ((bits) / MPI_FIXED_WORD_SIZE)
+
+//Largest modulus supported by the fixed-width kernels, in bits
+#define MPI_FIXED_MAX_MODULUS_SIZE 8192
+//Maximum number of words
+#define MPI_FIXED_MAX_WORDS MPI_FIXED_WORDS(MPI_FIXED_MAX_MODULUS_SIZE)
+
+//Multiply-accumulate step: (C, T) = T + X * Y + C
+#define MPI_FIXED_MUL_ACC(t, x, y, c) \
+{ \
+   MpiFixedDword z; \
+   z = (MpiFixedDword) (x) * (y) + (t) + (c); \
+   (t) = (MpiFixedWord) z; \
+   (c) = (MpiFixedWord) (z >> MPI_FIXED_WORD_SIZE); \
+}
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Word used by the fixed-width kernels
+ **/
+
+#if (MPI_FIXED_WORD_SIZE == 64)
+   typedef uint64_t MpiFixedWord;
+   __extension__ typedef unsigned __int128 MpiFixedDword;
+#else
+   typedef uint32_t MpiFixedWord;
+   typedef uint64_t MpiFixedDword;
+#endif
+
+
+/**
+ * @brief Montgomery multiplication kernel
+ **/
+
+typedef void (*MpiFixedMontgomeryMul)(MpiFixedWord *r, const MpiFixedWord *a,
+   const MpiFixedWord *b, const MpiFixedWord *p, MpiFixedWord m);
+
+
+/**
+ * @brief Montgomery squaring kernel
+ **/
+
+typedef void (*MpiFixedMontgomerySqr)(MpiFixedWord *r, const MpiFixedWord *a,
+   const MpiFixedWord *p, MpiFixedWord m);
+
+
+/**
+ * @brief Fixed-width kernels for a given modulus size
+ **/
+
+typedef struct
+{
+   uint_t bitLen;                    ///<Modulus size, in bits
+   uint_t n;                         ///<Number of words
+   MpiFixedMontgomeryMul montMul;    ///<Montgomery multiplication
+   MpiFixedMontgomerySqr montSqr;    ///<Montgomery squaring
+} MpiFixedKernel;
+
+
+//Fixed-width modular arithmetic related functions
+const MpiFixedKernel *mpiGetFixedKernel(const Mpi *p);
+
+error_t mpiExpModFixed(Mpi *r, const Mpi *a, const Mpi *e, const Mpi *p);
+
+error_t mpiMultiExpModFixed(Mpi *r, const Mpi *const *a, const Mpi *const *e,
+   uint_t n, const Mpi *p);
+
+error_t mpiFixedImport(MpiFixedWord *r, const Mpi *a, uint_t n);
+error_t mpiFixedExport(Mpi *r, const MpiFixedWord *a, uint_t n);
+
+error_t mpiFixedImportRaw(MpiFixedWord *r, uint_t n, const uint8_t *data,
+   size_t length);
+
+error_t mpiFixedExportRaw(const MpiFixedWord *a, uint_t n, uint8_t *data,
+   size_t length);
+
+int_t mpiFixedComp(const MpiFixedWord *a, const MpiFixedWord *b, uint_t n);
+
+MpiFixedWord mpiFixedMontgomeryInit(const MpiFixedWord *p);
+
+void mpiFixedMontgomerySetup(const MpiFixedKernel *kernel, MpiFixedWord *r2,
+   const MpiFixedWord *p, MpiFixedWord m);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
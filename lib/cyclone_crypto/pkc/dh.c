@@ -40,6 +40,7 @@
 //Dependencies
 #include "core/crypto.h"
 #include "pkc/dh.h"
+#include "mpi/mpi_comb.h"
 #include "debug.h"
 
 //Check crypto library configuration
@@ -124,8 +125,13 @@ error_t dhGenerateKeyPair(DhContext *context,
    TRACE_DEBUG_MPI("    ", &context->xa);
 
    //Calculate the corresponding public value (ya = g ^ xa mod p)
+#if (MPI_COMB_SUPPORT == ENABLED)
+   error = mpiExpModFixedBase(&context->ya, &context->params.g, &context->xa,
+      &context->params.p, k);
+#else
    error = mpiExpModRegular(&context->ya, &context->params.g, &context->xa,
       &context->params.p);
+#endif
    //Any error to report?
    if(error)
       return error;
@@ -244,4 +250,447 @@ error_t dhComputeSharedSecret(DhContext *context,
    return error;
 }
 
+
+/**
+ * @brief Generate Diffie-Hellman parameters
+ *
+ * The prime modulus p is a safe prime (p = 2q + 1, where q is also prime)
+ * and p = 7 mod 8, so that the generator g = 2 generates the subgroup of
+ * order q
+ *
+ * @param[out] params Pointer to the Diffie-Hellman parameters
+ * @param[in] length Bit length of the prime modulus
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @param[in] callback Progress callback (optional parameter)
+ * @param[in] param Opaque pointer passed to the callback
+ * @return Error code
+ **/
+
+error_t dhGenerateParameters(DhParameters *params, uint_t length,
+   const PrngAlgo *prngAlgo, void *prngContext, DhParamGenCallback callback,
+   void *param)
+{
+   error_t error;
+   DhParamGenContext context;
+
+   //Initialize parameter generation context
+   error = dhParamGenInit(&context, length, prngAlgo, prngContext, callback,
+      param);
+
+   //Check status code
+   if(!error)
+   {
+      //Search for a safe prime
+      error = dhParamGenRun(&context);
+
+      //Check status code
+      if(!error)
+      {
+         //Retrieve the resulting parameters
+         error = dhParamGenGetResult(&context, params);
+      }
+
+      //Release parameter generation context
+      dhParamGenFree(&context);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Initialize Diffie-Hellman parameter generation context
+ * @param[in] context Pointer to the parameter generation context
+ * @param[in] length Bit length of the prime modulus
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @param[in] callback Progress callback (optional parameter)
+ * @param[in] param Opaque pointer passed to the callback
+ * @return Error code
+ **/
+
+error_t dhParamGenInit(DhParamGenContext *context, uint_t length,
+   const PrngAlgo *prngAlgo, void *prngContext, DhParamGenCallback callback,
+   void *param)
+{
+   uint_t i;
+   uint_t j;
+   uint8_t *composite;
+
+   //Check parameters
+   if(context == NULL || prngAlgo == NULL || prngContext == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The sieve requires the candidates to be larger than the small primes
+   if(length < 64)
+      return ERROR_INVALID_PARAMETER;
+
+   //Clear the context
+   osMemset(context, 0, sizeof(DhParamGenContext));
+
+   //Save parameters
+   context->length = length;
+   context->prngAlgo = prngAlgo;
+   context->prngContext = prngContext;
+   context->callback = callback;
+   context->param = param;
+
+   //Initialize multiple precision integer
+   mpiInit(&context->p);
+
+   //Allocate a temporary buffer for the sieve of Eratosthenes
+   composite = cryptoAllocMem(DH_SIEVE_PRIME_BOUND);
+   //Failed to allocate memory?
+   if(composite == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Find the odd primes below the bound
+   osMemset(composite, 0, DH_SIEVE_PRIME_BOUND);
+
+   for(i = 3; (i * i) < DH_SIEVE_PRIME_BOUND; i += 2)
+   {
+      //Cross out the odd multiples of each prime
+      if(!composite[i])
+      {
+         for(j = i * i; j < DH_SIEVE_PRIME_BOUND; j += 2 * i)
+         {
+            composite[j] = TRUE;
+         }
+      }
+   }
+
+   for(i = 3; i < DH_SIEVE_PRIME_BOUND; i += 2)
+   {
+      if(!composite[i])
+      {
+         context->numPrimes++;
+      }
+   }
+
+   //Allocate a memory buffer to hold the small primes
+   context->primes = cryptoAllocMem(context->numPrimes * sizeof(uint16_t));
+
+   //Check status code
+   if(context->primes != NULL)
+   {
+      //Save the small primes
+      for(i = 3, j = 0; i < DH_SIEVE_PRIME_BOUND; i += 2)
+      {
+         if(!composite[i])
+         {
+            context->primes[j++] = i;
+         }
+      }
+   }
+
+   //Release the temporary buffer
+   cryptoFreeMem(composite);
+
+   //Failed to allocate memory?
+   if(context->primes == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Create a mutex to prevent simultaneous access to the context
+   if(!osCreateMutex(&context->mutex))
+   {
+      //Clean up side effects
+      cryptoFreeMem(context->primes);
+      context->primes = NULL;
+      //Report an error
+      return ERROR_OUT_OF_RESOURCES;
+   }
+
+   //Successful initialization
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Search for a safe prime
+ *
+ * Each call picks a random starting point q0 = 3 mod 4 and walks through
+ * the candidates q = q0 + 4i. A joint sieve discards the candidates for
+ * which either q or p = 2q + 1 is divisible by one of the small primes.
+ * The survivors undergo a Fermat test to base 2 on p, followed by a full
+ * probable prime test on q. Since q > sqrt(p), a prime q together with
+ * 2^(p - 1) = 1 mod p proves that p is prime (Pocklington's criterion).
+ * This function may be called by several tasks concurrently
+ *
+ * @param[in] context Pointer to the parameter generation context
+ * @return Error code
+ **/
+
+error_t dhParamGenRun(DhParamGenContext *context)
+{
+   error_t error;
+   bool_t done;
+   uint_t i;
+   uint_t j;
+   uint_t s;
+   uint_t r;
+   uint_t u;
+   uint_t candidates;
+   uint16_t *residues;
+   uint8_t *sieve;
+   Mpi b;
+   Mpi e;
+   Mpi p;
+   Mpi q;
+   Mpi t;
+
+   //Check parameters
+   if(context == NULL || context->primes == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a memory buffer to hold the residues and the sieve
+   residues = cryptoAllocMem(context->numPrimes * sizeof(uint16_t) +
+      DH_SIEVE_SIZE);
+   //Failed to allocate memory?
+   if(residues == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Point to the sieve
+   sieve = (uint8_t *) (residues + context->numPrimes);
+
+   //Initialize multiple precision integers
+   mpiInit(&b);
+   mpiInit(&e);
+   mpiInit(&p);
+   mpiInit(&q);
+   mpiInit(&t);
+
+   //Initialize status code
+   error = NO_ERROR;
+   //Initialize flag
+   done = FALSE;
+
+   //Search for a safe prime
+   while(!done)
+   {
+      //Acquire exclusive access to the context
+      osAcquireMutex(&context->mutex);
+
+      //Generate a random starting point of bit length L - 1
+      if(!context->done)
+      {
+         error = mpiRand(&q, context->length - 1, context->prngAlgo,
+            context->prngContext);
+      }
+
+      //Check whether another task has already found a safe prime
+      done = context->done;
+
+      //Release exclusive access to the context
+      osReleaseMutex(&context->mutex);
+
+      //Any error to report?
+      if(done)
+         break;
+
+      MPI_CHECK(error);
+
+      //Set the high bit (this ensures p has the expected bit length) and
+      //the two low bits (q = 3 mod 4 implies p = 7 mod 8)
+      MPI_CHECK(mpiSetBitValue(&q, context->length - 2, 1));
+      MPI_CHECK(mpiSetBitValue(&q, 1, 1));
+      MPI_CHECK(mpiSetBitValue(&q, 0, 1));
+
+      //Compute the residues of q0 modulo the small primes
+      for(i = 0; i < context->numPrimes; i++)
+      {
+         MPI_CHECK(mpiModInt(&r, &q, context->primes[i]));
+         residues[i] = r;
+      }
+
+      //Process the sieve windows until q overflows its bit length
+      while(!done && mpiGetBitLength(&q) < context->length)
+      {
+         //Clear the sieve
+         osMemset(sieve, 0, DH_SIEVE_SIZE);
+
+         //Loop through the small primes
+         for(i = 0; i < context->numPrimes; i++)
+         {
+            //Current prime
+            s = context->primes[i];
+            //Compute 1/4 mod s
+            u = (s + 1) / 2;
+            u = (u * u) % s;
+
+            //Discard the candidates such that q0 + 4i = 0 mod s
+            for(j = ((s - residues[i]) * u) % s; j < DH_SIEVE_SIZE; j += s)
+            {
+               sieve[j] = TRUE;
+            }
+
+            //Discard the candidates such that 2 * (q0 + 4i) + 1 = 0 mod s
+            r = ((s - 1) / 2 + s - residues[i]) % s;
+
+            for(j = (r * u) % s; j < DH_SIEVE_SIZE; j += s)
+            {
+               sieve[j] = TRUE;
+            }
+         }
+
+         //Test the candidates that survived the sieve
+         for(j = 0; j < DH_SIEVE_SIZE && !done; j++)
+         {
+            //Skip the candidates that have a small factor
+            if(sieve[j])
+               continue;
+
+            //Compute p = 2 * (q0 + 4j) + 1
+            MPI_CHECK(mpiAddInt(&p, &q, 4 * j));
+            MPI_CHECK(mpiShiftLeft(&p, 1));
+            MPI_CHECK(mpiAddInt(&p, &p, 1));
+
+            //The candidate must fit in the expected bit length
+            if(mpiGetBitLength(&p) > context->length)
+               break;
+
+            //Fermat test to base 2 on p
+            MPI_CHECK(mpiSubInt(&e, &p, 1));
+            MPI_CHECK(mpiSetValue(&b, 2));
+            MPI_CHECK(mpiExpModFast(&t, &b, &e, &p));
+
+            //2^(p - 1) = 1 mod p?
+            if(mpiCompInt(&t, 1) == 0)
+            {
+               //Compute (p - 1) / 2
+               MPI_CHECK(mpiShiftRight(&e, 1));
+
+               //Test whether (p - 1) / 2 is a probable prime
+               error = mpiCheckProbablePrime(&e);
+
+               //Any error to report?
+               if(error != NO_ERROR && error != ERROR_INVALID_VALUE)
+                  goto end;
+            }
+            else
+            {
+               //p is composite
+               error = ERROR_INVALID_VALUE;
+            }
+
+            //Acquire exclusive access to the context
+            osAcquireMutex(&context->mutex);
+
+            //Check whether another task has already found a safe prime
+            done = context->done;
+
+            //Safe prime found?
+            if(!error && !done)
+            {
+               //Save the safe prime
+               error = mpiCopy(&context->p, &p);
+               //Stop the search
+               context->done = TRUE;
+               done = TRUE;
+            }
+
+            //Update statistics
+            candidates = ++context->candidates;
+
+            //Release exclusive access to the context
+            osReleaseMutex(&context->mutex);
+
+            //Report progress
+            if(context->callback != NULL)
+            {
+               context->callback(candidates, context->param);
+            }
+
+            //Any error to report?
+            if(error != NO_ERROR && error != ERROR_INVALID_VALUE)
+               goto end;
+         }
+
+         //Move to the next window
+         MPI_CHECK(mpiAddInt(&q, &q, 4 * DH_SIEVE_SIZE));
+
+         //Update the residues accordingly
+         for(i = 0; i < context->numPrimes; i++)
+         {
+            residues[i] = (residues[i] + 4 * DH_SIEVE_SIZE) %
+               context->primes[i];
+         }
+      }
+   }
+
+   //Successful processing
+   error = NO_ERROR;
+
+end:
+   //Release multiple precision integers
+   mpiFree(&b);
+   mpiFree(&e);
+   mpiFree(&p);
+   mpiFree(&q);
+   mpiFree(&t);
+
+   //Release previously allocated memory
+   cryptoFreeMem(residues);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Retrieve the generated Diffie-Hellman parameters
+ * @param[in] context Pointer to the parameter generation context
+ * @param[out] params Pointer to the Diffie-Hellman parameters
+ * @return Error code
+ **/
+
+error_t dhParamGenGetResult(DhParamGenContext *context, DhParameters *params)
+{
+   error_t error;
+
+   //Check parameters
+   if(context == NULL || params == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Make sure a safe prime has been found
+   if(!context->done)
+      return ERROR_WRONG_STATE;
+
+   //Save the prime modulus
+   error = mpiCopy(&params->p, &context->p);
+
+   //Check status code
+   if(!error)
+   {
+      //Since p = 7 mod 8, 2 is a quadratic residue and generates the
+      //subgroup of order q
+      error = mpiSetValue(&params->g, 2);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Release Diffie-Hellman parameter generation context
+ * @param[in] context Pointer to the parameter generation context
+ **/
+
+void dhParamGenFree(DhParamGenContext *context)
+{
+   //Valid context?
+   if(context != NULL && context->primes != NULL)
+   {
+      //Release previously allocated resources
+      osDeleteMutex(&context->mutex);
+      cryptoFreeMem(context->primes);
+      mpiFree(&context->p);
+
+      //Clear the context
+      osMemset(context, 0, sizeof(DhParamGenContext));
+   }
+}
+
 #endif
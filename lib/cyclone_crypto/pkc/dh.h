@@ -35,6 +35,20 @@
 #include "core/crypto.h"
 #include "mpi/mpi.h"
 
+//Number of candidates covered by each sieve window
+#ifndef DH_SIEVE_SIZE
+   #define DH_SIEVE_SIZE 4096
+#elif (DH_SIEVE_SIZE < 64)
+   #error DH_SIEVE_SIZE parameter is not valid
+#endif
+
+//Upper bound of the small primes used by the sieve
+#ifndef DH_SIEVE_PRIME_BOUND
+   #define DH_SIEVE_PRIME_BOUND 16384
+#elif (DH_SIEVE_PRIME_BOUND < 256 || DH_SIEVE_PRIME_BOUND > 65536)
+   #error DH_SIEVE_PRIME_BOUND parameter is not valid
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 extern "C" {
@@ -65,6 +79,39 @@ typedef struct
 } DhContext;
 
 
+
+/**
+ * @brief Progress callback invoked during parameter generation
+ **/
+
+typedef void (*DhParamGenCallback)(uint_t candidates, void *param);
+
+
+/**
+ * @brief Diffie-Hellman parameter generation context
+ *
+ * Several tasks can invoke dhParamGenRun() concurrently on the same context.
+ * Each of them searches its own range of candidates, and all of them return
+ * as soon as a safe prime has been found
+ *
+ **/
+
+typedef struct
+{
+   OsMutex mutex;                ///<Mutex preventing simultaneous access to the context
+   uint_t length;                ///<Bit length of the prime modulus
+   const PrngAlgo *prngAlgo;     ///<PRNG algorithm
+   void *prngContext;            ///<Pointer to the PRNG context
+   DhParamGenCallback callback;  ///<Progress callback
+   void *param;                  ///<Opaque pointer passed to the callback
+   uint16_t *primes;             ///<Small primes used by the sieve
+   uint_t numPrimes;             ///<Number of small primes
+   uint_t candidates;            ///<Number of candidates tested so far
+   bool_t done;                  ///<A safe prime has been found
+   Mpi p;                        ///<Resulting safe prime
+} DhParamGenContext;
+
+
 //Diffie-Hellman related functions
 void dhInit(DhContext *context);
 void dhFree(DhContext *context);
@@ -77,6 +124,18 @@ error_t dhCheckPublicKey(DhParameters *params, const Mpi *publicKey);
 error_t dhComputeSharedSecret(DhContext *context,
    uint8_t *output, size_t outputSize, size_t *outputLen);
 
+error_t dhGenerateParameters(DhParameters *params, uint_t length,
+   const PrngAlgo *prngAlgo, void *prngContext, DhParamGenCallback callback,
+   void *param);
+
+error_t dhParamGenInit(DhParamGenContext *context, uint_t length,
+   const PrngAlgo *prngAlgo, void *prngContext, DhParamGenCallback callback,
+   void *param);
+
+error_t dhParamGenRun(DhParamGenContext *context);
+error_t dhParamGenGetResult(DhParamGenContext *context, DhParameters *params);
+void dhParamGenFree(DhParamGenContext *context);
+
 //C++ guard
 #ifdef __cplusplus
 }
@@ -41,6 +41,7 @@
 #include "core/crypto.h"
 #include "pkc/dsa.h"
 #include "mpi/mpi.h"
+#include "mpi/mpi_comb.h"
 #include "encoding/asn1.h"
 #include "debug.h"
 
@@ -68,6 +69,11 @@ const uint8_t DSA_WITH_SHA3_384_OID[9] = {0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x
 //DSA with SHA-3-512 OID (2.16.840.1.101.3.4.3.8)
 const uint8_t DSA_WITH_SHA3_512_OID[9] = {0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x08};
 
+#if (DSA_NONCE_POOL_SUPPORT == ENABLED)
+//Registered pool of precomputed nonces
+static DsaNoncePool *dsaNoncePool = NULL;
+#endif
+
 
 /**
  * @brief Initialize DSA domain parameters
@@ -470,8 +476,111 @@ error_t dsaReadSignature(const uint8_t *data, size_t length, DsaSignature *signa
 }
 
 
+/**
+ * @brief Generate a per-message secret and the matching r component
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @param[in] params DSA domain parameters
+ * @param[out] kinv Inverse of the per-message secret k
+ * @param[out] r Resulting value r = (g ^ k mod p) mod q
+ * @return Error code
+ **/
+
+static error_t dsaComputeNonce(const PrngAlgo *prngAlgo, void *prngContext,
+   const DsaDomainParameters *params, Mpi *kinv, Mpi *r)
+{
+   error_t error;
+   Mpi k;
+
+   //Initialize multiple precision integer
+   mpiInit(&k);
+
+   //Generate a random number k such as 0 < k < q - 1
+   MPI_CHECK(mpiRandRange(&k, &params->q, prngAlgo, prngContext));
+
+   //Debug message
+   TRACE_DEBUG("  k:\r\n");
+   TRACE_DEBUG_MPI("    ", &k);
+
+   //Compute r = (g ^ k mod p) mod q
+#if (MPI_COMB_SUPPORT == ENABLED)
+   MPI_CHECK(mpiExpModFixedBase(r, &params->g, &k, &params->p,
+      mpiGetBitLength(&params->q)));
+#else
+   MPI_CHECK(mpiExpModRegular(r, &params->g, &k, &params->p));
+#endif
+   MPI_CHECK(mpiMod(r, r, &params->q));
+
+   //Compute k ^ -1 mod q
+   MPI_CHECK(mpiInvMod(kinv, &k, &params->q));
+
+end:
+   //Release multiple precision integer
+   mpiFree(&k);
+
+   //Return status code
+   return error;
+}
+
+
+#if (DSA_NONCE_POOL_SUPPORT == ENABLED)
+
+/**
+ * @brief Check whether two sets of DSA domain parameters are identical
+ * @param[in] params1 First set of domain parameters
+ * @param[in] params2 Second set of domain parameters
+ * @return TRUE if the domain parameters match, else FALSE
+ **/
+
+static bool_t dsaCompareDomainParameters(const DsaDomainParameters *params1,
+   const DsaDomainParameters *params2)
+{
+   //Compare p, q and g
+   if(mpiComp(&params1->p, &params2->p) || mpiComp(&params1->q, &params2->q) ||
+      mpiComp(&params1->g, &params2->g))
+   {
+      return FALSE;
+   }
+   else
+   {
+      return TRUE;
+   }
+}
+
+
+/**
+ * @brief Take a precomputed nonce from the registered pool
+ * @param[in] params DSA domain parameters
+ * @param[out] kinv Inverse of the per-message secret k
+ * @param[out] r Value r = (g ^ k mod p) mod q
+ * @return Error code (ERROR_BUFFER_EMPTY if no nonce is available for
+ *   the specified domain parameters)
+ **/
+
+static error_t dsaTakeNonce(const DsaDomainParameters *params, Mpi *kinv,
+   Mpi *r)
+{
+   //No pool, or pool dedicated to other domain parameters?
+   if(dsaNoncePool == NULL ||
+      !dsaCompareDomainParameters(&dsaNoncePool->params, params))
+   {
+      return ERROR_BUFFER_EMPTY;
+   }
+
+   //Take the most recently computed nonce
+   return signNoncePoolTake(&dsaNoncePool->pool, kinv, r);
+}
+
+#endif
+
+
 /**
  * @brief DSA signature generation
+ *
+ * When a nonce pool is registered, the precomputed values k ^ -1 mod q and
+ * r are used, so that no modular exponentiation is needed. Otherwise, they
+ * are computed inline
+ *
  * @param[in] prngAlgo PRNG algorithm
  * @param[in] prngContext Pointer to the PRNG context
  * @param[in] key Signer's DSA private key
@@ -487,7 +596,7 @@ error_t dsaGenerateSignature(const PrngAlgo *prngAlgo, void *prngContext,
 {
    error_t error;
    uint_t n;
-   Mpi k;
+   Mpi kinv;
    Mpi z;
 
    //Check parameters
@@ -508,15 +617,20 @@ error_t dsaGenerateSignature(const PrngAlgo *prngAlgo, void *prngContext,
    TRACE_DEBUG_ARRAY("    ", digest, digestLen);
 
    //Initialize multiple precision integers
-   mpiInit(&k);
+   mpiInit(&kinv);
    mpiInit(&z);
 
-   //Generate a random number k such as 0 < k < q - 1
-   MPI_CHECK(mpiRandRange(&k, &key->params.q, prngAlgo, prngContext));
-
-   //Debug message
-   TRACE_DEBUG("  k:\r\n");
-   TRACE_DEBUG_MPI("    ", &k);
+#if (DSA_NONCE_POOL_SUPPORT == ENABLED)
+   //Use a precomputed nonce, if available
+   error = dsaTakeNonce(&key->params, &kinv, &signature->r);
+   //Fall back to inline computation when the pool is empty
+   if(error)
+#endif
+   {
+      //Generate k and compute r and k ^ -1 mod q
+      MPI_CHECK(dsaComputeNonce(prngAlgo, prngContext, &key->params, &kinv,
+         &signature->r));
+   }
 
    //Let N be the bit length of q
    n = mpiGetBitLength(&key->params.q);
@@ -536,18 +650,11 @@ error_t dsaGenerateSignature(const PrngAlgo *prngAlgo, void *prngContext,
    TRACE_DEBUG("  z:\r\n");
    TRACE_DEBUG_MPI("    ", &z);
 
-   //Compute r = (g ^ k mod p) mod q
-   MPI_CHECK(mpiExpModRegular(&signature->r, &key->params.g, &k, &key->params.p));
-   MPI_CHECK(mpiMod(&signature->r, &signature->r, &key->params.q));
-
-   //Compute k ^ -1 mod q
-   MPI_CHECK(mpiInvMod(&k, &k, &key->params.q));
-
    //Compute s = k ^ -1 * (z + x * r) mod q
    MPI_CHECK(mpiMul(&signature->s, &key->x, &signature->r));
    MPI_CHECK(mpiAdd(&signature->s, &signature->s, &z));
    MPI_CHECK(mpiMod(&signature->s, &signature->s, &key->params.q));
-   MPI_CHECK(mpiMulMod(&signature->s, &signature->s, &k, &key->params.q));
+   MPI_CHECK(mpiMulMod(&signature->s, &signature->s, &kinv, &key->params.q));
 
    //Dump DSA signature
    TRACE_DEBUG("  r:\r\n");
@@ -557,7 +664,7 @@ error_t dsaGenerateSignature(const PrngAlgo *prngAlgo, void *prngContext,
 
 end:
    //Release multiple precision integers
-   mpiFree(&k);
+   mpiFree(&kinv);
    mpiFree(&z);
 
    //Clean up side effects if necessary
@@ -565,7 +672,7 @@ end:
    {
       //Release (R, S) integer pair
       mpiFree(&signature->r);
-      mpiFree(&signature->r);
+      mpiFree(&signature->s);
    }
 
    //Return status code
@@ -573,6 +680,159 @@ end:
 }
 
 
+#if (DSA_NONCE_POOL_SUPPORT == ENABLED)
+
+/**
+ * @brief Compute a nonce on behalf of the pool
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @param[in] params DSA domain parameters
+ * @param[out] kinv Inverse of the per-message secret k
+ * @param[out] r Resulting value r = (g ^ k mod p) mod q
+ * @return Error code
+ **/
+
+static error_t dsaComputePoolNonce(const PrngAlgo *prngAlgo,
+   void *prngContext, const void *params, Mpi *kinv, Mpi *r)
+{
+   return dsaComputeNonce(prngAlgo, prngContext, params, kinv, r);
+}
+
+
+/**
+ * @brief Create a pool of precomputed nonces
+ * @param[in] params DSA domain parameters
+ * @param[in] size Maximum number of nonces held by the pool
+ * @return Pointer to the newly created pool
+ **/
+
+DsaNoncePool *dsaInitNoncePool(const DsaDomainParameters *params,
+   uint_t size)
+{
+   DsaNoncePool *pool;
+
+   //Make sure the parameters are acceptable
+   if(params == NULL || size < 1)
+      return NULL;
+
+   //Allocate a memory buffer to hold the pool
+   pool = cryptoAllocMem(sizeof(DsaNoncePool));
+   //Failed to allocate memory?
+   if(pool == NULL)
+      return NULL;
+
+   //Initialize domain parameters
+   dsaInitDomainParameters(&pool->params);
+
+   //The nonces are only valid for the specified domain parameters
+   if(mpiCopy(&pool->params.p, &params->p) ||
+      mpiCopy(&pool->params.q, &params->q) ||
+      mpiCopy(&pool->params.g, &params->g) ||
+      signNoncePoolInit(&pool->pool, size))
+   {
+      //Clean up side effects
+      dsaFreeDomainParameters(&pool->params);
+      cryptoFreeMem(pool);
+      //Report an error
+      return NULL;
+   }
+
+   //Return a pointer to the newly created pool
+   return pool;
+}
+
+
+/**
+ * @brief Release a pool of precomputed nonces
+ * @param[in] pool Pointer to the pool (must not be registered)
+ **/
+
+void dsaFreeNoncePool(DsaNoncePool *pool)
+{
+   //Valid pool?
+   if(pool != NULL)
+   {
+      //Release previously allocated resources
+      signNoncePoolFree(&pool->pool);
+      dsaFreeDomainParameters(&pool->params);
+      cryptoFreeMem(pool);
+   }
+}
+
+
+/**
+ * @brief Fill a pool of precomputed nonces
+ * @param[in] pool Pointer to the pool
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @param[in] params DSA domain parameters
+ * @return Error code
+ **/
+
+error_t dsaFillNoncePool(DsaNoncePool *pool, const PrngAlgo *prngAlgo,
+   void *prngContext, const DsaDomainParameters *params)
+{
+   //Check parameters
+   if(pool == NULL || params == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The pool is dedicated to a single set of domain parameters
+   if(!dsaCompareDomainParameters(&pool->params, params))
+      return ERROR_INVALID_PARAMETER;
+
+   //Fill the pool up to its maximum depth
+   return signNoncePoolFill(&pool->pool, dsaComputePoolNonce, prngAlgo,
+      prngContext, params);
+}
+
+
+/**
+ * @brief Get the number of precomputed nonces available in a pool
+ * @param[in] pool Pointer to the pool
+ * @return Number of available nonces
+ **/
+
+uint_t dsaGetNoncePoolCount(DsaNoncePool *pool)
+{
+   //Invalid pool?
+   if(pool == NULL)
+      return 0;
+
+   //Retrieve the number of available nonces
+   return signNoncePoolGetCount(&pool->pool);
+}
+
+
+/**
+ * @brief Register the pool used by signature generation
+ * @param[in] pool Pointer to the pool (NULL to disable the pool)
+ * @return Error code
+ **/
+
+error_t dsaRegisterNoncePool(DsaNoncePool *pool)
+{
+   //Save the pool
+   dsaNoncePool = pool;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Get the registered pool
+ * @return Pointer to the pool (NULL if no pool has been registered)
+ **/
+
+DsaNoncePool *dsaGetNoncePool(void)
+{
+   //Return the registered pool
+   return dsaNoncePool;
+}
+
+#endif
+
+
 /**
  * @brief DSA signature verification
  * @param[in] key Signer's DSA public key
@@ -659,9 +919,8 @@ error_t dsaVerifySignature(const DsaPublicKey *key,
    MPI_CHECK(mpiMulMod(&u2, &signature->r, &w, &key->params.q));
 
    //Compute v = ((g ^ u1) * (y ^ u2) mod p) mod q
-   MPI_CHECK(mpiExpModFast(&v, &key->params.g, &u1, &key->params.p));
-   MPI_CHECK(mpiExpModFast(&w, &key->y, &u2, &key->params.p));
-   MPI_CHECK(mpiMulMod(&v, &v, &w, &key->params.p));
+   MPI_CHECK(mpiExpMod2(&v, &key->params.g, &u1, &key->y, &u2,
+      &key->params.p));
    MPI_CHECK(mpiMod(&v, &v, &key->params.q));
 
    //Debug message
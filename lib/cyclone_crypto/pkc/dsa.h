@@ -34,6 +34,14 @@
 //Dependencies
 #include "core/crypto.h"
 #include "mpi/mpi.h"
+#include "pkc/sign_nonce_pool.h"
+
+//Precomputed nonce pool support
+#ifndef DSA_NONCE_POOL_SUPPORT
+   #define DSA_NONCE_POOL_SUPPORT DISABLED
+#elif (DSA_NONCE_POOL_SUPPORT != ENABLED && DSA_NONCE_POOL_SUPPORT != DISABLED)
+   #error DSA_NONCE_POOL_SUPPORT parameter is not valid
+#endif
 
 //C++ guard
 #ifdef __cplusplus
@@ -87,6 +95,17 @@ typedef struct
 } DsaSignature;
 
 
+/**
+ * @brief Pool of precomputed DSA nonces
+ **/
+
+typedef struct
+{
+   SignNoncePool pool;         ///<Precomputed nonces
+   DsaDomainParameters params; ///<DSA domain parameters
+} DsaNoncePool;
+
+
 //DSA related constants
 extern const uint8_t DSA_OID[7];
 extern const uint8_t DSA_WITH_SHA1_OID[7];
@@ -122,6 +141,19 @@ error_t dsaGenerateSignature(const PrngAlgo *prngAlgo, void *prngContext,
 error_t dsaVerifySignature(const DsaPublicKey *key,
    const uint8_t *digest, size_t digestLen, const DsaSignature *signature);
 
+DsaNoncePool *dsaInitNoncePool(const DsaDomainParameters *params,
+   uint_t size);
+
+void dsaFreeNoncePool(DsaNoncePool *pool);
+
+error_t dsaFillNoncePool(DsaNoncePool *pool, const PrngAlgo *prngAlgo,
+   void *prngContext, const DsaDomainParameters *params);
+
+uint_t dsaGetNoncePoolCount(DsaNoncePool *pool);
+
+error_t dsaRegisterNoncePool(DsaNoncePool *pool);
+DsaNoncePool *dsaGetNoncePool(void);
+
 //C++ guard
 #ifdef __cplusplus
 }
@@ -43,6 +43,7 @@
 #include "core/crypto.h"
 #include "mac/hmac.h"
 #include "pkc/rsa.h"
+#include "pkc/rsa_sign_cache.h"
 #include "mpi/mpi.h"
 #include "encoding/asn1.h"
 #include "encoding/oid.h"
@@ -687,6 +688,10 @@ error_t rsassaPkcs1v15Sign(const RsaPrivateKey *key, const HashAlgo *hash,
    Mpi m;
    Mpi s;
    Mpi t;
+#if (RSA_SIGN_CACHE_SUPPORT == ENABLED)
+   RsaSignCache *cache;
+   uint8_t keyId[RSA_SIGN_CACHE_KEY_ID_SIZE];
+#endif
 
    //Check parameters
    if(key == NULL || hash == NULL || digest == NULL)
@@ -694,6 +699,36 @@ error_t rsassaPkcs1v15Sign(const RsaPrivateKey *key, const HashAlgo *hash,
    if(signature == NULL || signatureLen == NULL)
       return ERROR_INVALID_PARAMETER;
 
+#if (RSA_SIGN_CACHE_SUPPORT == ENABLED)
+   //Retrieve the signature cache
+   cache = rsaGetSignCache();
+
+   //Any signature cache registered?
+   if(cache != NULL)
+   {
+      //Compute the identifier of the signer's key
+      error = rsaComputeSignCacheKeyId(key, keyId);
+
+      //Check status code
+      if(!error)
+      {
+         //RSASSA-PKCS1-v1_5 is deterministic. The private-key operation can
+         //be skipped if the same digest has already been signed
+         error = rsaFindSignCache(cache, keyId, hash, digest, signature,
+            signatureLen);
+
+         //Cache hit?
+         if(!error)
+            return NO_ERROR;
+      }
+      else
+      {
+         //The key cannot be cached
+         cache = NULL;
+      }
+   }
+#endif
+
    //Debug message
    TRACE_DEBUG("RSASSA-PKCS1-v1_5 signature generation...\r\n");
    TRACE_DEBUG("  Modulus:\r\n");
@@ -788,6 +823,14 @@ error_t rsassaPkcs1v15Sign(const RsaPrivateKey *key, const HashAlgo *hash,
       TRACE_DEBUG("  Signature:\r\n");
       TRACE_DEBUG_ARRAY("    ", signature, *signatureLen);
 
+#if (RSA_SIGN_CACHE_SUPPORT == ENABLED)
+      //Save the resulting signature in the cache
+      if(cache != NULL)
+      {
+         rsaSaveToSignCache(cache, keyId, hash, digest, signature, k);
+      }
+#endif
+
       //End of exception handling block
    } while(0);
 
@@ -0,0 +1,466 @@
+/**
+ * @file rsa_sign_cache.c
+ * @brief RSASSA-PKCS1-v1_5 signature cache
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * RSASSA-PKCS1-v1_5 is a deterministic signature scheme: a given private key
+ * always produces the same signature for a given message digest. The cache
+ * keeps the most recently generated signatures, indexed by the fingerprint of
+ * the signer's key, the hash algorithm and the message digest, so that the
+ * private-key operation can be skipped when the same digest is signed again
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "pkc/rsa.h"
+#include "pkc/rsa_sign_cache.h"
+#include "hash/sha256.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (RSA_SUPPORT == ENABLED && RSA_SIGN_CACHE_SUPPORT == ENABLED)
+
+//Signature cache used by rsassaPkcs1v15Sign
+static RsaSignCache *rsaSignCache = NULL;
+
+
+/**
+ * @brief Signature cache initialization
+ * @param[in] size Maximum number of cache entries
+ * @return Handle referencing the fully initialized signature cache
+ **/
+
+RsaSignCache *rsaInitSignCache(uint_t size)
+{
+   size_t n;
+   RsaSignCache *cache;
+
+   //Make sure the parameter is acceptable
+   if(size < 1)
+      return NULL;
+
+   //Size of the memory required
+   n = sizeof(RsaSignCache) + size * sizeof(RsaSignCacheEntry);
+
+   //Allocate a memory buffer to hold the signature cache
+   cache = cryptoAllocMem(n);
+   //Failed to allocate memory?
+   if(cache == NULL)
+      return NULL;
+
+   //Clear the signature cache
+   osMemset(cache, 0, n);
+
+   //Create a mutex to prevent simultaneous access to the cache
+   if(!osCreateMutex(&cache->mutex))
+   {
+      //Clean up side effects
+      cryptoFreeMem(cache);
+      //Report an error
+      return NULL;
+   }
+
+   //Save the maximum number of cache entries
+   cache->size = size;
+
+   //Return a pointer to the newly created cache
+   return cache;
+}
+
+
+/**
+ * @brief Properly dispose a signature cache
+ * @param[in] cache Pointer to the signature cache to be released
+ **/
+
+void rsaFreeSignCache(RsaSignCache *cache)
+{
+   //Valid cache?
+   if(cache != NULL)
+   {
+      //The cache must not be referenced by the signature generation routine
+      if(rsaSignCache == cache)
+      {
+         rsaSignCache = NULL;
+      }
+
+      //Release previously allocated resources
+      osDeleteMutex(&cache->mutex);
+
+      //Clear the cache before freeing memory
+      osMemset(cache, 0, sizeof(RsaSignCache) +
+         cache->size * sizeof(RsaSignCacheEntry));
+
+      //Release the memory buffer
+      cryptoFreeMem(cache);
+   }
+}
+
+
+/**
+ * @brief Invalidate all the entries of a signature cache
+ * @param[in] cache Pointer to the signature cache
+ **/
+
+void rsaFlushSignCache(RsaSignCache *cache)
+{
+   //Valid cache?
+   if(cache != NULL)
+   {
+      //Acquire exclusive access to the cache
+      osAcquireMutex(&cache->mutex);
+
+      //Erase the contents of the cache entries
+      osMemset(cache->entries, 0, cache->size * sizeof(RsaSignCacheEntry));
+
+      //Release exclusive access to the cache
+      osReleaseMutex(&cache->mutex);
+   }
+}
+
+
+/**
+ * @brief Register the signature cache used by rsassaPkcs1v15Sign
+ * @param[in] cache Pointer to the signature cache (NULL to disable caching)
+ * @return Error code
+ **/
+
+error_t rsaRegisterSignCache(RsaSignCache *cache)
+{
+   //Save the signature cache
+   rsaSignCache = cache;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Retrieve the signature cache used by rsassaPkcs1v15Sign
+ * @return Pointer to the registered signature cache (if any)
+ **/
+
+RsaSignCache *rsaGetSignCache(void)
+{
+   //Return the registered signature cache
+   return rsaSignCache;
+}
+
+
+/**
+ * @brief Compute the identifier of an RSA private key
+ *
+ * The identifier is the SHA-256 digest of the modulus and the public
+ * exponent, which uniquely determine the RSASSA-PKCS1-v1_5 signature
+ * of a given message digest
+ *
+ * @param[in] key Signer's RSA private key
+ * @param[out] keyId Resulting key identifier
+ * @return Error code
+ **/
+
+error_t rsaComputeSignCacheKeyId(const RsaPrivateKey *key, uint8_t *keyId)
+{
+   error_t error;
+   size_t n;
+   size_t e;
+   uint8_t buffer[RSA_SIGN_CACHE_MAX_SIGNATURE_SIZE];
+   Sha256Context context;
+
+   //Check parameters
+   if(key == NULL || keyId == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Get the length in octets of the modulus and the public exponent
+   n = mpiGetByteLength(&key->n);
+   e = mpiGetByteLength(&key->e);
+
+   //Keys that are too large cannot be cached
+   if(n == 0 || n > sizeof(buffer) || e == 0 || e > sizeof(buffer))
+      return ERROR_INVALID_LENGTH;
+
+   //Initialize hash context
+   sha256Init(&context);
+
+   //Digest the length of the modulus
+   buffer[0] = MSB(n);
+   buffer[1] = LSB(n);
+   sha256Update(&context, buffer, 2);
+
+   //Digest the modulus
+   error = mpiExport(&key->n, buffer, n, MPI_FORMAT_BIG_ENDIAN);
+
+   //Check status code
+   if(!error)
+   {
+      sha256Update(&context, buffer, n);
+
+      //Digest the length of the public exponent
+      buffer[0] = MSB(e);
+      buffer[1] = LSB(e);
+      sha256Update(&context, buffer, 2);
+
+      //Digest the public exponent
+      error = mpiExport(&key->e, buffer, e, MPI_FORMAT_BIG_ENDIAN);
+   }
+
+   //Check status code
+   if(!error)
+   {
+      sha256Update(&context, buffer, e);
+      //Finalize the key identifier
+      sha256Final(&context, keyId);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Search the signature cache for a matching entry
+ * @param[in] cache Pointer to the signature cache
+ * @param[in] keyId Identifier of the signer's key
+ * @param[in] hash Hash function used to digest the message
+ * @param[in] digest Digest of the message
+ * @param[out] signature Buffer where to copy the cached signature
+ * @param[out] signatureLen Length of the cached signature
+ * @return Error code (ERROR_NOT_FOUND if the cache holds no matching entry)
+ **/
+
+error_t rsaFindSignCache(RsaSignCache *cache, const uint8_t *keyId,
+   const HashAlgo *hash, const uint8_t *digest, uint8_t *signature,
+   size_t *signatureLen)
+{
+   error_t error;
+   uint_t i;
+   RsaSignCacheEntry *entry;
+
+   //Check parameters
+   if(cache == NULL || keyId == NULL || hash == NULL || digest == NULL)
+      return ERROR_INVALID_PARAMETER;
+   if(signature == NULL || signatureLen == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Initialize status code
+   error = ERROR_NOT_FOUND;
+
+   //Acquire exclusive access to the cache
+   osAcquireMutex(&cache->mutex);
+
+   //Loop through cache entries
+   for(i = 0; i < cache->size; i++)
+   {
+      //Point to the current entry
+      entry = &cache->entries[i];
+
+      //Compare key identifier, hash algorithm and message digest
+      if(entry->valid && entry->hash == hash &&
+         !osMemcmp(entry->keyId, keyId, RSA_SIGN_CACHE_KEY_ID_SIZE) &&
+         !osMemcmp(entry->digest, digest, hash->digestSize))
+      {
+         //Copy the cached signature
+         osMemcpy(signature, entry->signature, entry->signatureLen);
+         *signatureLen = entry->signatureLen;
+
+         //Mark the entry as the most recently used one
+         entry->lastUsed = ++cache->clock;
+
+         //A matching entry has been found
+         error = NO_ERROR;
+         break;
+      }
+   }
+
+   //Update statistics
+   if(!error)
+   {
+      cache->hits++;
+   }
+   else
+   {
+      cache->misses++;
+   }
+
+   //Release exclusive access to the cache
+   osReleaseMutex(&cache->mutex);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Save a signature in the cache
+ * @param[in] cache Pointer to the signature cache
+ * @param[in] keyId Identifier of the signer's key
+ * @param[in] hash Hash function used to digest the message
+ * @param[in] digest Digest of the message
+ * @param[in] signature Signature to be cached
+ * @param[in] signatureLen Length of the signature
+ * @return Error code
+ **/
+
+error_t rsaSaveToSignCache(RsaSignCache *cache, const uint8_t *keyId,
+   const HashAlgo *hash, const uint8_t *digest, const uint8_t *signature,
+   size_t signatureLen)
+{
+   uint_t i;
+   uint32_t age;
+   uint32_t maxAge;
+   RsaSignCacheEntry *entry;
+   RsaSignCacheEntry *oldestEntry;
+
+   //Check parameters
+   if(cache == NULL || keyId == NULL || hash == NULL || digest == NULL)
+      return ERROR_INVALID_PARAMETER;
+   if(signature == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Check the length of the digest and the signature
+   if(hash->digestSize > MAX_HASH_DIGEST_SIZE)
+      return ERROR_INVALID_LENGTH;
+   if(signatureLen > RSA_SIGN_CACHE_MAX_SIGNATURE_SIZE)
+      return ERROR_INVALID_LENGTH;
+
+   //Acquire exclusive access to the cache
+   osAcquireMutex(&cache->mutex);
+
+   //Keep track of the least recently used entry
+   oldestEntry = NULL;
+   maxAge = 0;
+
+   //Loop through cache entries
+   for(i = 0; i < cache->size; i++)
+   {
+      //Point to the current entry
+      entry = &cache->entries[i];
+
+      //Check whether the entry is free
+      if(!entry->valid)
+      {
+         //Use the free entry
+         oldestEntry = entry;
+         break;
+      }
+
+      //The same signature may have been saved concurrently by another task
+      if(entry->hash == hash &&
+         !osMemcmp(entry->keyId, keyId, RSA_SIGN_CACHE_KEY_ID_SIZE) &&
+         !osMemcmp(entry->digest, digest, hash->digestSize))
+      {
+         //Refresh the existing entry
+         oldestEntry = entry;
+         break;
+      }
+
+      //Compute the age of the entry (the logical clock may wrap around)
+      age = cache->clock - entry->lastUsed;
+
+      //Keep track of the least recently used entry
+      if(oldestEntry == NULL || age > maxAge)
+      {
+         oldestEntry = entry;
+         maxAge = age;
+      }
+   }
+
+   //A valid entry is about to be replaced?
+   if(oldestEntry->valid && (oldestEntry->hash != hash ||
+      osMemcmp(oldestEntry->keyId, keyId, RSA_SIGN_CACHE_KEY_ID_SIZE) ||
+      osMemcmp(oldestEntry->digest, digest, hash->digestSize)))
+   {
+      //Update statistics
+      cache->evictions++;
+   }
+
+   //Erase the previous contents of the entry
+   osMemset(oldestEntry, 0, sizeof(RsaSignCacheEntry));
+
+   //Save key identifier, hash algorithm and message digest
+   osMemcpy(oldestEntry->keyId, keyId, RSA_SIGN_CACHE_KEY_ID_SIZE);
+   oldestEntry->hash = hash;
+   osMemcpy(oldestEntry->digest, digest, hash->digestSize);
+
+   //Save the resulting signature
+   osMemcpy(oldestEntry->signature, signature, signatureLen);
+   oldestEntry->signatureLen = signatureLen;
+
+   //Mark the entry as the most recently used one
+   oldestEntry->lastUsed = ++cache->clock;
+   oldestEntry->valid = TRUE;
+
+   //Release exclusive access to the cache
+   osReleaseMutex(&cache->mutex);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Retrieve signature cache statistics
+ * @param[in] cache Pointer to the signature cache
+ * @param[out] stats Cache statistics
+ **/
+
+void rsaGetSignCacheStats(RsaSignCache *cache, RsaSignCacheStats *stats)
+{
+   uint_t i;
+
+   //Check parameters
+   if(cache == NULL || stats == NULL)
+      return;
+
+   //Acquire exclusive access to the cache
+   osAcquireMutex(&cache->mutex);
+
+   //Copy counters
+   stats->size = cache->size;
+   stats->hits = cache->hits;
+   stats->misses = cache->misses;
+   stats->evictions = cache->evictions;
+
+   //Count the number of valid entries
+   for(stats->count = 0, i = 0; i < cache->size; i++)
+   {
+      if(cache->entries[i].valid)
+      {
+         stats->count++;
+      }
+   }
+
+   //Release exclusive access to the cache
+   osReleaseMutex(&cache->mutex);
+}
+
+#endif
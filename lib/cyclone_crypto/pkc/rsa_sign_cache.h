@@ -0,0 +1,134 @@
+/**
+ * @file rsa_sign_cache.h
+ * @brief RSASSA-PKCS1-v1_5 signature cache
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _RSA_SIGN_CACHE_H
+#define _RSA_SIGN_CACHE_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "pkc/rsa.h"
+
+//RSA signature cache support
+#ifndef RSA_SIGN_CACHE_SUPPORT
+   #define RSA_SIGN_CACHE_SUPPORT DISABLED
+#elif (RSA_SIGN_CACHE_SUPPORT != ENABLED && RSA_SIGN_CACHE_SUPPORT != DISABLED)
+   #error RSA_SIGN_CACHE_SUPPORT parameter is not valid
+#endif
+
+//Maximum size of the RSA modulus that can be cached, in bits
+#ifndef RSA_SIGN_CACHE_MAX_MODULUS_SIZE
+   #define RSA_SIGN_CACHE_MAX_MODULUS_SIZE 4096
+#elif (RSA_SIGN_CACHE_MAX_MODULUS_SIZE < 512)
+   #error RSA_SIGN_CACHE_MAX_MODULUS_SIZE parameter is not valid
+#endif
+
+//Size of the key identifier
+#define RSA_SIGN_CACHE_KEY_ID_SIZE 32
+//Maximum length of the cached signatures
+#define RSA_SIGN_CACHE_MAX_SIGNATURE_SIZE ((RSA_SIGN_CACHE_MAX_MODULUS_SIZE + 7) / 8)
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Signature cache entry
+ **/
+
+typedef struct
+{
+   bool_t valid;                                         ///<Valid entry
+   uint32_t lastUsed;                                    ///<Time of last use (LRU eviction)
+   uint8_t keyId[RSA_SIGN_CACHE_KEY_ID_SIZE];            ///<Fingerprint of the signer's key
+   const HashAlgo *hash;                                 ///<Hash algorithm
+   uint8_t digest[MAX_HASH_DIGEST_SIZE];                 ///<Message digest
+   uint8_t signature[RSA_SIGN_CACHE_MAX_SIGNATURE_SIZE]; ///<Resulting signature
+   size_t signatureLen;                                  ///<Length of the signature
+} RsaSignCacheEntry;
+
+
+/**
+ * @brief Signature cache statistics
+ **/
+
+typedef struct
+{
+   uint_t size;        ///<Max number of entries
+   uint_t count;       ///<Number of valid entries
+   uint32_t hits;      ///<Number of lookups that found a matching entry
+   uint32_t misses;    ///<Number of lookups that found no matching entry
+   uint32_t evictions; ///<Number of valid entries that have been replaced
+} RsaSignCacheStats;
+
+
+/**
+ * @brief Signature cache
+ **/
+
+typedef struct
+{
+   OsMutex mutex;               ///<Mutex preventing simultaneous access to the cache
+   uint_t size;                 ///<Max number of entries
+   uint32_t clock;              ///<Logical clock used to track the least recently used entry
+   uint32_t hits;               ///<Number of lookups that found a matching entry
+   uint32_t misses;             ///<Number of lookups that found no matching entry
+   uint32_t evictions;          ///<Number of valid entries that have been replaced
+   RsaSignCacheEntry entries[]; ///<Cache entries
+} RsaSignCache;
+
+
+//RSA signature cache related functions
+RsaSignCache *rsaInitSignCache(uint_t size);
+void rsaFreeSignCache(RsaSignCache *cache);
+void rsaFlushSignCache(RsaSignCache *cache);
+
+error_t rsaRegisterSignCache(RsaSignCache *cache);
+RsaSignCache *rsaGetSignCache(void);
+
+error_t rsaComputeSignCacheKeyId(const RsaPrivateKey *key, uint8_t *keyId);
+
+error_t rsaFindSignCache(RsaSignCache *cache, const uint8_t *keyId,
+   const HashAlgo *hash, const uint8_t *digest, uint8_t *signature,
+   size_t *signatureLen);
+
+error_t rsaSaveToSignCache(RsaSignCache *cache, const uint8_t *keyId,
+   const HashAlgo *hash, const uint8_t *digest, const uint8_t *signature,
+   size_t signatureLen);
+
+void rsaGetSignCacheStats(RsaSignCache *cache, RsaSignCacheStats *stats);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
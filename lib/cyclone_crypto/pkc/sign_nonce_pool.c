@@ -0,0 +1,271 @@
+/**
+ * @file sign_nonce_pool.c
+ * @brief Pool of precomputed signature nonces (DSA and ECDSA)
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * DSA and ECDSA signature generation spend most of their time computing
+ * k ^ -1 mod q and r, which do not depend on the message. A pool holds
+ * such pairs computed ahead of time, typically by a low-priority task.
+ * The nonces are computed without holding the mutex, so that signature
+ * generation is never blocked by the computation
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "pkc/sign_nonce_pool.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (MPI_SUPPORT == ENABLED)
+
+
+/**
+ * @brief Initialize a pool of precomputed nonces
+ * @param[out] pool Pointer to the pool
+ * @param[in] size Maximum number of nonces held by the pool
+ * @return Error code
+ **/
+
+error_t signNoncePoolInit(SignNoncePool *pool, uint_t size)
+{
+   uint_t i;
+
+   //Make sure the parameters are acceptable
+   if(pool == NULL || size < 1)
+      return ERROR_INVALID_PARAMETER;
+
+   //Clear the structure
+   osMemset(pool, 0, sizeof(SignNoncePool));
+
+   //Allocate a memory buffer to hold the nonces
+   pool->entries = cryptoAllocMem(size * sizeof(SignNonce));
+   //Failed to allocate memory?
+   if(pool->entries == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Initialize multiple precision integers
+   for(i = 0; i < size; i++)
+   {
+      mpiInit(&pool->entries[i].kinv);
+      mpiInit(&pool->entries[i].r);
+   }
+
+   //Create a mutex to prevent simultaneous access to the pool
+   if(!osCreateMutex(&pool->mutex))
+   {
+      //Clean up side effects
+      cryptoFreeMem(pool->entries);
+      pool->entries = NULL;
+      //Report an error
+      return ERROR_OUT_OF_RESOURCES;
+   }
+
+   //Save the maximum number of nonces
+   pool->size = size;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Release a pool of precomputed nonces (the remaining nonces are erased)
+ * @param[in] pool Pointer to the pool
+ **/
+
+void signNoncePoolFree(SignNoncePool *pool)
+{
+   uint_t i;
+
+   //Valid pool?
+   if(pool != NULL && pool->entries != NULL)
+   {
+      //Erase the remaining nonces
+      for(i = 0; i < pool->size; i++)
+      {
+         mpiFree(&pool->entries[i].kinv);
+         mpiFree(&pool->entries[i].r);
+      }
+
+      //Release previously allocated resources
+      osDeleteMutex(&pool->mutex);
+      cryptoFreeMem(pool->entries);
+
+      //Clear the structure
+      osMemset(pool, 0, sizeof(SignNoncePool));
+   }
+}
+
+
+/**
+ * @brief Fill a pool of precomputed nonces up to its maximum depth
+ * @param[in] pool Pointer to the pool
+ * @param[in] compute Nonce computation callback
+ * @param[in] prngAlgo PRNG algorithm
+ * @param[in] prngContext Pointer to the PRNG context
+ * @param[in] params Domain parameters passed to the callback
+ * @return Error code
+ **/
+
+error_t signNoncePoolFill(SignNoncePool *pool, SignNonceCompute compute,
+   const PrngAlgo *prngAlgo, void *prngContext, const void *params)
+{
+   error_t error;
+   bool_t full;
+   Mpi kinv;
+   Mpi r;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Initialize multiple precision integers
+   mpiInit(&kinv);
+   mpiInit(&r);
+
+   //Fill the pool up to its maximum depth
+   while(!error)
+   {
+      //Check whether the pool is full
+      osAcquireMutex(&pool->mutex);
+      full = (pool->count >= pool->size) ? TRUE : FALSE;
+      osReleaseMutex(&pool->mutex);
+
+      //Exit immediately if no more nonce is needed
+      if(full)
+         break;
+
+      //Compute a new nonce
+      error = compute(prngAlgo, prngContext, params, &kinv, &r);
+
+      //Check status code
+      if(!error)
+      {
+         //Acquire exclusive access to the pool
+         osAcquireMutex(&pool->mutex);
+
+         //The pool may have been filled in the meantime by another task
+         if(pool->count < pool->size)
+         {
+            //Transfer the ownership of the integers to the pool
+            pool->entries[pool->count].kinv = kinv;
+            pool->entries[pool->count].r = r;
+            pool->count++;
+
+            //The integers are now held by the pool
+            mpiInit(&kinv);
+            mpiInit(&r);
+         }
+
+         //Release exclusive access to the pool
+         osReleaseMutex(&pool->mutex);
+      }
+   }
+
+   //Erase the nonce that could not be stored, if any
+   mpiFree(&kinv);
+   mpiFree(&r);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Take a precomputed nonce from a pool
+ * @param[in] pool Pointer to the pool
+ * @param[out] kinv Inverse of the per-message secret k
+ * @param[out] r r component of the signature
+ * @return Error code (ERROR_BUFFER_EMPTY if the pool is empty)
+ **/
+
+error_t signNoncePoolTake(SignNoncePool *pool, Mpi *kinv, Mpi *r)
+{
+   error_t error;
+   SignNonce *entry;
+
+   //Acquire exclusive access to the pool
+   osAcquireMutex(&pool->mutex);
+
+   //Any nonce available?
+   if(pool->count > 0)
+   {
+      //Point to the most recently computed nonce
+      entry = &pool->entries[pool->count - 1];
+
+      //Retrieve the nonce
+      error = mpiCopy(kinv, &entry->kinv);
+
+      //Check status code
+      if(!error)
+      {
+         error = mpiCopy(r, &entry->r);
+      }
+
+      //The nonce must never be used twice, even if the copy failed
+      mpiFree(&entry->kinv);
+      mpiFree(&entry->r);
+      pool->count--;
+   }
+   else
+   {
+      //The pool is empty
+      error = ERROR_BUFFER_EMPTY;
+   }
+
+   //Release exclusive access to the pool
+   osReleaseMutex(&pool->mutex);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Get the number of precomputed nonces available in a pool
+ * @param[in] pool Pointer to the pool
+ * @return Number of available nonces
+ **/
+
+uint_t signNoncePoolGetCount(SignNoncePool *pool)
+{
+   uint_t n;
+
+   //Retrieve the number of available nonces
+   osAcquireMutex(&pool->mutex);
+   n = pool->count;
+   osReleaseMutex(&pool->mutex);
+
+   //Return the number of available nonces
+   return n;
+}
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file sign_nonce_pool.h
+ * @brief Pool of precomputed signature nonces (DSA and ECDSA)
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _SIGN_NONCE_POOL_H
+#define _SIGN_NONCE_POOL_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "mpi/mpi.h"
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Precomputed nonce (k ^ -1 mod q, r)
+ **/
+
+typedef struct
+{
+   Mpi kinv; ///<Inverse of the per-message secret k
+   Mpi r;    ///<r component of the signature
+} SignNonce;
+
+
+//Nonce computation callback
+typedef error_t (*SignNonceCompute)(const PrngAlgo *prngAlgo,
+   void *prngContext, const void *params, Mpi *kinv, Mpi *r);
+
+
+/**
+ * @brief Pool of precomputed nonces (each nonce is handed out only once)
+ **/
+
+typedef struct
+{
+   OsMutex mutex;      ///<Mutex preventing simultaneous access to the pool
+   uint_t size;        ///<Maximum number of nonces
+   uint_t count;       ///<Number of available nonces
+   SignNonce *entries; ///<Precomputed nonces
+} SignNoncePool;
+
+
+//Nonce pool related functions
+error_t signNoncePoolInit(SignNoncePool *pool, uint_t size);
+void signNoncePoolFree(SignNoncePool *pool);
+
+error_t signNoncePoolFill(SignNoncePool *pool, SignNonceCompute compute,
+   const PrngAlgo *prngAlgo, void *prngContext, const void *params);
+
+error_t signNoncePoolTake(SignNoncePool *pool, Mpi *kinv, Mpi *r);
+uint_t signNoncePoolGetCount(SignNoncePool *pool);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,788 @@
+/**
+ * @file x509_key_cache.c
+ * @brief Parsed public key cache
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * Verifiers frequently receive the same public keys over and over. The cache
+ * keeps the most recently used keys in their imported form, indexed by the
+ * SHA-256 digest of the DER-encoded SubjectPublicKeyInfo structure, so that
+ * the import of the key material can be skipped. Cached keys are reference
+ * counted and never modified once inserted in the cache
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL CRYPTO_TRACE_LEVEL
+
+//Dependencies
+#include "core/crypto.h"
+#include "pkix/x509_key_cache.h"
+#include "pkix/x509_key_parse.h"
+#include "hash/sha256.h"
+#include "debug.h"
+
+//Check crypto library configuration
+#if (X509_SUPPORT == ENABLED && X509_KEY_CACHE_SUPPORT == ENABLED)
+
+//Public key cache used by the signature verification routines
+static X509KeyCache *x509KeyCache = NULL;
+
+//Forward declaration of functions
+static error_t x509ImportCachedPublicKey(const X509SubjectPublicKeyInfo *publicKeyInfo,
+   X509CachedPublicKey *publicKey);
+
+static void x509FreeCachedPublicKey(X509CachedPublicKey *publicKey);
+
+
+/**
+ * @brief Public key cache initialization
+ * @param[in] size Maximum number of cache entries
+ * @return Handle referencing the fully initialized public key cache
+ **/
+
+X509KeyCache *x509InitKeyCache(uint_t size)
+{
+   size_t n;
+   X509KeyCache *cache;
+
+   //Make sure the parameter is acceptable
+   if(size < 1)
+      return NULL;
+
+   //Size of the memory required
+   n = sizeof(X509KeyCache) + size * sizeof(X509CachedPublicKey *);
+
+   //Allocate a memory buffer to hold the public key cache
+   cache = cryptoAllocMem(n);
+   //Failed to allocate memory?
+   if(cache == NULL)
+      return NULL;
+
+   //Clear the public key cache
+   osMemset(cache, 0, n);
+
+   //Create a mutex to prevent simultaneous access to the cache
+   if(!osCreateMutex(&cache->mutex))
+   {
+      //Clean up side effects
+      cryptoFreeMem(cache);
+      //Report an error
+      return NULL;
+   }
+
+   //Save the maximum number of cache entries
+   cache->size = size;
+
+   //Return a pointer to the newly created cache
+   return cache;
+}
+
+
+/**
+ * @brief Properly dispose a public key cache
+ *
+ * All the references obtained with x509AcquireCachedPublicKey must have been
+ * released before the cache is disposed
+ *
+ * @param[in] cache Pointer to the public key cache to be released
+ **/
+
+void x509FreeKeyCache(X509KeyCache *cache)
+{
+   //Valid cache?
+   if(cache != NULL)
+   {
+      //The cache must not be referenced by the signature verification routines
+      if(x509KeyCache == cache)
+      {
+         x509KeyCache = NULL;
+      }
+
+      //Release the cached public keys
+      x509FlushKeyCache(cache);
+
+      //Release previously allocated resources
+      osDeleteMutex(&cache->mutex);
+
+      //Release the memory buffer
+      cryptoFreeMem(cache);
+   }
+}
+
+
+/**
+ * @brief Invalidate all the entries of a public key cache
+ *
+ * Keys that are still referenced remain usable and are released as soon as
+ * their last reference is dropped
+ *
+ * @param[in] cache Pointer to the public key cache
+ **/
+
+void x509FlushKeyCache(X509KeyCache *cache)
+{
+   uint_t i;
+   X509CachedPublicKey *entry;
+
+   //Valid cache?
+   if(cache != NULL)
+   {
+      //Acquire exclusive access to the cache
+      osAcquireMutex(&cache->mutex);
+
+      //Loop through cache entries
+      for(i = 0; i < cache->size; i++)
+      {
+         //Point to the current entry
+         entry = cache->entries[i];
+
+         //Valid entry?
+         if(entry != NULL)
+         {
+            //Drop the reference held by the cache
+            if(--entry->refCount == 0)
+            {
+               x509FreeCachedPublicKey(entry);
+            }
+
+            //Mark the entry as free
+            cache->entries[i] = NULL;
+         }
+      }
+
+      //Release exclusive access to the cache
+      osReleaseMutex(&cache->mutex);
+   }
+}
+
+
+/**
+ * @brief Register the public key cache used by the signature verification routines
+ * @param[in] cache Pointer to the public key cache (NULL to disable caching)
+ * @return Error code
+ **/
+
+error_t x509RegisterKeyCache(X509KeyCache *cache)
+{
+   //Save the public key cache
+   x509KeyCache = cache;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Retrieve the public key cache used by the signature verification routines
+ * @return Pointer to the registered public key cache (if any)
+ **/
+
+X509KeyCache *x509GetKeyCache(void)
+{
+   //Return the registered public key cache
+   return x509KeyCache;
+}
+
+
+/**
+ * @brief Retrieve a parsed public key from the cache
+ *
+ * The public key is imported and inserted in the cache if no matching entry
+ * is found. The returned key must be released with x509ReleaseCachedPublicKey
+ * once it is no longer needed
+ *
+ * @param[in] cache Pointer to the public key cache
+ * @param[in] publicKeyInfo Subject's public key information
+ * @param[out] publicKey Pointer to the cached public key
+ * @return Error code
+ **/
+
+error_t x509AcquireCachedPublicKey(X509KeyCache *cache,
+   const X509SubjectPublicKeyInfo *publicKeyInfo,
+   const X509CachedPublicKey **publicKey)
+{
+   error_t error;
+   uint_t i;
+   uint32_t age;
+   uint32_t maxAge;
+   uint8_t keyId[X509_KEY_CACHE_KEY_ID_SIZE];
+   X509CachedPublicKey *entry;
+   X509CachedPublicKey *newEntry;
+   X509CachedPublicKey *oldEntry;
+   X509CachedPublicKey **slot;
+
+   //Check parameters
+   if(cache == NULL || publicKeyInfo == NULL || publicKey == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The key identifier is computed over the DER-encoded structure
+   if(publicKeyInfo->rawData == NULL || publicKeyInfo->rawDataLen == 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Compute the key identifier
+   error = sha256Compute(publicKeyInfo->rawData, publicKeyInfo->rawDataLen,
+      keyId);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Acquire exclusive access to the cache
+   osAcquireMutex(&cache->mutex);
+
+   //Initialize pointer
+   entry = NULL;
+
+   //Loop through cache entries
+   for(i = 0; i < cache->size; i++)
+   {
+      //Compare key identifiers
+      if(cache->entries[i] != NULL && !osMemcmp(cache->entries[i]->keyId,
+         keyId, X509_KEY_CACHE_KEY_ID_SIZE))
+      {
+         //Point to the matching entry
+         entry = cache->entries[i];
+
+         //The caller holds a new reference to the key
+         entry->refCount++;
+         //Mark the entry as the most recently used one
+         entry->lastUsed = ++cache->clock;
+         break;
+      }
+   }
+
+   //Update statistics
+   if(entry != NULL)
+   {
+      cache->hits++;
+   }
+   else
+   {
+      cache->misses++;
+   }
+
+   //Release exclusive access to the cache
+   osReleaseMutex(&cache->mutex);
+
+   //Cache hit?
+   if(entry != NULL)
+   {
+      //Return a pointer to the cached key
+      *publicKey = entry;
+      //Successful processing
+      return NO_ERROR;
+   }
+
+   //Allocate a new entry
+   newEntry = cryptoAllocMem(sizeof(X509CachedPublicKey));
+   //Failed to allocate memory?
+   if(newEntry == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Clear the entry
+   osMemset(newEntry, 0, sizeof(X509CachedPublicKey));
+   //Save the key identifier
+   osMemcpy(newEntry->keyId, keyId, X509_KEY_CACHE_KEY_ID_SIZE);
+
+#if (RSA_SUPPORT == ENABLED)
+   //Initialize RSA public key
+   rsaInitPublicKey(&newEntry->rsaPublicKey);
+#endif
+#if (DSA_SUPPORT == ENABLED)
+   //Initialize DSA public key
+   dsaInitPublicKey(&newEntry->dsaPublicKey);
+#endif
+#if (EC_SUPPORT == ENABLED)
+   //Initialize EC domain parameters and EC public key
+   ecInitDomainParameters(&newEntry->ecParams);
+   ecInitPublicKey(&newEntry->ecPublicKey);
+#endif
+#if (ECDSA_SUPPORT == ENABLED)
+   //Initialize ECDSA verification key
+   ecdsaInitVerifyKey(&newEntry->ecdsaVerifyKey);
+#endif
+
+   //The key is imported outside the critical section
+   error = x509ImportCachedPublicKey(publicKeyInfo, newEntry);
+
+   //Any error to report?
+   if(error)
+   {
+      //Clean up side effects
+      x509FreeCachedPublicKey(newEntry);
+      //Report an error
+      return error;
+   }
+
+   //Acquire exclusive access to the cache
+   osAcquireMutex(&cache->mutex);
+
+   //Initialize pointers
+   entry = NULL;
+   slot = NULL;
+   oldEntry = NULL;
+   maxAge = 0;
+
+   //Loop through cache entries
+   for(i = 0; i < cache->size; i++)
+   {
+      //Check whether the entry is free
+      if(cache->entries[i] == NULL)
+      {
+         //Use the free entry
+         slot = &cache->entries[i];
+         oldEntry = NULL;
+         maxAge = UINT32_MAX;
+         continue;
+      }
+
+      //The same key may have been inserted concurrently by another task
+      if(!osMemcmp(cache->entries[i]->keyId, keyId,
+         X509_KEY_CACHE_KEY_ID_SIZE))
+      {
+         //Point to the existing entry
+         entry = cache->entries[i];
+         break;
+      }
+
+      //Compute the age of the entry (the logical clock may wrap around)
+      age = cache->clock - cache->entries[i]->lastUsed;
+
+      //Keep track of the least recently used entry
+      if(slot == NULL || age > maxAge)
+      {
+         slot = &cache->entries[i];
+         oldEntry = cache->entries[i];
+         maxAge = age;
+      }
+   }
+
+   //The key has been inserted concurrently by another task?
+   if(entry != NULL)
+   {
+      //The caller holds a new reference to the existing key
+      entry->refCount++;
+      entry->lastUsed = ++cache->clock;
+
+      //Discard the key that has just been imported
+      oldEntry = newEntry;
+   }
+   else
+   {
+      //A valid entry is about to be replaced?
+      if(oldEntry != NULL)
+      {
+         //Drop the reference held by the cache
+         if(--oldEntry->refCount != 0)
+         {
+            //The evicted key is still in use
+            oldEntry = NULL;
+         }
+
+         //Update statistics
+         cache->evictions++;
+      }
+
+      //The key is referenced by the cache and by the caller
+      newEntry->refCount = 2;
+      newEntry->lastUsed = ++cache->clock;
+
+      //Insert the key in the cache
+      *slot = newEntry;
+      entry = newEntry;
+   }
+
+   //Release exclusive access to the cache
+   osReleaseMutex(&cache->mutex);
+
+   //Release the key that is no longer referenced
+   if(oldEntry != NULL)
+   {
+      x509FreeCachedPublicKey(oldEntry);
+   }
+
+   //Return a pointer to the cached key
+   *publicKey = entry;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Retrieve a parsed RSA public key from the cache
+ * @param[in] cache Pointer to the public key cache
+ * @param[in] publicKeyInfo Subject's public key information
+ * @param[out] cachedKey Reference to be released with x509ReleaseCachedPublicKey
+ * @param[out] publicKey Pointer to the cached RSA public key
+ * @return Error code
+ **/
+
+error_t x509AcquireCachedRsaPublicKey(X509KeyCache *cache,
+   const X509SubjectPublicKeyInfo *publicKeyInfo,
+   const X509CachedPublicKey **cachedKey, const RsaPublicKey **publicKey)
+{
+#if (RSA_SUPPORT == ENABLED)
+   error_t error;
+
+   //Check parameters
+   if(cachedKey == NULL || publicKey == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Retrieve the public key from the cache
+   error = x509AcquireCachedPublicKey(cache, publicKeyInfo, cachedKey);
+
+   //Check status code
+   if(!error)
+   {
+      //Make sure the cached key is an RSA public key
+      if((*cachedKey)->keyType == X509_KEY_TYPE_RSA ||
+         (*cachedKey)->keyType == X509_KEY_TYPE_RSA_PSS)
+      {
+         *publicKey = &(*cachedKey)->rsaPublicKey;
+      }
+      else
+      {
+         //Release the reference to the cached key
+         x509ReleaseCachedPublicKey(cache, *cachedKey);
+         *cachedKey = NULL;
+
+         //Invalid algorithm identifier
+         error = ERROR_WRONG_IDENTIFIER;
+      }
+   }
+
+   //Return status code
+   return error;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
+/**
+ * @brief Retrieve a parsed DSA public key from the cache
+ * @param[in] cache Pointer to the public key cache
+ * @param[in] publicKeyInfo Subject's public key information
+ * @param[out] cachedKey Reference to be released with x509ReleaseCachedPublicKey
+ * @param[out] publicKey Pointer to the cached DSA public key
+ * @return Error code
+ **/
+
+error_t x509AcquireCachedDsaPublicKey(X509KeyCache *cache,
+   const X509SubjectPublicKeyInfo *publicKeyInfo,
+   const X509CachedPublicKey **cachedKey, const DsaPublicKey **publicKey)
+{
+#if (DSA_SUPPORT == ENABLED)
+   error_t error;
+
+   //Check parameters
+   if(cachedKey == NULL || publicKey == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Retrieve the public key from the cache
+   error = x509AcquireCachedPublicKey(cache, publicKeyInfo, cachedKey);
+
+   //Check status code
+   if(!error)
+   {
+      //Make sure the cached key is a DSA public key
+      if((*cachedKey)->keyType == X509_KEY_TYPE_DSA)
+      {
+         *publicKey = &(*cachedKey)->dsaPublicKey;
+      }
+      else
+      {
+         //Release the reference to the cached key
+         x509ReleaseCachedPublicKey(cache, *cachedKey);
+         *cachedKey = NULL;
+
+         //Invalid algorithm identifier
+         error = ERROR_WRONG_IDENTIFIER;
+      }
+   }
+
+   //Return status code
+   return error;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
+/**
+ * @brief Retrieve a parsed EC public key from the cache
+ * @param[in] cache Pointer to the public key cache
+ * @param[in] publicKeyInfo Subject's public key information
+ * @param[out] cachedKey Reference to be released with x509ReleaseCachedPublicKey
+ * @param[out] params Pointer to the cached EC domain parameters
+ * @param[out] publicKey Pointer to the cached EC public key
+ * @return Error code
+ **/
+
+error_t x509AcquireCachedEcPublicKey(X509KeyCache *cache,
+   const X509SubjectPublicKeyInfo *publicKeyInfo,
+   const X509CachedPublicKey **cachedKey, const EcDomainParameters **params,
+   const EcPublicKey **publicKey)
+{
+#if (EC_SUPPORT == ENABLED)
+   error_t error;
+
+   //Check parameters
+   if(cachedKey == NULL || params == NULL || publicKey == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Retrieve the public key from the cache
+   error = x509AcquireCachedPublicKey(cache, publicKeyInfo, cachedKey);
+
+   //Check status code
+   if(!error)
+   {
+      //Make sure the cached key is an EC public key
+      if((*cachedKey)->keyType == X509_KEY_TYPE_EC)
+      {
+         *params = &(*cachedKey)->ecParams;
+         *publicKey = &(*cachedKey)->ecPublicKey;
+      }
+      else
+      {
+         //Release the reference to the cached key
+         x509ReleaseCachedPublicKey(cache, *cachedKey);
+         *cachedKey = NULL;
+
+         //Invalid algorithm identifier
+         error = ERROR_WRONG_IDENTIFIER;
+      }
+   }
+
+   //Return status code
+   return error;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
+/**
+ * @brief Release a reference to a cached public key
+ * @param[in] cache Pointer to the public key cache
+ * @param[in] publicKey Pointer to the cached public key
+ **/
+
+void x509ReleaseCachedPublicKey(X509KeyCache *cache,
+   const X509CachedPublicKey *publicKey)
+{
+   X509CachedPublicKey *entry;
+
+   //Check parameters
+   if(cache != NULL && publicKey != NULL)
+   {
+      //Point to the entry
+      entry = (X509CachedPublicKey *) publicKey;
+
+      //Acquire exclusive access to the cache
+      osAcquireMutex(&cache->mutex);
+
+      //Drop the reference held by the caller
+      if(--entry->refCount != 0)
+      {
+         //The key is still referenced
+         entry = NULL;
+      }
+
+      //Release exclusive access to the cache
+      osReleaseMutex(&cache->mutex);
+
+      //The key has been evicted and is no longer referenced?
+      if(entry != NULL)
+      {
+         x509FreeCachedPublicKey(entry);
+      }
+   }
+}
+
+
+/**
+ * @brief Get public key cache statistics
+ * @param[in] cache Pointer to the public key cache
+ * @param[out] stats Current statistics
+ **/
+
+void x509GetKeyCacheStats(X509KeyCache *cache, X509KeyCacheStats *stats)
+{
+   uint_t i;
+
+   //Check parameters
+   if(cache != NULL && stats != NULL)
+   {
+      //Acquire exclusive access to the cache
+      osAcquireMutex(&cache->mutex);
+
+      //Save cache parameters
+      stats->size = cache->size;
+      stats->count = 0;
+      stats->hits = cache->hits;
+      stats->misses = cache->misses;
+      stats->evictions = cache->evictions;
+
+      //Count the number of valid entries
+      for(i = 0; i < cache->size; i++)
+      {
+         if(cache->entries[i] != NULL)
+         {
+            stats->count++;
+         }
+      }
+
+      //Release exclusive access to the cache
+      osReleaseMutex(&cache->mutex);
+   }
+}
+
+
+/**
+ * @brief Import the public key to be cached
+ * @param[in] publicKeyInfo Subject's public key information
+ * @param[out] publicKey Cache entry where to store the imported key
+ * @return Error code
+ **/
+
+static error_t x509ImportCachedPublicKey(const X509SubjectPublicKeyInfo *publicKeyInfo,
+   X509CachedPublicKey *publicKey)
+{
+   error_t error;
+#if (EC_SUPPORT == ENABLED)
+   const EcCurveInfo *curveInfo;
+#endif
+
+   //Retrieve public key type
+   publicKey->keyType = x509GetPublicKeyType(publicKeyInfo->oid,
+      publicKeyInfo->oidLen);
+
+#if (RSA_SUPPORT == ENABLED)
+   //RSA public key?
+   if(publicKey->keyType == X509_KEY_TYPE_RSA ||
+      publicKey->keyType == X509_KEY_TYPE_RSA_PSS)
+   {
+      //Import the RSA public key
+      error = x509ImportRsaPublicKey(publicKeyInfo, &publicKey->rsaPublicKey);
+   }
+   else
+#endif
+#if (DSA_SUPPORT == ENABLED)
+   //DSA public key?
+   if(publicKey->keyType == X509_KEY_TYPE_DSA)
+   {
+      //Import the DSA public key
+      error = x509ImportDsaPublicKey(publicKeyInfo, &publicKey->dsaPublicKey);
+   }
+   else
+#endif
+#if (EC_SUPPORT == ENABLED)
+   //EC public key?
+   if(publicKey->keyType == X509_KEY_TYPE_EC)
+   {
+      //Retrieve EC domain parameters
+      curveInfo = x509GetCurveInfo(publicKeyInfo->ecParams.namedCurve,
+         publicKeyInfo->ecParams.namedCurveLen);
+
+      //Make sure the specified elliptic curve is supported
+      if(curveInfo != NULL)
+      {
+         //Load EC domain parameters
+         error = ecLoadDomainParameters(&publicKey->ecParams, curveInfo);
+      }
+      else
+      {
+         //Invalid EC domain parameters
+         error = ERROR_BAD_CERTIFICATE;
+      }
+
+      //Check status code
+      if(!error)
+      {
+         //Retrieve the EC public key
+         error = ecImport(&publicKey->ecParams, &publicKey->ecPublicKey.q,
+            publicKeyInfo->ecPublicKey.q, publicKeyInfo->ecPublicKey.qLen);
+      }
+
+#if (ECDSA_SUPPORT == ENABLED)
+      //Check status code
+      if(!error)
+      {
+         //Precompute the ECDSA verification key
+         error = ecdsaBuildVerifyKey(&publicKey->ecParams,
+            &publicKey->ecPublicKey, &publicKey->ecdsaVerifyKey);
+      }
+#endif
+   }
+   else
+#endif
+   //Unsupported public key type?
+   {
+      //Report an error
+      error = ERROR_WRONG_IDENTIFIER;
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Release a cached public key
+ * @param[in] publicKey Cache entry to be released
+ **/
+
+static void x509FreeCachedPublicKey(X509CachedPublicKey *publicKey)
+{
+#if (RSA_SUPPORT == ENABLED)
+   //Release RSA public key
+   rsaFreePublicKey(&publicKey->rsaPublicKey);
+#endif
+#if (DSA_SUPPORT == ENABLED)
+   //Release DSA public key
+   dsaFreePublicKey(&publicKey->dsaPublicKey);
+#endif
+#if (EC_SUPPORT == ENABLED)
+   //Release EC domain parameters and EC public key
+   ecFreeDomainParameters(&publicKey->ecParams);
+   ecFreePublicKey(&publicKey->ecPublicKey);
+#endif
+#if (ECDSA_SUPPORT == ENABLED)
+   //Release ECDSA verification key
+   ecdsaFreeVerifyKey(&publicKey->ecdsaVerifyKey);
+#endif
+
+   //Release the memory buffer
+   cryptoFreeMem(publicKey);
+}
+
+#endif
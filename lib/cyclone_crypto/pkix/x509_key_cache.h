@@ -0,0 +1,145 @@
+/**
+ * @file x509_key_cache.h
+ * @brief Parsed public key cache
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+#ifndef _X509_KEY_CACHE_H
+#define _X509_KEY_CACHE_H
+
+//Dependencies
+#include "core/crypto.h"
+#include "pkix/x509_common.h"
+
+//Public key cache support
+#ifndef X509_KEY_CACHE_SUPPORT
+   #define X509_KEY_CACHE_SUPPORT DISABLED
+#elif (X509_KEY_CACHE_SUPPORT != ENABLED && X509_KEY_CACHE_SUPPORT != DISABLED)
+   #error X509_KEY_CACHE_SUPPORT parameter is not valid
+#endif
+
+//Size of the key identifier
+#define X509_KEY_CACHE_KEY_ID_SIZE 32
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Cached public key
+ **/
+
+typedef struct
+{
+   uint_t refCount;                             ///<Number of references to the key
+   uint32_t lastUsed;                           ///<Time of last use (LRU eviction)
+   uint8_t keyId[X509_KEY_CACHE_KEY_ID_SIZE];   ///<SHA-256 digest of the SubjectPublicKeyInfo
+   X509KeyType keyType;                         ///<Public key type
+#if (RSA_SUPPORT == ENABLED)
+   RsaPublicKey rsaPublicKey;                   ///<RSA public key
+#endif
+#if (DSA_SUPPORT == ENABLED)
+   DsaPublicKey dsaPublicKey;                   ///<DSA public key
+#endif
+#if (EC_SUPPORT == ENABLED)
+   EcDomainParameters ecParams;                 ///<EC domain parameters
+   EcPublicKey ecPublicKey;                     ///<EC public key
+#endif
+#if (ECDSA_SUPPORT == ENABLED)
+   EcdsaVerifyKey ecdsaVerifyKey;               ///<Precomputed ECDSA verification key
+#endif
+} X509CachedPublicKey;
+
+
+/**
+ * @brief Public key cache statistics
+ **/
+
+typedef struct
+{
+   uint_t size;        ///<Max number of entries
+   uint_t count;       ///<Number of valid entries
+   uint32_t hits;      ///<Number of lookups that found a matching entry
+   uint32_t misses;    ///<Number of lookups that found no matching entry
+   uint32_t evictions; ///<Number of valid entries that have been replaced
+} X509KeyCacheStats;
+
+
+/**
+ * @brief Public key cache
+ **/
+
+typedef struct
+{
+   OsMutex mutex;                   ///<Mutex preventing simultaneous access to the cache
+   uint_t size;                     ///<Max number of entries
+   uint32_t clock;                  ///<Logical clock used to track the least recently used entry
+   uint32_t hits;                   ///<Number of lookups that found a matching entry
+   uint32_t misses;                 ///<Number of lookups that found no matching entry
+   uint32_t evictions;              ///<Number of valid entries that have been replaced
+   X509CachedPublicKey *entries[];  ///<Cache entries
+} X509KeyCache;
+
+
+//Public key cache related functions
+X509KeyCache *x509InitKeyCache(uint_t size);
+void x509FreeKeyCache(X509KeyCache *cache);
+void x509FlushKeyCache(X509KeyCache *cache);
+
+error_t x509RegisterKeyCache(X509KeyCache *cache);
+X509KeyCache *x509GetKeyCache(void);
+
+error_t x509AcquireCachedPublicKey(X509KeyCache *cache,
+   const X509SubjectPublicKeyInfo *publicKeyInfo,
+   const X509CachedPublicKey **publicKey);
+
+error_t x509AcquireCachedRsaPublicKey(X509KeyCache *cache,
+   const X509SubjectPublicKeyInfo *publicKeyInfo,
+   const X509CachedPublicKey **cachedKey, const RsaPublicKey **publicKey);
+
+error_t x509AcquireCachedDsaPublicKey(X509KeyCache *cache,
+   const X509SubjectPublicKeyInfo *publicKeyInfo,
+   const X509CachedPublicKey **cachedKey, const DsaPublicKey **publicKey);
+
+error_t x509AcquireCachedEcPublicKey(X509KeyCache *cache,
+   const X509SubjectPublicKeyInfo *publicKeyInfo,
+   const X509CachedPublicKey **cachedKey, const EcDomainParameters **params,
+   const EcPublicKey **publicKey);
+
+void x509ReleaseCachedPublicKey(X509KeyCache *cache,
+   const X509CachedPublicKey *publicKey);
+
+void x509GetKeyCacheStats(X509KeyCache *cache, X509KeyCacheStats *stats);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -979,6 +979,7 @@ error_t x509ImportEcPublicKey(const X509SubjectPublicKeyInfo *publicKeyInfo,
 #if (EC_SUPPORT == ENABLED)
    const EcCurveInfo *curveInfo;
    EcDomainParameters params;
+   const EcDomainParameters *curveParams;
 
    //EC public key identifier?
    if(!oidComp(publicKeyInfo->oid, publicKeyInfo->oidLen, EC_PUBLIC_KEY_OID,
@@ -998,8 +999,8 @@ error_t x509ImportEcPublicKey(const X509SubjectPublicKeyInfo *publicKeyInfo,
          //Make sure the specified elliptic curve is supported
          if(curveInfo != NULL)
          {
-            //Load EC domain parameters
-            error = ecLoadDomainParameters(&params, curveInfo);
+            //Retrieve the shared EC domain parameters, if any
+            error = ecGetDomainParameters(curveInfo, &params, &curveParams);
          }
          else
          {
@@ -1011,8 +1012,8 @@ error_t x509ImportEcPublicKey(const X509SubjectPublicKeyInfo *publicKeyInfo,
          if(!error)
          {
             //Read the EC public key
-            error = ecImport(&params, &publicKey->q, publicKeyInfo->ecPublicKey.q,
-               publicKeyInfo->ecPublicKey.qLen);
+            error = ecImport(curveParams, &publicKey->q,
+               publicKeyInfo->ecPublicKey.q, publicKeyInfo->ecPublicKey.qLen);
          }
 
          //Check status code
@@ -34,6 +34,7 @@
 //Dependencies
 #include "core/crypto.h"
 #include "pkix/x509_key_parse.h"
+#include "pkix/x509_key_cache.h"
 #include "pkix/x509_signature.h"
 #include "pkc/rsa.h"
 #include "pkc/dsa.h"
@@ -375,6 +376,7 @@ error_t x509GenerateEcdsaSignature(const PrngAlgo *prngAlgo, void *prngContext,
    error_t error;
    const EcCurveInfo *curveInfo;
    EcDomainParameters params;
+   const EcDomainParameters *curveParams;
    EcdsaSignature signature;
    uint8_t digest[X509_MAX_HASH_DIGEST_SIZE];
 
@@ -390,8 +392,8 @@ error_t x509GenerateEcdsaSignature(const PrngAlgo *prngAlgo, void *prngContext,
    //Make sure the specified elliptic curve is supported
    if(curveInfo != NULL)
    {
-      //Load EC domain parameters
-      error = ecLoadDomainParameters(&params, curveInfo);
+      //Retrieve the shared EC domain parameters, if any
+      error = ecGetDomainParameters(curveInfo, &params, &curveParams);
    }
    else
    {
@@ -410,8 +412,8 @@ error_t x509GenerateEcdsaSignature(const PrngAlgo *prngAlgo, void *prngContext,
    if(!error)
    {
       //Generate ECDSA signature
-      error = ecdsaGenerateSignature(prngAlgo, prngContext, &params, privateKey,
-         digest, hashAlgo->digestSize, &signature);
+      error = ecdsaGenerateSignature(prngAlgo, prngContext, curveParams,
+         privateKey, digest, hashAlgo->digestSize, &signature);
    }
 
    //Check status code
@@ -671,10 +673,22 @@ error_t x509VerifyRsaSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    error_t error;
    uint_t k;
    RsaPublicKey publicKey;
+   const RsaPublicKey *key;
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   X509KeyCache *cache;
+   const X509CachedPublicKey *cachedKey;
+#endif
    uint8_t digest[X509_MAX_HASH_DIGEST_SIZE];
 
    //Initialize RSA public key
    rsaInitPublicKey(&publicKey);
+   key = &publicKey;
+
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   //Point to the registered public key cache
+   cache = x509GetKeyCache();
+   cachedKey = NULL;
+#endif
 
    //Digest the TBSCertificate structure using the specified hash algorithm
    error = hashAlgo->compute(tbsCert, tbsCertLen, digest);
@@ -682,15 +696,27 @@ error_t x509VerifyRsaSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    //Check status code
    if(!error)
    {
-      //Import the RSA public key
-      error = x509ImportRsaPublicKey(publicKeyInfo, &publicKey);
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+      //Any public key cache registered?
+      if(cache != NULL)
+      {
+         //Retrieve the RSA public key from the cache
+         error = x509AcquireCachedRsaPublicKey(cache, publicKeyInfo,
+            &cachedKey, &key);
+      }
+      else
+#endif
+      {
+         //Import the RSA public key
+         error = x509ImportRsaPublicKey(publicKeyInfo, &publicKey);
+      }
    }
 
    //Check status code
    if(!error)
    {
       //Get the length of the modulus, in bits
-      k = mpiGetBitLength(&publicKey.n);
+      k = mpiGetBitLength(&key->n);
 
       //Make sure the modulus is acceptable
       if(k < X509_MIN_RSA_MODULUS_SIZE || k > X509_MAX_RSA_MODULUS_SIZE)
@@ -704,10 +730,15 @@ error_t x509VerifyRsaSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    if(!error)
    {
       //Verify RSA signature (RSASSA-PKCS1-v1_5 signature scheme)
-      error = rsassaPkcs1v15Verify(&publicKey, hashAlgo, digest,
+      error = rsassaPkcs1v15Verify(key, hashAlgo, digest,
          signatureValue->data, signatureValue->length);
    }
 
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   //Release the reference to the cached public key
+   x509ReleaseCachedPublicKey(cache, cachedKey);
+#endif
+
    //Release previously allocated resources
    rsaFreePublicKey(&publicKey);
 
@@ -740,10 +771,22 @@ error_t x509VerifyRsaPssSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    error_t error;
    uint_t k;
    RsaPublicKey publicKey;
+   const RsaPublicKey *key;
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   X509KeyCache *cache;
+   const X509CachedPublicKey *cachedKey;
+#endif
    uint8_t digest[X509_MAX_HASH_DIGEST_SIZE];
 
    //Initialize RSA public key
    rsaInitPublicKey(&publicKey);
+   key = &publicKey;
+
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   //Point to the registered public key cache
+   cache = x509GetKeyCache();
+   cachedKey = NULL;
+#endif
 
    //Digest the TBSCertificate structure using the specified hash algorithm
    error = hashAlgo->compute(tbsCert, tbsCertLen, digest);
@@ -751,15 +794,27 @@ error_t x509VerifyRsaPssSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    //Check status code
    if(!error)
    {
-      //Import the RSA public key
-      error = x509ImportRsaPublicKey(publicKeyInfo, &publicKey);
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+      //Any public key cache registered?
+      if(cache != NULL)
+      {
+         //Retrieve the RSA public key from the cache
+         error = x509AcquireCachedRsaPublicKey(cache, publicKeyInfo,
+            &cachedKey, &key);
+      }
+      else
+#endif
+      {
+         //Import the RSA public key
+         error = x509ImportRsaPublicKey(publicKeyInfo, &publicKey);
+      }
    }
 
    //Check status code
    if(!error)
    {
       //Get the length of the modulus, in bits
-      k = mpiGetBitLength(&publicKey.n);
+      k = mpiGetBitLength(&key->n);
 
       //Make sure the modulus is acceptable
       if(k < X509_MIN_RSA_MODULUS_SIZE || k > X509_MAX_RSA_MODULUS_SIZE)
@@ -773,10 +828,15 @@ error_t x509VerifyRsaPssSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    if(!error)
    {
       //Verify RSA signature (RSASSA-PSS signature scheme)
-      error = rsassaPssVerify(&publicKey, hashAlgo, saltLen, digest,
+      error = rsassaPssVerify(key, hashAlgo, saltLen, digest,
          signatureValue->data, signatureValue->length);
    }
 
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   //Release the reference to the cached public key
+   x509ReleaseCachedPublicKey(cache, cachedKey);
+#endif
+
    //Release previously allocated resources
    rsaFreePublicKey(&publicKey);
 
@@ -807,29 +867,53 @@ error_t x509VerifyDsaSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    error_t error;
    uint_t k;
    DsaPublicKey publicKey;
+   const DsaPublicKey *key;
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   X509KeyCache *cache;
+   const X509CachedPublicKey *cachedKey;
+#endif
    DsaSignature signature;
    uint8_t digest[X509_MAX_HASH_DIGEST_SIZE];
 
    //Initialize DSA public key
    dsaInitPublicKey(&publicKey);
+   key = &publicKey;
    //Initialize DSA signature
    dsaInitSignature(&signature);
 
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   //Point to the registered public key cache
+   cache = x509GetKeyCache();
+   cachedKey = NULL;
+#endif
+
    //Digest the TBSCertificate structure using the specified hash algorithm
    error = hashAlgo->compute(tbsCert, tbsCertLen, digest);
 
    //Check status code
    if(!error)
    {
-      //Import the DSA public key
-      error = x509ImportDsaPublicKey(publicKeyInfo, &publicKey);
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+      //Any public key cache registered?
+      if(cache != NULL)
+      {
+         //Retrieve the DSA public key from the cache
+         error = x509AcquireCachedDsaPublicKey(cache, publicKeyInfo,
+            &cachedKey, &key);
+      }
+      else
+#endif
+      {
+         //Import the DSA public key
+         error = x509ImportDsaPublicKey(publicKeyInfo, &publicKey);
+      }
    }
 
    //Check status code
    if(!error)
    {
       //Get the length of the prime modulus, in bits
-      k = mpiGetBitLength(&publicKey.p);
+      k = mpiGetBitLength(&key->p);
 
       //Make sure the prime modulus is acceptable
       if(k < X509_MIN_DSA_MODULUS_SIZE || k > X509_MAX_DSA_MODULUS_SIZE)
@@ -851,10 +935,15 @@ error_t x509VerifyDsaSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    if(!error)
    {
       //Verify DSA signature
-      error = dsaVerifySignature(&publicKey, digest, hashAlgo->digestSize,
+      error = dsaVerifySignature(key, digest, hashAlgo->digestSize,
          &signature);
    }
 
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   //Release the reference to the cached public key
+   x509ReleaseCachedPublicKey(cache, cachedKey);
+#endif
+
    //Release previously allocated resources
    dsaFreePublicKey(&publicKey);
    dsaFreeSignature(&signature);
@@ -887,6 +976,12 @@ error_t x509VerifyEcdsaSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    const EcCurveInfo *curveInfo;
    EcDomainParameters params;
    EcPublicKey publicKey;
+   const EcDomainParameters *curveParams;
+   const EcPublicKey *key;
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   X509KeyCache *cache;
+   const X509CachedPublicKey *cachedKey;
+#endif
    EcdsaSignature signature;
    uint8_t digest[X509_MAX_HASH_DIGEST_SIZE];
 
@@ -897,35 +992,62 @@ error_t x509VerifyEcdsaSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    //Initialize ECDSA signature
    ecdsaInitSignature(&signature);
 
-   //Retrieve EC domain parameters
-   curveInfo = x509GetCurveInfo(publicKeyInfo->ecParams.namedCurve,
-      publicKeyInfo->ecParams.namedCurveLen);
+   //Point to the EC domain parameters and EC public key
+   curveParams = &params;
+   key = &publicKey;
 
-   //Make sure the specified elliptic curve is supported
-   if(curveInfo != NULL)
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   //Point to the registered public key cache
+   cache = x509GetKeyCache();
+   cachedKey = NULL;
+
+   //Any public key cache registered?
+   if(cache != NULL)
    {
-      //Load EC domain parameters
-      error = ecLoadDomainParameters(&params, curveInfo);
+      //Retrieve the EC domain parameters and EC public key from the cache
+      error = x509AcquireCachedEcPublicKey(cache, publicKeyInfo, &cachedKey,
+         &curveParams, &key);
+
+      //Check status code
+      if(!error)
+      {
+         //Digest the TBSCertificate structure using the specified hash algorithm
+         error = hashAlgo->compute(tbsCert, tbsCertLen, digest);
+      }
    }
    else
+#endif
    {
-      //Invalid EC domain parameters
-      error = ERROR_BAD_CERTIFICATE;
-   }
+      //Retrieve EC domain parameters
+      curveInfo = x509GetCurveInfo(publicKeyInfo->ecParams.namedCurve,
+         publicKeyInfo->ecParams.namedCurveLen);
 
-   //Check status code
-   if(!error)
-   {
-      //Digest the TBSCertificate structure using the specified hash algorithm
-      error = hashAlgo->compute(tbsCert, tbsCertLen, digest);
-   }
+      //Make sure the specified elliptic curve is supported
+      if(curveInfo != NULL)
+      {
+         //Retrieve the shared EC domain parameters, if any
+         error = ecGetDomainParameters(curveInfo, &params, &curveParams);
+      }
+      else
+      {
+         //Invalid EC domain parameters
+         error = ERROR_BAD_CERTIFICATE;
+      }
 
-   //Check status code
-   if(!error)
-   {
-      //Retrieve the EC public key
-      error = ecImport(&params, &publicKey.q, publicKeyInfo->ecPublicKey.q,
-         publicKeyInfo->ecPublicKey.qLen);
+      //Check status code
+      if(!error)
+      {
+         //Digest the TBSCertificate structure using the specified hash algorithm
+         error = hashAlgo->compute(tbsCert, tbsCertLen, digest);
+      }
+
+      //Check status code
+      if(!error)
+      {
+         //Retrieve the EC public key
+         error = ecImport(curveParams, &publicKey.q,
+            publicKeyInfo->ecPublicKey.q, publicKeyInfo->ecPublicKey.qLen);
+      }
    }
 
    //Check status code
@@ -939,11 +1061,29 @@ error_t x509VerifyEcdsaSignature(const uint8_t *tbsCert, size_t tbsCertLen,
    //Check status code
    if(!error)
    {
-      //Verify ECDSA signature
-      error = ecdsaVerifySignature(&params, &publicKey, digest,
-         hashAlgo->digestSize, &signature);
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+      //Cached public key?
+      if(cachedKey != NULL)
+      {
+         //Verify ECDSA signature using the precomputed verification key
+         error = ecdsaVerifySignatureWithKey(curveParams,
+            &cachedKey->ecdsaVerifyKey, digest, hashAlgo->digestSize,
+            &signature);
+      }
+      else
+#endif
+      {
+         //Verify ECDSA signature
+         error = ecdsaVerifySignature(curveParams, key, digest,
+            hashAlgo->digestSize, &signature);
+      }
    }
 
+#if (X509_KEY_CACHE_SUPPORT == ENABLED)
+   //Release the reference to the cached public key
+   x509ReleaseCachedPublicKey(cache, cachedKey);
+#endif
+
    //Release previously allocated resources
    ecFreeDomainParameters(&params);
    ecFreePublicKey(&publicKey);
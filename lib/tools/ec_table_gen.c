@@ -0,0 +1,654 @@
+/**
+ * @file ec_table_gen.c
+ * @brief Generator of the precomputed EC tables compiled into the library
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2022 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneCRYPTO Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * The tool builds the precomputed multiples of the base point of the
+ * curves enabled in crypto_config.h with the very same routines that are
+ * used at runtime (ecCombBuild and ed25519BuildBaseTable), and emits them
+ * as constant C objects. It must be compiled with the same configuration
+ * as the library, and with EC_STATIC_TABLE_SUPPORT disabled. The output
+ * only depends on the configuration, so that the generated file is
+ * reproducible
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.1.6
+ **/
+
+//Dependencies
+#include <stdio.h>
+#include <stdlib.h>
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_comb.h"
+#include "ecc/ec_fixed.h"
+#include "ecc/ec_tables.h"
+#include "ecc/ec_wnaf.h"
+
+//Ed25519 supported?
+#if (ED25519_SUPPORT == ENABLED)
+   #include "ecc/ed25519.h"
+#endif
+
+//Check configuration
+#if (EC_STATIC_TABLE_SUPPORT == ENABLED)
+   #error The generator must be compiled with EC_STATIC_TABLE_SUPPORT disabled
+#endif
+
+//Number of words per line
+#define EC_TABLE_GEN_WORDS_PER_LINE(size) (((size) == 8) ? 4 : 8)
+
+//Any table to emit?
+#if (EC_COMB_SUPPORT == ENABLED || (ED25519_SUPPORT == ENABLED && \
+   ED25519_BASE_TABLE_SUPPORT == ENABLED))
+
+/**
+ * @brief Write a list of words
+ * @param[in] fp Output stream
+ * @param[in] data Pointer to the words
+ * @param[in] size Size of a word, in bytes (4 or 8)
+ * @param[in] n Number of words
+ * @param[in] last Last list of the array
+ **/
+
+static void ecTableGenWriteWords(FILE *fp, const void *data, size_t size,
+   size_t n, bool_t last)
+{
+   size_t i;
+   uint64_t value;
+
+   //Loop through the words
+   for(i = 0; i < n; i++)
+   {
+      //Retrieve the value of the current word
+      if(size == 8)
+      {
+         value = ((const uint64_t *) data)[i];
+      }
+      else
+      {
+         value = ((const uint32_t *) data)[i];
+      }
+
+      //Beginning of a new line?
+      if((i % EC_TABLE_GEN_WORDS_PER_LINE(size)) == 0)
+      {
+         fprintf(fp, "   ");
+      }
+
+      //Write the current word
+      if(size == 8)
+      {
+         fprintf(fp, "0x%016llX", (unsigned long long) value);
+      }
+      else
+      {
+         fprintf(fp, "0x%08lX", (unsigned long) value);
+      }
+
+      //Words are separated by a comma
+      if((i + 1) < n || !last)
+      {
+         fprintf(fp, ",");
+      }
+
+      //End of the current line?
+      if(((i + 1) % EC_TABLE_GEN_WORDS_PER_LINE(size)) == 0 || (i + 1) == n)
+      {
+         fprintf(fp, "\n");
+      }
+      else
+      {
+         fprintf(fp, " ");
+      }
+   }
+}
+
+#endif
+
+
+/**
+ * @brief Write the file header
+ * @param[in] fp Output stream
+ **/
+
+static void ecTableGenWriteHeader(FILE *fp)
+{
+   fprintf(fp,
+      "/**\n"
+      " * @file ec_tables.c\n"
+      " * @brief Precomputed EC tables compiled into the library\n"
+      " *\n"
+      " * This file has been generated by ec_table_gen. Do not edit\n"
+      " *\n"
+      " * @author Oryx Embedded SARL (www.oryx-embedded.com)\n"
+      " * @version 2.1.6\n"
+      " **/\n"
+      "\n"
+      "//Dependencies\n"
+      "#include \"core/crypto.h\"\n"
+      "#include \"ecc/ec.h\"\n"
+      "#include \"ecc/ec_comb.h\"\n"
+      "#include \"ecc/ec_tables.h\"\n"
+      "\n"
+      "//Check crypto library configuration\n"
+      "#if (EC_SUPPORT == ENABLED && EC_STATIC_TABLE_SUPPORT == ENABLED)\n");
+}
+
+
+#if (EC_COMB_SUPPORT == ENABLED)
+
+/**
+ * @brief Number of words used to store a multiple precision integer
+ * @param[in] a Multiple precision integer
+ * @return Number of words
+ **/
+
+static uint_t ecTableGenGetMpiLength(const Mpi *a)
+{
+   uint_t n;
+
+   //Leading zero words are discarded
+   n = mpiGetLength(a);
+
+   //Zero is stored as a single word
+   return (n > 0) ? n : 1;
+}
+
+
+/**
+ * @brief Write the words of an array of EC points
+ * @param[in] fp Output stream
+ * @param[in] points EC points
+ * @param[in] n Number of points
+ * @param[in] last Last list of the array
+ **/
+
+static void ecTableGenWritePointData(FILE *fp, const EcPoint *points,
+   uint_t n, bool_t last)
+{
+   uint_t i;
+
+   //Loop through the points
+   for(i = 0; i < n; i++)
+   {
+      ecTableGenWriteWords(fp, points[i].x.data, MPI_INT_SIZE,
+         ecTableGenGetMpiLength(&points[i].x), FALSE);
+      ecTableGenWriteWords(fp, points[i].y.data, MPI_INT_SIZE,
+         ecTableGenGetMpiLength(&points[i].y), FALSE);
+      ecTableGenWriteWords(fp, points[i].z.data, MPI_INT_SIZE,
+         ecTableGenGetMpiLength(&points[i].z), last && (i + 1) == n);
+   }
+}
+
+
+/**
+ * @brief Write a multiple precision integer referencing the word array
+ * @param[in] fp Output stream
+ * @param[in] name Name of the word array
+ * @param[in] a Multiple precision integer
+ * @param[in,out] offset Offset of the integer in the word array
+ **/
+
+static void ecTableGenWriteMpi(FILE *fp, const char_t *name, const Mpi *a,
+   uint_t *offset)
+{
+   uint_t n;
+
+   //Number of words
+   n = ecTableGenGetMpiLength(a);
+
+   //The integer points to the word array
+   fprintf(fp, "{%d, %u, (uint_t *) %sData + %u}", (int) a->sign, n, name,
+      *offset);
+
+   //Advance offset
+   *offset += n;
+}
+
+
+/**
+ * @brief Write an array of EC points referencing the word array
+ * @param[in] fp Output stream
+ * @param[in] name Name of the word array
+ * @param[in] suffix Suffix of the point array
+ * @param[in] points EC points
+ * @param[in] n Number of points
+ * @param[in,out] offset Offset of the first point in the word array
+ **/
+
+static void ecTableGenWritePoints(FILE *fp, const char_t *name,
+   const char_t *suffix, const EcPoint *points, uint_t n, uint_t *offset)
+{
+   uint_t i;
+
+   fprintf(fp, "\nstatic const EcPoint %s%s[%u] =\n{\n", name, suffix, n);
+
+   //Loop through the points
+   for(i = 0; i < n; i++)
+   {
+      fprintf(fp, "   {");
+      ecTableGenWriteMpi(fp, name, &points[i].x, offset);
+      fprintf(fp, ", ");
+      ecTableGenWriteMpi(fp, name, &points[i].y, offset);
+      fprintf(fp, ", ");
+      ecTableGenWriteMpi(fp, name, &points[i].z, offset);
+      fprintf(fp, "}%s\n", ((i + 1) < n) ? "," : "");
+   }
+
+   fprintf(fp, "};\n");
+}
+
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+
+/**
+ * @brief Write an array of EC points in fixed-width representation
+ * @param[in] fp Output stream
+ * @param[in] name Name of the array
+ * @param[in] points EC points
+ * @param[in] n Number of points
+ * @param[in] words Number of significant words per coordinate
+ **/
+
+static void ecTableGenWriteFixedPoints(FILE *fp, const char_t *name,
+   const EcFixedPoint *points, uint_t n, uint_t words)
+{
+   uint_t i;
+
+   fprintf(fp, "\nstatic const EcFixedPoint %sWnafFixedPoints[%u] =\n{\n",
+      name, n);
+
+   //Loop through the points
+   for(i = 0; i < n; i++)
+   {
+      fprintf(fp, "   {\n   {\n");
+      ecTableGenWriteWords(fp, points[i].x, sizeof(MpiFixedWord), words, TRUE);
+      fprintf(fp, "   },\n   {\n");
+      ecTableGenWriteWords(fp, points[i].y, sizeof(MpiFixedWord), words, TRUE);
+      fprintf(fp, "   },\n   {\n");
+      ecTableGenWriteWords(fp, points[i].z, sizeof(MpiFixedWord), words, TRUE);
+      fprintf(fp, "   }\n   }%s\n", ((i + 1) < n) ? "," : "");
+   }
+
+   fprintf(fp, "};\n");
+}
+
+#endif
+
+
+/**
+ * @brief Write the precomputed multiples of the base point of a curve
+ * @param[in] fp Output stream
+ * @param[in] name Name of the table
+ * @param[in] curveInfo Elliptic curve parameters
+ * @return Error code
+ **/
+
+static error_t ecTableGenWriteComb(FILE *fp, const char_t *name,
+   const EcCurveInfo *curveInfo)
+{
+   error_t error;
+   uint_t n;
+   uint_t m;
+   uint_t offset;
+   EcDomainParameters params;
+   EcCombTable table;
+#if (EC_FIXED_SUPPORT == ENABLED)
+   EcFixedCurve curve;
+#endif
+
+   //Initialize EC domain parameters
+   ecInitDomainParameters(&params);
+   //Initialize precomputed tables
+   ecCombInit(&table);
+
+   //Load EC domain parameters
+   error = ecLoadDomainParameters(&params, curveInfo);
+
+   //Check status code
+   if(!error)
+   {
+      //Build the tables exactly as the comb cache does
+      error = ecCombBuild(&params, &table);
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //Number of comb points and odd multiples
+      n = table.v << table.h;
+      m = 1 << (table.wnaf.w - 2);
+
+      //Words of all the integers
+      fprintf(fp, "\n//%s elliptic curve\n", curveInfo->name);
+      fprintf(fp, "static const uint_t %sData[] =\n{\n", name);
+      ecTableGenWriteWords(fp, table.p.data, MPI_INT_SIZE,
+         ecTableGenGetMpiLength(&table.p), FALSE);
+      ecTableGenWritePointData(fp, table.points, n, FALSE);
+      ecTableGenWritePointData(fp, table.wnaf.points, m, TRUE);
+      fprintf(fp, "};\n");
+
+      //The integers are stored in the same order as their words
+      offset = ecTableGenGetMpiLength(&table.p);
+      ecTableGenWritePoints(fp, name, "Points", table.points, n, &offset);
+      ecTableGenWritePoints(fp, name, "WnafPoints", table.wnaf.points, m,
+         &offset);
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+      //Odd multiples in fixed-width representation
+      if(table.wnaf.fixedPoints != NULL && !ecFixedInit(&curve, &params))
+      {
+         ecTableGenWriteFixedPoints(fp, name, table.wnaf.fixedPoints, m,
+            curve.n);
+      }
+#endif
+
+      //Precomputed tables
+      fprintf(fp, "\nstatic const EcCombTable %sTable =\n{\n", name);
+      fprintf(fp, "   \"%s\",\n   ", curveInfo->name);
+      offset = 0;
+      ecTableGenWriteMpi(fp, name, &table.p, &offset);
+      fprintf(fp, ",\n   %u,\n   %u,\n   %u,\n   %u,\n   %u,\n",
+         table.expLen, table.h, table.v, table.a, table.b);
+      fprintf(fp, "   (EcPoint *) %sPoints,\n", name);
+      fprintf(fp, "   {\n      %u,\n      (EcPoint *) %sWnafPoints",
+         table.wnaf.w, name);
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+      if(table.wnaf.fixedPoints != NULL)
+      {
+         fprintf(fp, ",\n      (EcFixedPoint *) %sWnafFixedPoints\n", name);
+      }
+      else
+      {
+         fprintf(fp, ",\n      NULL\n");
+      }
+#else
+      fprintf(fp, "\n");
+#endif
+
+      fprintf(fp, "   }\n};\n");
+   }
+
+   //Release previously allocated resources
+   ecCombFree(&table);
+   ecFreeDomainParameters(&params);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Write the precomputed multiples of the base points
+ * @param[in] fp Output stream
+ * @return Error code
+ **/
+
+static error_t ecTableGenWriteCombTables(FILE *fp)
+{
+   error_t error;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   fprintf(fp,
+      "\n"
+      "//Precomputed multiples of the base point G\n"
+      "#if (EC_COMB_SUPPORT == ENABLED)\n"
+      "\n"
+      "//Check that the tables match the library configuration\n"
+      "#if (EC_COMB_TEETH != %u || EC_COMB_TABLES != %u || EC_COMB_WNAF_WIDTH != %u)\n"
+      "   #error The precomputed EC tables must be generated again\n"
+      "#endif\n",
+      EC_COMB_TEETH, EC_COMB_TABLES, EC_COMB_WNAF_WIDTH);
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+   fprintf(fp,
+      "#if (EC_FIXED_SUPPORT != ENABLED || MPI_FIXED_WORD_SIZE != %u)\n"
+      "   #error The precomputed EC tables must be generated again\n"
+      "#endif\n", MPI_FIXED_WORD_SIZE);
+#else
+   fprintf(fp,
+      "#if (EC_FIXED_SUPPORT == ENABLED)\n"
+      "   #error The precomputed EC tables must be generated again\n"
+      "#endif\n");
+#endif
+
+#if (SECP256R1_SUPPORT == ENABLED)
+   //secp256r1 elliptic curve
+   if(!error)
+   {
+      error = ecTableGenWriteComb(fp, "secp256r1Comb", SECP256R1_CURVE);
+   }
+#endif
+
+#if (SECP384R1_SUPPORT == ENABLED)
+   //secp384r1 elliptic curve
+   if(!error)
+   {
+      error = ecTableGenWriteComb(fp, "secp384r1Comb", SECP384R1_CURVE);
+   }
+#endif
+
+   //List of the precomputed tables
+   fprintf(fp,
+      "\n"
+      "static const EcCombTable *const ecStaticCombTables[] =\n"
+      "{\n");
+#if (SECP256R1_SUPPORT == ENABLED)
+   fprintf(fp, "   &secp256r1CombTable,\n");
+#endif
+#if (SECP384R1_SUPPORT == ENABLED)
+   fprintf(fp, "   &secp384r1CombTable,\n");
+#endif
+   fprintf(fp, "   NULL\n};\n");
+
+   //Lookup function
+   fprintf(fp,
+      "\n"
+      "\n"
+      "/**\n"
+      " * @brief Retrieve the precomputed multiples of the base point of a curve\n"
+      " * @param[in] curveInfo Elliptic curve parameters\n"
+      " * @return Precomputed tables (NULL if the curve has no precomputed tables)\n"
+      " **/\n"
+      "\n"
+      "const EcCombTable *ecGetStaticCombTable(const EcCurveInfo *curveInfo)\n"
+      "{\n"
+      "   uint_t i;\n"
+      "\n"
+      "   //Loop through the precomputed tables\n"
+      "   for(i = 0; ecStaticCombTables[i] != NULL; i++)\n"
+      "   {\n"
+      "      //Matching curve name?\n"
+      "      if(!osStrcmp(ecStaticCombTables[i]->name, curveInfo->name))\n"
+      "         return ecStaticCombTables[i];\n"
+      "   }\n"
+      "\n"
+      "   //No precomputed tables\n"
+      "   return NULL;\n"
+      "}\n"
+      "\n"
+      "#endif\n");
+
+   //Return status code
+   return error;
+}
+
+#endif
+
+
+#if (ED25519_SUPPORT == ENABLED && ED25519_BASE_TABLE_SUPPORT == ENABLED)
+
+/**
+ * @brief Write the precomputed multiples of the Ed25519 base point
+ * @param[in] fp Output stream
+ * @return Error code
+ **/
+
+static error_t ecTableGenWriteEd25519(FILE *fp)
+{
+   error_t error;
+   uint_t i;
+   uint_t j;
+   Ed25519BaseTable *table;
+   const Ed25519PrecompPoint *p;
+
+   //Allocate a memory buffer to hold the table
+   table = cryptoAllocMem(sizeof(Ed25519BaseTable));
+   //Failed to allocate memory?
+   if(table == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Build the table exactly as at runtime
+   error = ed25519BuildBaseTable(table);
+
+   //Check status code
+   if(!error)
+   {
+      fprintf(fp,
+         "\n"
+         "//Precomputed multiples of the base point B\n"
+         "#if (ED25519_SUPPORT == ENABLED && ED25519_BASE_TABLE_SUPPORT == ENABLED)\n"
+         "\n"
+         "//Check that the table matches the library configuration\n"
+         "#if (CURVE25519_LIMB_LEN != %u)\n"
+         "   #error The precomputed EC tables must be generated again\n"
+         "#endif\n"
+         "\n"
+         "const Ed25519BaseTable ed25519StaticBaseTable =\n"
+         "{\n"
+         "   {\n", CURVE25519_LIMB_LEN);
+
+      //Loop through the rows of the table
+      for(i = 0; i < 32; i++)
+      {
+         fprintf(fp, "      {\n");
+
+         //Loop through the multiples
+         for(j = 0; j < 8; j++)
+         {
+            //Point to the current multiple
+            p = &table->points[i][j];
+
+            fprintf(fp, "      {\n      {\n");
+            ecTableGenWriteWords(fp, p->yPlusX, sizeof(Curve25519Limb),
+               CURVE25519_LIMB_LEN, TRUE);
+            fprintf(fp, "      },\n      {\n");
+            ecTableGenWriteWords(fp, p->yMinusX, sizeof(Curve25519Limb),
+               CURVE25519_LIMB_LEN, TRUE);
+            fprintf(fp, "      },\n      {\n");
+            ecTableGenWriteWords(fp, p->xy2d, sizeof(Curve25519Limb),
+               CURVE25519_LIMB_LEN, TRUE);
+            fprintf(fp, "      }\n      }%s\n", (j < 7) ? "," : "");
+         }
+
+         fprintf(fp, "      }%s\n", (i < 31) ? "," : "");
+      }
+
+      fprintf(fp, "   }\n};\n\n#endif\n");
+   }
+
+   //Release previously allocated memory
+   cryptoFreeMem(table);
+
+   //Return status code
+   return error;
+}
+
+#endif
+
+
+/**
+ * @brief Main entry point
+ * @param[in] argc Number of arguments
+ * @param[in] argv Path to the output file
+ * @return Exit status
+ **/
+
+int main(int argc, char *argv[])
+{
+   error_t error;
+   FILE *fp;
+
+   //Check the number of arguments
+   if(argc != 2)
+   {
+      fprintf(stderr, "Usage: ec_table_gen <output file>\n");
+      return EXIT_FAILURE;
+   }
+
+   //Open the output file
+   fp = fopen(argv[1], "w");
+   //Failed to open the file?
+   if(fp == NULL)
+   {
+      fprintf(stderr, "Cannot open %s\n", argv[1]);
+      return EXIT_FAILURE;
+   }
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Write the file header
+   ecTableGenWriteHeader(fp);
+
+#if (EC_COMB_SUPPORT == ENABLED)
+   //Write the precomputed multiples of the base points
+   if(!error)
+   {
+      error = ecTableGenWriteCombTables(fp);
+   }
+#endif
+
+#if (ED25519_SUPPORT == ENABLED && ED25519_BASE_TABLE_SUPPORT == ENABLED)
+   //Write the precomputed multiples of the Ed25519 base point
+   if(!error)
+   {
+      error = ecTableGenWriteEd25519(fp);
+   }
+#endif
+
+   //End of the file
+   fprintf(fp, "\n#endif\n");
+
+   //Close the output file
+   fclose(fp);
+
+   //Any error to report?
+   if(error)
+   {
+      fprintf(stderr, "Failed to generate the precomputed tables (%d)\n",
+         error);
+      remove(argv[1]);
+      return EXIT_FAILURE;
+   }
+
+   //Successful processing
+   return EXIT_SUCCESS;
+}
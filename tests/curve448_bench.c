@@ -0,0 +1,178 @@
+/**
+ * @file curve448_bench.c
+ * @brief Curve448 benchmark
+ *
+ * Measures the throughput of the Curve448 field arithmetic, X448 and Ed448.
+ * The program is built once per field arithmetic backend, so that both
+ * backends can be compared on the same machine
+ **/
+
+//Dependencies
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "core/crypto.h"
+#include "ecc/curve448.h"
+#include "ecc/x448.h"
+#include "ecc/ed448.h"
+
+//Minimum duration of each benchmark, in seconds
+#define BENCH_MIN_DURATION 1.0
+
+
+/**
+ * @brief Benchmark entry
+ **/
+
+typedef struct
+{
+   const char_t *name;
+   void (*run)(void);
+} BenchEntry;
+
+//Operands
+static Curve448Limb benchA[CURVE448_LIMB_LEN];
+static Curve448Limb benchB[CURVE448_LIMB_LEN];
+static uint8_t benchScalar[CURVE448_BYTE_LEN];
+static uint8_t benchPoint[CURVE448_BYTE_LEN];
+static uint8_t benchPrivateKey[ED448_PRIVATE_KEY_LEN];
+static uint8_t benchPublicKey[ED448_PUBLIC_KEY_LEN];
+static uint8_t benchMessage[64];
+static uint8_t benchSignature[ED448_SIGNATURE_LEN];
+
+
+/**
+ * @brief Field multiplication
+ **/
+
+static void benchMul(void)
+{
+   curve448Mul(benchA, benchA, benchB);
+}
+
+
+/**
+ * @brief Field squaring
+ **/
+
+static void benchSqr(void)
+{
+   curve448Sqr(benchA, benchA);
+}
+
+
+/**
+ * @brief Field inversion
+ **/
+
+static void benchInv(void)
+{
+   curve448Inv(benchA, benchA);
+}
+
+
+/**
+ * @brief X448 scalar multiplication
+ **/
+
+static void benchX448(void)
+{
+   x448(benchPoint, benchScalar, benchPoint);
+}
+
+
+/**
+ * @brief Ed448 public key generation
+ **/
+
+static void benchEd448PublicKey(void)
+{
+   ed448GeneratePublicKey(benchPrivateKey, benchPublicKey);
+}
+
+
+/**
+ * @brief Ed448 signature generation
+ **/
+
+static void benchEd448Sign(void)
+{
+   ed448GenerateSignature(benchPrivateKey, benchPublicKey, benchMessage,
+      sizeof(benchMessage), NULL, 0, 0, benchSignature);
+}
+
+
+/**
+ * @brief Ed448 signature verification
+ **/
+
+static void benchEd448Verify(void)
+{
+   ed448VerifySignature(benchPublicKey, benchMessage, sizeof(benchMessage),
+      NULL, 0, 0, benchSignature);
+}
+
+
+//Benchmark entries
+static const BenchEntry benchEntries[] =
+{
+   {"curve448Mul", benchMul},
+   {"curve448Sqr", benchSqr},
+   {"curve448Inv", benchInv},
+   {"x448", benchX448},
+   {"ed448GeneratePublicKey", benchEd448PublicKey},
+   {"ed448GenerateSignature", benchEd448Sign},
+   {"ed448VerifySignature", benchEd448Verify}
+};
+
+
+int main(void)
+{
+   uint_t i;
+   uint32_t n;
+   uint32_t count;
+   double duration;
+   clock_t start;
+
+   //Fixed operands
+   memset(benchScalar, 0x5C, sizeof(benchScalar));
+   memset(benchPoint, 0, sizeof(benchPoint));
+   benchPoint[0] = 5;
+   memset(benchPrivateKey, 0xA5, sizeof(benchPrivateKey));
+   memset(benchMessage, 0x3C, sizeof(benchMessage));
+
+   curve448Import(benchA, benchScalar);
+   curve448Import(benchB, benchPrivateKey);
+
+   //The verification benchmark needs a valid signature
+   benchEd448PublicKey();
+   benchEd448Sign();
+
+   printf("Curve448 backend: %u-bit limbs\r\n",
+      (unsigned int) (sizeof(Curve448Limb) * 8));
+
+   //Loop through the benchmark entries
+   for(i = 0; i < arraysize(benchEntries); i++)
+   {
+      //Double the number of iterations until the minimum duration is reached
+      for(count = 1; ; count *= 2)
+      {
+         start = clock();
+
+         for(n = 0; n < count; n++)
+         {
+            benchEntries[i].run();
+         }
+
+         duration = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+         if(duration >= BENCH_MIN_DURATION)
+            break;
+      }
+
+      printf("%-24s %12.0f op/s %12.2f us/op\r\n", benchEntries[i].name,
+         count / duration, 1e6 * duration / count);
+   }
+
+   return 0;
+}
@@ -0,0 +1,581 @@
+/**
+ * @file curve448_test.c
+ * @brief Curve448 test
+ *
+ * Checks X448 against the RFC 7748 test vectors and Ed448 against the
+ * RFC 8032 test vectors. The program is built once per field arithmetic
+ * backend. When an output file is given, the results of a fixed sequence of
+ * random operations are written to it, so that the transcripts of both
+ * backends can be compared
+ **/
+
+//Dependencies
+#include <stdio.h>
+#include <string.h>
+#include "core/crypto.h"
+#include "ecc/curve448.h"
+#include "ecc/x448.h"
+#include "ecc/ed448.h"
+#include "rng/yarrow.h"
+
+//Number of random operations in the transcript
+#define TEST_RANDOM_ITERATIONS 64
+
+/**
+ * @brief X448 test vector
+ **/
+
+typedef struct
+{
+   const char_t *k;
+   const char_t *u;
+   const char_t *r;
+} X448TestVector;
+
+/**
+ * @brief Ed448 test vector
+ **/
+
+typedef struct
+{
+   const char_t *privateKey;
+   const char_t *publicKey;
+   const char_t *message;
+   const char_t *context;
+   const char_t *signature;
+} Ed448TestVector;
+
+//PRNG context
+static YarrowContext yarrowContext;
+
+//RFC 7748, section 5.2
+static const X448TestVector x448TestVectors[] =
+{
+   {
+      "3d262fddf9ec8e88495266fea19a34d28882acef045104d0d1aae121700a779c"
+      "984c24f8cdd78fbff44943eba368f54b29259a4f1c600ad3",
+      "06fce640fa3487bfda5f6cf2d5263f8aad88334cbd07437f020f08f9814dc031"
+      "ddbdc38c19c6da2583fa5429db94ada18aa7a7fb4ef8a086",
+      "ce3e4ff95a60dc6697da1db1d85e6afbdf79b50a2412d7546d5f239fe14fbaad"
+      "eb445fc66a01b0779d98223961111e21766282f73dd96b6f"
+   },
+   {
+      "203d494428b8399352665ddca42f9de8fef600908e0d461cb021f8c538345dd7"
+      "7c3e4806e25f46d3315c44e0a5b4371282dd2c8d5be3095f",
+      "0fbcc2f993cd56d3305b0b7d9e55d4c1a8fb5dbb52f8e9a1e9b6201b165d0158"
+      "94e56c4d3570bee52fe205e28a78b91cdfbde71ce8d157db",
+      "884a02576239ff7a2f2f63b2db6a9ff37047ac13568e1e30fe63c4a7ad1b3ee3"
+      "a5700df34321d62077e63633c575c1c954514e99da7c179d"
+   }
+};
+
+//RFC 7748, section 5.2 (output after 1 and 1000 iterations)
+static const char_t x448Iteration1[] =
+   "3f482c8a9f19b01e6c46ee9711d9dc14fd4bf67af30765c2ae2b846a4d23a8cd"
+   "0db897086239492caf350b51f833868b9bc2b3bca9cf4113";
+
+static const char_t x448Iteration1000[] =
+   "aa3b4749d55b9daf1e5b00288826c467274ce3ebbdd5c17b975e09d4af6c67cf"
+   "10d087202db88286e2b79fceea3ec353ef54faa26e219f38";
+
+//RFC 7748, section 6.2
+static const char_t x448AlicePrivateKey[] =
+   "9a8f4925d1519f5775cf46b04b5800d4ee9ee8bae8bc5565d498c28dd9c9baf5"
+   "74a9419744897391006382a6f127ab1d9ac2d8c0a598726b";
+
+static const char_t x448AlicePublicKey[] =
+   "9b08f7cc31b7e3e67d22d5aea121074a273bd2b83de09c63faa73d2c22c5d9bb"
+   "c836647241d953d40c5b12da88120d53177f80e532c41fa0";
+
+static const char_t x448BobPrivateKey[] =
+   "1c306a7ac2a0e2e0990b294470cba339e6453772b075811d8fad0d1d6927c120"
+   "bb5ee8972b0d3e21374c9c921b09d1b0366f10b65173992d";
+
+static const char_t x448BobPublicKey[] =
+   "3eb7a829b0cd20f5bcfc0b599b6feccf6da4627107bdb0d4f345b43027d8b972"
+   "fc3e34fb4232a13ca706dcb57aec3dae07bdc1c67bf33609";
+
+static const char_t x448SharedSecret[] =
+   "07fff4181ac6cc95ec1c16a94a0f74d12da232ce40a77552281d282bb60c0b56"
+   "fd2464c335543936521c24403085d59a449a5037514a879d";
+
+//RFC 8032, section 7.4
+static const Ed448TestVector ed448TestVectors[] =
+{
+   //Blank
+   {
+      "6c82a562cb808d10d632be89c8513ebf6c929f34ddfa8c9f63c9960ef6e348a3"
+      "528c8a3fcc2f044e39a3fc5b94492f8f032e7549a20098f95b",
+      "5fd7449b59b461fd2ce787ec616ad46a1da1342485a70e1f8a0ea75d80e96778"
+      "edf124769b46c7061bd6783df1e50f6cd1fa1abeafe8256180",
+      "",
+      "",
+      "533a37f6bbe457251f023c0d88f976ae2dfb504a843e34d2074fd823d41a591f"
+      "2b233f034f628281f2fd7a22ddd47d7828c59bd0a21bfd3980ff0d2028d4b18a"
+      "9df63e006c5d1c2d345b925d8dc00b4104852db99ac5c7cdda8530a113a0f4db"
+      "b61149f05a7363268c71d95808ff2e652600"
+   },
+   //1 octet
+   {
+      "c4eab05d357007c632f3dbb48489924d552b08fe0c353a0d4a1f00acda2c463a"
+      "fbea67c5e8d2877c5e3bc397a659949ef8021e954e0a12274e",
+      "43ba28f430cdff456ae531545f7ecd0ac834a55d9358c0372bfa0c6c6798c086"
+      "6aea01eb00742802b8438ea4cb82169c235160627b4c3a9480",
+      "03",
+      "",
+      "26b8f91727bd62897af15e41eb43c377efb9c610d48f2335cb0bd0087810f435"
+      "2541b143c4b981b7e18f62de8ccdf633fc1bf037ab7cd779805e0dbcc0aae1cb"
+      "cee1afb2e027df36bc04dcecbf154336c19f0af7e0a6472905e799f1953d2a0f"
+      "f3348ab21aa4adafd1d234441cf807c03a00"
+   },
+   //1 octet (with context)
+   {
+      "c4eab05d357007c632f3dbb48489924d552b08fe0c353a0d4a1f00acda2c463a"
+      "fbea67c5e8d2877c5e3bc397a659949ef8021e954e0a12274e",
+      "43ba28f430cdff456ae531545f7ecd0ac834a55d9358c0372bfa0c6c6798c086"
+      "6aea01eb00742802b8438ea4cb82169c235160627b4c3a9480",
+      "03",
+      "666f6f",
+      "d4f8f6131770dd46f40867d6fd5d5055de43541f8c5e35abbcd001b32a89f7d2"
+      "151f7647f11d8ca2ae279fb842d607217fce6e042f6815ea000c85741de5c8da"
+      "1144a6a1aba7f96de42505d7a7298524fda538fccbbb754f578c1cad10d54d0d"
+      "5428407e85dcbc98a49155c13764e66c3c00"
+   },
+   //11 octets
+   {
+      "cd23d24f714274e744343237b93290f511f6425f98e64459ff203e8985083ffd"
+      "f60500553abc0e05cd02184bdb89c4ccd67e187951267eb328",
+      "dcea9e78f35a1bf3499a831b10b86c90aac01cd84b67a0109b55a36e9328b1e3"
+      "65fce161d71ce7131a543ea4cb5f7e9f1d8b00696447001400",
+      "0c3e544074ec63b0265e0c",
+      "",
+      "1f0a8888ce25e8d458a21130879b840a9089d999aaba039eaf3e3afa090a09d3"
+      "89dba82c4ff2ae8ac5cdfb7c55e94d5d961a29fe0109941e00b8dbdeea6d3b05"
+      "1068df7254c0cdc129cbe62db2dc957dbb47b51fd3f213fb8698f064774250a5"
+      "028961c9bf8ffd973fe5d5c206492b140e00"
+   }
+};
+
+
+/**
+ * @brief Decode a hex string
+ * @param[in] s Hex string
+ * @param[out] data Decoded bytes
+ * @return Number of decoded bytes
+ **/
+
+static size_t hexDecode(const char_t *s, uint8_t *data)
+{
+   size_t n;
+   unsigned int value;
+
+   for(n = 0; s[2 * n] != '\0'; n++)
+   {
+      sscanf(s + 2 * n, "%2x", &value);
+      data[n] = (uint8_t) value;
+   }
+
+   return n;
+}
+
+
+/**
+ * @brief Compare a buffer against a hex string
+ * @param[in] data Buffer
+ * @param[in] s Expected value, as a hex string
+ * @return Error code
+ **/
+
+static error_t hexCompare(const uint8_t *data, const char_t *s)
+{
+   size_t n;
+   uint8_t buffer[256];
+
+   //Decode the expected value
+   n = hexDecode(s, buffer);
+
+   //Compare the values
+   return memcmp(data, buffer, n) ? ERROR_FAILURE : NO_ERROR;
+}
+
+
+/**
+ * @brief Write a buffer to the transcript, as a hex string
+ * @param[in] fp Transcript file (optional)
+ * @param[in] label Label of the line
+ * @param[in] data Buffer
+ * @param[in] length Length of the buffer, in bytes
+ **/
+
+static void writeTranscript(FILE *fp, const char_t *label,
+   const uint8_t *data, size_t length)
+{
+   size_t i;
+
+   if(fp != NULL)
+   {
+      fprintf(fp, "%s ", label);
+
+      for(i = 0; i < length; i++)
+      {
+         fprintf(fp, "%02x", data[i]);
+      }
+
+      fprintf(fp, "\n");
+   }
+}
+
+
+/**
+ * @brief X448 test vectors
+ * @return Error code
+ **/
+
+static error_t testX448(void)
+{
+   error_t error;
+   uint_t i;
+   uint8_t k[CURVE448_BYTE_LEN];
+   uint8_t u[CURVE448_BYTE_LEN];
+   uint8_t r[CURVE448_BYTE_LEN];
+   uint8_t t[CURVE448_BYTE_LEN];
+
+   //Scalar multiplication
+   for(error = NO_ERROR, i = 0; i < arraysize(x448TestVectors) && !error; i++)
+   {
+      hexDecode(x448TestVectors[i].k, k);
+      hexDecode(x448TestVectors[i].u, u);
+
+      error = x448(r, k, u);
+
+      if(!error)
+      {
+         error = hexCompare(r, x448TestVectors[i].r);
+      }
+   }
+
+   //Iterated scalar multiplication, starting with k = u = 5
+   if(!error)
+   {
+      memset(k, 0, sizeof(k));
+      memset(u, 0, sizeof(u));
+      k[0] = 5;
+      u[0] = 5;
+
+      for(i = 1; i <= 1000 && !error; i++)
+      {
+         error = x448(r, k, u);
+
+         //Set u to the old value of k and k to the result
+         memcpy(u, k, CURVE448_BYTE_LEN);
+         memcpy(k, r, CURVE448_BYTE_LEN);
+
+         if(!error && i == 1)
+         {
+            error = hexCompare(k, x448Iteration1);
+         }
+      }
+
+      if(!error)
+      {
+         error = hexCompare(k, x448Iteration1000);
+      }
+   }
+
+   //Diffie-Hellman
+   if(!error)
+   {
+      memset(u, 0, sizeof(u));
+      u[0] = 5;
+
+      hexDecode(x448AlicePrivateKey, k);
+      error = x448(r, k, u);
+
+      if(!error)
+      {
+         error = hexCompare(r, x448AlicePublicKey);
+      }
+
+      if(!error)
+      {
+         hexDecode(x448BobPrivateKey, k);
+         error = x448(t, k, u);
+      }
+
+      if(!error)
+      {
+         error = hexCompare(t, x448BobPublicKey);
+      }
+
+      if(!error)
+      {
+         error = x448(t, k, r);
+      }
+
+      if(!error)
+      {
+         error = hexCompare(t, x448SharedSecret);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Ed448 test vectors
+ * @return Error code
+ **/
+
+static error_t testEd448(void)
+{
+   error_t error;
+   uint_t i;
+   size_t messageLen;
+   size_t contextLen;
+   uint8_t privateKey[ED448_PRIVATE_KEY_LEN];
+   uint8_t publicKey[ED448_PUBLIC_KEY_LEN];
+   uint8_t message[64];
+   uint8_t context[64];
+   uint8_t signature[ED448_SIGNATURE_LEN];
+
+   //Loop through the test vectors
+   for(error = NO_ERROR, i = 0; i < arraysize(ed448TestVectors) && !error; i++)
+   {
+      hexDecode(ed448TestVectors[i].privateKey, privateKey);
+      messageLen = hexDecode(ed448TestVectors[i].message, message);
+      contextLen = hexDecode(ed448TestVectors[i].context, context);
+
+      //Derive the public key
+      error = ed448GeneratePublicKey(privateKey, publicKey);
+
+      if(!error)
+      {
+         error = hexCompare(publicKey, ed448TestVectors[i].publicKey);
+      }
+
+      //Sign the message
+      if(!error)
+      {
+         error = ed448GenerateSignature(privateKey, publicKey, message,
+            messageLen, context, (uint8_t) contextLen, 0, signature);
+      }
+
+      if(!error)
+      {
+         error = hexCompare(signature, ed448TestVectors[i].signature);
+      }
+
+      //Verify the signature
+      if(!error)
+      {
+         error = ed448VerifySignature(publicKey, message, messageLen, context,
+            (uint8_t) contextLen, 0, signature);
+      }
+
+      //A modified signature must be rejected
+      if(!error)
+      {
+         signature[0] ^= 0x01;
+
+         error = ed448VerifySignature(publicKey, message, messageLen, context,
+            (uint8_t) contextLen, 0, signature);
+
+         error = error ? NO_ERROR : ERROR_FAILURE;
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Random operations, recorded in a transcript
+ * @param[in] fp Transcript file (optional)
+ * @return Error code
+ **/
+
+static error_t testRandom(FILE *fp)
+{
+   error_t error;
+   uint_t i;
+   uint32_t c;
+   uint8_t a[CURVE448_BYTE_LEN];
+   uint8_t b[CURVE448_BYTE_LEN];
+   uint8_t r[CURVE448_BYTE_LEN];
+   uint8_t message[64];
+   uint8_t privateKey[ED448_PRIVATE_KEY_LEN];
+   uint8_t publicKey[ED448_PUBLIC_KEY_LEN];
+   uint8_t signature[ED448_SIGNATURE_LEN];
+   Curve448Limb x[CURVE448_LIMB_LEN];
+   Curve448Limb y[CURVE448_LIMB_LEN];
+   Curve448Limb z[CURVE448_LIMB_LEN];
+   Ed448Point p;
+
+   //Loop through the iterations
+   for(error = NO_ERROR, i = 0; i < TEST_RANDOM_ITERATIONS && !error; i++)
+   {
+      error = yarrowRead(&yarrowContext, a, sizeof(a));
+
+      if(!error)
+      {
+         error = yarrowRead(&yarrowContext, b, sizeof(b));
+      }
+
+      if(!error)
+      {
+         error = yarrowRead(&yarrowContext, message, sizeof(message));
+      }
+
+      if(error)
+         break;
+
+      //Field elements must be lower than p
+      a[CURVE448_BYTE_LEN - 1] &= 0x7F;
+      b[CURVE448_BYTE_LEN - 1] &= 0x7F;
+
+      curve448Import(x, a);
+      curve448Import(y, b);
+
+      //Field arithmetic
+      curve448Add(z, x, y);
+      curve448Export(z, r);
+      writeTranscript(fp, "add", r, sizeof(r));
+
+      curve448Sub(z, x, y);
+      curve448Export(z, r);
+      writeTranscript(fp, "sub", r, sizeof(r));
+
+      curve448Mul(z, x, y);
+      curve448Export(z, r);
+      writeTranscript(fp, "mul", r, sizeof(r));
+
+      curve448Sqr(z, x);
+      curve448Export(z, r);
+      writeTranscript(fp, "sqr", r, sizeof(r));
+
+      curve448Inv(z, x);
+      curve448Export(z, r);
+      writeTranscript(fp, "inv", r, sizeof(r));
+
+      c = curve448Sqrt(z, x, y);
+      curve448Export(z, r);
+      r[0] ^= (uint8_t) c;
+      writeTranscript(fp, "sqrt", r, sizeof(r));
+
+      //Scalar multiplication on Curve448
+      error = x448(r, a, b);
+      writeTranscript(fp, "x448", r, sizeof(r));
+
+      //Point decoding on Edwards448
+      if(!error)
+      {
+         memcpy(publicKey, a, CURVE448_BYTE_LEN);
+         publicKey[CURVE448_BYTE_LEN] = b[0] & 0x80;
+
+         c = ed448Decode(&p, publicKey);
+         ed448Encode(&p, publicKey);
+         publicKey[0] ^= (uint8_t) c;
+         writeTranscript(fp, "decode", publicKey, sizeof(publicKey));
+      }
+
+      //Ed448 signature
+      if(!error)
+      {
+         memcpy(privateKey, a, CURVE448_BYTE_LEN);
+         privateKey[CURVE448_BYTE_LEN] = b[0];
+
+         error = ed448GeneratePublicKey(privateKey, publicKey);
+         writeTranscript(fp, "publicKey", publicKey, sizeof(publicKey));
+      }
+
+      if(!error)
+      {
+         error = ed448GenerateSignature(privateKey, publicKey, message,
+            sizeof(message), NULL, 0, 0, signature);
+         writeTranscript(fp, "signature", signature, sizeof(signature));
+      }
+
+      if(!error)
+      {
+         error = ed448VerifySignature(publicKey, message, sizeof(message),
+            NULL, 0, 0, signature);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Report the outcome of a test
+ * @param[in] name Name of the test
+ * @param[in] error Error code
+ * @return 0 on success, 1 on failure
+ **/
+
+static int testReport(const char_t *name, error_t error)
+{
+   printf("%s: %s\r\n", name, error ? "FAILED" : "OK");
+   return error ? 1 : 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+   error_t error;
+   uint8_t seed[32];
+   FILE *fp;
+   int status;
+
+   //Seed the PRNG with a fixed value so that failures are reproducible
+   memset(seed, 0x5C, sizeof(seed));
+   error = yarrowInit(&yarrowContext);
+
+   if(!error)
+   {
+      error = yarrowSeed(&yarrowContext, seed, sizeof(seed));
+   }
+
+   if(error)
+   {
+      printf("Failed to initialize PRNG!\r\n");
+      return 1;
+   }
+
+   //Optional transcript file
+   fp = NULL;
+
+   if(argc > 1)
+   {
+      fp = fopen(argv[1], "w");
+
+      if(fp == NULL)
+      {
+         printf("Failed to open %s!\r\n", argv[1]);
+         return 1;
+      }
+   }
+
+   printf("Curve448 backend: %u-bit limbs\r\n",
+      (unsigned int) (sizeof(Curve448Limb) * 8));
+
+   status = 0;
+   status |= testReport("X448", testX448());
+   status |= testReport("Ed448", testEd448());
+   status |= testReport("Random operations", testRandom(fp));
+
+   if(fp != NULL)
+   {
+      fclose(fp);
+   }
+
+   //Release PRNG context
+   yarrowRelease(&yarrowContext);
+
+   //Return status code
+   return status;
+}
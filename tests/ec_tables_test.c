@@ -0,0 +1,250 @@
+/**
+ * @file ec_tables_test.c
+ * @brief Precomputed EC tables test
+ *
+ * Rebuilds each table emitted by ec_table_gen with the runtime routines
+ * (ecCombBuild and ed25519BuildBaseTable) and compares the result with the
+ * constant data compiled into the program
+ **/
+
+//Dependencies
+#include <stdio.h>
+#include <string.h>
+#include "core/crypto.h"
+#include "ecc/ec.h"
+#include "ecc/ec_comb.h"
+#include "ecc/ec_fixed.h"
+#include "ecc/ec_tables.h"
+
+//Check configuration
+#if (EC_STATIC_TABLE_SUPPORT != ENABLED)
+   #error The test must be compiled with EC_STATIC_TABLE_SUPPORT enabled
+#endif
+
+
+#if (EC_COMB_SUPPORT == ENABLED)
+
+/**
+ * @brief Compare two multiple precision integers word by word
+ * @param[in] a First integer
+ * @param[in] b Second integer
+ * @return TRUE if the integers have the same sign and significant words
+ **/
+
+static bool_t testCompareMpi(const Mpi *a, const Mpi *b)
+{
+   uint_t n;
+
+   //Number of significant words
+   n = mpiGetLength(a);
+
+   //Compare sign and length
+   if(a->sign != b->sign || mpiGetLength(b) != n)
+      return FALSE;
+
+   //Compare the words
+   return !osMemcmp(a->data, b->data, n * MPI_INT_SIZE);
+}
+
+
+/**
+ * @brief Compare two arrays of EC points
+ * @param[in] a First array
+ * @param[in] b Second array
+ * @param[in] n Number of points
+ * @return TRUE if the points are identical
+ **/
+
+static bool_t testComparePoints(const EcPoint *a, const EcPoint *b, uint_t n)
+{
+   uint_t i;
+
+   //Loop through the points
+   for(i = 0; i < n; i++)
+   {
+      if(!testCompareMpi(&a[i].x, &b[i].x) ||
+         !testCompareMpi(&a[i].y, &b[i].y) ||
+         !testCompareMpi(&a[i].z, &b[i].z))
+      {
+         return FALSE;
+      }
+   }
+
+   //The points are identical
+   return TRUE;
+}
+
+
+/**
+ * @brief Check the precomputed multiples of the base point of a curve
+ * @param[in] curveInfo Elliptic curve parameters
+ * @return Error code
+ **/
+
+static error_t testCombTable(const EcCurveInfo *curveInfo)
+{
+   error_t error;
+   uint_t m;
+   const EcCombTable *expected;
+   EcDomainParameters params;
+   EcCombTable table;
+#if (EC_FIXED_SUPPORT == ENABLED)
+   uint_t i;
+   EcFixedCurve curve;
+#endif
+
+   //Retrieve the table compiled into the program
+   expected = ecGetStaticCombTable(curveInfo);
+   //No table emitted for this curve?
+   if(expected == NULL)
+      return ERROR_FAILURE;
+
+   //Initialize structures
+   ecInitDomainParameters(&params);
+   ecCombInit(&table);
+
+   //Load EC domain parameters
+   error = ecLoadDomainParameters(&params, curveInfo);
+
+   //Rebuild the table at runtime
+   if(!error)
+   {
+      error = ecCombBuild(&params, &table);
+   }
+
+   //Compare the parameters of the tables
+   if(!error)
+   {
+      if(table.expLen != expected->expLen || table.h != expected->h ||
+         table.v != expected->v || table.a != expected->a ||
+         table.b != expected->b || table.wnaf.w != expected->wnaf.w ||
+         !testCompareMpi(&table.p, &expected->p))
+      {
+         error = ERROR_FAILURE;
+      }
+   }
+
+   //Compare the comb points and the odd multiples of G
+   if(!error)
+   {
+      m = 1 << (table.wnaf.w - 2);
+
+      if(!testComparePoints(table.points, expected->points,
+         table.v << table.h) ||
+         !testComparePoints(table.wnaf.points, expected->wnaf.points, m))
+      {
+         error = ERROR_FAILURE;
+      }
+   }
+
+#if (EC_FIXED_SUPPORT == ENABLED)
+   //Compare the odd multiples of G in fixed-width representation
+   if(!error && !ecFixedInit(&curve, &params))
+   {
+      if(table.wnaf.fixedPoints == NULL || expected->wnaf.fixedPoints == NULL)
+      {
+         error = ERROR_FAILURE;
+      }
+
+      for(i = 0; i < m && !error; i++)
+      {
+         if(osMemcmp(table.wnaf.fixedPoints[i].x,
+            expected->wnaf.fixedPoints[i].x, curve.n * sizeof(MpiFixedWord)) ||
+            osMemcmp(table.wnaf.fixedPoints[i].y,
+            expected->wnaf.fixedPoints[i].y, curve.n * sizeof(MpiFixedWord)) ||
+            osMemcmp(table.wnaf.fixedPoints[i].z,
+            expected->wnaf.fixedPoints[i].z, curve.n * sizeof(MpiFixedWord)))
+         {
+            error = ERROR_FAILURE;
+         }
+      }
+   }
+#endif
+
+   //Release resources
+   ecCombFree(&table);
+   ecFreeDomainParameters(&params);
+
+   //Return status code
+   return error;
+}
+
+#endif
+
+
+#if (ED25519_SUPPORT == ENABLED && ED25519_BASE_TABLE_SUPPORT == ENABLED)
+
+/**
+ * @brief Check the precomputed multiples of the Ed25519 base point
+ * @return Error code
+ **/
+
+static error_t testEd25519Table(void)
+{
+   error_t error;
+   Ed25519BaseTable *table;
+
+   //Allocate a memory buffer to hold the table
+   table = cryptoAllocMem(sizeof(Ed25519BaseTable));
+   //Failed to allocate memory?
+   if(table == NULL)
+      return ERROR_OUT_OF_MEMORY;
+
+   //Rebuild the table at runtime
+   error = ed25519BuildBaseTable(table);
+
+   //The tables must be identical
+   if(!error)
+   {
+      if(osMemcmp(table, &ed25519StaticBaseTable, sizeof(Ed25519BaseTable)))
+         error = ERROR_FAILURE;
+   }
+
+   //Release previously allocated memory
+   cryptoFreeMem(table);
+
+   //Return status code
+   return error;
+}
+
+#endif
+
+
+/**
+ * @brief Report the result of a check
+ * @param[in] name Name of the table
+ * @param[in] error Error code returned by the check
+ * @return Exit status of the check
+ **/
+
+static int testReport(const char_t *name, error_t error)
+{
+   printf("%s: %s\r\n", name, error ? "FAILED" : "OK");
+   return error ? 1 : 0;
+}
+
+
+int main(void)
+{
+   int status;
+
+   //Initialize exit status
+   status = 0;
+
+#if (EC_COMB_SUPPORT == ENABLED && SECP256R1_SUPPORT == ENABLED)
+   status |= testReport("secp256r1 comb table",
+      testCombTable(SECP256R1_CURVE));
+#endif
+
+#if (EC_COMB_SUPPORT == ENABLED && SECP384R1_SUPPORT == ENABLED)
+   status |= testReport("secp384r1 comb table",
+      testCombTable(SECP384R1_CURVE));
+#endif
+
+#if (ED25519_SUPPORT == ENABLED && ED25519_BASE_TABLE_SUPPORT == ENABLED)
+   status |= testReport("Ed25519 base table", testEd25519Table());
+#endif
+
+   //Return exit status
+   return status;
+}
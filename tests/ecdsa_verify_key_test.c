@@ -0,0 +1,167 @@
+/**
+ * @file ecdsa_verify_key_test.c
+ * @brief ECDSA verification key test
+ *
+ * Checks that signatures verified with a prebuilt verification key yield the
+ * same result as the one-shot verification routine, on each curve type
+ **/
+
+//Dependencies
+#include <stdio.h>
+#include <string.h>
+#include "core/crypto.h"
+#include "ecc/ecdsa.h"
+#include "rng/yarrow.h"
+
+//PRNG context
+static YarrowContext yarrowContext;
+
+//Curves under test
+static const EcCurveInfo *const testCurves[] =
+{
+   SECP112R2_CURVE,
+   SECP128R2_CURVE,
+   SECP160R2_CURVE,
+   SECP256K1_CURVE,
+   SECP256R1_CURVE
+};
+
+
+/**
+ * @brief Sign a digest and verify the signature with a verification key
+ * @param[in] curveInfo Elliptic curve parameters
+ * @return Error code
+ **/
+
+static error_t testCurve(const EcCurveInfo *curveInfo)
+{
+   error_t error;
+   uint8_t digest[32];
+   EcDomainParameters params;
+   EcPrivateKey privateKey;
+   EcPublicKey publicKey;
+   EcdsaSignature signature;
+   EcdsaVerifyKey key;
+
+   //Initialize structures
+   ecInitDomainParameters(&params);
+   ecInitPrivateKey(&privateKey);
+   ecInitPublicKey(&publicKey);
+   ecdsaInitSignature(&signature);
+   ecdsaInitVerifyKey(&key);
+
+   //Message digest
+   memset(digest, 0xA5, sizeof(digest));
+
+   //Load EC domain parameters
+   error = ecLoadDomainParameters(&params, curveInfo);
+
+   //Generate a key pair and sign the digest
+   if(!error)
+   {
+      error = ecGenerateKeyPair(YARROW_PRNG_ALGO, &yarrowContext, &params,
+         &privateKey, &publicKey);
+   }
+
+   if(!error)
+   {
+      error = ecdsaGenerateSignature(YARROW_PRNG_ALGO, &yarrowContext,
+         &params, &privateKey, digest, sizeof(digest), &signature);
+   }
+
+   //Precompute the verification key
+   if(!error)
+   {
+      error = ecdsaBuildVerifyKey(&params, &publicKey, &key);
+   }
+
+   //Both verification routines must accept the signature
+   if(!error)
+   {
+      error = ecdsaVerifySignature(&params, &publicKey, digest,
+         sizeof(digest), &signature);
+   }
+
+   if(!error)
+   {
+      error = ecdsaVerifySignatureWithKey(&params, &key, digest,
+         sizeof(digest), &signature);
+   }
+
+   //Both verification routines must reject a modified digest
+   if(!error)
+   {
+      digest[0] ^= 0x01;
+
+      if(ecdsaVerifySignature(&params, &publicKey, digest, sizeof(digest),
+         &signature) != ERROR_INVALID_SIGNATURE)
+      {
+         error = ERROR_FAILURE;
+      }
+      else if(ecdsaVerifySignatureWithKey(&params, &key, digest,
+         sizeof(digest), &signature) != ERROR_INVALID_SIGNATURE)
+      {
+         error = ERROR_FAILURE;
+      }
+   }
+
+   //Release resources
+   ecdsaFreeVerifyKey(&key);
+   ecdsaFreeSignature(&signature);
+   ecFreePublicKey(&publicKey);
+   ecFreePrivateKey(&privateKey);
+   ecFreeDomainParameters(&params);
+
+   //Return status code
+   return error;
+}
+
+
+int main(void)
+{
+   error_t error;
+   uint_t i;
+   uint_t j;
+   uint8_t seed[32];
+   int status;
+
+   //Seed the PRNG with a fixed value so that failures are reproducible
+   memset(seed, 0x5C, sizeof(seed));
+   error = yarrowInit(&yarrowContext);
+
+   if(!error)
+   {
+      error = yarrowSeed(&yarrowContext, seed, sizeof(seed));
+   }
+
+   if(error)
+   {
+      printf("Failed to initialize PRNG!\r\n");
+      return 1;
+   }
+
+   status = 0;
+
+   //Loop through the curves
+   for(i = 0; i < arraysize(testCurves); i++)
+   {
+      //Run several iterations per curve
+      for(j = 0; j < 16; j++)
+      {
+         error = testCurve(testCurves[i]);
+         if(error)
+            break;
+      }
+
+      printf("%s: %s\r\n", testCurves[i]->name, error ? "FAILED" : "OK");
+
+      if(error)
+         status = 1;
+   }
+
+   //Release PRNG context
+   yarrowRelease(&yarrowContext);
+
+   //Return status code
+   return status;
+}
@@ -0,0 +1,304 @@
+/**
+ * @file mpi_comb_test.c
+ * @brief Fixed-base precomputed tables test
+ *
+ * Checks that serialized tables survive an export/import round trip and that
+ * corrupted tables are rejected by the import routine
+ **/
+
+//Dependencies
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/crypto.h"
+#include "mpi/mpi_comb.h"
+#include "hash/sha256.h"
+#include "rng/yarrow.h"
+
+//PRNG context
+static YarrowContext yarrowContext;
+
+//Modulus sizes under test
+static const uint_t testModulusSizes[] =
+{
+   1024,
+   2048
+};
+
+
+/**
+ * @brief Check a table against the regular modular exponentiation
+ * @param[in] table Precomputed tables for base G and modulus P
+ * @param[in] g Base
+ * @param[in] p Modulus
+ * @param[in] expLen Length of the exponent, in bits
+ * @return Error code
+ **/
+
+static error_t testExpMod(const MpiCombTable *table, const Mpi *g,
+   const Mpi *p, uint_t expLen)
+{
+   error_t error;
+   uint_t i;
+   Mpi e;
+   Mpi r;
+   Mpi s;
+
+   //Initialize multiple precision integers
+   mpiInit(&e);
+   mpiInit(&r);
+   mpiInit(&s);
+
+   //Compare the results on a few random exponents
+   for(error = NO_ERROR, i = 0; i < 8 && !error; i++)
+   {
+      error = mpiRand(&e, expLen, YARROW_PRNG_ALGO, &yarrowContext);
+
+      if(!error)
+      {
+         error = mpiCombExpMod(table, &r, &e);
+      }
+
+      if(!error)
+      {
+         error = mpiExpModRegular(&s, g, &e, p);
+      }
+
+      if(!error && mpiComp(&r, &s))
+      {
+         error = ERROR_FAILURE;
+      }
+   }
+
+   //Release multiple precision integers
+   mpiFree(&e);
+   mpiFree(&r);
+   mpiFree(&s);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Import a table that is expected to be rejected
+ * @param[in] g Base
+ * @param[in] p Modulus
+ * @param[in] data Serialized tables
+ * @param[in] length Length of the serialized tables, in bytes
+ * @return Error code
+ **/
+
+static error_t testReject(const Mpi *g, const Mpi *p, const uint8_t *data,
+   size_t length)
+{
+   error_t error;
+   MpiCombTable table;
+
+   //Initialize precomputed tables
+   mpiCombInit(&table);
+
+   //The import routine must fail
+   error = mpiCombImport(&table, g, p, data, length);
+   error = error ? NO_ERROR : ERROR_FAILURE;
+
+   //Release precomputed tables
+   mpiCombFree(&table);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Export, import and corrupt the tables for a random modulus
+ * @param[in] modulusSize Size of the modulus, in bits
+ * @return Error code
+ **/
+
+static error_t testModulus(uint_t modulusSize)
+{
+   error_t error;
+   uint_t n;
+   size_t length;
+   uint8_t *data;
+   uint8_t *copy;
+   Mpi g;
+   Mpi p;
+   MpiCombTable table;
+   MpiCombTable table2;
+
+   //Initialize variables
+   data = NULL;
+   copy = NULL;
+   mpiInit(&g);
+   mpiInit(&p);
+   mpiCombInit(&table);
+   mpiCombInit(&table2);
+
+   //Generate a random odd modulus of the requested size
+   error = mpiRand(&p, modulusSize, YARROW_PRNG_ALGO, &yarrowContext);
+
+   if(!error)
+   {
+      error = mpiSetBitValue(&p, modulusSize - 1, 1);
+   }
+
+   if(!error)
+   {
+      error = mpiSetBitValue(&p, 0, 1);
+   }
+
+   //Generate a random base
+   if(!error)
+   {
+      error = mpiRandRange(&g, &p, YARROW_PRNG_ALGO, &yarrowContext);
+   }
+
+   //Build the tables
+   if(!error)
+   {
+      error = mpiCombBuild(&table, &g, &p, 256);
+   }
+
+   if(!error)
+   {
+      error = testExpMod(&table, &g, &p, 256);
+   }
+
+   //Serialize the tables
+   if(!error)
+   {
+      error = mpiCombExport(&table, NULL, &length);
+   }
+
+   if(!error)
+   {
+      data = malloc(length);
+      copy = malloc(length);
+
+      if(data == NULL || copy == NULL)
+         error = ERROR_OUT_OF_MEMORY;
+   }
+
+   if(!error)
+   {
+      error = mpiCombExport(&table, data, &length);
+   }
+
+   //The imported tables must give the same results
+   if(!error)
+   {
+      error = mpiCombImport(&table2, &g, &p, data, length);
+   }
+
+   if(!error)
+   {
+      error = testExpMod(&table2, &g, &p, 256);
+   }
+
+   //Length of each entry, in bytes
+   n = modulusSize / 8;
+
+   //Truncated tables
+   if(!error)
+   {
+      error = testReject(&g, &p, data, length - 1);
+   }
+
+   //Flipped bit in the middle of the entries
+   if(!error)
+   {
+      memcpy(copy, data, length);
+      copy[MPI_COMB_HEADER_SIZE + (length - MPI_COMB_HEADER_SIZE) / 2] ^= 0x01;
+      error = testReject(&g, &p, copy, length);
+   }
+
+   //Flipped bit in the digest
+   if(!error)
+   {
+      memcpy(copy, data, length);
+      copy[MPI_COMB_HEADER_SIZE - 1] ^= 0x80;
+      error = testReject(&g, &p, copy, length);
+   }
+
+   //Entry that is not reduced modulo P, with a matching digest
+   if(!error)
+   {
+      memcpy(copy, data, length);
+      memset(copy + MPI_COMB_HEADER_SIZE + 2 * n, 0xFF, n);
+      error = sha256Compute(copy + MPI_COMB_HEADER_SIZE,
+         length - MPI_COMB_HEADER_SIZE, copy + 8);
+
+      if(!error)
+      {
+         error = testReject(&g, &p, copy, length);
+      }
+   }
+
+   //Tables built for another base
+   if(!error)
+   {
+      error = mpiAddInt(&g, &g, 1);
+
+      if(!error)
+      {
+         error = testReject(&g, &p, data, length);
+      }
+   }
+
+   //Release resources
+   free(data);
+   free(copy);
+   mpiCombFree(&table);
+   mpiCombFree(&table2);
+   mpiFree(&g);
+   mpiFree(&p);
+
+   //Return status code
+   return error;
+}
+
+
+int main(void)
+{
+   error_t error;
+   uint_t i;
+   uint8_t seed[32];
+   int status;
+
+   //Seed the PRNG with a fixed value so that failures are reproducible
+   memset(seed, 0x5C, sizeof(seed));
+   error = yarrowInit(&yarrowContext);
+
+   if(!error)
+   {
+      error = yarrowSeed(&yarrowContext, seed, sizeof(seed));
+   }
+
+   if(error)
+   {
+      printf("Failed to initialize PRNG!\r\n");
+      return 1;
+   }
+
+   status = 0;
+
+   //Loop through the modulus sizes
+   for(i = 0; i < arraysize(testModulusSizes); i++)
+   {
+      error = testModulus(testModulusSizes[i]);
+
+      printf("%u-bit modulus: %s\r\n", testModulusSizes[i],
+         error ? "FAILED" : "OK");
+
+      if(error)
+         status = 1;
+   }
+
+   //Release PRNG context
+   yarrowRelease(&yarrowContext);
+
+   //Return status code
+   return status;
+}
@@ -0,0 +1,343 @@
+/**
+ * @file mpi_prime_test.c
+ * @brief Probable prime test
+ *
+ * Checks that mpiCheckProbablePrime accepts known primes and rejects
+ * Carmichael numbers and strong pseudoprimes to the first prime bases. A
+ * small set of Diffie-Hellman parameters is also generated and checked
+ **/
+
+//Dependencies
+#include <stdio.h>
+#include <string.h>
+#include "core/crypto.h"
+#include "mpi/mpi.h"
+#include "pkc/dh.h"
+#include "rng/yarrow.h"
+
+//PRNG context
+static YarrowContext yarrowContext;
+
+//Primes, as hex strings
+static const char_t *const testPrimes[] =
+{
+   "02",
+   "03",
+   "fb",                 //251
+   "0101",               //257
+   "010001",             //65537
+   "7fffffff",           //2^31 - 1
+   "1fffffffffffffff"    //2^61 - 1
+};
+
+//Exponents of Mersenne primes 2^n - 1
+static const uint_t testMersennePrimes[] =
+{
+   89,
+   127,
+   521,
+   607,
+   1279
+};
+
+//Composites, as hex strings
+static const char_t *const testComposites[] =
+{
+   "00",
+   "01",
+   "04",
+   //Carmichael numbers
+   "0231",               //561
+   "0451",               //1105
+   "06c1",               //1729
+   "09a1",               //2465
+   "0b05",               //2821
+   "19c9",               //6601
+   "22cf",               //8911
+   "07164b11",           //118901521 = 271 * 541 * 811
+   //Strong pseudoprimes to base 2
+   "07ff",               //2047
+   "0ccd",               //3277
+   "0fc1",               //4033
+   //Strong pseudoprimes to base 3
+   "79",                 //121
+   "02bf",               //703
+   "0763",               //1891
+   //Strong pseudoprimes to the first prime bases
+   "14f5d5",             //1373653 (bases 2 and 3)
+   "018271b1",           //25326001 (bases 2 to 5)
+   "01f51f3fee3b",       //2152302898747 (bases 2 to 11)
+   "032907381cdf",       //3474749660383 (bases 2 to 13)
+   "0136a352b2c8c1",     //341550071728321 (bases 2 to 17)
+   "351591274f9af9fb",   //3825123056546413051 (bases 2 to 31)
+   //318665857834031151167461 (bases 2 to 37)
+   "437ae92817f9fc85b7e5",
+   //3317044064679887385961981 (bases 2 to 41)
+   "02be6951adc5b22410a5fd",
+   //2^67 - 1 (strong pseudoprime to base 2)
+   "07ffffffffffffffff"
+};
+
+
+/**
+ * @brief Load a multiple precision integer from a hex string
+ * @param[out] r Resulting integer
+ * @param[in] s Hex string
+ * @return Error code
+ **/
+
+static error_t loadHex(Mpi *r, const char_t *s)
+{
+   size_t n;
+   unsigned int value;
+   uint8_t data[64];
+
+   for(n = 0; s[2 * n] != '\0'; n++)
+   {
+      sscanf(s + 2 * n, "%2x", &value);
+      data[n] = (uint8_t) value;
+   }
+
+   return mpiImport(r, data, n, MPI_FORMAT_BIG_ENDIAN);
+}
+
+
+/**
+ * @brief Load the Mersenne number 2^n - 1
+ * @param[out] r Resulting integer
+ * @param[in] n Exponent
+ * @return Error code
+ **/
+
+static error_t loadMersenne(Mpi *r, uint_t n)
+{
+   error_t error;
+
+   error = mpiSetValue(r, 1);
+
+   if(!error)
+   {
+      error = mpiShiftLeft(r, n);
+   }
+
+   if(!error)
+   {
+      error = mpiSubInt(r, r, 1);
+   }
+
+   return error;
+}
+
+
+/**
+ * @brief Primes must be accepted and composites rejected
+ * @return Error code
+ **/
+
+static error_t testProbablePrime(void)
+{
+   error_t error;
+   uint_t i;
+   Mpi a;
+   Mpi b;
+
+   //Initialize multiple precision integers
+   mpiInit(&a);
+   mpiInit(&b);
+
+   //Primes
+   for(error = NO_ERROR, i = 0; i < arraysize(testPrimes) && !error; i++)
+   {
+      error = loadHex(&a, testPrimes[i]);
+
+      if(!error)
+      {
+         error = mpiCheckProbablePrime(&a);
+      }
+
+      if(error)
+      {
+         printf("  prime %s rejected\r\n", testPrimes[i]);
+      }
+   }
+
+   for(i = 0; i < arraysize(testMersennePrimes) && !error; i++)
+   {
+      error = loadMersenne(&a, testMersennePrimes[i]);
+
+      if(!error)
+      {
+         error = mpiCheckProbablePrime(&a);
+      }
+
+      if(error)
+      {
+         printf("  prime 2^%u - 1 rejected\r\n", testMersennePrimes[i]);
+      }
+   }
+
+   //Composites
+   for(i = 0; i < arraysize(testComposites) && !error; i++)
+   {
+      error = loadHex(&a, testComposites[i]);
+
+      if(!error && mpiCheckProbablePrime(&a) != ERROR_INVALID_VALUE)
+      {
+         printf("  composite %s accepted\r\n", testComposites[i]);
+         error = ERROR_FAILURE;
+      }
+   }
+
+   //Product of two Mersenne primes (no small factor)
+   if(!error)
+   {
+      error = loadMersenne(&a, 89);
+
+      if(!error)
+      {
+         error = loadMersenne(&b, 127);
+      }
+
+      if(!error)
+      {
+         error = mpiMul(&a, &a, &b);
+      }
+
+      if(!error && mpiCheckProbablePrime(&a) != ERROR_INVALID_VALUE)
+      {
+         printf("  composite (2^89 - 1) * (2^127 - 1) accepted\r\n");
+         error = ERROR_FAILURE;
+      }
+   }
+
+   //Release multiple precision integers
+   mpiFree(&a);
+   mpiFree(&b);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Generate Diffie-Hellman parameters and check the safe prime
+ * @param[in] length Bit length of the prime modulus
+ * @return Error code
+ **/
+
+static error_t testDhParameters(uint_t length)
+{
+   error_t error;
+   uint_t r;
+   DhParameters params;
+   Mpi q;
+
+   //Initialize structures
+   mpiInit(&params.p);
+   mpiInit(&params.g);
+   mpiInit(&q);
+
+   //Generate Diffie-Hellman parameters
+   error = dhGenerateParameters(&params, length, YARROW_PRNG_ALGO,
+      &yarrowContext, NULL, NULL);
+
+   //Check the length of the prime modulus
+   if(!error && mpiGetBitLength(&params.p) != length)
+   {
+      error = ERROR_FAILURE;
+   }
+
+   //The generator must be 2
+   if(!error && mpiCompInt(&params.g, 2) != 0)
+   {
+      error = ERROR_FAILURE;
+   }
+
+   //Check that p = 7 mod 8
+   if(!error)
+   {
+      error = mpiModInt(&r, &params.p, 8);
+
+      if(!error && r != 7)
+      {
+         error = ERROR_FAILURE;
+      }
+   }
+
+   //p must be a probable prime
+   if(!error)
+   {
+      error = mpiCheckProbablePrime(&params.p);
+   }
+
+   //(p - 1) / 2 must be a probable prime
+   if(!error)
+   {
+      error = mpiCopy(&q, &params.p);
+   }
+
+   if(!error)
+   {
+      error = mpiShiftRight(&q, 1);
+   }
+
+   if(!error)
+   {
+      error = mpiCheckProbablePrime(&q);
+   }
+
+   //Release structures
+   mpiFree(&params.p);
+   mpiFree(&params.g);
+   mpiFree(&q);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Report the result of a check
+ * @param[in] name Name of the check
+ * @param[in] error Error code returned by the check
+ * @return Exit status of the check
+ **/
+
+static int testReport(const char_t *name, error_t error)
+{
+   printf("%s: %s\r\n", name, error ? "FAILED" : "OK");
+   return error ? 1 : 0;
+}
+
+
+int main(void)
+{
+   error_t error;
+   uint8_t seed[32];
+   int status;
+
+   //Seed the PRNG with a fixed value so that failures are reproducible
+   memset(seed, 0x5C, sizeof(seed));
+   error = yarrowInit(&yarrowContext);
+
+   if(!error)
+   {
+      error = yarrowSeed(&yarrowContext, seed, sizeof(seed));
+   }
+
+   if(error)
+   {
+      printf("Failed to initialize PRNG!\r\n");
+      return 1;
+   }
+
+   status = 0;
+   status |= testReport("Probable primes", testProbablePrime());
+   status |= testReport("256-bit DH parameters", testDhParameters(256));
+
+   //Release PRNG context
+   yarrowRelease(&yarrowContext);
+
+   //Return status code
+   return status;
+}